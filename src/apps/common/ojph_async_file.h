@@ -0,0 +1,189 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, Aous Naman
+// Copyright (c) 2026, Kakadu Software Pty Ltd, Australia
+// Copyright (c) 2026, The University of New South Wales, Australia
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: ojph_async_file.h
+// Author: Aous Naman
+// Date: 19 October 2026
+//***************************************************************************/
+
+#ifndef OJPH_ASYNC_FILE_H
+#define OJPH_ASYNC_FILE_H
+
+#include <condition_variable>
+#include <mutex>
+
+#include "ojph_file.h"
+#include "ojph_threads.h"
+
+namespace ojph
+{
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*****************************************************************************/
+/** @brief A file written by a background thread
+ *
+ *  Writes are collected in one of two large buffers; when it is full, the
+ *  buffer is handed to a writer thread, and writing continues into the 
+ *  other buffer.  The caller waits only when both buffers are full, which
+ *  is when the storage is slower than the encoder.  
+ *
+ *  Each buffer is written at its own file offset; this allows seek() to 
+ *  move anywhere in the file, such as to patch a marker segment that was
+ *  written earlier, without waiting for pending writes.
+ *
+ *  Errors of the writer thread are reported by the next call to write(),
+ *  seek(), flush(), or close().
+ */
+class async_outfile : public outfile_base
+{
+public:
+  /**
+   *  @brief default constructor
+   */
+  async_outfile();
+  /**
+   *  @brief the destructor; close() must be called to learn whether all
+   *         data are written
+   */
+  ~async_outfile() override;
+
+public:
+  /**
+   *  @brief Creates the file, and starts the writer thread
+   *
+   *  With direct_io, the file is opened with O_DIRECT, where supported,
+   *  so that data bypass the page cache; buffers are then aligned to,
+   *  and written in multiples of, direct_io_alignment bytes, except for
+   *  the last part of the file, and data after a seek to an unaligned 
+   *  offset.  If the file system does not support O_DIRECT, the file is
+   *  written normally.
+   *
+   *  @param filename is the name of the file
+   *  @param buffer_size is the size of each of the two buffers
+   *  @param direct_io set to true to bypass the page cache
+   */
+  void open(const char *filename, size_t buffer_size = 1 << 22,
+            bool direct_io = false);
+
+  /**
+   *  @brief copies data into the current buffer; returns size
+   */
+  size_t write(const void *ptr, size_t size) override;
+
+  /**
+   *  @brief returns the position of the next write
+   */
+  si64 tell() override { return cur->offset + (si64)cur->used; }
+
+  /**
+   *  @brief moves the position of the next write; 0 on success
+   */
+  int seek(si64 offset, enum outfile_base::seek origin) override;
+
+  /**
+   *  @brief hands buffered data to the writer thread, and waits until all
+   *         data are written
+   */
+  void flush() override;
+
+  /**
+   *  @brief writes all data, stops the writer thread, and closes the file
+   */
+  void close() override;
+
+public:
+  static const size_t direct_io_alignment = 4096;
+
+private:
+  /** @brief A buffer, which is written to the file by the writer thread
+   */
+  struct write_task : public thds::worker_thread_base
+  {
+    write_task() 
+    { owner = NULL; store = data = NULL; used = 0; offset = 0; busy = false; }
+
+    void execute() override;
+
+    async_outfile *owner;  //!<the file this buffer belongs to
+    ui8 *store;            //!<the allocated memory
+    ui8 *data;             //!<the buffer, aligned in store
+    size_t used;           //!<bytes in data
+    si64 offset;           //!<file offset of data[0]
+    bool busy;             //!<true while the writer thread owns the buffer
+  };
+
+private:
+  /**
+   *  @brief hands cur to the writer thread, and switches to the other
+   *         buffer, which is waited for; the other buffer starts at
+   *         next_offset
+   */
+  void submit(si64 next_offset);
+
+  /**
+   *  @brief waits until the writer thread is done with task
+   */
+  void wait_for(write_task& task);
+
+  /**
+   *  @brief reports an error of the writer thread
+   */
+  void check_error();
+
+  /**
+   *  @brief writes a buffer at its offset; runs in the writer thread
+   */
+  bool write_task_data(const write_task& task);
+
+private:
+  int fd;                      //!<the file descriptor
+  bool direct;                 //!<true if the file uses O_DIRECT
+  size_t buf_size;             //!<the size of each buffer
+  si64 file_end;               //!<end of the data handed to the thread
+  write_task tasks[2];         //!<the two buffers
+  write_task *cur;             //!<the buffer being filled
+  bool failed;                 //!<set by the writer thread on error
+  std::mutex mutex;            //!<protects busy and failed
+  std::condition_variable condition;
+  thds::thread_pool writer;    //!<a pool with one thread
+};
+
+} // !ojph namespace
+
+#endif // !OJPH_ASYNC_FILE_H
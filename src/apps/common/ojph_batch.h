@@ -0,0 +1,171 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, Aous Naman
+// Copyright (c) 2026, Kakadu Software Pty Ltd, Australia
+// Copyright (c) 2026, The University of New South Wales, Australia
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: ojph_batch.h
+// Author: Aous Naman
+// Date: 19 October 2026
+//***************************************************************************/
+
+#ifndef OJPH_BATCH_H
+#define OJPH_BATCH_H
+
+#include <string>
+#include <vector>
+#include "ojph_defs.h"
+
+namespace ojph
+{
+namespace batch
+{
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*****************************************************************************/
+/** @brief A base object for processing the files of a batch
+ *
+ *  Each worker thread owns one of these objects, and uses it for all the
+ *  files it processes; derived objects can therefore keep buffers and
+ *  other state from one file to the next.
+ */
+class file_processor
+{
+public:
+  /**
+   *  @brief virtual destruction is a necessity to deconstruct derived
+   *  objects.
+   */
+  virtual ~file_processor() { }
+
+  /**
+   *  @brief Derived objects must define this function to process one file;
+   *         errors are reported by throwing an exception.
+   *
+   *  @param input_filename is the file to process
+   *  @param output_filename is the file to produce
+   */
+  virtual void process(const char *input_filename,
+                       const char *output_filename) = 0;
+};
+
+/*****************************************************************************/
+/** @brief Aggregate statistics of a batch
+ */
+struct batch_stats
+{
+  batch_stats()
+  { num_files = num_failed = 0; input_bytes = output_bytes = 0;
+    elapsed_secs = 0.0; }
+
+  ui32 num_files;       //!<number of files in the batch
+  ui32 num_failed;      //!<number of files that could not be processed
+  ui64 input_bytes;     //!<total size of the processed input files
+  ui64 output_bytes;    //!<total size of the produced output files
+  double elapsed_secs;  //!<wall-clock time of the batch
+};
+
+/*****************************************************************************/
+/** @brief Collects the names of the files of a batch
+ *
+ *  If source is a directory, every regular file in it whose extension
+ *  matches one of the extensions is collected, sorted by name; otherwise,
+ *  source is read as a list file with one file name per line, where empty
+ *  lines and lines starting with '#' are ignored.
+ *
+ *  @param source is a directory or a list file
+ *  @param extensions is a NULL-terminated array of extensions, including
+ *         the dot, that select files from a directory
+ *  @param files receives the file names
+ */
+void collect_files(const char *source, const char * const *extensions,
+                   std::vector<std::string>& files);
+
+/*****************************************************************************/
+/** @brief Builds an output file name from an input file name
+ *
+ *  The output file is placed in output_dir, and has the name of the input
+ *  file with its extension replaced by extension.
+ *
+ *  @param output_dir is the output directory
+ *  @param input_filename is the input file name, which may have a path
+ *  @param extension is the extension of the output file, including the dot
+ */
+std::string make_output_filename(const char *output_dir,
+                                 const char *input_filename,
+                                 const char *extension);
+
+/*****************************************************************************/
+/** @brief Checks that no two input files produce the same output file
+ *
+ *  Output names keep only the name of the input file, without its path
+ *  and extension, and therefore, img.ppm and img.pgm, or a/img.ppm and
+ *  b/img.ppm, produce the same output name; an error is reported for the
+ *  first such pair, before any file is processed.
+ *
+ *  @param inputs is the list of input files
+ *  @param outputs is the list of output files, one for each input
+ */
+void check_output_filenames(const std::vector<std::string>& inputs,
+                            const std::vector<std::string>& outputs);
+
+/*****************************************************************************/
+/** @brief Processes the files of a batch concurrently
+ *
+ *  Each processor is used by one thread; files are handed to threads as
+ *  they become free.  A file that fails is reported and counted, and does
+ *  not stop the batch.
+ *
+ *  @param inputs is the list of input files
+ *  @param outputs is the list of output files, one for each input
+ *  @param processors is an array of num_processors objects
+ *  @param num_processors is the number of threads to use
+ *  @param stats receives the statistics of the batch
+ */
+void run(const std::vector<std::string>& inputs,
+         const std::vector<std::string>& outputs,
+         file_processor **processors, ui32 num_processors,
+         batch_stats& stats);
+
+/*****************************************************************************/
+/** @brief Prints the statistics of a batch, including the throughput
+ */
+void print_stats(const batch_stats& stats);
+
+} // !batch namespace
+} // !ojph namespace
+
+#endif // !OJPH_BATCH_H
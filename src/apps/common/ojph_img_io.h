@@ -56,6 +56,225 @@ namespace ojph {
   class mem_fixed_allocator;
   class line_buf;
 
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  //
+  //
+  //
+  //
+  ////////////////////////////////////////////////////////////////////////////
+  // A read-only memory mapping of a whole file.  open() returns false if 
+  // the file cannot be mapped, such as an empty file, a file larger than 
+  // the address space, or where mapping is not supported; the caller then
+  // reads the file using stdio.
+  class mmap_in_file
+  {
+  public:
+    mmap_in_file()
+    {
+      data = NULL;
+      data_size = 0;
+      fd = -1;
+      file_h = map_h = NULL;
+    }
+    ~mmap_in_file() { close(); }
+
+    // sequential hints the system to read ahead
+    bool open(const char* filename, bool sequential = true);
+    void close();
+
+    bool is_open() const { return data != NULL; }
+    const ui8* get_data() const { assert(data); return data; }
+    size_t get_size() const { assert(data); return data_size; }
+
+  private:
+    const ui8* data;
+    size_t data_size;
+    int fd;                 // used with POSIX
+    void *file_h, *map_h;   // used with Windows
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  // A file that is written sequentially through memory-mapped windows.  
+  // The file is extended by one window at a time, and truncated to the 
+  // bytes written when closed.  open() returns false if the file cannot be
+  // mapped, in which case the caller writes the file using stdio.
+  class mmap_out_file
+  {
+  public:
+    mmap_out_file()
+    {
+      window = NULL;
+      window_start = 0;
+      window_size = 0;
+      pos = 0;
+      fd = -1;
+      file_h = map_h = NULL;
+    }
+    ~mmap_out_file() { close(); }
+
+    bool open(const char* filename);
+    // copies size bytes to the file; returns false on failure
+    bool write(const void* p, size_t size);
+    void close();
+
+    bool is_open() const { return fd != -1 || file_h != NULL; }
+
+  private:
+    bool map_window();
+    void unmap_window();
+
+  private:
+    ui8* window;            // mapped window of the file
+    si64 window_start;      // file offset of the window
+    size_t window_size;     // window size in bytes
+    si64 pos;               // number of bytes written
+    int fd;                 // used with POSIX
+    void *file_h, *map_h;   // used with Windows
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  // Image writers open their files using open_output_file, which takes the
+  // name "-" to mean the standard output; the standard output is switched
+  // to binary mode, given a large buffer, and never memory mapped.  Files
+  // opened this way are closed with close_output_file, which flushes the
+  // standard output rather than closing it, so that many images can be 
+  // written to it, one after another.
+  bool is_standard_stream(const char* filename);
+  FILE* open_output_file(const char* filename);
+  void close_output_file(FILE* fh);
+
+  ////////////////////////////////////////////////////////////////////////////
+  // The standard input copied into a temporary file, because image readers
+  // seek in their files, and identify file formats by extension.  open()
+  // reads the standard input to its end, and returns the name of a file 
+  // with the extension ext, such as ppm or .ppm; the file is removed by 
+  // close(), or on destruction.
+  class stdin_copy_file
+  {
+  public:
+    stdin_copy_file() { name[0] = '\0'; base_name[0] = '\0'; }
+    ~stdin_copy_file() { close(); }
+
+    const char* open(const char* ext);
+    void close();
+
+  private:
+    static const int max_name = 1024;
+    char name[max_name];       // the file that holds the standard input
+    char base_name[max_name];  // a file created to reserve a unique name,
+                               // used with Windows
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  // Input accelerators (defined in ojph_img_io_*); these read count samples
+  // of component comp_num from a line of a file, where 1c and 3c are the 
+  // number of interleaved components, ub and sb denote unsigned and signed
+  // samples, and le and be their byte order.  10b3c denotes 3 10-bit 
+  // samples packed in a 32-bit word, starting from its MSB.  msb10 denotes
+  // 10-bit samples held in the 10 MSBs of 16-bit words, as in P010, and 
+  // v210 denotes the v210 packing of 4:2:2 10-bit samples, where comp_num
+  // is 0 for Y, 1 for Cb, and 2 for Cr.
+  typedef void (*in_conversion_fun)(const void *sp, si32 *dp, 
+                                    ui32 comp_num, ui32 count);
+
+  void gen_cvrt_8ub1c_to_32b1c(const void *sp, si32 *dp,
+                               ui32 comp_num, ui32 count);
+  void gen_cvrt_8ub3c_to_32b1c(const void *sp, si32 *dp,
+                               ui32 comp_num, ui32 count);
+  void gen_cvrt_8sb1c_to_32b1c(const void *sp, si32 *dp,
+                               ui32 comp_num, ui32 count);
+  void gen_cvrt_16ub1c_le_to_32b1c(const void *sp, si32 *dp,
+                                   ui32 comp_num, ui32 count);
+  void gen_cvrt_16ub3c_le_to_32b1c(const void *sp, si32 *dp,
+                                   ui32 comp_num, ui32 count);
+  void gen_cvrt_16ub1c_be_to_32b1c(const void *sp, si32 *dp,
+                                   ui32 comp_num, ui32 count);
+  void gen_cvrt_16ub3c_be_to_32b1c(const void *sp, si32 *dp,
+                                   ui32 comp_num, ui32 count);
+  void gen_cvrt_16sb1c_le_to_32b1c(const void *sp, si32 *dp,
+                                   ui32 comp_num, ui32 count);
+  void gen_cvrt_10b3c_le_to_32b1c(const void *sp, si32 *dp,
+                                  ui32 comp_num, ui32 count);
+  void gen_cvrt_10b3c_be_to_32b1c(const void *sp, si32 *dp,
+                                  ui32 comp_num, ui32 count);
+  void gen_cvrt_8ub2c_to_32b1c(const void *sp, si32 *dp,
+                               ui32 comp_num, ui32 count);
+  void gen_cvrt_8ub4c_to_32b1c(const void *sp, si32 *dp,
+                               ui32 comp_num, ui32 count);
+  void gen_cvrt_16ub2c_le_to_32b1c(const void *sp, si32 *dp,
+                                   ui32 comp_num, ui32 count);
+  void gen_cvrt_16ub1c_le_msb10_to_32b1c(const void *sp, si32 *dp,
+                                         ui32 comp_num, ui32 count);
+  void gen_cvrt_16ub2c_le_msb10_to_32b1c(const void *sp, si32 *dp,
+                                         ui32 comp_num, ui32 count);
+  void gen_cvrt_v210_to_32b1c(const void *sp, si32 *dp,
+                              ui32 comp_num, ui32 count);
+
+  void sse41_cvrt_8ub1c_to_32b1c(const void *sp, si32 *dp,
+                                 ui32 comp_num, ui32 count);
+  void sse41_cvrt_8ub3c_to_32b1c(const void *sp, si32 *dp,
+                                 ui32 comp_num, ui32 count);
+  void sse41_cvrt_8sb1c_to_32b1c(const void *sp, si32 *dp,
+                                 ui32 comp_num, ui32 count);
+  void sse41_cvrt_16ub1c_le_to_32b1c(const void *sp, si32 *dp,
+                                     ui32 comp_num, ui32 count);
+  void sse41_cvrt_16ub3c_le_to_32b1c(const void *sp, si32 *dp,
+                                     ui32 comp_num, ui32 count);
+  void sse41_cvrt_16ub1c_be_to_32b1c(const void *sp, si32 *dp,
+                                     ui32 comp_num, ui32 count);
+  void sse41_cvrt_16ub3c_be_to_32b1c(const void *sp, si32 *dp,
+                                     ui32 comp_num, ui32 count);
+  void sse41_cvrt_16sb1c_le_to_32b1c(const void *sp, si32 *dp,
+                                     ui32 comp_num, ui32 count);
+  void sse41_cvrt_10b3c_le_to_32b1c(const void *sp, si32 *dp,
+                                    ui32 comp_num, ui32 count);
+  void sse41_cvrt_10b3c_be_to_32b1c(const void *sp, si32 *dp,
+                                    ui32 comp_num, ui32 count);
+  void sse41_cvrt_8ub2c_to_32b1c(const void *sp, si32 *dp,
+                                 ui32 comp_num, ui32 count);
+  void sse41_cvrt_8ub4c_to_32b1c(const void *sp, si32 *dp,
+                                 ui32 comp_num, ui32 count);
+  void sse41_cvrt_16ub2c_le_to_32b1c(const void *sp, si32 *dp,
+                                     ui32 comp_num, ui32 count);
+  void sse41_cvrt_16ub1c_le_msb10_to_32b1c(const void *sp, si32 *dp,
+                                           ui32 comp_num, ui32 count);
+  void sse41_cvrt_16ub2c_le_msb10_to_32b1c(const void *sp, si32 *dp,
+                                           ui32 comp_num, ui32 count);
+  void sse41_cvrt_v210_to_32b1c(const void *sp, si32 *dp,
+                                ui32 comp_num, ui32 count);
+
+  void avx2_cvrt_8ub1c_to_32b1c(const void *sp, si32 *dp,
+                                ui32 comp_num, ui32 count);
+  void avx2_cvrt_8ub3c_to_32b1c(const void *sp, si32 *dp,
+                                ui32 comp_num, ui32 count);
+  void avx2_cvrt_8sb1c_to_32b1c(const void *sp, si32 *dp,
+                                ui32 comp_num, ui32 count);
+  void avx2_cvrt_16ub1c_le_to_32b1c(const void *sp, si32 *dp,
+                                    ui32 comp_num, ui32 count);
+  void avx2_cvrt_16ub3c_le_to_32b1c(const void *sp, si32 *dp,
+                                    ui32 comp_num, ui32 count);
+  void avx2_cvrt_16ub1c_be_to_32b1c(const void *sp, si32 *dp,
+                                    ui32 comp_num, ui32 count);
+  void avx2_cvrt_16ub3c_be_to_32b1c(const void *sp, si32 *dp,
+                                    ui32 comp_num, ui32 count);
+  void avx2_cvrt_16sb1c_le_to_32b1c(const void *sp, si32 *dp,
+                                    ui32 comp_num, ui32 count);
+  void avx2_cvrt_10b3c_le_to_32b1c(const void *sp, si32 *dp,
+                                   ui32 comp_num, ui32 count);
+  void avx2_cvrt_10b3c_be_to_32b1c(const void *sp, si32 *dp,
+                                   ui32 comp_num, ui32 count);
+  void avx2_cvrt_8ub2c_to_32b1c(const void *sp, si32 *dp,
+                                ui32 comp_num, ui32 count);
+  void avx2_cvrt_8ub4c_to_32b1c(const void *sp, si32 *dp,
+                                ui32 comp_num, ui32 count);
+  void avx2_cvrt_16ub2c_le_to_32b1c(const void *sp, si32 *dp,
+                                    ui32 comp_num, ui32 count);
+  void avx2_cvrt_16ub1c_le_msb10_to_32b1c(const void *sp, si32 *dp,
+                                          ui32 comp_num, ui32 count);
+  void avx2_cvrt_16ub2c_le_msb10_to_32b1c(const void *sp, si32 *dp,
+                                          ui32 comp_num, ui32 count);
+
   ////////////////////////////////////////////////////////////////////////////
   //
   //
@@ -90,10 +309,13 @@ namespace ojph {
       width = height = num_comps = max_val = max_val_num_bits = 0;
       bytes_per_sample = num_ele_per_line = 0;
       temp_buf_byte_size = 0;
+      converter = NULL;
 
       cur_line = 0;
       start_of_data = 0;
       planar = false;
+      use_mmap = false;
+      line_data = NULL;
 
       bit_depth[2] = bit_depth[1] = bit_depth[0] = 0;
       is_signed[2] = is_signed[1] = is_signed[0] = false;
@@ -109,8 +331,12 @@ namespace ojph {
     void open(const char* filename);
     void finalize_alloc();
     virtual ui32 read(const line_buf* line, ui32 comp_num);
-    void close() { if(fh) { fclose(fh); fh = NULL; } fname = NULL; }
+    void close() 
+    { if(fh) { fclose(fh); fh = NULL; } mapped.close(); fname = NULL; }
     void set_planar(bool planar) { this->planar = planar; }
+    // reads image data from a memory mapping of the file, when possible;
+    // call before open()
+    void set_mmap(bool use_mmap) { this->use_mmap = use_mmap; }
 
     size get_size() { assert(fh); return size(width, height); }
     ui32 get_width() { assert(fh); return width; }
@@ -132,10 +358,14 @@ namespace ojph {
     ui32 width, height, num_comps, max_val, max_val_num_bits;
     ui32 bytes_per_sample, num_ele_per_line;
     ui32 temp_buf_byte_size;
+    in_conversion_fun converter;
 
     ui32 cur_line;
     si64 start_of_data;
     bool planar;
+    bool use_mmap;
+    mmap_in_file mapped;
+    const void *line_data;   // the line being converted
     ui32 bit_depth[3];
     bool is_signed[3];
     point subsampling[3];
@@ -245,7 +475,7 @@ namespace ojph {
       fname = NULL;
 
       line_buffer = NULL;
-      line_buffer_16bit_samples = NULL;
+      converter = NULL;
 
       width = height = 0;
       num_comps = 0;
@@ -266,8 +496,6 @@ namespace ojph {
       close();
       if (line_buffer)
         free(line_buffer);
-      if (line_buffer_16bit_samples)
-        free(line_buffer_16bit_samples);
     }
 
     void open(const char* filename);
@@ -310,7 +538,7 @@ namespace ojph {
 
     ui32 number_of_samples_per_line;
 
-    ui16* line_buffer_16bit_samples;
+    in_conversion_fun converter;
 
     // DPX specific members
     bool is_byte_swapping_necessary;
@@ -358,12 +586,21 @@ namespace ojph {
         subsampling[i] = point(1,1);
         comp_address[i] = 0;
         bytes_per_sample[i] = 0;
+        converter[i] = NULL;
       }
       num_com = 0;
 
       cur_line = 0;
       last_comp = 0;
       planar = false;
+      use_mmap = false;
+      mapped_pos = 0;
+
+      is_y4m = false;
+      start_of_data = file_size = 0;
+      frame_size = 0;
+      cur_frame = 0;
+      cur_frame_offset = 0;
     }
     virtual ~yuv_in()
     {
@@ -374,12 +611,26 @@ namespace ojph {
 
     void open(const char* filename);
     virtual ui32 read(const line_buf* line, ui32 comp_num);
-    void close() { if(fh) { fclose(fh); fh = NULL; } fname = NULL; }
+    void close() 
+    { if(fh) { fclose(fh); fh = NULL; } mapped.close(); fname = NULL; }
+    // reads image data from a memory mapping of the file, when possible;
+    // call before open()
+    void set_mmap(bool use_mmap) { this->use_mmap = use_mmap; }
 
     void set_bit_depth(ui32 num_bit_depths, ui32* bit_depth);
     void set_img_props(const size& s, ui32 num_components,
                        ui32 num_downsampling, const point *downsampling);
 
+    // A file can hold a sequence of frames.  For .y4m files, the image 
+    // properties are obtained from the file header, and set_img_props and
+    // set_bit_depth are not needed.  The first frame is read after open().
+    // seek_frame() moves reading to the start of a frame, and returns false
+    // if the file does not hold the whole frame; get_num_frames() returns
+    // the number of whole frames in the file.
+    bool seek_frame(ui32 frame_idx);
+    ui32 get_num_frames();
+
+    size get_size() { assert(fh); return size(width[0], height[0]); }
     ui32 get_num_components() { assert(fh); return num_com; }
     ui32 *get_bit_depth() { assert(fh); return bit_depth; }
     point *get_comp_subsampling() { assert(fh); return subsampling; }
@@ -391,11 +642,27 @@ namespace ojph {
     ui32 width[3], height[3], num_com;
     ui32 bytes_per_sample[3];
     ui32 comp_address[3];
+    in_conversion_fun converter[3];
 
     ui32 cur_line, last_comp;
     bool planar;
+    bool use_mmap;
+    mmap_in_file mapped;
+    size_t mapped_pos;       // offset of the next line in mapped
     ui32 bit_depth[3];
     point subsampling[3];
+
+  private:
+    void read_y4m_header(const char* filename);
+    si64 skip_y4m_frame_header(si64 offset);
+    void set_position(si64 offset);
+
+    bool is_y4m;             // true for .y4m files
+    si64 start_of_data;      // offset of the first frame
+    si64 file_size;
+    si64 frame_size;         // bytes of samples in one frame
+    ui32 cur_frame;          // the frame being read
+    si64 cur_frame_offset;   // for .y4m, offset of cur_frame's header
   };
 
   ////////////////////////////////////////////////////////////////////////////
@@ -418,6 +685,9 @@ namespace ojph {
       cur_line = 0;
       buffer = NULL;
       buffer_size = 0;
+      converter = NULL;
+      use_mmap = false;
+      mapped_pos = 0;
     }
     virtual ~raw_in()
     {
@@ -428,7 +698,11 @@ namespace ojph {
 
     void open(const char* filename);
     virtual ui32 read(const line_buf* line, ui32 comp_num = 0);
-    void close() { if(fh) { fclose(fh); fh = NULL; } fname = NULL; }
+    void close() 
+    { if(fh) { fclose(fh); fh = NULL; } mapped.close(); fname = NULL; }
+    // reads image data from a memory mapping of the file, when possible;
+    // call before open()
+    void set_mmap(bool use_mmap) { this->use_mmap = use_mmap; }
 
     void set_img_props(const size& s, ui32 bit_depth, bool is_signed);
 
@@ -444,6 +718,10 @@ namespace ojph {
     ui32 cur_line;
     void* buffer;
     size_t buffer_size;
+    in_conversion_fun converter;
+    bool use_mmap;
+    mmap_in_file mapped;
+    size_t mapped_pos;       // offset of the next line in mapped
   };
 
   ////////////////////////////////////////////////////////////////////////////
@@ -470,6 +748,8 @@ namespace ojph {
 
       cur_line = 0;
       start_of_data = 0;
+      use_mmap = false;
+      line_data = NULL;
     }
     virtual ~pfm_in()
     {
@@ -486,7 +766,11 @@ namespace ojph {
         this->bit_depth[c] = bit_depth[c];
     }
     virtual ui32 read(const line_buf* line, ui32 comp_num);
-    void close() { if(fh) { fclose(fh); fh = NULL; } fname = NULL; }
+    void close() 
+    { if(fh) { fclose(fh); fh = NULL; } mapped.close(); fname = NULL; }
+    // reads image data from a memory mapping of the file, when possible;
+    // call before open()
+    void set_mmap(bool use_mmap) { this->use_mmap = use_mmap; }
 
     size get_size() { assert(fh); return size(width, height); }
     ui32 get_width() { assert(fh); return width; }
@@ -505,6 +789,111 @@ namespace ojph {
     ui32 width, height, num_comps;
     ui32 cur_line;
     si64 start_of_data;
+    bool use_mmap;
+    mmap_in_file mapped;
+    const float *line_data;  // the line being converted
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  //
+  //
+  //
+  //
+  ////////////////////////////////////////////////////////////////////////////
+  // Packed and semi-planar layouts of 4:2:2 and 4:2:0 frames used by 
+  // broadcast and video equipment; a file holds one frame, and its layout 
+  // is identified by the file extension:
+  //   .v210  4:2:2 10-bit, 6 pixels in 4 little-endian 32-bit words, with 
+  //          lines padded to multiples of 128 bytes
+  //   .uyvy  4:2:2 8-bit, interleaved as Cb Y Cr Y
+  //   .nv12  4:2:0 8-bit, a Y plane followed by an interleaved CbCr plane
+  //   .p010  as .nv12, but 10-bit samples held in the MSBs of 16-bit 
+  //          little-endian words
+  //   .p016  as .nv12, but 16-bit little-endian samples
+  enum packed_yuv_format : ui32 {
+    PYF_UNKNOWN = 0, PYF_V210, PYF_UYVY, PYF_NV12, PYF_P010, PYF_P016
+  };
+
+  // returns the format of filename from its extension, or PYF_UNKNOWN
+  packed_yuv_format get_packed_yuv_format(const char *filename);
+
+  // Where the 3 components of a frame of a packed_yuv_format are; the 
+  // first line of component c starts at plane_offset[c], and its next lines
+  // follow every line_stride[c] bytes.  cvrt_comp[c] is the comp_num that
+  // the converters of the format use for component c.
+  struct packed_yuv_layout
+  {
+    packed_yuv_layout() { format = PYF_UNKNOWN; bit_depth = 0; }
+    void init(packed_yuv_format format, const size& s);
+
+    packed_yuv_format format;
+    ui32 bit_depth;
+    point subsampling[3];
+    ui32 width[3], height[3];
+    size_t plane_offset[3];
+    size_t line_stride[3];
+    ui32 cvrt_comp[3];
+    size_t frame_size;       // bytes in a frame
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  // Reads a file of a packed_yuv_format; the image dimensions must be set 
+  // using set_img_props before open().  Components are read one after the
+  // other, as for codestream::set_planar(true); the lines of packed layouts
+  // are therefore read once for each component.
+  class packed_yuv_in : public image_in_base
+  {
+  public:
+    packed_yuv_in()
+    {
+      fh = NULL;
+      fname = NULL;
+      temp_buf = NULL;
+      temp_buf_byte_size = 0;
+      use_mmap = false;
+      file_pos = 0;
+      for (int i = 0; i < 3; ++i)
+      {
+        converter[i] = NULL;
+        cur_line[i] = 0;
+      }
+    }
+    virtual ~packed_yuv_in()
+    {
+      close();
+      if (temp_buf)
+        free(temp_buf);
+    }
+
+    void open(const char* filename);
+    virtual ui32 read(const line_buf* line, ui32 comp_num);
+    void close() 
+    { if(fh) { fclose(fh); fh = NULL; } mapped.close(); fname = NULL; }
+    // reads image data from a memory mapping of the file, when possible;
+    // call before open()
+    void set_mmap(bool use_mmap) { this->use_mmap = use_mmap; }
+
+    void set_img_props(const size& s) { img_size = s; }
+
+    size get_size() { assert(fh); return img_size; }
+    ui32 get_num_components() { assert(fh); return 3; }
+    ui32 get_bit_depth() { assert(fh); return layout.bit_depth; }
+    point get_comp_subsampling(ui32 comp_num)
+    { assert(fh && comp_num < 3); return layout.subsampling[comp_num]; }
+
+  private:
+    FILE *fh;
+    const char *fname;
+    void *temp_buf;
+    size_t temp_buf_byte_size;
+    bool use_mmap;
+    mmap_in_file mapped;
+    si64 file_pos;           // position of fh
+    size img_size;
+    packed_yuv_layout layout;
+    in_conversion_fun converter[3];
+    ui32 cur_line[3];
   };
 
 
@@ -532,6 +921,10 @@ namespace ojph {
   void gen_cvrt_32b3c_to_16ub3c_be(const line_buf *ln0, const line_buf *ln1, 
                                    const line_buf *ln2, void *dp, 
                                    ui32 bit_depth, ui32 count);
+  void gen_cvrt_32b1c_to_16ub1c_le_msb10(const line_buf *ln0, 
+                                         const line_buf *ln1, 
+                                         const line_buf *ln2, void *dp, 
+                                         ui32 bit_depth, ui32 count);
 
   void sse41_cvrt_32b1c_to_8ub1c(const line_buf *ln0, const line_buf *ln1, 
                                  const line_buf *ln2, void *dp, 
@@ -551,6 +944,10 @@ namespace ojph {
   void sse41_cvrt_32b3c_to_16ub3c_be(const line_buf *ln0, const line_buf *ln1, 
                                      const line_buf *ln2, void *dp, 
                                      ui32 bit_depth, ui32 count);
+  void sse41_cvrt_32b1c_to_16ub1c_le_msb10(const line_buf *ln0, 
+                                           const line_buf *ln1, 
+                                           const line_buf *ln2, void *dp, 
+                                           ui32 bit_depth, ui32 count);
 
   void avx2_cvrt_32b1c_to_8ub1c(const line_buf *ln0, const line_buf *ln1, 
                                 const line_buf *ln2, void *dp, 
@@ -565,6 +962,42 @@ namespace ojph {
                                     const line_buf *ln2, void *dp, 
                                     ui32 bit_depth, ui32 count);
 
+  ////////////////////////////////////////////////////////////////////////////
+  // Packing accelerators (defined in ojph_img_io_*); these store count 
+  // samples of one component into a line that interleaves 2 or 4 
+  // components (2c and 4c) or that is packed as v210, at the positions of
+  // component comp_num, leaving the samples of other components unchanged.
+  // msb10 and v210 samples are 10-bit, and bit_depth must be 10.
+  typedef void (*pack_conversion_fun)(const line_buf *ln, void *dp, 
+                                      ui32 comp_num, ui32 bit_depth, 
+                                      ui32 count);
+
+  void gen_cvrt_32b1c_to_8ub2c(const line_buf *ln, void *dp, 
+                               ui32 comp_num, ui32 bit_depth, ui32 count);
+  void gen_cvrt_32b1c_to_8ub4c(const line_buf *ln, void *dp, 
+                               ui32 comp_num, ui32 bit_depth, ui32 count);
+  void gen_cvrt_32b1c_to_16ub2c_le(const line_buf *ln, void *dp, 
+                                   ui32 comp_num, ui32 bit_depth, 
+                                   ui32 count);
+  void gen_cvrt_32b1c_to_16ub2c_le_msb10(const line_buf *ln, void *dp, 
+                                         ui32 comp_num, ui32 bit_depth, 
+                                         ui32 count);
+  void gen_cvrt_32b1c_to_v210(const line_buf *ln, void *dp, 
+                              ui32 comp_num, ui32 bit_depth, ui32 count);
+
+  void sse41_cvrt_32b1c_to_8ub2c(const line_buf *ln, void *dp, 
+                                 ui32 comp_num, ui32 bit_depth, ui32 count);
+  void sse41_cvrt_32b1c_to_8ub4c(const line_buf *ln, void *dp, 
+                                 ui32 comp_num, ui32 bit_depth, ui32 count);
+  void sse41_cvrt_32b1c_to_16ub2c_le(const line_buf *ln, void *dp, 
+                                     ui32 comp_num, ui32 bit_depth, 
+                                     ui32 count);
+  void sse41_cvrt_32b1c_to_16ub2c_le_msb10(const line_buf *ln, void *dp, 
+                                           ui32 comp_num, ui32 bit_depth, 
+                                           ui32 count);
+  void sse41_cvrt_32b1c_to_v210(const line_buf *ln, void *dp, 
+                                ui32 comp_num, ui32 bit_depth, ui32 count);
+
   ////////////////////////////////////////////////////////////////////////////
   //
   //
@@ -601,6 +1034,7 @@ namespace ojph {
       cur_line = samples_per_line = bytes_per_line = 0;
       converter = NULL;
       lptr[0] = lptr[1] = lptr[2] = 0;
+      use_mmap = false;
     }
     virtual ~ppm_out()
     {
@@ -613,11 +1047,17 @@ namespace ojph {
     void configure(ui32 width, ui32 height, ui32 num_components, 
                    ui32 bit_depth);
     virtual ui32 write(const line_buf* line, ui32 comp_num);
-    virtual void close() { if(fh) { fclose(fh); fh = NULL; } fname = NULL; }
+    virtual void close() 
+    { if(fh) close_output_file(fh); fh = NULL; mapped.close(); fname = NULL; }
+    // writes the file through memory-mapped windows, when possible;
+    // call before open()
+    void set_mmap(bool use_mmap) { this->use_mmap = use_mmap; }
 
   private:
     FILE *fh;
     const char *fname;
+    bool use_mmap;
+    mmap_out_file mapped;
     ui32 width, height, num_components;
     ui32 bit_depth, bytes_per_sample;
     ui8* buffer;
@@ -708,17 +1148,24 @@ namespace ojph {
       comp_width = NULL;
       buffer = NULL;
       buffer_size = 0;
+      use_mmap = false;
     }
     virtual ~yuv_out();
 
     void open(char* filename);
     void configure(ui32 bit_depth, ui32 num_components, ui32 *comp_width);
     virtual ui32 write(const line_buf* line, ui32 comp_num);
-    virtual void close() { if(fh) { fclose(fh); fh = NULL; } fname = NULL; }
+    virtual void close() 
+    { if(fh) close_output_file(fh); fh = NULL; mapped.close(); fname = NULL; }
+    // writes the file through memory-mapped windows, when possible;
+    // call before open()
+    void set_mmap(bool use_mmap) { this->use_mmap = use_mmap; }
 
   private:
     FILE *fh;
     const char *fname;
+    bool use_mmap;
+    mmap_out_file mapped;
     ui32 width;
     ui32 num_components;
     ui32 bit_depth;
@@ -747,17 +1194,24 @@ namespace ojph {
       width = 0;
       buffer = NULL;
       buffer_size = 0;
+      use_mmap = false;
     }
     virtual ~raw_out();
 
     void open(char* filename);
     void configure(bool is_signed, ui32 bit_depth, ui32 width);
     virtual ui32 write(const line_buf* line, ui32 comp_num = 0);
-    virtual void close() { if (fh) { fclose(fh); fh = NULL; } fname = NULL; }
+    virtual void close() 
+    { if (fh) close_output_file(fh); fh = NULL; mapped.close(); fname = NULL; }
+    // writes the file through memory-mapped windows, when possible;
+    // call before open()
+    void set_mmap(bool use_mmap) { this->use_mmap = use_mmap; }
 
   private:
     FILE* fh;
     const char* fname;
+    bool use_mmap;
+    mmap_out_file mapped;
     bool is_signed;
     ui32 bit_depth, bytes_per_sample;
     si64 lower_val, upper_val;
@@ -813,6 +1267,66 @@ namespace ojph {
     si64 start_of_data;
   };
 
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  //
+  //
+  //
+  //
+  ////////////////////////////////////////////////////////////////////////////
+  // Writes a file of a packed_yuv_format.  Components arrive one after the
+  // other, while packed layouts interleave them; the frame is therefore 
+  // assembled in memory and written once its last line arrives.
+  class packed_yuv_out : public image_out_base
+  {
+  public:
+    packed_yuv_out()
+    {
+      fh = NULL;
+      fname = NULL;
+      buffer = NULL;
+      use_mmap = false;
+      lines_left = 0;
+      plane_converter = NULL;
+      for (int i = 0; i < 3; ++i)
+      {
+        packer[i] = NULL;
+        cur_line[i] = 0;
+      }
+    }
+    virtual ~packed_yuv_out()
+    {
+      close();
+      if (buffer)
+        free(buffer);
+    }
+
+    void open(char* filename);
+    void configure(packed_yuv_format format, ui32 width, ui32 height);
+    virtual ui32 write(const line_buf* line, ui32 comp_num);
+    virtual void close() 
+    { if(fh) close_output_file(fh); fh = NULL; mapped.close(); fname = NULL; }
+    // writes the file through memory-mapped windows, when possible;
+    // call before open()
+    void set_mmap(bool use_mmap) { this->use_mmap = use_mmap; }
+
+    ui32 get_bit_depth() { return layout.bit_depth; }
+    point get_comp_subsampling(ui32 comp_num)
+    { assert(comp_num < 3); return layout.subsampling[comp_num]; }
+
+  private:
+    FILE *fh;
+    const char *fname;
+    bool use_mmap;
+    mmap_out_file mapped;
+    ui8 *buffer;             // the frame
+    ui32 lines_left;         // lines to receive before writing the frame
+    packed_yuv_layout layout;
+    conversion_fun plane_converter;  // for the Y plane of nv12 and p01x
+    pack_conversion_fun packer[3];   // NULL for a plane
+    ui32 cur_line[3];
+  };
+
 
 }
 
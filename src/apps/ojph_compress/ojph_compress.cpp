@@ -36,12 +36,18 @@
 //***************************************************************************/
 
 
+#include <algorithm>
 #include <ctime>
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "ojph_arg.h"
 #include "ojph_mem.h"
 #include "ojph_img_io.h"
+#include "ojph_threads.h"
+#include "ojph_batch.h"
+#include "ojph_async_file.h"
 #include "ojph_file.h"
 #include "ojph_codestream.h"
 #include "ojph_params.h"
@@ -372,7 +378,10 @@ bool get_arguments(int argc, char *argv[], char *&input_filename,
                    ojph::ui32& num_bit_depths, ojph::ui32*& bit_depth,
                    ojph::ui32& num_is_signed, ojph::si32*& is_signed,
                    bool& tlm_marker, bool& tileparts_at_resolutions,
-                   bool& tileparts_at_components, char *&com_string)
+                   bool& tileparts_at_components, char *&com_string,
+                   bool& use_mmap, bool& async_write, bool& direct_io,
+                   ojph::ui32& num_frames, ojph::ui32& num_threads, 
+                   char *&batch_source, char *&stdin_ext)
 {
   ojph::cli_interpreter interpreter;
   interpreter.init(argc, argv);
@@ -388,6 +397,13 @@ bool get_arguments(int argc, char *argv[], char *&input_filename,
   interpreter.reinterpret("-num_comps", num_comps);
   interpreter.reinterpret("-tlm_marker", tlm_marker);
   interpreter.reinterpret("-com", com_string);
+  interpreter.reinterpret("-mmap", use_mmap);
+  interpreter.reinterpret("-async_write", async_write);
+  interpreter.reinterpret("-direct_io", direct_io);
+  interpreter.reinterpret("-num_frames", num_frames);
+  interpreter.reinterpret("-num_threads", num_threads);
+  interpreter.reinterpret("-batch", batch_source);
+  interpreter.reinterpret("-stdin_ext", stdin_ext);
 
   size_interpreter block_interpreter(block_size);
   size_interpreter dims_interpreter(dims);
@@ -480,6 +496,1089 @@ bool is_matching(const char *ref, const char *other)
   return true;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// sequence encoding
+//////////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////////
+// The image properties and coding parameters of all frames of a sequence
+struct sequence_params
+{
+  const char *input_filename;
+  bool use_mmap;
+  ojph::size dims;
+  ojph::ui32 num_comps;
+  ojph::point downsamp[3];
+  ojph::ui32 bit_depth[3];
+  bool is_signed[3];
+
+  ojph::point image_offset;
+  ojph::size tile_size;
+  ojph::point tile_offset;
+  ojph::ui32 num_decompositions;
+  ojph::size block_size;
+  int num_precincts;
+  ojph::size *precinct_size;
+  const char *prog_order;
+  bool reversible;
+  float quantization_step;
+  const char *profile_string;
+  bool tileparts_at_resolutions;
+  bool tileparts_at_components;
+  bool tlm_marker;
+  const char *com_string;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// Encodes frames of a sequence, one at a time, into a codestream held in 
+// memory.  Each object reads the input file through its own yuv_in, and 
+// can be executed by a thread of a thread_pool.
+class sequence_frame_encoder : public ojph::thds::worker_thread_base
+{
+public:
+  sequence_frame_encoder()
+  { params = NULL; frame_idx = 0; busy = failed = false; }
+  ~sequence_frame_encoder() override {}
+
+  void init(const sequence_params *params)
+  {
+    this->params = params;
+    ojph::ui32 bit_depth[3] = { params->bit_depth[0], params->bit_depth[1], 
+                                params->bit_depth[2] };
+    yuv.set_mmap(params->use_mmap);
+    yuv.set_img_props(params->dims, params->num_comps, params->num_comps,
+                      params->downsamp);
+    yuv.set_bit_depth(params->num_comps, bit_depth);
+    yuv.open(params->input_filename);
+  }
+
+  // call this before execute(), or before adding the object to a 
+  // thread_pool
+  void set_frame(ojph::ui32 frame_idx)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    assert(!busy);
+    this->frame_idx = frame_idx;
+    busy = true;
+  }
+
+  void execute() override
+  {
+    bool success = true;
+    try {
+      encode();
+    }
+    catch (const std::exception&) { // the error is already reported
+      success = false;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    failed = !success;
+    busy = false;
+    condition.notify_one();
+  }
+
+  // waits until the frame is encoded; returns false if encoding failed
+  bool wait()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock, [this] { return !busy; });
+    return !failed;
+  }
+
+  const ojph::mem_outfile& get_codestream() const { return out; }
+
+private:
+  void encode()
+  {
+    const sequence_params& p = *params;
+    if (!yuv.seek_frame(frame_idx))
+      OJPH_ERROR(0x010000A1, "frame %d is missing from file %s",
+        frame_idx, p.input_filename);
+
+    ojph::codestream codestream;
+    ojph::param_siz siz = codestream.access_siz();
+    siz.set_image_extent(ojph::point(p.image_offset.x + p.dims.w,
+      p.image_offset.y + p.dims.h));
+    siz.set_num_components(p.num_comps);
+    for (ojph::ui32 c = 0; c < p.num_comps; ++c)
+      siz.set_component(c, p.downsamp[c], p.bit_depth[c], p.is_signed[c]);
+    siz.set_image_offset(p.image_offset);
+    siz.set_tile_size(p.tile_size);
+    siz.set_tile_offset(p.tile_offset);
+
+    ojph::param_cod cod = codestream.access_cod();
+    cod.set_num_decomposition(p.num_decompositions);
+    cod.set_block_dims(p.block_size.w, p.block_size.h);
+    if (p.num_precincts != -1)
+      cod.set_precinct_size(p.num_precincts, p.precinct_size);
+    cod.set_progression_order(p.prog_order);
+    cod.set_color_transform(false);
+    cod.set_reversible(p.reversible);
+    if (!p.reversible && p.quantization_step != -1.0f)
+      codestream.access_qcd().set_irrev_quant(p.quantization_step);
+    codestream.set_planar(true);
+    if (p.profile_string[0] != '\0')
+      codestream.set_profile(p.profile_string);
+    codestream.set_tilepart_divisions(p.tileparts_at_resolutions, 
+                                      p.tileparts_at_components);
+    codestream.request_tlm_marker(p.tlm_marker);
+
+    ojph::comment_exchange com_ex;
+    if (p.com_string)
+      com_ex.set_string(p.com_string);
+    out.open();
+    codestream.write_headers(&out, &com_ex, p.com_string ? 1 : 0);
+
+    ojph::ui32 next_comp;
+    ojph::line_buf* cur_line = codestream.exchange(NULL, next_comp);
+    for (ojph::ui32 c = 0; c < p.num_comps; ++c)
+    {
+      ojph::point ds = siz.get_downsampling(c);
+      ojph::ui32 height = ojph_div_ceil(siz.get_image_extent().y, ds.y);
+      height -= ojph_div_ceil(siz.get_image_offset().y, ds.y);
+      for (ojph::ui32 i = height; i > 0; --i)
+      {
+        assert(c == next_comp);
+        yuv.read(cur_line, next_comp);
+        cur_line = codestream.exchange(cur_line, next_comp);
+      }
+    }
+
+    codestream.flush();
+    codestream.close();
+  }
+
+private:
+  const sequence_params *params;
+  ojph::yuv_in yuv;
+  ojph::mem_outfile out;           // the codestream of frame_idx
+  ojph::ui32 frame_idx;
+  bool busy, failed;
+  std::mutex mutex;                // protects busy and failed
+  std::condition_variable condition;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// The files that codestreams are written to; open() picks one based on
+// the file name, where "-" is the standard output, and on the 
+// -async_write and -direct_io options.
+struct codestream_outfile
+{
+  ojph::outfile_base* open(const char *filename, bool async_write,
+                           bool direct_io)
+  {
+    if (ojph::is_standard_stream(filename))
+    {
+      std_file.open(1);
+      return &std_file;
+    }
+    if (async_write)
+    {
+      async_file.open(filename, 1 << 22, direct_io);
+      return &async_file;
+    }
+    j2c_file.open(filename);
+    return &j2c_file;
+  }
+
+  ojph::j2c_outfile j2c_file;
+  ojph::stream_outfile std_file;
+  ojph::async_outfile async_file;  // written by a background thread
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// Encodes num_frames frames, using num_threads threads.  When 
+// output_filename holds a printf-style conversion, such as out_%05d.j2c,
+// each frame is written to a file named using its frame number; otherwise,
+// the codestreams of frames are concatenated into output_filename, which 
+// is opened by codestream_outfile.
+static
+void encode_sequence(const sequence_params& params, 
+                     const char *output_filename, ojph::ui32 num_frames,
+                     ojph::ui32 num_threads, bool async_write, 
+                     bool direct_io)
+{
+  bool numbered = strchr(output_filename, '%') != NULL;
+  codestream_outfile out_file;
+  ojph::outfile_base *file = NULL;
+  if (!numbered)
+    file = out_file.open(output_filename, async_write, direct_io);
+
+  // frames are given to the encoders in turn; there are more encoders 
+  // than threads, so that threads are not idle while the oldest frame 
+  // is being written
+  ojph::thds::thread_pool thread_pool;
+  ojph::ui32 num_encoders = 1;
+  if (num_threads > 1)
+  {
+    thread_pool.init(num_threads);
+    num_encoders = 2 * num_threads;
+  }
+  num_encoders = ojph_min(num_encoders, num_frames);
+  sequence_frame_encoder *encoders = new sequence_frame_encoder[num_encoders];
+  for (ojph::ui32 i = 0; i < num_encoders; ++i)
+    encoders[i].init(&params);
+
+  // frames are written in order, once encoded
+  bool success = true;
+  for (ojph::ui32 f = 0; f < num_frames + num_encoders && success; ++f)
+  {
+    if (f >= num_encoders)
+    {
+      ojph::ui32 frame_idx = f - num_encoders;
+      sequence_frame_encoder& e = encoders[frame_idx % num_encoders];
+      success = e.wait();
+      if (success && numbered)
+      {
+        char name[1024];
+        snprintf(name, sizeof(name), output_filename, (int)frame_idx);
+        e.get_codestream().write_to_file(name);
+      }
+      else if (success)
+      {
+        const ojph::mem_outfile& cs = e.get_codestream();
+        if (file->write(cs.get_data(), cs.get_used_size()) 
+            != cs.get_used_size())
+          success = false;
+      }
+    }
+    if (f < num_frames && success)
+    {
+      sequence_frame_encoder& e = encoders[f % num_encoders];
+      e.set_frame(f);
+      if (num_threads > 1)
+        thread_pool.add_task(&e);
+      else
+        e.execute();
+    }
+  }
+
+  // on failure, frames that are still being encoded are waited for
+  for (ojph::ui32 i = 0; i < num_encoders; ++i)
+    encoders[i].wait();
+  delete[] encoders;
+  if (file)
+    file->close();
+  if (!success)
+    OJPH_ERROR(0x010000A3, "failed to encode or write frames of %s", 
+      params.input_filename);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// file encoding
+//////////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////////
+// The command line options that control the encoding of a file
+struct compress_options
+{
+  char *prog_order;
+  char *profile_string;
+  char *com_string;
+  ojph::ui32 num_decompositions;
+  float quantization_step;
+  bool reversible;
+  int employ_color_transform;
+  ojph::size *precinct_size;
+  int num_precincts;
+  ojph::size block_size;
+  ojph::size dims;
+  ojph::size tile_size;
+  ojph::point tile_offset;
+  ojph::point image_offset;
+  ojph::ui32 max_num_comps;        // the size of the three arrays below
+  ojph::ui32 num_components;
+  ojph::ui32 num_is_signed;
+  ojph::si32 *is_signed;
+  ojph::ui32 num_bit_depths;
+  ojph::ui32 *bit_depth;           // completed when encoding a pfm file
+  ojph::ui32 num_comp_downsamps;
+  ojph::point *comp_downsampling;
+  bool tlm_marker;
+  bool tileparts_at_resolutions;
+  bool tileparts_at_components;
+  bool use_mmap;
+  bool async_write;
+  bool direct_io;
+  ojph::ui32 num_frames;           // 0 for all, or num_frames_default
+  ojph::ui32 num_threads;
+};
+
+// -num_frames is not given; one frame is encoded from a .yuv file, and all
+// the frames of a .y4m file
+const ojph::ui32 num_frames_default = 0xFFFFFFFF;
+
+/////////////////////////////////////////////////////////////////////////////
+// Encodes input_filename into output_filename.  The codestream is written
+// to output_filename, which is opened by codestream_outfile, as it is 
+// generated, or, when mem_file is not NULL, it is collected in mem_file
+// and written to output_filename in one go.
+// opts is passed by value, because encoding may change some of its members.
+static
+void compress_file(const char *input_filename, const char *output_filename,
+                   compress_options opts, ojph::mem_outfile *mem_file)
+{
+  ojph::codestream codestream;
+
+  ojph::ppm_in ppm;
+  ojph::pfm_in pfm;
+  ojph::yuv_in yuv;
+  ojph::raw_in raw;
+  ojph::dpx_in dpx;
+  ojph::packed_yuv_in pyuv;
+#ifdef OJPH_ENABLE_TIFF_SUPPORT
+  ojph::tif_in tif;
+#endif // !OJPH_ENABLE_TIFF_SUPPORT
+  ppm.set_mmap(opts.use_mmap);
+  pfm.set_mmap(opts.use_mmap);
+  yuv.set_mmap(opts.use_mmap);
+  raw.set_mmap(opts.use_mmap);
+  pyuv.set_mmap(opts.use_mmap);
+
+  ojph::image_in_base *base = NULL;
+  const char *v = get_file_extension(input_filename);
+
+  if (v)
+  {
+    bool is_y4m = is_matching(".y4m", v);
+    if (opts.num_frames == num_frames_default)
+      opts.num_frames = is_y4m ? 0 : 1;
+
+    if (is_y4m || (is_matching(".yuv", v) && opts.num_frames != 1))
+    {
+      ojph::yuv_in yuv_seq; // obtains the image properties
+      if (!is_y4m)
+      {
+        if (opts.dims.w == 0 || opts.dims.h == 0)
+          OJPH_ERROR(0x010000A4,
+            "-dims option must have positive dimensions\n");
+        if (opts.num_components <= 0)
+          OJPH_ERROR(0x010000A5,
+            "-num_comps option is missing and must be provided\n");
+        if (opts.num_is_signed <= 0)
+          OJPH_ERROR(0x010000A6,
+            "-signed option is missing and must be provided\n");
+        if (opts.num_bit_depths <= 0)
+          OJPH_ERROR(0x010000A7,
+            "-bit_depth option is missing and must be provided\n");
+        if (opts.num_comp_downsamps <= 0)
+          OJPH_ERROR(0x010000A8,
+            "-downsamp option is missing and must be provided\n");
+        yuv_seq.set_img_props(opts.dims, opts.num_components,
+          opts.num_comp_downsamps, opts.comp_downsampling);
+        yuv_seq.set_bit_depth(opts.num_bit_depths, opts.bit_depth);
+      }
+      if (opts.employ_color_transform != -1)
+        OJPH_ERROR(0x010000A9,
+          "color transform is not supported for yuv or y4m sequences\n");
+      yuv_seq.open(input_filename);
+
+      sequence_params params;
+      params.input_filename = input_filename;
+      params.use_mmap = opts.use_mmap;
+      params.dims = yuv_seq.get_size();
+      params.num_comps = yuv_seq.get_num_components();
+      ojph::ui32 last_signed_idx = 0;
+      for (ojph::ui32 c = 0; c < params.num_comps; ++c)
+      {
+        params.downsamp[c] = yuv_seq.get_comp_subsampling()[c];
+        params.bit_depth[c] = yuv_seq.get_bit_depth()[c];
+        params.is_signed[c] = false; // y4m samples are unsigned
+        if (!is_y4m)
+        {
+          int is =
+            opts.is_signed[c < opts.num_is_signed ? c : last_signed_idx];
+          last_signed_idx += last_signed_idx + 1 < opts.num_is_signed ? 1 : 0;
+          params.is_signed[c] = is == 1;
+        }
+      }
+      params.image_offset = opts.image_offset;
+      params.tile_size = opts.tile_size;
+      params.tile_offset = opts.tile_offset;
+      params.num_decompositions = opts.num_decompositions;
+      params.block_size = opts.block_size;
+      params.num_precincts = opts.num_precincts;
+      params.precinct_size = opts.precinct_size;
+      params.prog_order = opts.prog_order;
+      params.reversible = opts.reversible;
+      params.quantization_step = opts.quantization_step;
+      params.profile_string = opts.profile_string;
+      params.tileparts_at_resolutions = opts.tileparts_at_resolutions;
+      params.tileparts_at_components = opts.tileparts_at_components;
+      params.tlm_marker = opts.tlm_marker;
+      params.com_string = opts.com_string;
+
+      ojph::ui32 frames_in_file = yuv_seq.get_num_frames();
+      yuv_seq.close();
+      if (opts.num_frames == 0)
+        opts.num_frames = frames_in_file;
+      else if (opts.num_frames > frames_in_file)
+        OJPH_ERROR(0x010000AA, "file %s holds only %d frames\n", 
+          input_filename, frames_in_file);
+
+      encode_sequence(params, output_filename, opts.num_frames,
+                      opts.num_threads, opts.async_write, opts.direct_io);
+    }
+    else if (is_matching(".pgm", v))
+    {
+      ppm.open(input_filename);
+      ojph::param_siz siz = codestream.access_siz();
+      siz.set_image_extent(ojph::point(opts.image_offset.x + ppm.get_width(),
+        opts.image_offset.y + ppm.get_height()));
+      ojph::ui32 num_comps = ppm.get_num_components();
+      assert(num_comps == 1);
+      siz.set_num_components(num_comps);
+      for (ojph::ui32 c = 0; c < num_comps; ++c)
+        siz.set_component(c, ppm.get_comp_subsampling(c),
+          ppm.get_bit_depth(c), ppm.get_is_signed(c));
+      siz.set_image_offset(opts.image_offset);
+      siz.set_tile_size(opts.tile_size);
+      siz.set_tile_offset(opts.tile_offset);
+
+      ojph::param_cod cod = codestream.access_cod();
+      cod.set_num_decomposition(opts.num_decompositions);
+      cod.set_block_dims(opts.block_size.w, opts.block_size.h);
+      if (opts.num_precincts != -1)
+        cod.set_precinct_size(opts.num_precincts, opts.precinct_size);
+      cod.set_progression_order(opts.prog_order);
+      cod.set_color_transform(false);
+      cod.set_reversible(opts.reversible);
+      if (!opts.reversible && opts.quantization_step != -1.0f)
+        codestream.access_qcd().set_irrev_quant(opts.quantization_step);
+      if (opts.profile_string[0] != '\0')
+        codestream.set_profile(opts.profile_string);
+      codestream.set_tilepart_divisions(opts.tileparts_at_resolutions, 
+                                        opts.tileparts_at_components);
+      codestream.request_tlm_marker(opts.tlm_marker);
+
+      if (opts.employ_color_transform != -1)
+        OJPH_WARN(0x01000001,
+          "-colour_trans option is not needed and was not used\n");
+      if (opts.dims.w != 0 || opts.dims.h != 0)
+        OJPH_WARN(0x01000002,
+          "-dims option is not needed and was not used\n");
+      if (opts.num_components != 0)
+        OJPH_WARN(0x01000003,
+          "-num_comps is not needed and was not used\n");
+      if (opts.is_signed[0] != -1)
+        OJPH_WARN(0x01000004,
+          "-signed is not needed and was not used\n");
+      if (opts.bit_depth[0] != 0)
+        OJPH_WARN(0x01000005,
+          "-bit_depth is not needed and was not used\n");
+      if (opts.comp_downsampling[0].x != 0 || opts.comp_downsampling[0].y != 0)
+        OJPH_WARN(0x01000006,
+          "-downsamp is not needed and was not used\n");
+
+      base = &ppm;
+    }
+    else if (is_matching(".ppm", v))
+    {
+      ppm.open(input_filename);
+      ojph::param_siz siz = codestream.access_siz();
+      siz.set_image_extent(ojph::point(opts.image_offset.x + ppm.get_width(),
+        opts.image_offset.y + ppm.get_height()));
+      ojph::ui32 num_comps = ppm.get_num_components();
+      assert(num_comps == 3);
+      siz.set_num_components(num_comps);
+      for (ojph::ui32 c = 0; c < num_comps; ++c)
+        siz.set_component(c, ppm.get_comp_subsampling(c),
+          ppm.get_bit_depth(c), ppm.get_is_signed(c));
+      siz.set_image_offset(opts.image_offset);
+      siz.set_tile_size(opts.tile_size);
+      siz.set_tile_offset(opts.tile_offset);
+
+      ojph::param_cod cod = codestream.access_cod();
+      cod.set_num_decomposition(opts.num_decompositions);
+      cod.set_block_dims(opts.block_size.w, opts.block_size.h);
+      if (opts.num_precincts != -1)
+        cod.set_precinct_size(opts.num_precincts, opts.precinct_size);
+      cod.set_progression_order(opts.prog_order);
+      if (opts.employ_color_transform == -1)
+        cod.set_color_transform(true);
+      else
+        cod.set_color_transform(opts.employ_color_transform == 1);
+      cod.set_reversible(opts.reversible);
+      if (!opts.reversible && opts.quantization_step != -1.0f)
+        codestream.access_qcd().set_irrev_quant(opts.quantization_step);
+      codestream.set_planar(false);
+      if (opts.profile_string[0] != '\0')
+        codestream.set_profile(opts.profile_string);
+      codestream.set_tilepart_divisions(opts.tileparts_at_resolutions, 
+                                        opts.tileparts_at_components);
+      codestream.request_tlm_marker(opts.tlm_marker);          
+
+      if (opts.dims.w != 0 || opts.dims.h != 0)
+        OJPH_WARN(0x01000011,
+          "-dims option is not needed and was not used\n");
+      if (opts.num_components != 0)
+        OJPH_WARN(0x01000012,
+          "-num_comps is not needed and was not used\n");
+      if (opts.is_signed[0] != -1)
+        OJPH_WARN(0x01000013,
+          "-signed is not needed and was not used\n");
+      if (opts.bit_depth[0] != 0)
+        OJPH_WARN(0x01000014,
+          "-bit_depth is not needed and was not used\n");
+      if (opts.comp_downsampling[0].x != 0 || opts.comp_downsampling[0].y != 0)
+        OJPH_WARN(0x01000015,
+          "-downsamp is not needed and was not used\n");
+
+      base = &ppm;
+    }
+    else if (is_matching(".pfm", v))
+    {
+      pfm.open(input_filename);
+      ojph::param_siz siz = codestream.access_siz();
+      siz.set_image_extent(ojph::point(opts.image_offset.x + pfm.get_width(),
+        opts.image_offset.y + pfm.get_height()));
+      ojph::ui32 num_comps = pfm.get_num_components();
+      assert(num_comps == 1 || num_comps == 3);
+      siz.set_num_components(num_comps);
+
+      if (opts.bit_depth[0] != 0)             // one was set
+        if (opts.num_bit_depths < num_comps)  // but if not enough, repeat
+          for (ojph::ui32 c = opts.num_bit_depths; c < num_comps; ++c)
+            opts.bit_depth[c] = opts.bit_depth[opts.num_bit_depths - 1];
+
+      bool all_the_same = true;
+      if (num_comps == 3)
+        all_the_same = all_the_same 
+          && opts.bit_depth[0] == opts.bit_depth[1] 
+          && opts.bit_depth[1] == opts.bit_depth[2];
+
+      for (ojph::ui32 c = 0; c < num_comps; ++c) {
+        if (opts.bit_depth[c] == 0)
+          opts.bit_depth[c] = 32;
+        siz.set_component(c, ojph::point(1,1), opts.bit_depth[c], true);
+      }
+      pfm.configure(opts.bit_depth);
+
+      siz.set_image_offset(opts.image_offset);
+      siz.set_tile_size(opts.tile_size);
+      siz.set_tile_offset(opts.tile_offset);
+
+      ojph::param_cod cod = codestream.access_cod();
+      cod.set_num_decomposition(opts.num_decompositions);
+      cod.set_block_dims(opts.block_size.w, opts.block_size.h);
+      if (opts.num_precincts != -1)
+        cod.set_precinct_size(opts.num_precincts, opts.precinct_size);
+      cod.set_progression_order(opts.prog_order);
+      if (num_comps == 1)
+      {
+        if (opts.employ_color_transform != -1)
+          OJPH_WARN(0x01000091,
+            "-colour_trans option is not needed and was not used; "
+            "this is because the image has one component only\n");
+      }
+      else
+      {
+        if (opts.employ_color_transform == -1)
+          cod.set_color_transform(true);
+        else
+          cod.set_color_transform(opts.employ_color_transform == 1);
+      }
+      cod.set_reversible(opts.reversible);
+      if (!opts.reversible) {
+        const float min_step = 1.0f / 16384.0f;
+        if (opts.quantization_step == -1.0f)
+          opts.quantization_step = min_step;
+        else
+          opts.quantization_step = ojph_max(opts.quantization_step, min_step);
+        codestream.access_qcd().set_irrev_quant(opts.quantization_step);
+      }
+
+      // Note: Even if only ALL_COMPS is set to 
+      // OJPH_NLT_BINARY_COMPLEMENT_NLT, the library can decide if
+      // one ALL_COMPS NLT marker segment is needed, or multiple 
+      // per component NLT marker segments are needed (when the components
+      // have different bit depths or signedness).
+      // Of course for .pfm images all components should have the same
+      // bit depth and signedness.
+      ojph::param_nlt nlt = codestream.access_nlt();
+      if (all_the_same)
+        nlt.set_nonlinear_transform(ojph::param_nlt::ALL_COMPS, 
+          ojph::param_nlt::OJPH_NLT_BINARY_COMPLEMENT_NLT);
+      else
+        for (ojph::ui32 c = 0; c < num_comps; ++c)
+          nlt.set_nonlinear_transform(c, 
+            ojph::param_nlt::OJPH_NLT_BINARY_COMPLEMENT_NLT);
+
+      codestream.set_planar(false);
+      if (opts.profile_string[0] != '\0')
+        codestream.set_profile(opts.profile_string);
+      codestream.set_tilepart_divisions(opts.tileparts_at_resolutions, 
+                                        opts.tileparts_at_components);
+      codestream.request_tlm_marker(opts.tlm_marker);          
+
+      if (opts.dims.w != 0 || opts.dims.h != 0)
+        OJPH_WARN(0x01000092,
+          "-dims option is not needed and was not used\n");
+      if (opts.num_components != 0)
+        OJPH_WARN(0x01000093,
+          "-num_comps is not needed and was not used\n");
+      if (opts.is_signed[0] != -1)
+        OJPH_WARN(0x01000094,
+          "-signed is not needed and was not used\n");            
+      if (opts.comp_downsampling[0].x != 0 || opts.comp_downsampling[0].y != 0)
+        OJPH_WARN(0x01000095,
+          "-downsamp is not needed and was not used\n");
+
+      base = &pfm;
+    }
+#ifdef OJPH_ENABLE_TIFF_SUPPORT
+    else if (is_matching(".tif", v) || is_matching(".tiff", v))
+    {
+      tif.open(input_filename);
+      ojph::param_siz siz = codestream.access_siz();
+      siz.set_image_extent(ojph::point(opts.image_offset.x + tif.get_size().w,
+        opts.image_offset.y + tif.get_size().h));
+      ojph::ui32 num_comps = tif.get_num_components();
+      siz.set_num_components(num_comps);
+      if(opts.num_bit_depths > 0 )
+        tif.set_bit_depth(opts.num_bit_depths, opts.bit_depth);
+      for (ojph::ui32 c = 0; c < num_comps; ++c)
+        siz.set_component(c, tif.get_comp_subsampling(c),
+          tif.get_bit_depth(c), tif.get_is_signed(c));
+      siz.set_image_offset(opts.image_offset);
+      siz.set_tile_size(opts.tile_size);
+      siz.set_tile_offset(opts.tile_offset);
+
+      ojph::param_cod cod = codestream.access_cod();
+      cod.set_num_decomposition(opts.num_decompositions);
+      cod.set_block_dims(opts.block_size.w, opts.block_size.h);
+      if (opts.num_precincts != -1)
+        cod.set_precinct_size(opts.num_precincts, opts.precinct_size);
+      cod.set_progression_order(opts.prog_order);
+      if (opts.employ_color_transform == -1 && num_comps >= 3)
+        cod.set_color_transform(true);
+      else
+        cod.set_color_transform(opts.employ_color_transform == 1);
+      cod.set_reversible(opts.reversible);
+      if (!opts.reversible && opts.quantization_step != -1)
+        codestream.access_qcd().set_irrev_quant(opts.quantization_step);
+      codestream.set_planar(false);
+      if (opts.profile_string[0] != '\0')
+        codestream.set_profile(opts.profile_string);
+      codestream.set_tilepart_divisions(opts.tileparts_at_resolutions, 
+                                        opts.tileparts_at_components);
+      codestream.request_tlm_marker(opts.tlm_marker);
+
+      if (opts.dims.w != 0 || opts.dims.h != 0)
+        OJPH_WARN(0x01000061,
+          "-dims option is not needed and was not used\n");
+      if (opts.num_components != 0)
+        OJPH_WARN(0x01000062,
+          "-num_comps is not needed and was not used\n");
+      if (opts.is_signed[0] != -1)
+        OJPH_WARN(0x01000063,
+          "-signed is not needed and was not used\n");
+      if (opts.comp_downsampling[0].x != 0 || opts.comp_downsampling[0].y != 0)
+        OJPH_WARN(0x01000065,
+          "-downsamp is not needed and was not used\n");
+
+      base = &tif;
+    }
+#endif // !OJPH_ENABLE_TIFF_SUPPORT
+    else if (is_matching(".yuv", v))
+    {
+      ojph::param_siz siz = codestream.access_siz();
+      if (opts.dims.w == 0 || opts.dims.h == 0)
+        OJPH_ERROR(0x01000021,
+          "-dims option must have positive dimensions\n");
+      siz.set_image_extent(ojph::point(opts.image_offset.x + opts.dims.w,
+        opts.image_offset.y + opts.dims.h));
+      if (opts.num_components <= 0)
+        OJPH_ERROR(0x01000022,
+          "-num_comps option is missing and must be provided\n");
+      if (opts.num_is_signed <= 0)
+        OJPH_ERROR(0x01000023,
+          "-signed option is missing and must be provided\n");
+      if (opts.num_bit_depths <= 0)
+        OJPH_ERROR(0x01000024,
+          "-bit_depth option is missing and must be provided\n");
+      if (opts.num_comp_downsamps <= 0)
+        OJPH_ERROR(0x01000025,
+          "-downsamp option is missing and must be provided\n");
+
+      yuv.set_img_props(opts.dims, opts.num_components,
+        opts.num_comp_downsamps, opts.comp_downsampling);
+      yuv.set_bit_depth(opts.num_bit_depths, opts.bit_depth);
+
+      ojph::ui32 last_signed_idx = 0, last_bit_depth_idx = 0;
+      ojph::ui32 last_downsamp_idx = 0;
+      siz.set_num_components(opts.num_components);
+      for (ojph::ui32 c = 0; c < opts.num_components; ++c)
+      {
+        ojph::point cp_ds = opts.comp_downsampling
+            [c < opts.num_comp_downsamps ? c : last_downsamp_idx];
+        last_downsamp_idx +=
+          last_downsamp_idx + 1 < opts.num_comp_downsamps ? 1 : 0;
+        ojph::ui32 bd =
+          opts.bit_depth[c < opts.num_bit_depths ? c : last_bit_depth_idx];
+        last_bit_depth_idx +=
+          last_bit_depth_idx + 1 < opts.num_bit_depths ? 1 : 0;
+        int is =
+          opts.is_signed[c < opts.num_is_signed ? c : last_signed_idx];
+        last_signed_idx += last_signed_idx + 1 < opts.num_is_signed ? 1 : 0;
+        siz.set_component(c, cp_ds, bd, is == 1);
+      }
+      siz.set_image_offset(opts.image_offset);
+      siz.set_tile_size(opts.tile_size);
+      siz.set_tile_offset(opts.tile_offset);
+
+      ojph::param_cod cod = codestream.access_cod();
+      cod.set_num_decomposition(opts.num_decompositions);
+      cod.set_block_dims(opts.block_size.w, opts.block_size.h);
+      if (opts.num_precincts != -1)
+        cod.set_precinct_size(opts.num_precincts, opts.precinct_size);
+      cod.set_progression_order(opts.prog_order);
+      if (opts.employ_color_transform == -1)
+        cod.set_color_transform(false);
+      else
+        OJPH_ERROR(0x01000031,
+          "We currently do not support color transform on raw(yuv) files."
+          " In any case, this not a normal usage scenario.  The OpenJPH "
+          "library however does support that, but ojph_compress.cpp must be "
+          "modified to send all lines from one component before moving to "
+          "the next component;  this requires buffering components outside"
+          " of the OpenJPH library");
+      cod.set_reversible(opts.reversible);
+      if (!opts.reversible && opts.quantization_step != -1.0f)
+        codestream.access_qcd().set_irrev_quant(opts.quantization_step);
+      codestream.set_planar(true);
+      if (opts.profile_string[0] != '\0')
+        codestream.set_profile(opts.profile_string);
+      codestream.set_tilepart_divisions(opts.tileparts_at_resolutions, 
+                                        opts.tileparts_at_components);
+      codestream.request_tlm_marker(opts.tlm_marker);          
+
+      yuv.open(input_filename);
+      base = &yuv;
+    }
+    else if (is_matching(".raw", v))
+    {
+      ojph::param_siz siz = codestream.access_siz();
+      if (opts.dims.w == 0 || opts.dims.h == 0)
+        OJPH_ERROR(0x01000081,
+          "-dims option must have positive dimensions\n");
+      siz.set_image_extent(ojph::point(opts.image_offset.x + opts.dims.w,
+        opts.image_offset.y + opts.dims.h));
+      if (opts.num_components != 1)
+        OJPH_ERROR(0x01000082,
+          "-num_comps must be 1\n");
+      if (opts.num_is_signed <= 0)
+        OJPH_ERROR(0x01000083,
+          "-signed option is missing and must be provided\n");
+      if (opts.num_bit_depths <= 0)
+        OJPH_ERROR(0x01000084,
+          "-bit_depth option is missing and must be provided\n");
+      if (opts.num_comp_downsamps <= 0)
+        OJPH_ERROR(0x01000085,
+          "-downsamp option is missing and must be provided\n");
+
+      raw.set_img_props(opts.dims, opts.bit_depth[0], opts.is_signed);
+
+      siz.set_num_components(opts.num_components);
+      siz.set_component(0, opts.comp_downsampling[0], opts.bit_depth[0],
+        opts.is_signed[0]);
+      siz.set_image_offset(opts.image_offset);
+      siz.set_tile_size(opts.tile_size);
+      siz.set_tile_offset(opts.tile_offset);
+
+      ojph::param_cod cod = codestream.access_cod();
+      cod.set_num_decomposition(opts.num_decompositions);
+      cod.set_block_dims(opts.block_size.w, opts.block_size.h);
+      if (opts.num_precincts != -1)
+        cod.set_precinct_size(opts.num_precincts, opts.precinct_size);
+      cod.set_progression_order(opts.prog_order);
+      if (opts.employ_color_transform != -1)
+        OJPH_ERROR(0x01000086,
+          "color transform is meaningless since .raw files are single "
+          "component files");
+      cod.set_reversible(opts.reversible);
+      if (!opts.reversible && opts.quantization_step != -1.0f)
+        codestream.access_qcd().set_irrev_quant(opts.quantization_step);
+      codestream.set_planar(true);
+      if (opts.profile_string[0] != '\0')
+        codestream.set_profile(opts.profile_string);
+      codestream.set_tilepart_divisions(opts.tileparts_at_resolutions, 
+                                        opts.tileparts_at_components);
+      codestream.request_tlm_marker(opts.tlm_marker);
+
+      raw.open(input_filename);
+      base = &raw;
+    }
+    else if (is_matching(".dpx", v))
+    {
+      dpx.open(input_filename);
+      ojph::param_siz siz = codestream.access_siz();
+      siz.set_image_extent(ojph::point(opts.image_offset.x + dpx.get_size().w,
+        opts.image_offset.y + dpx.get_size().h));
+      ojph::ui32 num_comps = dpx.get_num_components();
+      siz.set_num_components(num_comps);
+      //if (num_bit_depths > 0)
+      //  dpx.set_bit_depth(num_bit_depths, bit_depth);
+      for (ojph::ui32 c = 0; c < num_comps; ++c)
+        siz.set_component(c, dpx.get_comp_subsampling(c),
+          dpx.get_bit_depth(c), dpx.get_is_signed(c));
+      siz.set_image_offset(opts.image_offset);
+      siz.set_tile_size(opts.tile_size);
+      siz.set_tile_offset(opts.tile_offset);
+
+      ojph::param_cod cod = codestream.access_cod();
+      cod.set_num_decomposition(opts.num_decompositions);
+      cod.set_block_dims(opts.block_size.w, opts.block_size.h);
+      if (opts.num_precincts != -1)
+        cod.set_precinct_size(opts.num_precincts, opts.precinct_size);
+      cod.set_progression_order(opts.prog_order);
+      if (opts.employ_color_transform == -1 && num_comps >= 3)
+        cod.set_color_transform(true);
+      else
+        cod.set_color_transform(opts.employ_color_transform == 1);
+      cod.set_reversible(opts.reversible);
+      if (!opts.reversible && opts.quantization_step != -1)
+        codestream.access_qcd().set_irrev_quant(opts.quantization_step);
+      codestream.set_planar(false);
+      if (opts.profile_string[0] != '\0')
+        codestream.set_profile(opts.profile_string);
+      codestream.set_tilepart_divisions(opts.tileparts_at_resolutions,
+        opts.tileparts_at_components);
+      codestream.request_tlm_marker(opts.tlm_marker);
+
+      if (opts.dims.w != 0 || opts.dims.h != 0)
+        OJPH_WARN(0x01000071,
+          "-dims option is not needed and was not used\n");
+      if (opts.num_components != 0)
+        OJPH_WARN(0x01000072,
+          "-num_comps is not needed and was not used\n");
+      if (opts.is_signed[0] != -1)
+        OJPH_WARN(0x01000073,
+          "-signed is not needed and was not used\n");
+      if (opts.comp_downsampling[0].x != 0 || opts.comp_downsampling[0].y != 0)
+        OJPH_WARN(0x01000075,
+          "-downsamp is not needed and was not used\n");
+
+      base = &dpx;
+    }
+    else if (ojph::get_packed_yuv_format(input_filename) 
+             != ojph::PYF_UNKNOWN)
+    {
+      if (opts.dims.w == 0 || opts.dims.h == 0)
+        OJPH_ERROR(0x010000C1,
+          "-dims option must have positive dimensions\n");
+      pyuv.set_img_props(opts.dims);
+      pyuv.open(input_filename);
+
+      ojph::param_siz siz = codestream.access_siz();
+      siz.set_image_extent(ojph::point(opts.image_offset.x + opts.dims.w,
+        opts.image_offset.y + opts.dims.h));
+      siz.set_num_components(3);
+      for (ojph::ui32 c = 0; c < 3; ++c)
+        siz.set_component(c, pyuv.get_comp_subsampling(c),
+          pyuv.get_bit_depth(), false);
+      siz.set_image_offset(opts.image_offset);
+      siz.set_tile_size(opts.tile_size);
+      siz.set_tile_offset(opts.tile_offset);
+
+      ojph::param_cod cod = codestream.access_cod();
+      cod.set_num_decomposition(opts.num_decompositions);
+      cod.set_block_dims(opts.block_size.w, opts.block_size.h);
+      if (opts.num_precincts != -1)
+        cod.set_precinct_size(opts.num_precincts, opts.precinct_size);
+      cod.set_progression_order(opts.prog_order);
+      if (opts.employ_color_transform == -1)
+        cod.set_color_transform(false);
+      else
+        OJPH_ERROR(0x010000C2,
+          "color transform is not supported for v210, uyvy, nv12, p010,"
+          " or p016 files, whose chroma components are downsampled\n");
+      cod.set_reversible(opts.reversible);
+      if (!opts.reversible && opts.quantization_step != -1.0f)
+        codestream.access_qcd().set_irrev_quant(opts.quantization_step);
+      codestream.set_planar(true);
+      if (opts.profile_string[0] != '\0')
+        codestream.set_profile(opts.profile_string);
+      codestream.set_tilepart_divisions(opts.tileparts_at_resolutions,
+        opts.tileparts_at_components);
+      codestream.request_tlm_marker(opts.tlm_marker);
+
+      if (opts.num_components != 0)
+        OJPH_WARN(0x010000C3,
+          "-num_comps is not needed and was not used\n");
+      if (opts.is_signed[0] != -1)
+        OJPH_WARN(0x010000C4,
+          "-signed is not needed and was not used\n");
+      if (opts.bit_depth[0] != 0)
+        OJPH_WARN(0x010000C5,
+          "-bit_depth is not needed and was not used\n");
+      if (opts.comp_downsampling[0].x != 0 || opts.comp_downsampling[0].y != 0)
+        OJPH_WARN(0x010000C6,
+          "-downsamp is not needed and was not used\n");
+
+      base = &pyuv;
+    }
+    else
+#if defined( OJPH_ENABLE_TIFF_SUPPORT)
+      OJPH_ERROR(0x01000041,
+        "unknown input file extension; only pgm, ppm, dpx, tif(f),"
+        " raw(yuv), v210, uyvy, nv12, p010, or p016 are supported\n");
+#else
+      OJPH_ERROR(0x01000041,
+        "unknown input file extension; only pgm, ppm, dpx,"
+        " raw(yuv), v210, uyvy, nv12, p010, or p016 are supported\n");
+#endif // !OJPH_ENABLE_TIFF_SUPPORT 
+  }
+  else
+    OJPH_ERROR(0x01000051,
+      "Please supply a proper input filename with a proper three-letter "
+      "extension\n");
+
+  if (base != NULL) // NULL for sequences, which are already encoded
+  {
+    ojph::comment_exchange com_ex;
+    if (opts.com_string)
+      com_ex.set_string(opts.com_string);
+    codestream_outfile out_file;
+    ojph::outfile_base *file = mem_file;
+    if (mem_file)
+      mem_file->open();
+    else
+      file = out_file.open(output_filename, opts.async_write, 
+                           opts.direct_io);
+    codestream.write_headers(file, &com_ex, opts.com_string ? 1 : 0);
+
+    ojph::ui32 next_comp;
+    ojph::line_buf* cur_line = codestream.exchange(NULL, next_comp);
+    if (codestream.is_planar())
+    {
+      ojph::param_siz siz = codestream.access_siz();
+      for (ojph::ui32 c = 0; c < siz.get_num_components(); ++c)
+      {
+        ojph::point p = siz.get_downsampling(c);
+        ojph::ui32 height = ojph_div_ceil(siz.get_image_extent().y, p.y);
+        height -= ojph_div_ceil(siz.get_image_offset().y, p.y);
+        for (ojph::ui32 i = height; i > 0; --i)
+        {
+          assert(c == next_comp);
+          base->read(cur_line, next_comp);
+          cur_line = codestream.exchange(cur_line, next_comp);
+        }
+      }
+    }
+    else
+    {
+      ojph::param_siz siz = codestream.access_siz();
+      ojph::ui32 height = siz.get_image_extent().y; 
+      height -= siz.get_image_offset().y;
+      for (ojph::ui32 i = 0; i < height; ++i)
+      {
+        for (ojph::ui32 c = 0; c < siz.get_num_components(); ++c)
+        {
+          assert(c == next_comp);
+          base->read(cur_line, next_comp);
+          cur_line = codestream.exchange(cur_line, next_comp);
+        }
+      }
+    }
+
+    codestream.flush();
+    codestream.close();
+    base->close();
+    if (mem_file)
+      mem_file->write_to_file(output_filename);
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Encodes the files of a batch; each thread of a batch owns one of these
+// objects.  Codestreams are collected in a memory file that is reused for
+// all the files of the thread.  The component arrays of opts are private
+// copies, and bit_depth is restored before each file, because encoding a
+// pfm file completes it.
+class batch_compressor : public ojph::batch::file_processor
+{
+public:
+  ~batch_compressor() override {}
+
+  void init(const compress_options& opts)
+  {
+    this->opts = opts;
+    ojph::ui32 n = opts.max_num_comps;
+    is_signed.assign(opts.is_signed, opts.is_signed + n);
+    initial_bit_depth.assign(opts.bit_depth, opts.bit_depth + n);
+    bit_depth = initial_bit_depth;
+    downsampling.assign(opts.comp_downsampling,
+                        opts.comp_downsampling + n);
+    this->opts.is_signed = is_signed.data();
+    this->opts.bit_depth = bit_depth.data();
+    this->opts.comp_downsampling = downsampling.data();
+    this->opts.num_threads = 1; // a sequence is encoded by one thread
+  }
+
+  void process(const char *input_filename,
+               const char *output_filename) override
+  {
+    std::copy(initial_bit_depth.begin(), initial_bit_depth.end(),
+              bit_depth.begin());
+    try {
+      compress_file(input_filename, output_filename, opts, &out);
+    }
+    catch (...)
+    {
+      out.close(); // leaves out ready for the next file
+      throw;
+    }
+  }
+
+private:
+  compress_options opts;
+  std::vector<ojph::si32> is_signed;
+  std::vector<ojph::ui32> bit_depth, initial_bit_depth;
+  std::vector<ojph::point> downsampling;
+  ojph::mem_outfile out;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// Encodes the files in the batch_source directory, or the files listed in
+// the batch_source list file, into the output_dir directory.
+static
+void compress_batch(const char *batch_source, const char *output_dir,
+                    const compress_options& opts)
+{
+  static const char * const extensions[] = { ".pgm", ".ppm", ".pfm",
+    ".yuv", ".y4m", ".raw", ".dpx", ".v210", ".uyvy", ".nv12", ".p010",
+    ".p016",
+#ifdef OJPH_ENABLE_TIFF_SUPPORT
+    ".tif", ".tiff",
+#endif // !OJPH_ENABLE_TIFF_SUPPORT
+    NULL };
+
+  std::vector<std::string> inputs, outputs;
+  ojph::batch::collect_files(batch_source, extensions, inputs);
+  for (size_t i = 0; i < inputs.size(); ++i)
+    outputs.push_back(ojph::batch::make_output_filename(output_dir,
+      inputs[i].c_str(), ".j2c"));
+  ojph::batch::check_output_filenames(inputs, outputs);
+
+  ojph::ui32 num_workers = ojph_max(opts.num_threads, 1u);
+  num_workers = (ojph::ui32)ojph_min((size_t)num_workers, inputs.size());
+  std::vector<batch_compressor> workers(num_workers);
+  std::vector<ojph::batch::file_processor*> processors(num_workers);
+  for (ojph::ui32 i = 0; i < num_workers; ++i)
+  {
+    workers[i].init(opts);
+    processors[i] = &workers[i];
+  }
+
+  ojph::batch::batch_stats stats;
+  ojph::batch::run(inputs, outputs, processors.data(), num_workers, stats);
+  ojph::batch::print_stats(stats);
+  if (stats.num_failed)
+    OJPH_ERROR(0x010000B2, "%u of %u files could not be encoded",
+      stats.num_failed, stats.num_files);
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // main
 //////////////////////////////////////////////////////////////////////////////
@@ -492,6 +1591,8 @@ int main(int argc, char * argv[]) {
   char profile_string_store[] = "";
   char *profile_string = profile_string_store;
   char *com_string = NULL;
+  char *batch_source = NULL;
+  char *stdin_ext = NULL;
   ojph::ui32 num_decompositions = 5;
   float quantization_step = -1.0f;
   bool reversible = false;
@@ -521,16 +1622,27 @@ int main(int argc, char * argv[]) {
   bool tlm_marker = false;
   bool tileparts_at_resolutions = false;
   bool tileparts_at_components = false;
+  bool use_mmap = false;
+  bool async_write = false;
+  bool direct_io = false;
+  ojph::ui32 num_frames = num_frames_default;
+#ifdef OJPH_EMSCRIPTEN
+  ojph::ui32 num_threads = 1;
+#else
+  ojph::ui32 num_threads = std::thread::hardware_concurrency();
+#endif
 
   if (argc <= 1) {
     std::cout <<
     "\nThe following arguments are necessary:\n"
 #ifdef OJPH_ENABLE_TIFF_SUPPORT
-    " -i input file name (either pgm, ppm, pfm, tif(f), or raw(yuv))\n"
+    " -i input file name (pgm, ppm, pfm, tif(f), yuv, y4m, raw, dpx,\n"
 #else
-    " -i input file name (either pgm, ppm, pfm, or raw(yuv))\n"
+    " -i input file name (pgm, ppm, pfm, yuv, y4m, raw, dpx,\n"
 #endif // !OJPH_ENABLE_TIFF_SUPPORT
-    " -o output file name\n\n"
+    "    v210, uyvy, nv12, p010, or p016), or - for the standard input\n"
+    " -o output file name, or - for the standard output; messages are\n"
+    "    then written to the standard error\n\n"
 
     "The following option has a default value (optional):\n"
     " -num_decomps  (5) number of decompositions\n"
@@ -575,6 +1687,17 @@ int main(int argc, char * argv[]) {
     " -com          (None) if set, inserts a COM marker with the specified\n"
     "               string. If the string has spaces, please use\n"
     "               double quotes, as in -com \"This is a comment\".\n"
+    " -mmap         <true | false> if 'true', pgm, ppm, pfm, yuv, and raw\n"
+    "               input files are read through a memory mapping, when\n"
+    "               the system supports it.  Default value is false.\n"
+    " -async_write  <true | false> if 'true', the codestream is written to\n"
+    "               the output file by a background thread, through two\n"
+    "               4MB buffers, so that encoding does not wait for slow\n"
+    "               or network storage.  Default value is false.\n"
+    " -direct_io    <true | false> if 'true', with -async_write, the output\n"
+    "               file bypasses the page cache (O_DIRECT), where the\n"
+    "               system and file system support it.  Default value is\n"
+    "               false.\n"
     "\n"
 
     "When the input file is a YUV file, these arguments need to be \n"
@@ -589,6 +1712,46 @@ int main(int argc, char * argv[]) {
     "            component; for example {1,1},{2,2},{2,2}\n\n"
     "\n"
 
+    "Files in the packed and semi-planar layouts of broadcast and video\n"
+    "equipment are identified by their extension, and hold one frame:\n"
+    " .v210 4:2:2 10-bit, .uyvy 4:2:2 8-bit, .nv12 4:2:0 8-bit, .p010\n"
+    " 4:2:0 10-bit, and .p016 4:2:0 16-bit.  Only -dims is needed, as the\n"
+    " other image properties are implied by the layout.\n"
+    "\n"
+
+    "YUV files can hold a sequence of frames, and so can .y4m files, whose\n"
+    "image properties are obtained from their header.  Frames of a\n"
+    "sequence are encoded concurrently.  If the -o name has a printf-style\n"
+    "conversion, as in out_%05d.j2c, a codestream file is written for each\n"
+    "frame; otherwise, the codestreams of all frames are concatenated into\n"
+    "one file.  A .y4m file is always encoded as a sequence.\n"
+    " -num_frames  (1 for .yuv, 0 for .y4m) the number of frames to encode\n"
+    "              from a .yuv or .y4m file; 0 encodes all the frames in\n"
+    "              the file.\n"
+    " -num_threads (number of cores) the number of threads used to encode\n"
+    "              frames of a sequence, or files of a batch.\n"
+    "\n"
+
+    "The standard input can be encoded using -i -:\n"
+    " -stdin_ext the extension that gives the format of the standard\n"
+    "            input, such as ppm or y4m.  The standard input is read to\n"
+    "            its end, into a temporary file, before encoding starts;\n"
+    "            it is then encoded as a file with this extension is, so\n"
+    "            that .yuv and .y4m inputs can hold sequences.\n"
+    "\n"
+
+    "Many files can be encoded by one invocation, in batch mode:\n"
+    " -batch     <directory | list file> encodes every pgm, ppm, pfm, yuv,\n"
+    "            raw, or dpx file in a directory, or every file named in a\n"
+    "            list file, which has one file name per line.  -i is not\n"
+    "            used, and -o names the output directory; each output file\n"
+    "            is named after its input file, with the .j2c extension,\n"
+    "            and a batch in which two files would produce the same\n"
+    "            output name is rejected.\n"
+    "            Files are encoded concurrently, using -num_threads threads,\n"
+    "            and all other options apply to every file.\n"
+    "\n"
+
     ".pfm files receive special treatment. Currently, lossy compression\n"
     "with these files is not supported, only lossless. When these files are\n"
     "used, the NLT segment marker is automatically inserted into the\n"
@@ -625,534 +1788,82 @@ int main(int argc, char * argv[]) {
                      num_comp_downsamps, comp_downsampling,
                      num_bit_depths, bit_depth, num_is_signed, is_signed,
                      tlm_marker, tileparts_at_resolutions,
-                     tileparts_at_components, com_string))
+                     tileparts_at_components, com_string, use_mmap,
+                     async_write, direct_io,
+                     num_frames, num_threads, batch_source, stdin_ext))
   {
     return -1;
   }
 
+  compress_options opts;
+  opts.prog_order = prog_order;
+  opts.profile_string = profile_string;
+  opts.com_string = com_string;
+  opts.num_decompositions = num_decompositions;
+  opts.quantization_step = quantization_step;
+  opts.reversible = reversible;
+  opts.employ_color_transform = employ_color_transform;
+  opts.precinct_size = precinct_size;
+  opts.num_precincts = num_precincts;
+  opts.block_size = block_size;
+  opts.dims = dims;
+  opts.tile_size = tile_size;
+  opts.tile_offset = tile_offset;
+  opts.image_offset = image_offset;
+  opts.max_num_comps = max_num_comps;
+  opts.num_components = num_components;
+  opts.num_is_signed = num_is_signed;
+  opts.is_signed = is_signed;
+  opts.num_bit_depths = num_bit_depths;
+  opts.bit_depth = bit_depth;
+  opts.num_comp_downsamps = num_comp_downsamps;
+  opts.comp_downsampling = comp_downsampling;
+  opts.tlm_marker = tlm_marker;
+  opts.tileparts_at_resolutions = tileparts_at_resolutions;
+  opts.tileparts_at_components = tileparts_at_components;
+  opts.use_mmap = use_mmap;
+  opts.async_write = async_write;
+  opts.direct_io = direct_io;
+  opts.num_frames = num_frames;
+  opts.num_threads = num_threads;
+
+  // messages go to the standard error when codestreams go to the 
+  // standard output
+  FILE *msg_file = stdout;
+  if (output_filename != NULL && ojph::is_standard_stream(output_filename))
+  {
+    ojph::set_info_stream(stderr);
+    ojph::set_warning_stream(stderr);
+    msg_file = stderr;
+  }
+
   clock_t begin = clock();
 
   try
   {
-    ojph::codestream codestream;
-
-    ojph::ppm_in ppm;
-    ojph::pfm_in pfm;
-    ojph::yuv_in yuv;
-    ojph::raw_in raw;
-    ojph::dpx_in dpx;
-#ifdef OJPH_ENABLE_TIFF_SUPPORT
-    ojph::tif_in tif;
-#endif // !OJPH_ENABLE_TIFF_SUPPORT
-
-    ojph::image_in_base *base = NULL;
-    if (input_filename == NULL)
+    if (input_filename == NULL && batch_source == NULL)
       OJPH_ERROR(0x01000007, "please specify an input file name using"
         " the -i command line option");
     if (output_filename == NULL)
       OJPH_ERROR(0x01000008, "please specify an output file name using"
         " the -o command line option");
-    const char *v = get_file_extension(input_filename);
+    if (input_filename != NULL && batch_source != NULL)
+      OJPH_ERROR(0x010000B1, "the -i and -batch options cannot be used "
+        "together");
 
-    if (v)
+    ojph::stdin_copy_file stdin_file;
+    if (input_filename != NULL && ojph::is_standard_stream(input_filename))
     {
-      if (is_matching(".pgm", v))
-      {
-        ppm.open(input_filename);
-        ojph::param_siz siz = codestream.access_siz();
-        siz.set_image_extent(ojph::point(image_offset.x + ppm.get_width(),
-          image_offset.y + ppm.get_height()));
-        ojph::ui32 num_comps = ppm.get_num_components();
-        assert(num_comps == 1);
-        siz.set_num_components(num_comps);
-        for (ojph::ui32 c = 0; c < num_comps; ++c)
-          siz.set_component(c, ppm.get_comp_subsampling(c),
-            ppm.get_bit_depth(c), ppm.get_is_signed(c));
-        siz.set_image_offset(image_offset);
-        siz.set_tile_size(tile_size);
-        siz.set_tile_offset(tile_offset);
-
-        ojph::param_cod cod = codestream.access_cod();
-        cod.set_num_decomposition(num_decompositions);
-        cod.set_block_dims(block_size.w, block_size.h);
-        if (num_precincts != -1)
-          cod.set_precinct_size(num_precincts, precinct_size);
-        cod.set_progression_order(prog_order);
-        cod.set_color_transform(false);
-        cod.set_reversible(reversible);
-        if (!reversible && quantization_step != -1.0f)
-          codestream.access_qcd().set_irrev_quant(quantization_step);
-        if (profile_string[0] != '\0')
-          codestream.set_profile(profile_string);
-        codestream.set_tilepart_divisions(tileparts_at_resolutions, 
-                                          tileparts_at_components);
-        codestream.request_tlm_marker(tlm_marker);
-
-        if (employ_color_transform != -1)
-          OJPH_WARN(0x01000001,
-            "-colour_trans option is not needed and was not used\n");
-        if (dims.w != 0 || dims.h != 0)
-          OJPH_WARN(0x01000002,
-            "-dims option is not needed and was not used\n");
-        if (num_components != 0)
-          OJPH_WARN(0x01000003,
-            "-num_comps is not needed and was not used\n");
-        if (is_signed[0] != -1)
-          OJPH_WARN(0x01000004,
-            "-signed is not needed and was not used\n");
-        if (bit_depth[0] != 0)
-          OJPH_WARN(0x01000005,
-            "-bit_depth is not needed and was not used\n");
-        if (comp_downsampling[0].x != 0 || comp_downsampling[0].y != 0)
-          OJPH_WARN(0x01000006,
-            "-downsamp is not needed and was not used\n");
-
-        base = &ppm;
-      }
-      else if (is_matching(".ppm", v))
-      {
-        ppm.open(input_filename);
-        ojph::param_siz siz = codestream.access_siz();
-        siz.set_image_extent(ojph::point(image_offset.x + ppm.get_width(),
-          image_offset.y + ppm.get_height()));
-        ojph::ui32 num_comps = ppm.get_num_components();
-        assert(num_comps == 3);
-        siz.set_num_components(num_comps);
-        for (ojph::ui32 c = 0; c < num_comps; ++c)
-          siz.set_component(c, ppm.get_comp_subsampling(c),
-            ppm.get_bit_depth(c), ppm.get_is_signed(c));
-        siz.set_image_offset(image_offset);
-        siz.set_tile_size(tile_size);
-        siz.set_tile_offset(tile_offset);
-
-        ojph::param_cod cod = codestream.access_cod();
-        cod.set_num_decomposition(num_decompositions);
-        cod.set_block_dims(block_size.w, block_size.h);
-        if (num_precincts != -1)
-          cod.set_precinct_size(num_precincts, precinct_size);
-        cod.set_progression_order(prog_order);
-        if (employ_color_transform == -1)
-          cod.set_color_transform(true);
-        else
-          cod.set_color_transform(employ_color_transform == 1);
-        cod.set_reversible(reversible);
-        if (!reversible && quantization_step != -1.0f)
-          codestream.access_qcd().set_irrev_quant(quantization_step);
-        codestream.set_planar(false);
-        if (profile_string[0] != '\0')
-          codestream.set_profile(profile_string);
-        codestream.set_tilepart_divisions(tileparts_at_resolutions, 
-                                          tileparts_at_components);
-        codestream.request_tlm_marker(tlm_marker);          
-
-        if (dims.w != 0 || dims.h != 0)
-          OJPH_WARN(0x01000011,
-            "-dims option is not needed and was not used\n");
-        if (num_components != 0)
-          OJPH_WARN(0x01000012,
-            "-num_comps is not needed and was not used\n");
-        if (is_signed[0] != -1)
-          OJPH_WARN(0x01000013,
-            "-signed is not needed and was not used\n");
-        if (bit_depth[0] != 0)
-          OJPH_WARN(0x01000014,
-            "-bit_depth is not needed and was not used\n");
-        if (comp_downsampling[0].x != 0 || comp_downsampling[0].y != 0)
-          OJPH_WARN(0x01000015,
-            "-downsamp is not needed and was not used\n");
-
-        base = &ppm;
-      }
-      else if (is_matching(".pfm", v))
-      {
-        pfm.open(input_filename);
-        ojph::param_siz siz = codestream.access_siz();
-        siz.set_image_extent(ojph::point(image_offset.x + pfm.get_width(),
-          image_offset.y + pfm.get_height()));
-        ojph::ui32 num_comps = pfm.get_num_components();
-        assert(num_comps == 1 || num_comps == 3);
-        siz.set_num_components(num_comps);
-
-        if (bit_depth[0] != 0)             // one was set
-          if (num_bit_depths < num_comps)  // but if not enough, repeat
-            for (ojph::ui32 c = num_bit_depths; c < num_comps; ++c)
-              bit_depth[c] = bit_depth[num_bit_depths - 1];
-
-        bool all_the_same = true;
-        if (num_comps == 3)
-          all_the_same = all_the_same 
-            && bit_depth[0] == bit_depth[1] 
-            && bit_depth[1] == bit_depth[2];
-
-        for (ojph::ui32 c = 0; c < num_comps; ++c) {
-          if (bit_depth[c] == 0)
-            bit_depth[c] = 32;
-          siz.set_component(c, ojph::point(1,1), bit_depth[c], true);
-        }
-        pfm.configure(bit_depth);
-
-        siz.set_image_offset(image_offset);
-        siz.set_tile_size(tile_size);
-        siz.set_tile_offset(tile_offset);
-
-        ojph::param_cod cod = codestream.access_cod();
-        cod.set_num_decomposition(num_decompositions);
-        cod.set_block_dims(block_size.w, block_size.h);
-        if (num_precincts != -1)
-          cod.set_precinct_size(num_precincts, precinct_size);
-        cod.set_progression_order(prog_order);
-        if (num_comps == 1)
-        {
-          if (employ_color_transform != -1)
-            OJPH_WARN(0x01000091,
-              "-colour_trans option is not needed and was not used; "
-              "this is because the image has one component only\n");
-        }
-        else
-        {
-          if (employ_color_transform == -1)
-            cod.set_color_transform(true);
-          else
-            cod.set_color_transform(employ_color_transform == 1);
-        }
-        cod.set_reversible(reversible);
-        if (!reversible) {
-          const float min_step = 1.0f / 16384.0f;
-          if (quantization_step == -1.0f)
-            quantization_step = min_step;
-          else
-            quantization_step = ojph_max(quantization_step, min_step);
-          codestream.access_qcd().set_irrev_quant(quantization_step);
-        }
-
-        // Note: Even if only ALL_COMPS is set to 
-        // OJPH_NLT_BINARY_COMPLEMENT_NLT, the library can decide if
-        // one ALL_COMPS NLT marker segment is needed, or multiple 
-        // per component NLT marker segments are needed (when the components
-        // have different bit depths or signedness).
-        // Of course for .pfm images all components should have the same
-        // bit depth and signedness.
-        ojph::param_nlt nlt = codestream.access_nlt();
-        if (all_the_same)
-          nlt.set_nonlinear_transform(ojph::param_nlt::ALL_COMPS, 
-            ojph::param_nlt::OJPH_NLT_BINARY_COMPLEMENT_NLT);
-        else
-          for (ojph::ui32 c = 0; c < num_comps; ++c)
-            nlt.set_nonlinear_transform(c, 
-              ojph::param_nlt::OJPH_NLT_BINARY_COMPLEMENT_NLT);
-
-        codestream.set_planar(false);
-        if (profile_string[0] != '\0')
-          codestream.set_profile(profile_string);
-        codestream.set_tilepart_divisions(tileparts_at_resolutions, 
-                                          tileparts_at_components);
-        codestream.request_tlm_marker(tlm_marker);          
-
-        if (dims.w != 0 || dims.h != 0)
-          OJPH_WARN(0x01000092,
-            "-dims option is not needed and was not used\n");
-        if (num_components != 0)
-          OJPH_WARN(0x01000093,
-            "-num_comps is not needed and was not used\n");
-        if (is_signed[0] != -1)
-          OJPH_WARN(0x01000094,
-            "-signed is not needed and was not used\n");            
-        if (comp_downsampling[0].x != 0 || comp_downsampling[0].y != 0)
-          OJPH_WARN(0x01000095,
-            "-downsamp is not needed and was not used\n");
-
-        base = &pfm;
-      }
-#ifdef OJPH_ENABLE_TIFF_SUPPORT
-      else if (is_matching(".tif", v) || is_matching(".tiff", v))
-      {
-        tif.open(input_filename);
-        ojph::param_siz siz = codestream.access_siz();
-        siz.set_image_extent(ojph::point(image_offset.x + tif.get_size().w,
-          image_offset.y + tif.get_size().h));
-        ojph::ui32 num_comps = tif.get_num_components();
-        siz.set_num_components(num_comps);
-        if(num_bit_depths > 0 )
-          tif.set_bit_depth(num_bit_depths, bit_depth);
-        for (ojph::ui32 c = 0; c < num_comps; ++c)
-          siz.set_component(c, tif.get_comp_subsampling(c),
-            tif.get_bit_depth(c), tif.get_is_signed(c));
-        siz.set_image_offset(image_offset);
-        siz.set_tile_size(tile_size);
-        siz.set_tile_offset(tile_offset);
-
-        ojph::param_cod cod = codestream.access_cod();
-        cod.set_num_decomposition(num_decompositions);
-        cod.set_block_dims(block_size.w, block_size.h);
-        if (num_precincts != -1)
-          cod.set_precinct_size(num_precincts, precinct_size);
-        cod.set_progression_order(prog_order);
-        if (employ_color_transform == -1 && num_comps >= 3)
-          cod.set_color_transform(true);
-        else
-          cod.set_color_transform(employ_color_transform == 1);
-        cod.set_reversible(reversible);
-        if (!reversible && quantization_step != -1)
-          codestream.access_qcd().set_irrev_quant(quantization_step);
-        codestream.set_planar(false);
-        if (profile_string[0] != '\0')
-          codestream.set_profile(profile_string);
-        codestream.set_tilepart_divisions(tileparts_at_resolutions, 
-                                          tileparts_at_components);
-        codestream.request_tlm_marker(tlm_marker);
-
-        if (dims.w != 0 || dims.h != 0)
-          OJPH_WARN(0x01000061,
-            "-dims option is not needed and was not used\n");
-        if (num_components != 0)
-          OJPH_WARN(0x01000062,
-            "-num_comps is not needed and was not used\n");
-        if (is_signed[0] != -1)
-          OJPH_WARN(0x01000063,
-            "-signed is not needed and was not used\n");
-        if (comp_downsampling[0].x != 0 || comp_downsampling[0].y != 0)
-          OJPH_WARN(0x01000065,
-            "-downsamp is not needed and was not used\n");
-
-        base = &tif;
-      }
-#endif // !OJPH_ENABLE_TIFF_SUPPORT
-      else if (is_matching(".yuv", v))
-      {
-        ojph::param_siz siz = codestream.access_siz();
-        if (dims.w == 0 || dims.h == 0)
-          OJPH_ERROR(0x01000021,
-            "-dims option must have positive dimensions\n");
-        siz.set_image_extent(ojph::point(image_offset.x + dims.w,
-          image_offset.y + dims.h));
-        if (num_components <= 0)
-          OJPH_ERROR(0x01000022,
-            "-num_comps option is missing and must be provided\n");
-        if (num_is_signed <= 0)
-          OJPH_ERROR(0x01000023,
-            "-signed option is missing and must be provided\n");
-        if (num_bit_depths <= 0)
-          OJPH_ERROR(0x01000024,
-            "-bit_depth option is missing and must be provided\n");
-        if (num_comp_downsamps <= 0)
-          OJPH_ERROR(0x01000025,
-            "-downsamp option is missing and must be provided\n");
-
-        yuv.set_img_props(dims, num_components, num_comp_downsamps,
-          comp_downsampling);
-        yuv.set_bit_depth(num_bit_depths, bit_depth);
-
-        ojph::ui32 last_signed_idx = 0, last_bit_depth_idx = 0;
-        ojph::ui32 last_downsamp_idx = 0;
-        siz.set_num_components(num_components);
-        for (ojph::ui32 c = 0; c < num_components; ++c)
-        {
-          ojph::point cp_ds = comp_downsampling
-              [c < num_comp_downsamps ? c : last_downsamp_idx];
-          last_downsamp_idx += last_downsamp_idx+1 < num_comp_downsamps ? 1:0;
-          ojph::ui32 bd = bit_depth[c<num_bit_depths ? c : last_bit_depth_idx];
-          last_bit_depth_idx += last_bit_depth_idx + 1 < num_bit_depths ? 1:0;
-          int is = is_signed[c < num_is_signed ? c : last_signed_idx];
-          last_signed_idx += last_signed_idx + 1 < num_is_signed ? 1 : 0;
-          siz.set_component(c, cp_ds, bd, is == 1);
-        }
-        siz.set_image_offset(image_offset);
-        siz.set_tile_size(tile_size);
-        siz.set_tile_offset(tile_offset);
-
-        ojph::param_cod cod = codestream.access_cod();
-        cod.set_num_decomposition(num_decompositions);
-        cod.set_block_dims(block_size.w, block_size.h);
-        if (num_precincts != -1)
-          cod.set_precinct_size(num_precincts, precinct_size);
-        cod.set_progression_order(prog_order);
-        if (employ_color_transform == -1)
-          cod.set_color_transform(false);
-        else
-          OJPH_ERROR(0x01000031,
-            "We currently do not support color transform on raw(yuv) files."
-            " In any case, this not a normal usage scenario.  The OpenJPH "
-            "library however does support that, but ojph_compress.cpp must be "
-            "modified to send all lines from one component before moving to "
-            "the next component;  this requires buffering components outside"
-            " of the OpenJPH library");
-        cod.set_reversible(reversible);
-        if (!reversible && quantization_step != -1.0f)
-          codestream.access_qcd().set_irrev_quant(quantization_step);
-        codestream.set_planar(true);
-        if (profile_string[0] != '\0')
-          codestream.set_profile(profile_string);
-        codestream.set_tilepart_divisions(tileparts_at_resolutions, 
-                                          tileparts_at_components);
-        codestream.request_tlm_marker(tlm_marker);          
-
-        yuv.open(input_filename);
-        base = &yuv;
-      }
-      else if (is_matching(".raw", v))
-      {
-        ojph::param_siz siz = codestream.access_siz();
-        if (dims.w == 0 || dims.h == 0)
-          OJPH_ERROR(0x01000081,
-            "-dims option must have positive dimensions\n");
-        siz.set_image_extent(ojph::point(image_offset.x + dims.w,
-          image_offset.y + dims.h));
-        if (num_components != 1)
-          OJPH_ERROR(0x01000082,
-            "-num_comps must be 1\n");
-        if (num_is_signed <= 0)
-          OJPH_ERROR(0x01000083,
-            "-signed option is missing and must be provided\n");
-        if (num_bit_depths <= 0)
-          OJPH_ERROR(0x01000084,
-            "-bit_depth option is missing and must be provided\n");
-        if (num_comp_downsamps <= 0)
-          OJPH_ERROR(0x01000085,
-            "-downsamp option is missing and must be provided\n");
-
-        raw.set_img_props(dims, bit_depth[0], is_signed);
-
-        siz.set_num_components(num_components);
-        siz.set_component(0, comp_downsampling[0], bit_depth[0], is_signed[0]);
-        siz.set_image_offset(image_offset);
-        siz.set_tile_size(tile_size);
-        siz.set_tile_offset(tile_offset);
-
-        ojph::param_cod cod = codestream.access_cod();
-        cod.set_num_decomposition(num_decompositions);
-        cod.set_block_dims(block_size.w, block_size.h);
-        if (num_precincts != -1)
-          cod.set_precinct_size(num_precincts, precinct_size);
-        cod.set_progression_order(prog_order);
-        if (employ_color_transform != -1)
-          OJPH_ERROR(0x01000086,
-            "color transform is meaningless since .raw files are single "
-            "component files");
-        cod.set_reversible(reversible);
-        if (!reversible && quantization_step != -1.0f)
-          codestream.access_qcd().set_irrev_quant(quantization_step);
-        codestream.set_planar(true);
-        if (profile_string[0] != '\0')
-          codestream.set_profile(profile_string);
-        codestream.set_tilepart_divisions(tileparts_at_resolutions, 
-                                          tileparts_at_components);
-        codestream.request_tlm_marker(tlm_marker);
-
-        raw.open(input_filename);
-        base = &raw;
-      }
-      else if (is_matching(".dpx", v))
-      {
-        dpx.open(input_filename);
-        ojph::param_siz siz = codestream.access_siz();
-        siz.set_image_extent(ojph::point(image_offset.x + dpx.get_size().w,
-          image_offset.y + dpx.get_size().h));
-        ojph::ui32 num_comps = dpx.get_num_components();
-        siz.set_num_components(num_comps);
-        //if (num_bit_depths > 0)
-        //  dpx.set_bit_depth(num_bit_depths, bit_depth);
-        for (ojph::ui32 c = 0; c < num_comps; ++c)
-          siz.set_component(c, dpx.get_comp_subsampling(c),
-            dpx.get_bit_depth(c), dpx.get_is_signed(c));
-        siz.set_image_offset(image_offset);
-        siz.set_tile_size(tile_size);
-        siz.set_tile_offset(tile_offset);
-
-        ojph::param_cod cod = codestream.access_cod();
-        cod.set_num_decomposition(num_decompositions);
-        cod.set_block_dims(block_size.w, block_size.h);
-        if (num_precincts != -1)
-          cod.set_precinct_size(num_precincts, precinct_size);
-        cod.set_progression_order(prog_order);
-        if (employ_color_transform == -1 && num_comps >= 3)
-          cod.set_color_transform(true);
-        else
-          cod.set_color_transform(employ_color_transform == 1);
-        cod.set_reversible(reversible);
-        if (!reversible && quantization_step != -1)
-          codestream.access_qcd().set_irrev_quant(quantization_step);
-        codestream.set_planar(false);
-        if (profile_string[0] != '\0')
-          codestream.set_profile(profile_string);
-        codestream.set_tilepart_divisions(tileparts_at_resolutions,
-          tileparts_at_components);
-        codestream.request_tlm_marker(tlm_marker);
-
-        if (dims.w != 0 || dims.h != 0)
-          OJPH_WARN(0x01000071,
-            "-dims option is not needed and was not used\n");
-        if (num_components != 0)
-          OJPH_WARN(0x01000072,
-            "-num_comps is not needed and was not used\n");
-        if (is_signed[0] != -1)
-          OJPH_WARN(0x01000073,
-            "-signed is not needed and was not used\n");
-        if (comp_downsampling[0].x != 0 || comp_downsampling[0].y != 0)
-          OJPH_WARN(0x01000075,
-            "-downsamp is not needed and was not used\n");
-
-        base = &dpx;
-      }
-      else
-#if defined( OJPH_ENABLE_TIFF_SUPPORT)
-        OJPH_ERROR(0x01000041,
-          "unknown input file extension; only pgm, ppm, dpx, tif(f),"
-          " or raw(yuv) are supported\n");
-#else
-        OJPH_ERROR(0x01000041,
-          "unknown input file extension; only pgm, ppm, dpx,"
-          " or raw(yuv) are supported\n");
-#endif // !OJPH_ENABLE_TIFF_SUPPORT 
-    }
-    else
-      OJPH_ERROR(0x01000051,
-        "Please supply a proper input filename with a proper three-letter "
-        "extension\n");
-
-    ojph::comment_exchange com_ex;
-    if (com_string)
-      com_ex.set_string(com_string);
-    ojph::j2c_outfile j2c_file;
-    j2c_file.open(output_filename);
-    codestream.write_headers(&j2c_file, &com_ex, com_string ? 1 : 0);
-
-    ojph::ui32 next_comp;
-    ojph::line_buf* cur_line = codestream.exchange(NULL, next_comp);
-    if (codestream.is_planar())
-    {
-      ojph::param_siz siz = codestream.access_siz();
-      for (ojph::ui32 c = 0; c < siz.get_num_components(); ++c)
-      {
-        ojph::point p = siz.get_downsampling(c);
-        ojph::ui32 height = ojph_div_ceil(siz.get_image_extent().y, p.y);
-        height -= ojph_div_ceil(siz.get_image_offset().y, p.y);
-        for (ojph::ui32 i = height; i > 0; --i)
-        {
-          assert(c == next_comp);
-          base->read(cur_line, next_comp);
-          cur_line = codestream.exchange(cur_line, next_comp);
-        }
-      }
+      if (stdin_ext == NULL)
+        OJPH_ERROR(0x010000D1, "Please provide the format of the input "
+          "read from the standard input using the -stdin_ext option\n");
+      const char *name = stdin_file.open(stdin_ext);
+      compress_file(name, output_filename, opts, NULL);
     }
+    else if (batch_source == NULL)
+      compress_file(input_filename, output_filename, opts, NULL);
     else
-    {
-      ojph::param_siz siz = codestream.access_siz();
-      ojph::ui32 height = siz.get_image_extent().y; 
-      height -= siz.get_image_offset().y;
-      for (ojph::ui32 i = 0; i < height; ++i)
-      {
-        for (ojph::ui32 c = 0; c < siz.get_num_components(); ++c)
-        {
-          assert(c == next_comp);
-          base->read(cur_line, next_comp);
-          cur_line = codestream.exchange(cur_line, next_comp);
-        }
-      }
-    }
-
-    codestream.flush();
-    codestream.close();
-    base->close();
+      compress_batch(batch_source, output_filename, opts);
 
     if (max_num_comps != initial_num_comps)
     {
@@ -1165,13 +1876,13 @@ int main(int argc, char * argv[]) {
   {
     const char *p = e.what();
     if (strncmp(p, "ojph error", 10) != 0)
-      printf("%s\n", p);
+      fprintf(msg_file, "%s\n", p);
     exit(-1);
   }
 
   clock_t end = clock();
   double elapsed_secs = double(end - begin) / CLOCKS_PER_SEC;
-  printf("Elapsed time = %f\n", elapsed_secs);
+  fprintf(msg_file, "Elapsed time = %f\n", elapsed_secs);
 
   return 0;
 
@@ -38,10 +38,14 @@
 #include <ctime>
 #include <iostream>
 #include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "ojph_arg.h"
 #include "ojph_mem.h"
 #include "ojph_img_io.h"
+#include "ojph_batch.h"
 #include "ojph_file.h"
 #include "ojph_codestream.h"
 #include "ojph_params.h"
@@ -95,7 +99,9 @@ bool get_arguments(int argc, char *argv[],
                    char *&input_filename, char *&output_filename,
                    ojph::ui32& skipped_res_for_read, 
                    ojph::ui32& skipped_res_for_recon,
-                   bool& resilient)
+                   bool& resilient, bool& use_mmap,
+                   char *&batch_source, char *&batch_ext,
+                   char *&stdout_ext, ojph::ui32& num_threads)
 {
   ojph::cli_interpreter interpreter;
   interpreter.init(argc, argv);
@@ -108,6 +114,11 @@ bool get_arguments(int argc, char *argv[],
   interpreter.reinterpret("-o", output_filename);
   interpreter.reinterpret("-skip_res", &ilist);
   interpreter.reinterpret("-resilient", resilient);
+  interpreter.reinterpret("-mmap", use_mmap);
+  interpreter.reinterpret("-batch", batch_source);
+  interpreter.reinterpret("-batch_ext", batch_ext);
+  interpreter.reinterpret("-stdout_ext", stdout_ext);
+  interpreter.reinterpret("-num_threads", num_threads);
 
   //interpret skipped_string
   if (num_skipped_res > 0)
@@ -161,6 +172,403 @@ bool is_matching(const char *ref, const char *other)
   return true;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// file decoding
+//////////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////////
+// The command line options that control the decoding of a file
+struct expand_options
+{
+  ojph::ui32 skipped_res_for_read;
+  ojph::ui32 skipped_res_for_recon;
+  bool resilient;
+  bool use_mmap;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// Decodes the codestream in file, which is open, into output_filename;
+// the format of the output file is determined by the extension ext, which
+// includes the dot.
+static
+void expand_codestream(ojph::infile_base *file, char *output_filename,
+                       const char *ext, const expand_options& opts)
+{
+  ojph::codestream codestream;
+
+  ojph::ppm_out ppm;
+  ojph::pfm_out pfm;
+  #ifdef OJPH_ENABLE_TIFF_SUPPORT
+  ojph::tif_out tif;
+  #endif /* OJPH_ENABLE_TIFF_SUPPORT */
+  ojph::yuv_out yuv;
+  ojph::raw_out raw;
+  ojph::packed_yuv_out pyuv;
+  ppm.set_mmap(opts.use_mmap);
+  yuv.set_mmap(opts.use_mmap);
+  raw.set_mmap(opts.use_mmap);
+  pyuv.set_mmap(opts.use_mmap);
+  ojph::image_out_base *base = NULL;
+  const char *v = ext;
+  if (v)
+  {
+    if (opts.resilient)
+      codestream.enable_resilience();
+    codestream.read_headers(file);
+    codestream.restrict_input_resolution(opts.skipped_res_for_read, 
+      opts.skipped_res_for_recon);
+    ojph::param_siz siz = codestream.access_siz();
+
+    if (is_matching(".pgm", v))
+    {
+
+      if (siz.get_num_components() != 1)
+        OJPH_ERROR(0x02000002,
+          "The file has more than one color component, but .pgm can "
+          "contain only one color component\n");
+      ppm.configure(siz.get_recon_width(0), siz.get_recon_height(0),
+                    siz.get_num_components(), siz.get_bit_depth(0));
+      ppm.open(output_filename);
+      base = &ppm;
+    }
+    else if (is_matching(".ppm", v))
+    {
+      codestream.set_planar(false);
+      ojph::param_siz siz = codestream.access_siz();
+
+      if (siz.get_num_components() != 3)
+        OJPH_ERROR(0x02000003,
+          "The file has %d color components; this cannot be saved to"
+          " a .ppm file\n", siz.get_num_components());
+      bool all_same = true;
+      ojph::point p = siz.get_downsampling(0);
+      for (ojph::ui32 i = 1; i < siz.get_num_components(); ++i)
+      {
+        ojph::point p1 = siz.get_downsampling(i);
+        all_same = all_same && (p1.x == p.x) && (p1.y == p.y);
+      }
+      if (!all_same)
+        OJPH_ERROR(0x02000004,
+          "To save an image to ppm, all the components must have the "
+          "same downsampling ratio\n");
+      ppm.configure(siz.get_recon_width(0), siz.get_recon_height(0),
+                    siz.get_num_components(), siz.get_bit_depth(0));
+      ppm.open(output_filename);
+      base = &ppm;
+    }
+    else if (is_matching(".pfm", v))
+    {
+      OJPH_INFO(0x02000010, "Note: The .pfm implementation is "
+        "experimental.  Here, we are assuming that the original data is "
+        "floating-point numbers.");
+
+      codestream.set_planar(false);
+      ojph::param_siz siz = codestream.access_siz();
+
+      ojph::ui32 num_comps = siz.get_num_components();
+      if (num_comps != 3 && num_comps != 1)
+        OJPH_ERROR(0x0200000C,
+          "The file has %d color components; this cannot be saved to"
+          " a .pfm file", num_comps);
+      bool all_same = true;
+      ojph::point p = siz.get_downsampling(0);
+      for (ojph::ui32 i = 1; i < siz.get_num_components(); ++i) {
+        ojph::point p1 = siz.get_downsampling(i);
+        all_same = all_same && (p1.x == p.x) && (p1.y == p.y);
+      }
+      if (!all_same)
+        OJPH_ERROR(0x0200000D,
+          "To save an image to ppm, all the components must have the "
+          "same downsampling ratio");
+      ojph::ui32 bit_depth[3];
+      for (ojph::ui32 c = 0; c < siz.get_num_components(); ++c)
+        bit_depth[c] = siz.get_bit_depth(c);
+      pfm.configure(siz.get_recon_width(0), siz.get_recon_height(0),
+        siz.get_num_components(), -1.0f, bit_depth);
+      pfm.open(output_filename);
+      base = &pfm;
+    }
+#ifdef OJPH_ENABLE_TIFF_SUPPORT
+    else if (is_matching(".tif", v) || is_matching(".tiff", v))
+    {
+      codestream.set_planar(false);
+      ojph::param_siz siz = codestream.access_siz();
+
+      bool all_same = true;
+      ojph::point p = siz.get_downsampling(0);
+      for (unsigned int i = 1; i < siz.get_num_components(); ++i)
+      {
+        ojph::point p1 = siz.get_downsampling(i);
+        all_same = all_same && (p1.x == p.x) && (p1.y == p.y);
+      }
+      if (!all_same)
+        OJPH_ERROR(0x02000005,
+          "To save an image to tif(f), all the components must have the "
+          "same downsampling ratio\n");
+      ojph::ui32 bit_depths[4] = { 0, 0, 0, 0 };
+      for (ojph::ui32 c = 0; c < siz.get_num_components(); c++)
+      {
+        bit_depths[c] = siz.get_bit_depth(c);
+      }
+      tif.configure(siz.get_recon_width(0), siz.get_recon_height(0),
+        siz.get_num_components(), bit_depths);
+      tif.open(output_filename);
+      base = &tif;
+    }
+#endif // !OJPH_ENABLE_TIFF_SUPPORT
+    else if (is_matching(".yuv", v))
+    {
+      codestream.set_planar(true);
+      ojph::param_siz siz = codestream.access_siz();
+
+      if (siz.get_num_components() != 3 && siz.get_num_components() != 1)
+        OJPH_ERROR(0x02000006,
+          "The file has %d color components; this cannot be saved to"
+           " .yuv file\n", siz.get_num_components());
+      ojph::param_cod cod = codestream.access_cod();
+      if (cod.is_using_color_transform())
+        OJPH_ERROR(0x02000007,
+          "The current implementation of yuv file object does not"
+          " support saving file when conversion from yuv to rgb is"
+          " needed; in any case, this is not the normal usage of yuv"
+          "file.");
+      ojph::ui32 comp_widths[3];
+      ojph::ui32 max_bit_depth = 0;
+      for (ojph::ui32 i = 0; i < siz.get_num_components(); ++i)
+      {
+        comp_widths[i] = siz.get_recon_width(i);
+        max_bit_depth = ojph_max(max_bit_depth, siz.get_bit_depth(i));
+      }
+      codestream.set_planar(true);
+      yuv.configure(max_bit_depth, siz.get_num_components(), comp_widths);
+      yuv.open(output_filename);
+      base = &yuv;
+    }
+    else if (is_matching(".raw", v))
+    {
+      ojph::param_siz siz = codestream.access_siz();
+
+      if (siz.get_num_components() != 1)
+        OJPH_ERROR(0x02000008,
+          "The file has %d color components; this cannot be saved to"
+          " .raw file (only one component is allowed).\n", 
+          siz.get_num_components());
+      bool is_signed = siz.is_signed(0);
+      ojph::ui32 width = siz.get_recon_width(0);
+      ojph::ui32 bit_depth = siz.get_bit_depth(0);
+      raw.configure(is_signed, bit_depth, width);
+      raw.open(output_filename);
+      base = &raw;
+    }
+    else if (ojph::get_packed_yuv_format(v) != ojph::PYF_UNKNOWN)
+    {
+      codestream.set_planar(true);
+      ojph::param_siz siz = codestream.access_siz();
+
+      if (siz.get_num_components() != 3)
+        OJPH_ERROR(0x02000031,
+          "The file has %d color components; this cannot be saved to"
+          " a %s file, which holds 3 components\n", 
+          siz.get_num_components(), v);
+      if (codestream.access_cod().is_using_color_transform())
+        OJPH_ERROR(0x02000032,
+          "The file employs a color transform; this is not supported"
+          " for %s files\n", v);
+      ojph::ui32 width = siz.get_recon_width(0);
+      ojph::ui32 height = siz.get_recon_height(0);
+      pyuv.configure(ojph::get_packed_yuv_format(v), width, height);
+      for (ojph::ui32 c = 0; c < 3; ++c)
+      {
+        ojph::point ds = pyuv.get_comp_subsampling(c);
+        if (siz.get_downsampling(c).x != ds.x 
+            || siz.get_downsampling(c).y != ds.y
+            || siz.get_recon_width(c) != ojph_div_ceil(width, ds.x)
+            || siz.get_recon_height(c) != ojph_div_ceil(height, ds.y))
+          OJPH_ERROR(0x02000033,
+            "The downsampling of component %d does not match that of %s"
+            " files\n", c, v);
+        if (siz.get_bit_depth(c) != pyuv.get_bit_depth() || siz.is_signed(c))
+          OJPH_ERROR(0x02000034,
+            "Component %d has %d-bit %s samples, but %s files hold %d-bit"
+            " unsigned samples\n", c, siz.get_bit_depth(c), 
+            siz.is_signed(c) ? "signed" : "unsigned", v, 
+            pyuv.get_bit_depth());
+      }
+      pyuv.open(output_filename);
+      base = &pyuv;
+    }
+    else
+#ifdef OJPH_ENABLE_TIFF_SUPPORT
+      OJPH_ERROR(0x02000009,
+        "unknown output file extension; only pgm, ppm, tif(f), raw(yuv),"
+        " v210, uyvy, nv12, p010, and p016 are supported\n");
+#else
+      OJPH_ERROR(0x0200000A,
+        "unknown output file extension; only pgm, ppm, raw(yuv), v210,"
+        " uyvy, nv12, p010, and p016 are supported\n");
+#endif // !OJPH_ENABLE_TIFF_SUPPORT
+  }
+  else
+    OJPH_ERROR(0x0200000B,
+      "Please supply a proper output filename with a proper extension\n");
+
+  codestream.create();
+
+  if (codestream.is_planar())
+  {
+    ojph::param_siz siz = codestream.access_siz();
+    for (ojph::ui32 c = 0; c < siz.get_num_components(); ++c)
+    {
+      ojph::ui32 height = siz.get_recon_height(c);
+      for (ojph::ui32 i = height; i > 0; --i)
+      {
+        ojph::ui32 comp_num;
+        ojph::line_buf *line = codestream.pull(comp_num);
+        assert(comp_num == c);
+        base->write(line, comp_num);
+      }
+    }
+  }
+  else
+  {
+    ojph::param_siz siz = codestream.access_siz();
+    ojph::ui32 height = siz.get_recon_height(0);
+    for (ojph::ui32 i = 0; i < height; ++i)
+    {
+      for (ojph::ui32 c = 0; c < siz.get_num_components(); ++c)
+      {
+        ojph::ui32 comp_num;
+        ojph::line_buf *line = codestream.pull(comp_num);
+        assert(comp_num == c);
+        base->write(line, comp_num);
+      }
+    }
+  }
+
+  base->close();
+  codestream.close();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Decodes the codestreams read from the standard input, which can hold
+// many, one after another, such as the codestreams of a sequence written
+// by ojph_compress.  The images are written one after another when 
+// output_filename is "-", which is the standard output, or to files named
+// using their frame number when output_filename holds a printf-style 
+// conversion, such as out_%05d.ppm; otherwise, the standard input must
+// hold one codestream.
+static
+void expand_stream(const char *output_filename, const char *ext,
+                   const expand_options& opts)
+{
+  ojph::stream_infile in;
+  in.open(0);
+  if (in.eof())
+    OJPH_ERROR(0x02000043, "The standard input holds no data\n");
+
+  bool numbered = strchr(output_filename, '%') != NULL;
+  bool to_stdout = ojph::is_standard_stream(output_filename);
+  for (ojph::ui32 frame_idx = 0; !in.eof(); ++frame_idx)
+  {
+    if (frame_idx > 0 && !numbered && !to_stdout)
+      OJPH_ERROR(0x02000044, "The standard input holds more than one "
+        "codestream; to decode them all, use -o - or an output file name "
+        "with a printf-style conversion, such as out_%%05d.ppm\n");
+    std::string name(output_filename); // writers can modify the name
+    if (numbered)
+    {
+      char buf[1024];
+      snprintf(buf, sizeof(buf), output_filename, (int)frame_idx);
+      name = buf;
+    }
+    expand_codestream(&in, &name[0], ext, opts);
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// Decodes the files of a batch; each thread of a batch owns one of these
+// objects.  A codestream is read into memory in one go, into a buffer that
+// is reused for all the files of the thread.
+class batch_expander : public ojph::batch::file_processor
+{
+public:
+  batch_expander() { opts = NULL; ext = NULL; }
+  ~batch_expander() override {}
+
+  void init(const expand_options *opts, const char *ext)
+  { this->opts = opts; this->ext = ext; }
+
+  void process(const char *input_filename,
+               const char *output_filename) override
+  {
+    FILE *f = fopen(input_filename, "rb");
+    if (f == NULL)
+      OJPH_ERROR(0x02000023, "Unable to open file %s\n", input_filename);
+    ojph::ojph_fseek(f, 0, SEEK_END);
+    ojph::si64 size = ojph::ojph_ftell(f);
+    ojph::ojph_fseek(f, 0, SEEK_SET);
+    size_t num_read = 0;
+    if (size > 0)
+    {
+      buffer.resize((size_t)size);
+      num_read = fread(buffer.data(), 1, (size_t)size, f);
+    }
+    fclose(f);
+    if (size <= 0 || num_read != (size_t)size)
+      OJPH_ERROR(0x02000024, "Unable to read file %s\n", input_filename);
+
+    ojph::mem_infile mem_file;
+    mem_file.open(buffer.data(), (size_t)size);
+    std::string name(output_filename); // writers can modify the name
+    expand_codestream(&mem_file, &name[0], ext, *opts);
+  }
+
+private:
+  const expand_options *opts;
+  const char *ext;                 // the extension of output files
+  std::vector<ojph::ui8> buffer;   // the codestream of the current file
+};
+
+/////////////////////////////////////////////////////////////////////////////
+// Decodes the files in the batch_source directory, or the files listed in
+// the batch_source list file, into the output_dir directory; output files
+// have the extension ext.
+static
+void expand_batch(const char *batch_source, const char *output_dir,
+                  const char *ext, const expand_options& opts,
+                  ojph::ui32 num_threads)
+{
+  static const char * const extensions[] =
+    { ".j2c", ".j2k", ".jph", NULL };
+
+  std::string dot_ext(ext[0] == '.' ? "" : ".");
+  dot_ext += ext;
+
+  std::vector<std::string> inputs, outputs;
+  ojph::batch::collect_files(batch_source, extensions, inputs);
+  for (size_t i = 0; i < inputs.size(); ++i)
+    outputs.push_back(ojph::batch::make_output_filename(output_dir,
+      inputs[i].c_str(), dot_ext.c_str()));
+  ojph::batch::check_output_filenames(inputs, outputs);
+
+  ojph::ui32 num_workers = ojph_max(num_threads, 1u);
+  num_workers = (ojph::ui32)ojph_min((size_t)num_workers, inputs.size());
+  std::vector<batch_expander> workers(num_workers);
+  std::vector<ojph::batch::file_processor*> processors(num_workers);
+  for (ojph::ui32 i = 0; i < num_workers; ++i)
+  {
+    workers[i].init(&opts, dot_ext.c_str());
+    processors[i] = &workers[i];
+  }
+
+  ojph::batch::batch_stats stats;
+  ojph::batch::run(inputs, outputs, processors.data(), num_workers, stats);
+  ojph::batch::print_stats(stats);
+  if (stats.num_failed)
+    OJPH_ERROR(0x02000025, "%u of %u files could not be decoded\n",
+      stats.num_failed, stats.num_files);
+}
+
 /////////////////////////////////////////////////////////////////////////////
 int main(int argc, char *argv[]) {
 
@@ -169,6 +577,15 @@ int main(int argc, char *argv[]) {
   ojph::ui32 skipped_res_for_read = 0;
   ojph::ui32 skipped_res_for_recon = 0;
   bool resilient = false;
+  bool use_mmap = false;
+  char *batch_source = NULL;
+  char *batch_ext = NULL;
+  char *stdout_ext = NULL;
+#ifdef OJPH_EMSCRIPTEN
+  ojph::ui32 num_threads = 1;
+#else
+  ojph::ui32 num_threads = std::thread::hardware_concurrency();
+#endif
 
   if (argc <= 1) {
     std::cout <<
@@ -190,17 +607,62 @@ int main(int argc, char *argv[]) {
     " -resilient <true | false> if 'true', the decoder will not exit when\n"
     "            running into recoverable errors in the codestream.\n"
     "            Default: 'false'.\n"
+    " -mmap      <true | false> if 'true', pgm, ppm, yuv, and raw output\n"
+    "            files are written through memory mappings, when the\n"
+    "            system supports it.  Default: 'false'.\n"
+    "\n"
+    "Images with 3 unsigned components, downsampled as 4:2:2 or 4:2:0, can\n"
+    "also be saved in the packed and semi-planar layouts of broadcast and\n"
+    "video equipment, selected by the extension of the output file: .v210\n"
+    "(4:2:2 10-bit), .uyvy (4:2:2 8-bit), .nv12 (4:2:0 8-bit), .p010\n"
+    "(4:2:0 10-bit), and .p016 (4:2:0 16-bit).\n"
+    "\n"
+    "Many files can be decoded by one invocation, in batch mode:\n"
+    " -batch     <directory | list file> decodes every j2c, j2k, or jph\n"
+    "            file in a directory, or every file named in a list file,\n"
+    "            which has one file name per line.  -i is not used, and -o\n"
+    "            names the output directory; each output file is named\n"
+    "            after its input file, and a batch in which two files\n"
+    "            would produce the same output name is rejected.\n"
+    " -batch_ext the extension of output files, such as ppm; it selects\n"
+    "            the output format, as the extension of -o does for a\n"
+    "            single file.\n"
+    " -num_threads (number of cores) the number of threads used to decode\n"
+    "            files concurrently.\n"
+    "\n"
+    "The standard input and output are named -, for use in pipelines:\n"
+    " -i -       reads codestreams from the standard input, which can hold\n"
+    "            many codestreams, one after another, such as those of a\n"
+    "            sequence encoded by ojph_compress.  Their images are\n"
+    "            written one after another to the standard output, or to\n"
+    "            files named using a printf-style conversion in the output\n"
+    "            file name, such as out_%05d.ppm.\n"
+    " -o -       writes to the standard output; messages are then written\n"
+    "            to the standard error.\n"
+    " -stdout_ext the extension that selects the format of the output\n"
+    "            written to the standard output, such as yuv; pfm and\n"
+    "            tif(f) files cannot be written there.\n"
     "\n"
     ;
     return -1;
   }
   if (!get_arguments(argc, argv, input_filename, output_filename,
                      skipped_res_for_read, skipped_res_for_recon,
-                     resilient))
+                     resilient, use_mmap, batch_source, batch_ext,
+                     stdout_ext, num_threads))
   {
     return -1;
   }
 
+  // messages go to the standard error when images go to the standard output
+  FILE *msg_file = stdout;
+  if (output_filename != NULL && ojph::is_standard_stream(output_filename))
+  {
+    ojph::set_info_stream(stderr);
+    ojph::set_warning_stream(stderr);
+    msg_file = stderr;
+  }
+
   clock_t begin = clock();
 
   try {
@@ -208,231 +670,65 @@ int main(int argc, char *argv[]) {
       OJPH_ERROR(0x02000001,
                  "Please provide an output file using the -o option\n");
 
-    ojph::j2c_infile j2c_file;
-    j2c_file.open(input_filename);
-    ojph::codestream codestream;
-
-    ojph::ppm_out ppm;
-    ojph::pfm_out pfm;
-    #ifdef OJPH_ENABLE_TIFF_SUPPORT
-    ojph::tif_out tif;
-    #endif /* OJPH_ENABLE_TIFF_SUPPORT */
-    ojph::yuv_out yuv;
-    ojph::raw_out raw;
-    ojph::image_out_base *base = NULL;
-    const char *v = get_file_extension(output_filename);
-    if (v)
-    {
-      if (resilient)
-        codestream.enable_resilience();
-      codestream.read_headers(&j2c_file);
-      codestream.restrict_input_resolution(skipped_res_for_read, 
-        skipped_res_for_recon);
-      ojph::param_siz siz = codestream.access_siz();
-
-      if (is_matching(".pgm", v))
-      {
+    expand_options opts;
+    opts.skipped_res_for_read = skipped_res_for_read;
+    opts.skipped_res_for_recon = skipped_res_for_recon;
+    opts.resilient = resilient;
+    opts.use_mmap = use_mmap;
 
-        if (siz.get_num_components() != 1)
-          OJPH_ERROR(0x02000002,
-            "The file has more than one color component, but .pgm can "
-            "contain only one color component\n");
-        ppm.configure(siz.get_recon_width(0), siz.get_recon_height(0),
-                      siz.get_num_components(), siz.get_bit_depth(0));
-        ppm.open(output_filename);
-        base = &ppm;
-      }
-      else if (is_matching(".ppm", v))
-      {
-        codestream.set_planar(false);
-        ojph::param_siz siz = codestream.access_siz();
-
-        if (siz.get_num_components() != 3)
-          OJPH_ERROR(0x02000003,
-            "The file has %d color components; this cannot be saved to"
-            " a .ppm file\n", siz.get_num_components());
-        bool all_same = true;
-        ojph::point p = siz.get_downsampling(0);
-        for (ojph::ui32 i = 1; i < siz.get_num_components(); ++i)
-        {
-          ojph::point p1 = siz.get_downsampling(i);
-          all_same = all_same && (p1.x == p.x) && (p1.y == p.y);
-        }
-        if (!all_same)
-          OJPH_ERROR(0x02000004,
-            "To save an image to ppm, all the components must have the "
-            "same downsampling ratio\n");
-        ppm.configure(siz.get_recon_width(0), siz.get_recon_height(0),
-                      siz.get_num_components(), siz.get_bit_depth(0));
-        ppm.open(output_filename);
-        base = &ppm;
-      }
-      else if (is_matching(".pfm", v))
-      {
-        OJPH_INFO(0x02000010, "Note: The .pfm implementation is "
-          "experimental.  Here, we are assuming that the original data is "
-          "floating-point numbers.");
-
-        codestream.set_planar(false);
-        ojph::param_siz siz = codestream.access_siz();
-
-        ojph::ui32 num_comps = siz.get_num_components();
-        if (num_comps != 3 && num_comps != 1)
-          OJPH_ERROR(0x0200000C,
-            "The file has %d color components; this cannot be saved to"
-            " a .pfm file", num_comps);
-        bool all_same = true;
-        ojph::point p = siz.get_downsampling(0);
-        for (ojph::ui32 i = 1; i < siz.get_num_components(); ++i) {
-          ojph::point p1 = siz.get_downsampling(i);
-          all_same = all_same && (p1.x == p.x) && (p1.y == p.y);
-        }
-        if (!all_same)
-          OJPH_ERROR(0x0200000D,
-            "To save an image to ppm, all the components must have the "
-            "same downsampling ratio");
-        ojph::ui32 bit_depth[3];
-        for (ojph::ui32 c = 0; c < siz.get_num_components(); ++c)
-          bit_depth[c] = siz.get_bit_depth(c);
-        pfm.configure(siz.get_recon_width(0), siz.get_recon_height(0),
-          siz.get_num_components(), -1.0f, bit_depth);
-        pfm.open(output_filename);
-        base = &pfm;
-      }
-#ifdef OJPH_ENABLE_TIFF_SUPPORT
-      else if (is_matching(".tif", v) || is_matching(".tiff", v))
-      {
-        codestream.set_planar(false);
-        ojph::param_siz siz = codestream.access_siz();
-
-        bool all_same = true;
-        ojph::point p = siz.get_downsampling(0);
-        for (unsigned int i = 1; i < siz.get_num_components(); ++i)
-        {
-          ojph::point p1 = siz.get_downsampling(i);
-          all_same = all_same && (p1.x == p.x) && (p1.y == p.y);
-        }
-        if (!all_same)
-          OJPH_ERROR(0x02000005,
-            "To save an image to tif(f), all the components must have the "
-            "same downsampling ratio\n");
-        ojph::ui32 bit_depths[4] = { 0, 0, 0, 0 };
-        for (ojph::ui32 c = 0; c < siz.get_num_components(); c++)
-        {
-          bit_depths[c] = siz.get_bit_depth(c);
-        }
-        tif.configure(siz.get_recon_width(0), siz.get_recon_height(0),
-          siz.get_num_components(), bit_depths);
-        tif.open(output_filename);
-        base = &tif;
-      }
-#endif // !OJPH_ENABLE_TIFF_SUPPORT
-      else if (is_matching(".yuv", v))
-      {
-        codestream.set_planar(true);
-        ojph::param_siz siz = codestream.access_siz();
-
-        if (siz.get_num_components() != 3 && siz.get_num_components() != 1)
-          OJPH_ERROR(0x02000006,
-            "The file has %d color components; this cannot be saved to"
-             " .yuv file\n", siz.get_num_components());
-        ojph::param_cod cod = codestream.access_cod();
-        if (cod.is_using_color_transform())
-          OJPH_ERROR(0x02000007,
-            "The current implementation of yuv file object does not"
-            " support saving file when conversion from yuv to rgb is"
-            " needed; in any case, this is not the normal usage of yuv"
-            "file.");
-        ojph::ui32 comp_widths[3];
-        ojph::ui32 max_bit_depth = 0;
-        for (ojph::ui32 i = 0; i < siz.get_num_components(); ++i)
-        {
-          comp_widths[i] = siz.get_recon_width(i);
-          max_bit_depth = ojph_max(max_bit_depth, siz.get_bit_depth(i));
-        }
-        codestream.set_planar(true);
-        yuv.configure(max_bit_depth, siz.get_num_components(), comp_widths);
-        yuv.open(output_filename);
-        base = &yuv;
-      }
-      else if (is_matching(".raw", v))
-      {
-        ojph::param_siz siz = codestream.access_siz();
-
-        if (siz.get_num_components() != 1)
-          OJPH_ERROR(0x02000008,
-            "The file has %d color components; this cannot be saved to"
-            " .raw file (only one component is allowed).\n", 
-            siz.get_num_components());
-        bool is_signed = siz.is_signed(0);
-        ojph::ui32 width = siz.get_recon_width(0);
-        ojph::ui32 bit_depth = siz.get_bit_depth(0);
-        raw.configure(is_signed, bit_depth, width);
-        raw.open(output_filename);
-        base = &raw;
-      }
-      else
-#ifdef OJPH_ENABLE_TIFF_SUPPORT
-        OJPH_ERROR(0x02000009,
-          "unknown output file extension; only pgm, ppm, tif(f) and raw(yuv))"
-          " are supported\n");
-#else
-        OJPH_ERROR(0x0200000A,
-          "unknown output file extension; only pgm, ppm, and raw(yuv) are"
-          " supported\n");
-#endif // !OJPH_ENABLE_TIFF_SUPPORT
+    if (batch_source != NULL)
+    {
+      if (input_filename != NULL)
+        OJPH_ERROR(0x02000021, "The -i and -batch options cannot be used "
+          "together\n");
+      if (batch_ext == NULL)
+        OJPH_ERROR(0x02000022, "Please provide the extension of output "
+          "files using the -batch_ext option\n");
+      expand_batch(batch_source, output_filename, batch_ext, opts,
+                   num_threads);
     }
     else
-      OJPH_ERROR(0x0200000B,
-        "Please supply a proper output filename with a proper extension\n");
-
-    codestream.create();
-
-    if (codestream.is_planar())
     {
-      ojph::param_siz siz = codestream.access_siz();
-      for (ojph::ui32 c = 0; c < siz.get_num_components(); ++c)
+      std::string ext;
+      if (ojph::is_standard_stream(output_filename))
       {
-        ojph::ui32 height = siz.get_recon_height(c);
-        for (ojph::ui32 i = height; i > 0; --i)
-        {
-          ojph::ui32 comp_num;
-          ojph::line_buf *line = codestream.pull(comp_num);
-          assert(comp_num == c);
-          base->write(line, comp_num);
-        }
+        if (stdout_ext == NULL)
+          OJPH_ERROR(0x02000041, "Please provide the format of the output"
+            " written to the standard output using the -stdout_ext "
+            "option\n");
+        ext = stdout_ext[0] == '.' ? "" : ".";
+        ext += stdout_ext;
+        if (is_matching(".pfm", ext.c_str()) 
+            || is_matching(".tif", ext.c_str())
+            || is_matching(".tiff", ext.c_str()))
+          OJPH_ERROR(0x02000042, "%s files cannot be written to the "
+            "standard output\n", ext.c_str());
       }
-    }
-    else
-    {
-      ojph::param_siz siz = codestream.access_siz();
-      ojph::ui32 height = siz.get_recon_height(0);
-      for (ojph::ui32 i = 0; i < height; ++i)
+      else
+        ext = get_file_extension(output_filename);
+
+      if (input_filename != NULL 
+          && ojph::is_standard_stream(input_filename))
+        expand_stream(output_filename, ext.c_str(), opts);
+      else
       {
-        for (ojph::ui32 c = 0; c < siz.get_num_components(); ++c)
-        {
-          ojph::ui32 comp_num;
-          ojph::line_buf *line = codestream.pull(comp_num);
-          assert(comp_num == c);
-          base->write(line, comp_num);
-        }
+        ojph::j2c_infile j2c_file;
+        j2c_file.open(input_filename);
+        expand_codestream(&j2c_file, output_filename, ext.c_str(), opts);
       }
     }
-
-    base->close();
-    codestream.close();
   }
   catch (const std::exception& e)
   {
     const char *p = e.what();
     if (strncmp(p, "ojph error", 10) != 0)
-      printf("%s\n", p);
+      fprintf(msg_file, "%s\n", p);
     exit(-1);
   }
 
   clock_t end = clock();
   double elapsed_secs = double(end - begin) / CLOCKS_PER_SEC;
-  printf("Elapsed time = %f\n", elapsed_secs);
+  fprintf(msg_file, "Elapsed time = %f\n", elapsed_secs);
 
   return 0;
 }
@@ -0,0 +1,548 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2024, Aous Naman
+// Copyright (c) 2024, Kakadu Software Pty Ltd, Australia
+// Copyright (c) 2024, The University of New South Wales, Australia
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: ojph_stream_compress.cpp
+// Author: Aous Naman
+// Date: 19 October 2026
+//***************************************************************************/
+
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <thread>
+#include "ojph_message.h"
+#include "ojph_arg.h"
+#include "ojph_sockets.h"
+#include "stream_compress_support.h"
+
+//////////////////////////////////////////////////////////////////////////////
+// maximum number of datagrams sent in one call to send_packets
+static const ojph::ui32 max_batch_size = 256;
+
+//////////////////////////////////////////////////////////////////////////////
+// RTP dynamic payload type used for the JPEG 2000 payload
+static const ojph::ui32 rtp_payload_type = 96;
+
+//////////////////////////////////////////////////////////////////////////////
+typedef std::chrono::steady_clock clock_type;
+
+/////////////////////////////////////////////////////////////////////////////
+struct size_interpreter : public ojph::cli_interpreter::arg_inter_base
+{
+  size_interpreter(ojph::size& val) : val(val) {}
+  virtual void operate(const char *str)
+  {
+    const char *next_char = str;
+    if (*next_char != '{')
+      throw "size must start with {";
+    next_char++;
+    char *endptr;
+    val.w = (ojph::ui32)strtoul(next_char, &endptr, 10);
+    if (endptr == next_char)
+      throw "size number is improperly formatted";
+    next_char = endptr;
+    if (*next_char != ',')
+      throw "size must have a "","" between the two numbers";
+    next_char++;
+    val.h = (ojph::ui32)strtoul(next_char, &endptr, 10);
+    if (endptr == next_char)
+      throw "number is improperly formatted";
+    next_char = endptr;
+    if (*next_char != '}')
+      throw "size must end with }";
+    next_char++;
+    if (*next_char != '\0') //must be end of string
+      throw "size has extra characters";
+  }
+  ojph::size& val;
+};
+
+/////////////////////////////////////////////////////////////////////////////
+struct point_interpreter : public ojph::cli_interpreter::arg_inter_base
+{
+  point_interpreter(ojph::point& val) : val(val) {}
+  virtual void operate(const char *str)
+  {
+    ojph::size t;
+    size_interpreter si(t);
+    si.operate(str);
+    val = ojph::point(t.w, t.h);
+  }
+  ojph::point& val;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// Sends num_packets packets to dest.  On Linux, a batch is sent with
+// sendmmsg in one system call; elsewhere, and for one packet, sendto is
+// called repeatedly.  Returns the number of sent datagrams, or -1 if none
+// is sent, in which case the socket's error is set.
+static
+int send_packets(ojph::net::socket& s, ojph::stcm::rtp_packet* packets,
+                 const struct sockaddr_in& dest, ojph::ui32 num_packets)
+{
+  assert(num_packets <= max_batch_size);
+#ifdef OJPH_OS_LINUX
+  if (num_packets > 1)
+  {
+    struct mmsghdr msgs[max_batch_size];
+    struct iovec iovs[max_batch_size];
+    memset(msgs, 0, sizeof(struct mmsghdr) * num_packets);
+    for (ojph::ui32 i = 0; i < num_packets; ++i)
+    {
+      iovs[i].iov_base = packets[i].data;
+      iovs[i].iov_len = packets[i].num_bytes;
+      msgs[i].msg_hdr.msg_iov = iovs + i;
+      msgs[i].msg_hdr.msg_iovlen = 1;
+      msgs[i].msg_hdr.msg_name = (void*)&dest;
+      msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+    }
+    return sendmmsg(s.intern(), msgs, num_packets, 0);
+  }
+#endif
+
+  int num = 0;
+  for (ojph::ui32 i = 0; i < num_packets; ++i)
+  {
+    int num_bytes = (int)sendto(s.intern(), (const char*)packets[i].data,
+      packets[i].num_bytes, 0, (const struct sockaddr*)&dest,
+      sizeof(struct sockaddr_in));
+    if (num_bytes < 0)
+      break;
+    ++num;
+  }
+  return num > 0 ? num : -1;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+static
+bool get_arguments(int argc, char *argv[],
+                   char *&input_template, ojph::ui32& num_files,
+                   ojph::ui32& num_frames,
+                   char *&dest_addr, char *&dest_port,
+                   float& fps, bool& burst, bool& unpaced, bool& live,
+                   ojph::ui32& payload_size, ojph::ui32& batch_size,
+                   ojph::ui32& send_buf_size,
+                   ojph::ui32& num_decompositions, float& quantization_step,
+                   bool& reversible, int& employ_color_transform,
+                   ojph::size& block_size, ojph::size& dims,
+                   ojph::ui32& num_comps, ojph::ui32& bit_depth,
+                   ojph::point& downsampling, bool& cb_cache, 
+                   bool& quiet)
+{
+  ojph::cli_interpreter interpreter;
+  interpreter.init(argc, argv);
+
+  interpreter.reinterpret("-i", input_template);
+  interpreter.reinterpret("-num_files", num_files);
+  interpreter.reinterpret("-num_frames", num_frames);
+  interpreter.reinterpret("-addr", dest_addr);
+  interpreter.reinterpret("-port", dest_port);
+  interpreter.reinterpret("-fps", fps);
+  interpreter.reinterpret("-payload_size", payload_size);
+  interpreter.reinterpret("-batch", batch_size);
+  interpreter.reinterpret("-send_buf_size", send_buf_size);
+  interpreter.reinterpret("-num_decomps", num_decompositions);
+  interpreter.reinterpret("-qstep", quantization_step);
+  interpreter.reinterpret("-reversible", reversible);
+  interpreter.reinterpret_to_bool("-colour_trans", employ_color_transform);
+  interpreter.reinterpret("-num_comps", num_comps);
+  interpreter.reinterpret("-bit_depth", bit_depth);
+
+  burst = interpreter.reinterpret("-burst");
+  unpaced = interpreter.reinterpret("-unpaced");
+  live = interpreter.reinterpret("-live");
+  cb_cache = interpreter.reinterpret("-cb_cache");
+  quiet = interpreter.reinterpret("-quiet");
+
+  size_interpreter block_interpreter(block_size);
+  size_interpreter dims_interpreter(dims);
+  point_interpreter downsamp_interpreter(downsampling);
+  try
+  {
+    interpreter.reinterpret("-block_size", &block_interpreter);
+    interpreter.reinterpret("-dims", &dims_interpreter);
+    interpreter.reinterpret("-downsamp", &downsamp_interpreter);
+  }
+  catch (const char *s)
+  {
+    printf("%s\n",s);
+    return false;
+  }
+
+  if (interpreter.is_exhausted() == false) {
+    printf("The following arguments were not interpreted:\n");
+    ojph::argument t = interpreter.get_argument_zero();
+    t = interpreter.get_next_avail_argument(t);
+    while (t.is_valid()) {
+      printf("%s\n", t.arg);
+      t = interpreter.get_next_avail_argument(t);
+    }
+    return false;
+  }
+
+  if (input_template == NULL)
+  {
+    printf("Please use \"-i\" to provide input files.\n");
+    return false;
+  }
+  if (dest_addr == NULL)
+  {
+    printf("Please use \"-addr\" to provide a destination address.\n");
+    return false;
+  }
+  if (dest_port == NULL)
+  {
+    printf("Please use \"-port\" to provide a port number.\n");
+    return false;
+  }
+  if (num_files < 1)
+  {
+    printf("Please set \"-num_files\" to 1 or more.\n");
+    return false;
+  }
+  if (fps <= 0.0f)
+  {
+    printf("Please set \"-fps\" to a positive number.\n");
+    return false;
+  }
+  if (payload_size < 1 ||
+      payload_size > (ojph::ui32)ojph::stcm::rtp_packet::max_payload_size)
+  {
+    printf("Please set \"-payload_size\" to a value between 1 and %d.\n",
+      ojph::stcm::rtp_packet::max_payload_size);
+    return false;
+  }
+  if (batch_size < 1 || batch_size > max_batch_size)
+  {
+    printf("Please set \"-batch\" to a value between 1 and %d.\n",
+      max_batch_size);
+    return false;
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+  char *input_template = NULL;
+  ojph::ui32 num_files = 1;
+  ojph::ui32 num_frames = 0;
+  char *dest_addr = NULL;
+  char *dest_port = NULL;
+  float fps = 30.0f;
+  bool burst = false;
+  bool unpaced = false;
+  bool live = false;
+  ojph::ui32 payload_size = 1400;
+  ojph::ui32 batch_size = 1;
+  ojph::ui32 send_buf_size = 0;
+  ojph::ui32 num_decompositions = 5;
+  float quantization_step = -1.0f;
+  bool reversible = false;
+  int employ_color_transform = -1;
+  ojph::size block_size(64, 64);
+  ojph::size dims(0, 0);
+  ojph::ui32 num_comps = 3;
+  ojph::ui32 bit_depth = 8;
+  ojph::point downsampling(1, 1);
+  bool cb_cache = false;
+  bool quiet = false;
+
+  if (argc <= 1) {
+    printf(
+    "\n"
+    "The following arguments are necessary:\n"
+    " -i             <input file name>; the same printf formating can be\n"
+    "                used, for example input_%%05d.j2c, where the index\n"
+    "                goes from 0 to -num_files minus 1. j2c/jph files\n"
+    "                are sent as they are; pgm, ppm, and yuv files are\n"
+    "                encoded first.\n"
+    " -addr          <destination IPv4 address>, for example 127.0.0.1\n"
+    " -port          <destination port>\n"
+    "\n"
+    "The following arguments are options:\n"
+    " -num_files     <integer> number of input files; default is 1.\n"
+    " -num_frames    <integer> number of frames to send, cycling through\n"
+    "                the input files; default is 0, which sends frames\n"
+    "                until the program is interrupted.\n"
+    " -fps           <float> frame rate; default is 30. This sets the\n"
+    "                pacing of frames, and the 90kHz RTP time stamps.\n"
+    " -burst         sends the packets of a frame back-to-back at the\n"
+    "                start of the frame period. By default, packets are\n"
+    "                spread evenly over the frame period, which reduces\n"
+    "                the likelihood of overflowing the receiver's buffer.\n"
+    " -unpaced       sends frames as fast as possible, to measure the\n"
+    "                throughput of the chain; time stamps still follow\n"
+    "                -fps.\n"
+    " -live          encodes images for every frame sent; by default,\n"
+    "                images are encoded once, before sending starts, and\n"
+    "                their codestreams are replayed.\n"
+    " -payload_size  <integer> maximum number of codestream bytes in a\n"
+    "                packet; default is 1400.\n"
+    " -batch         <integer> number of packets that can be sent in one\n"
+    "                system call; default is 1. It uses sendmmsg on\n"
+    "                Linux.\n"
+    " -send_buf_size <integer> sendto buffer size; by default the\n"
+    "                operating system's default is used.\n"
+    " -quiet         use to stop printing informative messages.\n"
+    "\n"
+    "The following arguments are used when encoding images:\n"
+    " -num_decomps   <integer> number of decompositions; default is 5.\n"
+    " -qstep         <float> quantization step size for lossy\n"
+    "                compression.\n"
+    " -reversible    <true | false> reversible compression; default is\n"
+    "                false.\n"
+    " -colour_trans  <true | false> employs a colour transform; the\n"
+    "                default is true for ppm files.\n"
+    " -block_size    {x,y} codeblock dimensions; default is {64,64}.\n"
+    " -dims          {x,y} the dimensions of yuv images.\n"
+    " -num_comps     <integer> number of components in yuv images;\n"
+    "                1 or 3, default is 3.\n"
+    " -bit_depth     <integer> bit depth of yuv images; default is 8.\n"
+    " -downsamp      {x,y} downsampling of the second and third yuv\n"
+    "                components; default is {1,1}. Use {2,2} for 4:2:0.\n"
+    " -cb_cache      with -live, codeblocks whose samples are unchanged\n"
+    "                from the previous encoding of the same location are\n"
+    "                not encoded again, and their earlier coded data are\n"
+    "                reused; this reduces the encoding time of mostly\n"
+    "                static content, without changing the codestreams.\n"
+    "\n"
+    );
+    exit(-1);
+  }
+  if (!get_arguments(argc, argv, input_template, num_files, num_frames,
+                     dest_addr, dest_port, fps, burst, unpaced, live,
+                     payload_size, batch_size, send_buf_size,
+                     num_decompositions, quantization_step, reversible,
+                     employ_color_transform, block_size, dims, num_comps,
+                     bit_depth, downsampling, cb_cache, quiet))
+  {
+    exit(-1);
+  }
+
+  ojph::mem_outfile* codestreams = NULL;
+  try {
+    ojph::net::socket_manager smanager;
+
+    // destination address/port
+    struct sockaddr_in dest;
+    {
+      memset(&dest, 0, sizeof(dest));
+      dest.sin_family = AF_INET;
+      const char *p = dest_addr;
+      const char localhost[] = "127.0.0.1";
+      if (strcmp(dest_addr, "localhost") == 0)
+        p = localhost;
+      int result = inet_pton(AF_INET, p, &dest.sin_addr);
+      if (result != 1)
+        OJPH_ERROR(0x02020001, "Please provide a valid IPv4 address when "
+          "using \"-addr,\" the provided address %s is not valid",
+          dest_addr);
+      ojph::ui16 port_number = 0;
+      port_number = (ojph::ui16)atoi(dest_port);
+      if (port_number == 0)
+        OJPH_ERROR(0x02020002, "Please provide a valid port number. "
+            "The number you provided is %s", dest_port);
+      dest.sin_port = htons(port_number);
+    }
+
+    // input files, which are encoded now unless -live is used
+    ojph::stcm::frame_encoder encoder;
+    encoder.set_coding_params(num_decompositions, quantization_step,
+      reversible, employ_color_transform, block_size);
+    encoder.set_yuv_props(dims, num_comps, bit_depth, downsampling);
+    encoder.enable_codeblock_cache(cb_cache);
+    char (*names)[256] = new char[num_files][256];
+    codestreams = new ojph::mem_outfile[num_files];
+    bool encode =
+      ojph::stcm::frame_encoder::is_supported(input_template);
+    for (ojph::ui32 i = 0; i < num_files; ++i)
+    {
+      snprintf(names[i], 256, input_template, i);
+      if (encode) {
+        if (!live)
+          encoder.encode(names[i], codestreams + i);
+      }
+      else
+      {
+        ojph::j2c_infile file;
+        file.open(names[i]);
+        file.seek(0, ojph::infile_base::OJPH_SEEK_END);
+        size_t size = (size_t)file.tell();
+        file.seek(0, ojph::infile_base::OJPH_SEEK_SET);
+        codestreams[i].open(size);
+        ojph::ui8 buf[4096];
+        size_t bytes;
+        while ((bytes = file.read(buf, sizeof(buf))) > 0)
+          codestreams[i].write(buf, bytes);
+        codestreams[i].close();
+        file.close();
+      }
+    }
+
+    // create a socket
+    ojph::net::socket s;
+    s = smanager.create_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if(s.intern() == OJPH_INVALID_SOCKET)
+    {
+      std::string err = smanager.get_last_error_message();
+      OJPH_ERROR(0x02020003, "Could not create socket: %s", err.data());
+    }
+
+    // change send buffer size
+    if (send_buf_size != 0 &&
+        ::setsockopt(s.intern(), SOL_SOCKET, SO_SNDBUF,
+                     (char*)&send_buf_size, sizeof(send_buf_size)) == -1)
+    {
+      std::string err = smanager.get_last_error_message();
+      OJPH_INFO(0x02020001,
+        "Failed to expand send buffer: %s", err.data());
+    }
+
+    // random initial sequence number, time stamp, and SSRC, as
+    // recommended by RFC 3550; the sequence number starts away from 0,
+    // because ojph_stream_expand reads 0 as not initialized
+    std::random_device rd;
+    std::mt19937 rng(rd());
+    ojph::ui32 first_seq = (ojph::ui32)(rng() & 0x7FFFFF) + 1;
+    ojph::ui32 first_time_stamp = (ojph::ui32)rng();
+    ojph::ui32 ssrc = (ojph::ui32)rng();
+    ojph::stcm::rtp_packetizer packetizer;
+    packetizer.init(rtp_payload_type, ssrc, first_seq, payload_size);
+
+    if (!quiet)
+      printf("Sending to %s, port %d\n", dest_addr, ntohs(dest.sin_port));
+
+    // send frames
+    const clock_type::duration period =
+      std::chrono::duration_cast<clock_type::duration>(
+        std::chrono::duration<double>(1.0 / fps));
+    clock_type::time_point start = clock_type::now();
+    clock_type::time_point frame_start = start;
+    clock_type::time_point last_report = start;
+    double encode_secs = 0.0;
+    ojph::ui64 total_packets = 0, total_bytes = 0, failed_packets = 0;
+    ojph::ui32 late_frames = 0, frame = 0;
+    for (; num_frames == 0 || frame < num_frames; ++frame)
+    {
+      ojph::ui32 idx = frame % num_files;
+      if (encode && live) {
+        clock_type::time_point t = clock_type::now();
+        encoder.encode(names[idx], codestreams + idx);
+        encode_secs += std::chrono::duration<double>(
+          clock_type::now() - t).count();
+      }
+
+      ojph::ui32 time_stamp = first_time_stamp
+        + (ojph::ui32)((double)frame * 90000.0 / fps + 0.5);
+      ojph::ui32 num_packets = packetizer.packetize(
+        codestreams[idx].get_data(), codestreams[idx].get_used_size(),
+        time_stamp);
+      ojph::stcm::rtp_packet* packets = packetizer.get_packets();
+
+      // a frame that cannot start on time starts now, and the schedule
+      // of later frames is moved with it
+      if (!unpaced && clock_type::now() > frame_start + period) {
+        frame_start = clock_type::now();
+        ++late_frames;
+      }
+
+      for (ojph::ui32 i = 0; i < num_packets; )
+      {
+        if (!unpaced)
+        {
+          clock_type::time_point t = frame_start;
+          if (!burst)
+            t += period * i / num_packets;
+          std::this_thread::sleep_until(t);
+        }
+        ojph::ui32 n = ojph_min(batch_size, num_packets - i);
+        int num_sent = send_packets(s, packets + i, dest, n);
+        if (num_sent < 0)
+        { // the packets are dropped
+          std::string err = smanager.get_last_error_message();
+          OJPH_INFO(0x02020002, "Failed to send data: %s", err.data());
+          num_sent = (int)n;
+          failed_packets += n;
+        }
+        for (int k = 0; k < num_sent; ++k)
+          total_bytes += packets[i + (ojph::ui32)k].num_bytes;
+        total_packets += (ojph::ui32)num_sent;
+        i += (ojph::ui32)num_sent;
+      }
+      frame_start += period;
+
+      if (!quiet && clock_type::now() - last_report > std::chrono::seconds(1))
+      {
+        last_report = clock_type::now();
+        double secs =
+          std::chrono::duration<double>(last_report - start).count();
+        printf("Sent frames %d, packets %lld, %.1f frames/s, %.1f Mbit/s, "
+          "late frames %d\n", frame + 1, (long long)total_packets,
+          (frame + 1) / secs, (double)total_bytes * 8.0 / secs / 1e6,
+          late_frames);
+      }
+    }
+    s.close();
+
+    if (!quiet) {
+      double secs =
+        std::chrono::duration<double>(clock_type::now() - start).count();
+      printf("Total frames %d, packets %lld, bytes %lld, elapsed %f s\n"
+        "%.1f frames/s, %.1f Mbit/s, late frames %d, failed packets %lld\n",
+        frame, (long long)total_packets, (long long)total_bytes, secs,
+        frame / secs, (double)total_bytes * 8.0 / secs / 1e6, late_frames,
+        (long long)failed_packets);
+      if (encode && live && frame > 0)
+        printf("Average encoding time %f ms\n", encode_secs * 1e3 / frame);
+      if (encode && cb_cache) {
+        ojph::ui64 hits = 0, misses = 0;
+        encoder.get_codeblock_cache_stats(hits, misses);
+        printf("Reused codeblocks %lld, encoded codeblocks %lld\n",
+          (long long)hits, (long long)misses);
+      }
+    }
+    delete[] names;
+    delete[] codestreams;
+  }
+  catch (const std::exception& e)
+  {
+    const char *p = e.what();
+    if (strncmp(p, "ojph error", 10) != 0)
+      printf("%s\n", p);
+    exit(-1);
+  }
+
+  return 0;
+}
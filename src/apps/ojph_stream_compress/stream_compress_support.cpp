@@ -0,0 +1,321 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2024, Aous Naman
+// Copyright (c) 2024, Kakadu Software Pty Ltd, Australia
+// Copyright (c) 2024, The University of New South Wales, Australia
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: stream_compress_support.cpp
+// Author: Aous Naman
+// Date: 19 October 2026
+//***************************************************************************/
+
+#include <cassert>
+#include <cctype>
+#include <cstring>
+#include "ojph_mem.h"
+#include "ojph_img_io.h"
+#include "ojph_codestream.h"
+#include "ojph_params.h"
+#include "ojph_message.h"
+#include "stream_compress_support.h"
+
+namespace ojph
+{
+namespace stcm
+{
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+void rtp_packet::set_header(ui32 type, bool marked, ui32 payload_type,
+                            ui32 seq_num, ui32 time_stamp, ui32 ssrc)
+{
+  // RTP header; version 2, no padding, no extension, no CSRC
+  data[0] = 0x80;
+  data[1] = (ui8)((marked ? 0x80 : 0) | (payload_type & 0x7F));
+  data[2] = (ui8)(seq_num >> 8);
+  data[3] = (ui8)seq_num;
+  data[4] = (ui8)(time_stamp >> 24);
+  data[5] = (ui8)(time_stamp >> 16);
+  data[6] = (ui8)(time_stamp >> 8);
+  data[7] = (ui8)time_stamp;
+  data[8] = (ui8)(ssrc >> 24);
+  data[9] = (ui8)(ssrc >> 16);
+  data[10] = (ui8)(ssrc >> 8);
+  data[11] = (ui8)ssrc;
+
+  // payload header; MH, TP = 0 (progressive frame), and ORDH = 0 for main
+  // packets, or RES = 0 for body packets.  PTSTAMP is not used, and
+  // therefore, for body packets, ORDH, QUAL, POS, and PID are all 0.
+  // For main packets, XTRAC is 0, and R, S, C, RANGE, PRIMS, TRANS, and
+  // MAT are all 0.  The 8 MSBs of the extended sequence number are in ESEQ.
+  data[12] = (ui8)(type << 6);
+  data[13] = data[14] = 0;
+  data[15] = (ui8)(seq_num >> 16);
+  data[16] = data[17] = data[18] = data[19] = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void rtp_packet::set_payload(const ui8* data, size_t size)
+{
+  assert(size <= (size_t)max_payload_size);
+  memcpy(this->data + header_size, data, size);
+  num_bytes = (ui32)size + header_size;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+void rtp_packetizer::init(ui32 payload_type, ui32 ssrc, ui32 seq_num,
+                          ui32 max_payload_size)
+{
+  assert(max_payload_size > 0 &&
+         max_payload_size <= (ui32)rtp_packet::max_payload_size);
+  this->payload_type = payload_type;
+  this->ssrc = ssrc;
+  this->seq_num = seq_num & 0xFFFFFF;
+  this->max_payload_size = max_payload_size;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+size_t rtp_packetizer::find_main_header_length(const ui8* data, size_t size)
+{
+  // skip SOC, then marker segments until SOT is found
+  size_t pos = 2;
+  while (pos + 4 <= size)
+  {
+    if (data[pos] != 0xFF)
+      break;  // not a marker; this is a corrupt codestream
+    if (data[pos + 1] == 0x90) // SOT
+      return pos;
+    ui32 len = ((ui32)data[pos + 2] << 8) | (ui32)data[pos + 3];
+    pos += 2 + len;
+  }
+  return size;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void rtp_packetizer::add_packet(ui32 type, bool marked, const ui8* data,
+                                size_t size, ui32 time_stamp)
+{
+  if (num_packets >= packets.size())
+    packets.resize(num_packets + 1);
+  rtp_packet& p = packets[num_packets++];
+  p.set_header(type, marked, payload_type, seq_num, time_stamp, ssrc);
+  p.set_payload(data, size);
+  seq_num = (seq_num + 1) & 0xFFFFFF;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+ui32 rtp_packetizer::packetize(const ui8* data, size_t size, ui32 time_stamp)
+{
+  assert(max_payload_size > 0);
+  num_packets = 0;
+
+  // main packets; the main header of a large codestream can span more
+  // than one main packet
+  size_t main_size = find_main_header_length(data, size);
+  size_t pos = 0;
+  while (pos < main_size)
+  {
+    size_t bytes = ojph_min((size_t)max_payload_size, main_size - pos);
+    bool last_main = pos + bytes == main_size;
+    ui32 type = rtp_packet::PT_MAIN_FOLLOWED_BY_MAIN;
+    if (last_main)
+      type = main_size == size ? rtp_packet::PT_MAIN
+                               : rtp_packet::PT_MAIN_FOLLOWED_BY_BODY;
+    add_packet(type, pos + bytes == size, data + pos, bytes, time_stamp);
+    pos += bytes;
+  }
+
+  // body packets
+  while (pos < size)
+  {
+    size_t bytes = ojph_min((size_t)max_payload_size, size - pos);
+    add_packet(rtp_packet::PT_BODY, pos + bytes == size, data + pos, bytes,
+      time_stamp);
+    pos += bytes;
+  }
+
+  return num_packets;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/////////////////////////////////////////////////////////////////////////////
+static
+const char* get_file_extension(const char* filename)
+{
+  size_t len = strlen(filename);
+  const char* p = strrchr(filename, '.');
+  if (p == NULL || p == filename + len - 1)
+    return NULL;
+  return p;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+static
+bool is_matching(const char *ref, const char *other)
+{
+  size_t num_ele = strlen(ref);
+
+  if (num_ele != strlen(other))
+    return false;
+
+  for (ui32 i = 0; i < num_ele; ++i)
+    if (ref[i] != other[i] && ref[i] != tolower(other[i]))
+      return false;
+
+  return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool frame_encoder::is_supported(const char *filename)
+{
+  const char *v = get_file_extension(filename);
+  return v && (is_matching(".pgm", v) || is_matching(".ppm", v)
+            || is_matching(".yuv", v));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void frame_encoder::encode(const char *filename, mem_outfile *out)
+{
+  codestream codestream;
+  ppm_in ppm;
+  yuv_in yuv;
+  image_in_base *base = NULL;
+
+  const char *v = get_file_extension(filename);
+  param_siz siz = codestream.access_siz();
+  if (v && (is_matching(".pgm", v) || is_matching(".ppm", v)))
+  {
+    ppm.open(filename);
+    siz.set_image_extent(point(ppm.get_width(), ppm.get_height()));
+    ui32 num_comps = ppm.get_num_components();
+    siz.set_num_components(num_comps);
+    for (ui32 c = 0; c < num_comps; ++c)
+      siz.set_component(c, ppm.get_comp_subsampling(c),
+        ppm.get_bit_depth(c), ppm.get_is_signed(c));
+    codestream.set_planar(false);
+    base = &ppm;
+  }
+  else if (v && is_matching(".yuv", v))
+  {
+    if (yuv_dims.w == 0 || yuv_dims.h == 0 || yuv_num_comps == 0)
+      OJPH_ERROR(0x02010001, "the dimensions and the number of components "
+        "of yuv files must be provided");
+    point ds[3] = { point(1, 1), yuv_downsampling, yuv_downsampling };
+    ui32 bit_depth = yuv_bit_depth;
+    yuv.set_img_props(yuv_dims, yuv_num_comps, 3, ds);
+    yuv.set_bit_depth(1, &bit_depth);
+    siz.set_image_extent(point(yuv_dims.w, yuv_dims.h));
+    siz.set_num_components(yuv_num_comps);
+    for (ui32 c = 0; c < yuv_num_comps; ++c)
+      siz.set_component(c, ds[c], yuv_bit_depth, false);
+    codestream.set_planar(true);
+    yuv.open(filename);
+    base = &yuv;
+  }
+  else
+    OJPH_ERROR(0x02010002, "unsupported input file %s; only pgm, ppm, "
+      "and yuv files can be encoded", filename);
+
+  param_cod cod = codestream.access_cod();
+  cod.set_num_decomposition(num_decompositions);
+  cod.set_block_dims(block_size.w, block_size.h);
+  cod.set_progression_order("RPCL");
+  if (employ_color_transform == -1)
+    cod.set_color_transform(siz.get_num_components() == 3
+                            && !codestream.is_planar());
+  else
+    cod.set_color_transform(employ_color_transform == 1);
+  cod.set_reversible(reversible);
+  if (!reversible && quantization_step != -1.0f)
+    codestream.access_qcd().set_irrev_quant(quantization_step);
+
+  if (use_cb_cache)
+    codestream.set_codeblock_cache(&cb_cache);
+  out->open();
+  codestream.write_headers(out);
+
+  ui32 next_comp;
+  line_buf* cur_line = codestream.exchange(NULL, next_comp);
+  if (codestream.is_planar())
+  {
+    for (ui32 c = 0; c < siz.get_num_components(); ++c)
+    {
+      point p = siz.get_downsampling(c);
+      ui32 height = ojph_div_ceil(siz.get_image_extent().y, p.y);
+      for (ui32 i = height; i > 0; --i)
+      {
+        assert(c == next_comp);
+        base->read(cur_line, next_comp);
+        cur_line = codestream.exchange(cur_line, next_comp);
+      }
+    }
+  }
+  else
+  {
+    ui32 height = siz.get_image_extent().y;
+    for (ui32 i = 0; i < height; ++i)
+    {
+      for (ui32 c = 0; c < siz.get_num_components(); ++c)
+      {
+        assert(c == next_comp);
+        base->read(cur_line, next_comp);
+        cur_line = codestream.exchange(cur_line, next_comp);
+      }
+    }
+  }
+
+  codestream.flush();
+  codestream.close();
+  base->close();
+}
+
+} // !stcm namespace
+} // !ojph namespace
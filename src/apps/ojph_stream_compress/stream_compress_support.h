@@ -0,0 +1,311 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2024, Aous Naman
+// Copyright (c) 2024, Kakadu Software Pty Ltd, Australia
+// Copyright (c) 2024, The University of New South Wales, Australia
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: stream_compress_support.h
+// Author: Aous Naman
+// Date: 19 October 2026
+//***************************************************************************/
+
+#ifndef OJPH_STR_CM_SUPPORT_H
+#define OJPH_STR_CM_SUPPORT_H
+
+#include <cassert>
+#include <vector>
+#include "ojph_base.h"
+#include "ojph_file.h"
+#include "ojph_codestream.h"
+#include "ojph_sockets.h"
+
+namespace ojph
+{
+namespace stcm // stream compress
+{
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*****************************************************************************/
+/** @brief builds the RTP header and payload of packets to be sent.
+ *
+ *  This object writes the RFC 3550 header and the RFC 9828 payload header
+ *  in the layout interpreted by ojph_stream_expand's rtp_packet; the
+ *  codestream follows the 20 bytes of headers.
+ */
+struct rtp_packet
+{
+  /**
+   *  @brief packet types based on the main header of RFC 9828
+   */
+  enum packet_type : ui32
+  {
+    PT_BODY                  = 0, // this is body packet
+    PT_MAIN_FOLLOWED_BY_MAIN = 1,
+    PT_MAIN_FOLLOWED_BY_BODY = 2,
+    PT_MAIN                  = 3, // frame has only one main packet
+  };
+public:
+  /**
+   *  @brief default constructor
+   */
+  rtp_packet() { num_bytes = 0; }
+
+public:
+  /**
+   *  @brief writes the RTP header and the payload header.
+   *
+   *  Only the fields needed by a receiver to reassemble frames are used;
+   *  the payload header signals no progression order (ORDH = 0), no
+   *  colorimetry, and no codeblock caching.
+   *
+   *  @param type is one of packet_type
+   *  @param marked is true for the last packet of a frame
+   *  @param payload_type is the RTP payload type
+   *  @param seq_num is the 24-bit extended sequence number
+   *  @param time_stamp is the 90kHz RTP time stamp
+   *  @param ssrc is the synchronization source identifier
+   */
+  void set_header(ui32 type, bool marked, ui32 payload_type, ui32 seq_num,
+                  ui32 time_stamp, ui32 ssrc);
+
+  /**
+   *  @brief copies the payload into the packet, and sets num_bytes
+   *
+   *  @param data points to the codestream bytes
+   *  @param size is the number of bytes; must not exceed max_payload_size
+   */
+  void set_payload(const ui8* data, size_t size);
+
+public:
+  static constexpr int header_size = 20;   //!<RTP and payload headers
+  static constexpr int max_size = 2048;    //!<maximum packet size, the
+                                           // same as in the receiver
+  static constexpr int max_payload_size = max_size - header_size;
+  ui8 data[max_size];                      //!<data in the packet
+  ui32 num_bytes;                          //!<number of bytes
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*****************************************************************************/
+/** @brief Splits j2k codestreams into RTP packets
+ *
+ *  The main header of a codestream is carried by main packets, and the
+ *  rest of the codestream by body packets; the last packet of a frame is
+ *  marked.  Consecutive frames use consecutive sequence numbers.
+ */
+class rtp_packetizer
+{
+public:
+  /**
+   *  @brief default constructor
+   */
+  rtp_packetizer()
+  {
+    payload_type = ssrc = seq_num = 0;
+    max_payload_size = 0;
+    num_packets = 0;
+  }
+
+public:
+  /**
+   *  @brief call this function to initialize the object
+   *
+   *  @param payload_type is the RTP payload type, a dynamic type
+   *  @param ssrc is the synchronization source identifier
+   *  @param seq_num is the sequence number of the first packet
+   *  @param max_payload_size is the maximum number of codestream bytes
+   *         in one packet
+   */
+  void init(ui32 payload_type, ui32 ssrc, ui32 seq_num,
+            ui32 max_payload_size);
+
+  /**
+   *  @brief packetizes one codestream
+   *
+   *  @param data is the codestream
+   *  @param size is the codestream size
+   *  @param time_stamp is the frame's RTP time stamp
+   *  @return the number of packets, which are obtained with get_packets
+   */
+  ui32 packetize(const ui8* data, size_t size, ui32 time_stamp);
+
+  /**
+   *  @brief returns the packets of the last call to packetize
+   */
+  rtp_packet* get_packets() { return packets.data(); }
+
+private:
+  /**
+   *  @brief finds the length of the main header of a codestream
+   *
+   *  The main header ends with the first SOT marker; if none is found,
+   *  the whole codestream is considered a main header.
+   */
+  static size_t find_main_header_length(const ui8* data, size_t size);
+
+  /**
+   *  @brief fills the next packet, enlarging packets as needed
+   */
+  void add_packet(ui32 type, bool marked, const ui8* data, size_t size,
+                  ui32 time_stamp);
+
+private:
+  ui32 payload_type;               //!<RTP payload type
+  ui32 ssrc;                       //!<synchronization source identifier
+  ui32 seq_num;                    //!<next sequence number, 24 bits
+  ui32 max_payload_size;           //!<maximum codestream bytes per packet
+  ui32 num_packets;                //!<number of packets of current frame
+  std::vector<rtp_packet> packets; //!<packets of current frame
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*****************************************************************************/
+/** @brief Encodes images into j2k codestreams held in memory
+ *
+ *  Input images are pgm, ppm, or yuv files; yuv files are unsigned, and
+ *  their geometry must be set using set_yuv_props.
+ */
+class frame_encoder
+{
+public:
+  /**
+   *  @brief default constructor
+   */
+  frame_encoder()
+  {
+    num_decompositions = 5;
+    quantization_step = -1.0f;
+    reversible = false;
+    employ_color_transform = -1;
+    block_size = size(64, 64);
+    yuv_num_comps = 0;
+    yuv_bit_depth = 8;
+    yuv_downsampling = point(1, 1);
+    use_cb_cache = false;
+  }
+
+public:
+  /**
+   *  @brief sets coding parameters; see ojph_compress for their meaning
+   */
+  void set_coding_params(ui32 num_decompositions, float quantization_step,
+                         bool reversible, int employ_color_transform,
+                         const size& block_size)
+  {
+    this->num_decompositions = num_decompositions;
+    this->quantization_step = quantization_step;
+    this->reversible = reversible;
+    this->employ_color_transform = employ_color_transform;
+    this->block_size = block_size;
+  }
+
+  /**
+   *  @brief sets the geometry of yuv files
+   *
+   *  @param dims is the width and height of the first component
+   *  @param num_comps is the number of components
+   *  @param bit_depth is the bit depth of all components
+   *  @param downsampling is the downsampling of components other than
+   *         the first component
+   */
+  void set_yuv_props(const size& dims, ui32 num_comps, ui32 bit_depth,
+                     const point& downsampling)
+  {
+    yuv_dims = dims;
+    yuv_num_comps = num_comps;
+    yuv_bit_depth = bit_depth;
+    yuv_downsampling = downsampling;
+  }
+
+  /**
+   *  @brief when enabled, codeblocks whose samples are unchanged from the
+   *         previous encoding are not encoded again; their earlier coded
+   *         data are reused
+   */
+  void enable_codeblock_cache(bool enable) { use_cb_cache = enable; }
+
+  /**
+   *  @brief returns the number of reused and encoded codeblocks
+   */
+  void get_codeblock_cache_stats(ui64& hits, ui64& misses) const
+  { cb_cache.get_stats(hits, misses); }
+
+  /**
+   *  @brief returns true if the file name has an extension this object
+   *         can encode
+   */
+  static bool is_supported(const char *filename);
+
+  /**
+   *  @brief encodes an image into a codestream
+   *
+   *  @param filename is the name of an image file
+   *  @param out receives the codestream; it is opened by this function
+   */
+  void encode(const char *filename, mem_outfile *out);
+
+private:
+  ui32 num_decompositions;         //!<number of wavelet decompositions
+  float quantization_step;         //!<quantization step, lossy only
+  bool reversible;                 //!<true for reversible coding
+  int employ_color_transform;      //!<-1 for default, 0 or 1
+  size block_size;                 //!<codeblock dimensions
+  size yuv_dims;                   //!<yuv image dimensions
+  ui32 yuv_num_comps;              //!<number of yuv components
+  ui32 yuv_bit_depth;              //!<bit depth of yuv components
+  point yuv_downsampling;          //!<downsampling of components 1 and 2
+  bool use_cb_cache;               //!<true to reuse unchanged codeblocks
+  codeblock_cache cb_cache;        //!<codeblocks of earlier encodings
+};
+
+} // !stcm namespace
+} // !ojph namespace
+
+#endif // !OJPH_STR_CM_SUPPORT_H
@@ -35,7 +35,11 @@
 // Date: 17 April 2024
 //***************************************************************************/
 
+#include <cassert>
+#include <cstring>
 #include <iostream>
+#include <thread>
+#include <vector>
 #include "ojph_message.h"
 #include "ojph_arg.h"
 #include "ojph_sockets.h"
@@ -43,11 +47,335 @@
 #include "stream_expand_support.h"
 
 #ifdef OJPH_OS_WINDOWS
-
+  #include <io.h>
+  #include <fcntl.h>
 #else
   #include <arpa/inet.h>
 #endif
 
+//////////////////////////////////////////////////////////////////////////////
+// maximum number of datagrams received in one call to receive_packets
+static const ojph::ui32 max_batch_size = 256;
+
+//////////////////////////////////////////////////////////////////////////////
+// maximum number of streams received concurrently
+static const ojph::ui32 max_num_streams = 64;
+
+//////////////////////////////////////////////////////////////////////////////
+// Receives up to num_packets datagrams into packets, setting the num_bytes
+// of each received packet, and the source address of each in sources.
+// On Linux, a batch is received with recvmmsg in one system call;
+// elsewhere, and for one packet, recvfrom is called repeatedly, where only
+// the first call can block -- on Windows, a blocking socket receives one
+// datagram.  Returns the number of received datagrams, or -1 if none is
+// received, in which case the socket's error is set.
+static
+int receive_packets(ojph::net::socket& s, ojph::stex::rtp_packet** packets,
+                    struct sockaddr_in* sources, ojph::ui32 num_packets,
+                    bool blocking)
+{
+  assert(num_packets <= max_batch_size);
+#ifdef OJPH_OS_LINUX
+  if (num_packets > 1)
+  {
+    struct mmsghdr msgs[max_batch_size];
+    struct iovec iovs[max_batch_size];
+    memset(msgs, 0, sizeof(struct mmsghdr) * num_packets);
+    for (ojph::ui32 i = 0; i < num_packets; ++i)
+    {
+      iovs[i].iov_base = packets[i]->data;
+      iovs[i].iov_len = packets[i]->max_size;
+      msgs[i].msg_hdr.msg_iov = iovs + i;
+      msgs[i].msg_hdr.msg_iovlen = 1;
+      msgs[i].msg_hdr.msg_name = sources + i;
+      msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+    }
+    int num = recvmmsg(s.intern(), msgs, num_packets, MSG_WAITFORONE, NULL);
+    for (int i = 0; i < num; ++i)
+      packets[i]->num_bytes = msgs[i].msg_len;
+    return num;
+  }
+#endif
+
+  int num = 0;
+  for (ojph::ui32 i = 0; i < num_packets; ++i)
+  {
+    socklen_t socklen = sizeof(struct sockaddr_in);
+#ifdef OJPH_OS_WINDOWS
+    int flags = 0; // no per-call non-blocking flag
+#else
+    ojph_unused(blocking);
+    int flags = i > 0 ? MSG_DONTWAIT : 0;
+#endif
+    int num_bytes = (int)recvfrom(s.intern(), (char*)packets[i]->data,
+      packets[i]->max_size, flags, (struct sockaddr*)(sources + i), 
+      &socklen);
+    if (num_bytes < 0)
+      break;
+    packets[i]->num_bytes = (ojph::ui32)num_bytes;
+    ++num;
+#ifdef OJPH_OS_WINDOWS
+    if (blocking) // cannot avoid blocking after the first
+      break;
+#endif
+  }
+  return num > 0 ? num : -1;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// The state of one receiving thread.  Each receiver has its own socket, 
+// and its own packets_handler and frames_handler, and therefore receives
+// one stream.  When more than one stream is received, sockets share the
+// listening address/port using SO_REUSEPORT, and a receiver connects its
+// socket to the source of the first packet it receives; from then on, the
+// operating system delivers that source's packets only to this socket, and
+// other sources to sockets that are not connected yet.
+struct stream_receiver
+{
+  stream_receiver()
+  {
+    index = 0;
+    smanager = NULL;
+    saddr = 0;
+    sport = 0;
+    connect_to_source = multiple = false;
+    batch_size = 1;
+    blocking = quiet = false;
+    stats_file = NULL;
+    ignored_packets = 0;
+    target_name[0] = '\0';
+  }
+
+  ojph::ui32 index;                   // stream index, for messages
+  ojph::net::socket s;                // receiving socket
+  ojph::net::socket_manager* smanager;// for error messages
+  ojph::ui32 saddr;                   // accepted source address, or 0
+  ojph::ui16 sport;                   // accepted source port (network 
+                                      // order), or 0
+  bool connect_to_source;             // connect to the first source
+  bool multiple;                      // more than one stream is received
+  ojph::ui32 batch_size;              // datagrams per receive call
+  bool blocking;                      // the socket is blocking
+  bool quiet;                         // no informative messages
+  FILE* stats_file;                   // receives JSON statistics, or NULL
+  ojph::ui32 ignored_packets;         // packets from other sources
+  char target_name[256];              // target_name of this stream
+  ojph::stex::frames_handler frames_handler;
+  ojph::stex::packets_handler packets_handler;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// Appends the JSON members of one latency histogram to buf, returning the
+// number of characters written
+static
+int print_histogram_json(char* buf, size_t size, const char* name,
+                         const ojph::stex::latency_histogram& h)
+{
+  int n = snprintf(buf, size, "\"%s\":{\"count\":%llu,\"mean_us\":%.1f,"
+    "\"p50_us\":%.1f,\"p90_us\":%.1f,\"p99_us\":%.1f,\"max_us\":%.1f,"
+    "\"bins\":[", name, (unsigned long long)h.count, h.get_mean_us(),
+    h.get_percentile_us(50.0), h.get_percentile_us(90.0),
+    h.get_percentile_us(99.0), (double)h.max_ns / 1000.0);
+  for (int i = 0; i < h.num_bins && n > 0 && (size_t)n < size; ++i)
+    n += snprintf(buf + n, size - (size_t)n, i ? ",%llu" : "%llu",
+      (unsigned long long)h.bins[i]);
+  if (n > 0 && (size_t)n < size)
+    n += snprintf(buf + n, size - (size_t)n, "]}");
+  return n;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// Prints the statistics of a stream, and writes them as one JSON line to
+// the stats file, if there is one.  The line is written in one call, so
+// that lines from different streams are not interleaved.
+static
+void report_stats(stream_receiver* r, const char* prefix)
+{
+  ojph::ui32 lost_packets = r->packets_handler.get_num_lost_packets();
+  ojph::ui32 dropped_packets = r->packets_handler.get_num_dropped_packets();
+  ojph::ui32 total_frames = 0, trunc_frames = 0, lost_frames = 0;
+  r->frames_handler.get_stats(total_frames, trunc_frames, lost_frames);
+  ojph::stex::frame_latency_stats lat;
+  r->frames_handler.get_latency_stats(lat);
+
+  if (!r->quiet)
+  {
+    printf("%sTotal frame %d, truncated frames %d, lost frames %d, "
+      "packets lost %d, packets dropped %d, packets ignored %d\n", prefix,
+      total_frames, trunc_frames, lost_frames, lost_packets, 
+      dropped_packets, r->ignored_packets);
+    printf("%sAssembly ms: mean %.3f, p50 %.3f, p99 %.3f, max %.3f; "
+      "processing ms: mean %.3f, p50 %.3f, p99 %.3f, max %.3f; "
+      "jitter ms %.3f\n", prefix,
+      lat.assembly.get_mean_us() / 1000.0,
+      lat.assembly.get_percentile_us(50.0) / 1000.0,
+      lat.assembly.get_percentile_us(99.0) / 1000.0,
+      (double)lat.assembly.max_ns / 1e6,
+      lat.processing.get_mean_us() / 1000.0,
+      lat.processing.get_percentile_us(50.0) / 1000.0,
+      lat.processing.get_percentile_us(99.0) / 1000.0,
+      (double)lat.processing.max_ns / 1e6,
+      lat.jitter_us / 1000.0);
+  }
+
+  if (r->stats_file)
+  {
+    constexpr size_t buf_size = 2048;
+    char buf[buf_size];
+    int n = snprintf(buf, buf_size, "{\"stream\":%d,\"time_ms\":%.3f,"
+      "\"total_frames\":%d,\"truncated_frames\":%d,\"lost_frames\":%d,"
+      "\"lost_packets\":%d,\"dropped_packets\":%d,"
+      "\"ignored_packets\":%d,\"jitter_us\":%.1f,",
+      r->index, (double)ojph::stex::get_steady_time_ns() / 1e6, 
+      total_frames, trunc_frames, lost_frames, lost_packets, 
+      dropped_packets, r->ignored_packets, lat.jitter_us);
+    n += print_histogram_json(buf + n, buf_size - (size_t)n, "assembly",
+      lat.assembly);
+    buf[n++] = ',';
+    n += print_histogram_json(buf + n, buf_size - (size_t)n, "processing",
+      lat.processing);
+    buf[n++] = ',';
+    n += print_histogram_json(buf + n, buf_size - (size_t)n, "total",
+      lat.total);
+    snprintf(buf + n, buf_size - (size_t)n, "}\n");
+    fputs(buf, r->stats_file);
+    fflush(r->stats_file);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// Receives packets of one stream, and forwards them to the receiver's 
+// packets_handler; this function does not return.
+static
+void receive_stream(stream_receiver* r)
+{
+  ojph::net::socket& s = r->s;
+  ojph::net::socket_manager& smanager = *r->smanager;
+  ojph::stex::packets_handler& packets_handler = r->packets_handler;
+  const ojph::ui32 batch_size = r->batch_size;
+  const bool quiet = r->quiet;
+
+  // stream messages start with the stream index if there is more than one
+  char prefix[32] = "";
+  if (r->multiple)
+    snprintf(prefix, sizeof(prefix), "Stream %d: ", r->index);
+
+  // listen to incoming data, and forward it to packet_handler
+  struct sockaddr_in sources[max_batch_size];
+  bool src_printed = false;
+  ojph::stex::rtp_packet* packets[max_batch_size] = { NULL };
+  ojph::ui32 last_time_stamp = 0;
+  while (1)
+  {
+    // hand received packets over, in the order they were received, and
+    // obtain packets for the next batch
+    for (ojph::ui32 i = 0; i < batch_size; ++i) {
+      packets[i] = packets_handler.exchange(packets[i]);
+      assert(packets[i] != NULL); // num_inflight_packets > batch_size
+      packets[i]->num_bytes = 0;
+    }
+
+    // receive data
+    int num_packets = receive_packets(s, packets, sources, batch_size,
+      r->blocking);
+
+    // packets of a batch share one reception time
+    if (num_packets > 0) {
+      ojph::ui64 now = ojph::stex::get_steady_time_ns();
+      for (int i = 0; i < num_packets; ++i)
+        packets[i]->recv_time = now;
+    }
+
+    if (num_packets < 0) // error or non-blocking call
+    {
+      int last_error = smanager.get_last_error();
+      if (last_error != OJPH_EWOULDBLOCK)
+      {
+        std::string err = smanager.get_error_message(last_error);
+        OJPH_INFO(0x02000003, "%sFailed to receive data: %s", prefix,
+          err.data());
+      }
+      continue; // if we wish to continue
+    }
+
+    for (int i = 0; i < num_packets; ++i)
+    {
+      ojph::stex::rtp_packet* packet = packets[i];
+      struct sockaddr_in& si_other = sources[i];
+
+      bool mismatch = (r->saddr && r->saddr != smanager.get_addr(si_other))
+        || (r->sport && r->sport != si_other.sin_port);
+
+      // lock onto the first source
+      if (!mismatch && r->connect_to_source)
+      {
+        r->saddr = smanager.get_addr(si_other);
+        r->sport = si_other.sin_port;
+        r->connect_to_source = false;
+        if (connect(s.intern(), (struct sockaddr*)&si_other,
+                    sizeof(si_other)) == -1)
+        {
+          std::string err = smanager.get_last_error_message();
+          OJPH_INFO(0x02000006, "%sFailed to connect the socket to the "
+            "source: %s", prefix, err.data());
+        }
+      }
+
+      // Packets from other sources are dropped, and counted in the 
+      // statistics; these are packets that do not match -src_addr or
+      // -src_port, or, with more than one stream, packets of other 
+      // streams that were queued on this socket before it locked onto its
+      // source.  Only the first is reported, because a stream of another
+      // source would produce a message for every packet.
+      if (mismatch) {
+        if (!quiet && r->ignored_packets == 0) {
+          constexpr int buf_size = 128;
+          char buf[buf_size];
+          ojph::ui32 addr = smanager.get_addr(si_other);
+          const char* t = inet_ntop(AF_INET, &addr, buf, buf_size);
+          if (t == NULL) {
+            std::string err = smanager.get_last_error_message();
+            OJPH_INFO(0x02000004,
+              "Error converting source address: %s", err.data());
+          }
+          printf("%sIgnoring packets from %s, port %d; this and other "
+            "ignored sources are counted in the statistics\n", prefix,
+            t, ntohs(si_other.sin_port));
+        }
+        ++r->ignored_packets;
+        packet->num_bytes = 0; // the packet is dropped
+        continue;
+      }
+
+      if (last_time_stamp == 0)
+        last_time_stamp = packet->get_time_stamp();
+
+      if (!quiet && !src_printed)
+      {
+        constexpr int buf_size = 128;
+        char buf[buf_size];
+        ojph::ui32 addr = smanager.get_addr(si_other);
+        const char* t = inet_ntop(AF_INET, &addr, buf, buf_size);
+        if (t == NULL) {
+          std::string err = smanager.get_last_error_message();
+          OJPH_INFO(0x02000005, 
+            "Error converting source address: %s", err.data());
+        }
+        printf("%sReceiving data from %s, port %d\n", prefix,
+          t, ntohs(si_other.sin_port));
+        src_printed = true;
+      }
+
+      if (!quiet || r->stats_file)
+        if (packet->get_time_stamp() >= last_time_stamp + 45000)
+        { // One second is 90000
+          last_time_stamp = packet->get_time_stamp();
+          report_stats(r, prefix);
+        }
+    }
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////
 static
 bool get_arguments(int argc, char *argv[],
@@ -55,7 +383,10 @@ bool get_arguments(int argc, char *argv[],
                    char *&src_addr, char *&src_port, 
                    char *&target_name, ojph::ui32& num_threads, 
                    ojph::ui32& num_inflight_packets,
-                   ojph::ui32& recvfrm_buf_size, bool& blocking,
+                   ojph::ui32& max_packets,
+                   ojph::ui32& recvfrm_buf_size, ojph::ui32& batch_size,
+                   ojph::ui32& num_streams, char *&stats_name, 
+                   bool& blocking, bool& decode, bool& cb_cache, 
                    bool& quiet)
 {
   ojph::cli_interpreter interpreter;
@@ -68,9 +399,15 @@ bool get_arguments(int argc, char *argv[],
   interpreter.reinterpret("-o", target_name);
   interpreter.reinterpret("-num_threads", num_threads);
   interpreter.reinterpret("-num_packets", num_inflight_packets);
+  interpreter.reinterpret("-max_packets", max_packets);
   interpreter.reinterpret("-recv_buf_size", recvfrm_buf_size);
+  interpreter.reinterpret("-batch", batch_size);
+  interpreter.reinterpret("-num_streams", num_streams);
+  interpreter.reinterpret("-stats", stats_name);
 
   blocking = interpreter.reinterpret("-blocking");
+  decode = interpreter.reinterpret("-decode");
+  cb_cache = interpreter.reinterpret("-cb_cache");
   quiet = interpreter.reinterpret("-quiet");
 
   if (interpreter.is_exhausted() == false) {
@@ -105,6 +442,47 @@ bool get_arguments(int argc, char *argv[],
     printf("Please set \"-num_packets\" to 1 or more.\n");
     return false;
   }
+  if (max_packets < num_inflight_packets)
+  {
+    printf("Please set \"-max_packets\" to a value not smaller than "
+      "\"-num_packets\".\n");
+    return false;
+  }
+  if (batch_size < 1 || batch_size > max_batch_size)
+  {
+    printf("Please set \"-batch\" to a value between 1 and %d.\n",
+      max_batch_size);
+    return false;
+  }
+  if (num_inflight_packets <= batch_size)
+  {
+    printf("Please set \"-num_packets\" to a value larger than "
+      "\"-batch\".\n");
+    return false;
+  }
+  if (num_streams < 1 || num_streams > max_num_streams)
+  {
+    printf("Please set \"-num_streams\" to a value between 1 and %d.\n",
+      max_num_streams);
+    return false;
+  }
+  if (num_streams > 1 && target_name && strcmp(target_name, "-") == 0)
+  {
+    printf("Only one stream can be written to stdout; please use a file "
+      "name with \"-o\" when \"-num_streams\" is larger than 1.\n");
+    return false;
+  }
+  if (stats_name && strcmp(stats_name, "-") == 0 && target_name 
+      && strcmp(target_name, "-") == 0)
+  {
+    printf("Frames and statistics cannot both be written to stdout.\n");
+    return false;
+  }
+  if (decode && target_name == NULL)
+  {
+    printf("Please use \"-o\" to provide a target for decoded frames.\n");
+    return false;
+  }
 
   return true;
 }
@@ -117,10 +495,16 @@ int main(int argc, char* argv[])
   char *src_addr = NULL;
   char *src_port = NULL;
   char *target_name = NULL;
+  char *stats_name = NULL;
   ojph::ui32 num_threads = 2;
   ojph::ui32 num_inflight_packets = 5;
+  ojph::ui32 max_packets = 131072;
   ojph::ui32 recvfrm_buf_size = 65536;
+  ojph::ui32 batch_size = 1;
+  ojph::ui32 num_streams = 1;
   bool blocking = false;
+  bool decode = false;
+  bool cb_cache = false;
   bool quiet = false;
 	
   if (argc <= 1) {
@@ -140,12 +524,37 @@ int main(int argc, char* argv[])
     " -src_port      <source port>, packets from other source ports are\n"    
     "                ignored. If not specified, then packets from any\n"
     "                port are accepted -- I would recommend not leaving\n"
-    "                this one out.\n"
+    "                this one out. Ignored packets are counted in the\n"
+    "                statistics.\n"
     " -recv_buf_size <integer> recvfrom buffer size; default is 65536.\n"
     "                This is the size of the operating system's receive\n"
     "                buffer, before packets are picked by the program.\n"
     "                Larger buffers reduces the likelihood that a packet\n"
     "                is dropped before the program has a chance to pick it.\n"
+    " -batch         <integer> number of packets that can be received in\n"
+    "                one system call; default is 1. Batching reduces the\n"
+    "                per-packet cost at high packet rates; it uses\n"
+    "                recvmmsg on Linux. This number must be smaller than\n"
+    "                -num_packets, which should be enlarged accordingly.\n"
+    " -num_streams   <integer> number of streams received concurrently;\n"
+    "                default is 1. Each stream is received by its own\n"
+    "                thread and socket; sockets share the listening port\n"
+    "                using SO_REUSEPORT, and each locks onto the first\n"
+    "                source it receives from; packets of other sources\n"
+    "                queued on a socket before it locks are ignored, and\n"
+    "                sources beyond -num_streams are not received. Frames\n"
+    "                are shared between -num_threads threads, and files\n"
+    "                of stream k have \"_sk\" appended to the -o name.\n"
+    "                Statistics are printed for each stream.\n"
+    " -stats         <string> file name; every half a second of stream\n"
+    "                time, the statistics of each stream are appended to\n"
+    "                this file as one line of JSON, even with -quiet.\n"
+    "                These include histograms of frame assembly latency,\n"
+    "                from the first to the last packet of a frame, of\n"
+    "                processing latency, from handing a frame to a thread\n"
+    "                until it is saved or decoded, and of their total, in\n"
+    "                log2 microsecond bins, as well as the RFC 3550\n"
+    "                interarrival jitter of frames. Use \"-\" for stdout.\n"
     " -blocking      sets the receiving socket blocking mode to blocking.\n"
     "                The default mode is non-blocking. A blocking socket\n"
     "                increases the likelihood of not receiving some\n"
@@ -160,10 +569,29 @@ int main(int argc, char* argv[])
     "                number of threads + 1\n"
     " -num_packets   <integer> number of in-flight packets; this is a\n"
     "                window of packets in which packets can be re-ordered.\n"
+    " -max_packets   <integer> maximum number of packets kept in memory,\n"
+    "                including those of frames being assembled or\n"
+    "                processed; default is 131072, or 256MB. Once they\n"
+    "                are all in use, the frame being assembled is dropped,\n"
+    "                and if this does not free any, received packets are\n"
+    "                dropped until frames finish processing.\n"
     " -o             <string> target file name without extension; the same\n"
     "                printf formating can be used. For example,\n"
     "                output_%%05d. An extension will be added, either .j2c\n"
-    "                for original frames, or .ppm for decoded images.\n"
+    "                for original frames, or .yuv for decoded frames.\n"
+    "                Use \"-o -\" to write all frames, in order, to stdout;\n"
+    "                this also implies -quiet.\n"
+    " -decode        decode frames, using the -num_threads threads, and\n"
+    "                save raw planar samples, one component after the\n"
+    "                other, one byte per sample for bit depths up to 8,\n"
+    "                and two bytes in native byte order for bit depths\n"
+    "                up to 16. Colour transformed frames produce RGB.\n"
+    " -cb_cache      with -decode, keeps the decoded codeblocks of earlier\n"
+    "                frames, and reuses them for codeblocks whose coded\n"
+    "                data are unchanged, instead of decoding them; this\n"
+    "                benefits screen content and other mostly static\n"
+    "                content. Frames that signal codeblock caching in their\n"
+    "                RTP payload header use the cache without this option.\n"
     " -quiet         use to stop printing informative messages.\n."
     "\n"
     );
@@ -171,18 +599,26 @@ int main(int argc, char* argv[])
   }
   if (!get_arguments(argc, argv, recv_addr, recv_port, src_addr, src_port,
                      target_name, num_threads, num_inflight_packets,
-                     recvfrm_buf_size, blocking, quiet))
+                     max_packets, recvfrm_buf_size, batch_size, num_streams,
+                     stats_name, blocking, decode, cb_cache, quiet))
   {
     exit(-1);
   }
 
+  // frames written to stdout must not be mixed with messages
+  if (target_name && strcmp(target_name, "-") == 0)
+  {
+    quiet = true;
+    ojph::set_info_stream(stderr);
+    ojph::set_warning_stream(stderr);
+#ifdef OJPH_OS_WINDOWS
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+  }
+
   try {
     ojph::thds::thread_pool thread_pool;
     thread_pool.init(num_threads);
-    ojph::stex::frames_handler frames_handler;
-    frames_handler.init(quiet, target_name, &thread_pool);
-    ojph::stex::packets_handler packets_handler;
-    packets_handler.init(quiet, num_inflight_packets, &frames_handler);
     ojph::net::socket_manager smanager;
 
     // listening address/port
@@ -202,58 +638,10 @@ int main(int argc, char* argv[])
       port_number = (ojph::ui16)atoi(recv_port);
       if (port_number == 0)
         OJPH_ERROR(0x02000002, "Please provide a valid port number. "
-            "The number you provided is %d", recv_port);
+            "The number you provided is %s", recv_port);
       server.sin_port = htons(port_number);
     }
 
-    // create a socket
-    ojph::net::socket s;
-    s = smanager.create_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-    if(s.intern() == OJPH_INVALID_SOCKET)
-    {
-      std::string err = smanager.get_last_error_message();
-      OJPH_ERROR(0x02000003, "Could not create socket: %s", err.data());
-    }
-
-    // change recv buffer size; default is 65536
-    if (::setsockopt(s.intern(), SOL_SOCKET, SO_RCVBUF,
-                   (char*)&recvfrm_buf_size, sizeof(recvfrm_buf_size)) == -1)
-    {
-      std::string err = smanager.get_last_error_message();
-      OJPH_INFO(0x02000001,
-        "Failed to expand receive buffer: %s", err.data());
-    }
-
-    // set socket to non-blocking
-    if (s.set_blocking_mode(blocking) == false)
-    {
-      std::string err = smanager.get_last_error_message();
-      OJPH_INFO(0x02000002,
-        "Failed to set the socket's blocking mode to %s, with error %s", 
-        blocking ? "blocking" : "non-blocking", err.data());
-    }
-
-    // bind to listening address
-    if(bind(s.intern(), (struct sockaddr *)&server, sizeof(server)) == -1)
-    {
-      std::string err = smanager.get_last_error_message();
-      OJPH_ERROR(0x02000004, 
-        "Could not bind address to socket: %s", err.data());
-    }
-
-    if (!quiet) {
-      constexpr int buf_size = 128;
-      char buf[buf_size];
-      ojph::ui32 addr = smanager.get_addr(server);
-      const char* t = inet_ntop(AF_INET, &addr, buf, buf_size);
-      if (t == NULL) {
-        std::string err = smanager.get_last_error_message();
-        OJPH_INFO(0x02000005,
-          "Error converting source address: %s", err.data());
-      }
-      printf("Listening on %s, port %d\n", t, ntohs(server.sin_port));
-    }
-
     // process the source IPv4 address and port
     ojph::ui32 saddr = 0;
     if (src_addr)
@@ -271,94 +659,133 @@ int main(int argc, char* argv[])
       saddr = smanager.get_addr(t);
     }
     ojph::ui16 sport = 0;
-    if (src_addr)
+    if (src_port)
     {
       sport = (ojph::ui16)atoi(src_port);
       if (sport == 0)
         OJPH_ERROR(0x02000006, "Please provide a valid port number. "
-            "The number you provided is %d", src_port);
+            "The number you provided is %s", src_port);
+      sport = htons(sport);
     }
 
-    // listen to incoming data, and forward it to packet_handler
-    struct sockaddr_in si_other;
-    socklen_t socklen = sizeof(si_other);
-    bool src_printed = false;
-    ojph::stex::rtp_packet* packet = NULL;
-    ojph::ui32 last_time_stamp = 0;
-    while (1)
+    // statistics file, shared by all streams
+    FILE* stats_file = NULL;
+    if (stats_name && strcmp(stats_name, "-") == 0)
+      stats_file = stdout;
+    else if (stats_name) {
+      stats_file = fopen(stats_name, "w");
+      if (stats_file == NULL)
+        OJPH_ERROR(0x02000009, "Could not open %s for writing statistics",
+          stats_name);
+    }
+
+    // one receiver for each stream, each with its own socket
+    stream_receiver* receivers = new stream_receiver[num_streams];
+    for (ojph::ui32 k = 0; k < num_streams; ++k)
     {
-      if (packet == NULL || packet->num_bytes != 0)
-        packet = packets_handler.exchange(packet);
-      if (packet == NULL)
-        continue;
-      packet->num_bytes = 0;
+      stream_receiver& r = receivers[k];
+      r.index = k;
+      r.smanager = &smanager;
+      r.saddr = saddr;
+      r.sport = sport;
+      r.connect_to_source = num_streams > 1;
+      r.batch_size = batch_size;
+      r.blocking = blocking;
+      r.quiet = quiet;
+      r.stats_file = stats_file;
+      r.multiple = num_streams > 1;
 
-      // receive data
-      int num_bytes = (int)recvfrom(s.intern(), (char*)packet->data,
-        packet->max_size, 0, (struct sockaddr*)&si_other, &socklen);
+      // files of each stream are distinguished by a suffix
+      const char *name = target_name;
+      if (target_name && num_streams > 1) {
+        snprintf(r.target_name, sizeof(r.target_name), "%s_s%d", 
+          target_name, k);
+        name = r.target_name;
+      }
+      r.frames_handler.init(quiet, name, decode, cb_cache, &thread_pool);
+      r.packets_handler.init(quiet, num_inflight_packets, max_packets,
+        &r.frames_handler);
 
-      if (num_bytes < 0) // error or non-blocking call
+      // create a socket
+      r.s = smanager.create_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+      if(r.s.intern() == OJPH_INVALID_SOCKET)
       {
-        int last_error = smanager.get_last_error();
-        if (last_error != OJPH_EWOULDBLOCK)
-        {
-          std::string err = smanager.get_error_message(last_error);
-          OJPH_INFO(0x02000003, "Failed to receive data: %s", err.data());
-        }
-        continue; // if we wish to continue
+        std::string err = smanager.get_last_error_message();
+        OJPH_ERROR(0x02000003, "Could not create socket: %s", err.data());
       }
 
-      if ((src_addr && saddr != smanager.get_addr(si_other)) ||
-        (src_port && sport != si_other.sin_port)) {
-        constexpr int buf_size = 128;
-        char buf[buf_size];
-        ojph::ui32 addr = smanager.get_addr(si_other);
-        const char* t = inet_ntop(AF_INET, &addr, buf, buf_size);
-        if (t == NULL) {
+      // allow sockets to share the listening address/port; the operating
+      // system distributes sources over sockets
+      if (num_streams > 1)
+      {
+#ifdef SO_REUSEPORT
+        int reuse = 1;
+        if (::setsockopt(r.s.intern(), SOL_SOCKET, SO_REUSEPORT,
+                         (char*)&reuse, sizeof(reuse)) == -1)
+        {
           std::string err = smanager.get_last_error_message();
-          OJPH_INFO(0x02000004,
-            "Error converting source address: %s", err.data());
+          OJPH_ERROR(0x02000007, 
+            "Failed to set SO_REUSEPORT: %s", err.data());
         }
-        printf("Source mismatch %s, port %d\n",
-          t, ntohs(si_other.sin_port));
-        continue;
+#else
+        OJPH_ERROR(0x02000008, "Receiving more than one stream requires "
+          "SO_REUSEPORT, which is not available on this platform");
+#endif
       }
 
-      packet->num_bytes = (ojph::ui32)num_bytes;
-
-      if (last_time_stamp == 0)
-        last_time_stamp = packet->get_time_stamp();
+      // change recv buffer size; default is 65536
+      if (::setsockopt(r.s.intern(), SOL_SOCKET, SO_RCVBUF,
+                     (char*)&recvfrm_buf_size, sizeof(recvfrm_buf_size)) 
+          == -1)
+      {
+        std::string err = smanager.get_last_error_message();
+        OJPH_INFO(0x02000001,
+          "Failed to expand receive buffer: %s", err.data());
+      }
 
-      if (!quiet && !src_printed)
+      // set socket to non-blocking
+      if (r.s.set_blocking_mode(blocking) == false)
       {
-        constexpr int buf_size = 128;
-        char buf[buf_size];
-        ojph::ui32 addr = smanager.get_addr(si_other);
-        const char* t = inet_ntop(AF_INET, &addr, buf, buf_size);
-        if (t == NULL) {
-          std::string err = smanager.get_last_error_message();
-          OJPH_INFO(0x02000005, 
-            "Error converting source address: %s", err.data());
-        }
-        printf("Receiving data from %s, port %d\n",
-          t, ntohs(si_other.sin_port));
-        src_printed = true;
+        std::string err = smanager.get_last_error_message();
+        OJPH_INFO(0x02000002,
+          "Failed to set the socket's blocking mode to %s, with error %s", 
+          blocking ? "blocking" : "non-blocking", err.data());
       }
 
-      if (!quiet)
-        if (packet->get_time_stamp() >= last_time_stamp + 45000)
-        { // One second is 90000
-          last_time_stamp = packet->get_time_stamp();
-          ojph::ui32 lost_packets = packets_handler.get_num_lost_packets();
-          ojph::ui32 total_frames = 0, trunc_frames = 0, lost_frames = 0;
-          frames_handler.get_stats(total_frames, trunc_frames, lost_frames);
+      // bind to listening address
+      if(bind(r.s.intern(), (struct sockaddr *)&server, sizeof(server)) 
+         == -1)
+      {
+        std::string err = smanager.get_last_error_message();
+        OJPH_ERROR(0x02000004, 
+          "Could not bind address to socket: %s", err.data());
+      }
+    }
 
-          printf("Total frame %d, truncated frames %d, lost frames %d, "
-            "packets lost %d\n",
-            total_frames, trunc_frames, lost_frames, lost_packets);
-        }
+    if (!quiet) {
+      constexpr int buf_size = 128;
+      char buf[buf_size];
+      ojph::ui32 addr = smanager.get_addr(server);
+      const char* t = inet_ntop(AF_INET, &addr, buf, buf_size);
+      if (t == NULL) {
+        std::string err = smanager.get_last_error_message();
+        OJPH_INFO(0x02000005,
+          "Error converting source address: %s", err.data());
+      }
+      printf("Listening on %s, port %d\n", t, ntohs(server.sin_port));
     }
-    s.close();    
+
+    // receive streams; the first on this thread, the others on their own 
+    // threads
+    std::vector<std::thread> threads;
+    for (ojph::ui32 k = 1; k < num_streams; ++k)
+      threads.emplace_back(receive_stream, receivers + k);
+    receive_stream(receivers);
+    for (size_t k = 0; k < threads.size(); ++k)
+      threads[k].join();
+    delete[] receivers;
+    if (stats_file && stats_file != stdout)
+      fclose(stats_file);
   }
   catch (const std::exception& e)
   {
@@ -370,4 +797,3 @@ int main(int argc, char* argv[])
 
   return 0;
 }
-
@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+#****************************************************************************/
+# This software is released under the 2-Clause BSD license, included
+# below.
+#
+# Copyright (c) 2026, Aous Naman
+# Copyright (c) 2026, Kakadu Software Pty Ltd, Australia
+# Copyright (c) 2026, The University of New South Wales, Australia
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met:
+#
+# 1. Redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+# IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+# TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+# PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+# TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+# PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+# LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+# NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#****************************************************************************/
+# This file is part of the OpenJPH software implementation.
+# File: recv_batch_bench.py
+# Author: Aous Naman
+# Date: 19 October 2026
+#****************************************************************************/
+#
+# Measures the CPU time ojph_stream_expand spends receiving packets, for
+# several values of -batch, on Linux loopback.
+#
+# For each run, the receiver is started with a blocking socket and stopped
+# with SIGSTOP; then, the packets are sent, so that they are queued in the
+# kernel's receive buffer.  The receiver is resumed, and its CPU time,
+# from /proc/<pid>/schedstat, is measured until the receive queue is
+# drained.  Each packet is a complete frame, made of one RTP main packet;
+# no files are written.
+#
+# The receive buffer must hold all packets; the kernel limits it to
+# net.core.rmem_max, which can be raised with, for example,
+#   sysctl -w net.core.rmem_max=536870912
+# Runs in which the kernel dropped packets are reported as such.
+#
+# Example:
+#   python3 recv_batch_bench.py build/src/apps/ojph_stream_expand/\
+#     ojph_stream_expand -batch 1 32 64 -runs 6
+
+import argparse
+import os
+import signal
+import socket
+import struct
+import subprocess
+import sys
+import time
+
+
+def find_socket(port):
+  """returns (rx_queue, drops) of the UDP socket bound to port, or None"""
+  with open('/proc/net/udp') as f:
+    next(f)
+    for line in f:
+      fields = line.split()
+      if int(fields[1].split(':')[1], 16) == port:
+        rx_queue = int(fields[4].split(':')[1], 16)
+        return rx_queue, int(fields[12])
+  return None
+
+
+def cpu_time_ns(pid):
+  """returns the CPU time of all threads of pid, in nanoseconds"""
+  total = 0
+  for tid in os.listdir('/proc/%d/task' % pid):
+    with open('/proc/%d/task/%s/schedstat' % (pid, tid)) as f:
+      total += int(f.read().split()[0])
+  return total
+
+
+def make_packet(seq, size):
+  """an RTP packet that holds a complete frame in one main packet"""
+  hdr = struct.pack('!BBHII', 0x80, 0x80 | 98, seq & 0xFFFF,
+                    (seq * 3000) & 0xFFFFFFFF, 0x4F4A5048)
+  # main payload header: packet type 3 (main), ESEQ in the last byte
+  payload = struct.pack('!BBBBBBBB', 3 << 6, 0, 0, (seq >> 16) & 0xFF,
+                        0, 0, 0, 0)
+  return hdr + payload + bytes(size - len(hdr) - len(payload))
+
+
+def run(args, batch, port):
+  """one measurement; returns (cpu ms, dropped packets)"""
+  cmd = [args.expand, '-addr', '127.0.0.1', '-port', str(port),
+         '-blocking', '-quiet', '-batch', str(batch),
+         '-num_packets', str(max(2 * batch, 64)),
+         '-recv_buf_size', str(args.recv_buf_size)]
+  rx = subprocess.Popen(cmd, stdout=subprocess.DEVNULL)
+  try:
+    deadline = time.time() + 5
+    while find_socket(port) is None:
+      if time.time() > deadline or rx.poll() is not None:
+        sys.exit('ojph_stream_expand did not start: ' + ' '.join(cmd))
+      time.sleep(0.01)
+    time.sleep(0.1)     # let it block in the receive call
+    rx.send_signal(signal.SIGSTOP)
+
+    tx = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    for seq in range(1, args.packets + 1):
+      tx.sendto(make_packet(seq, args.size), ('127.0.0.1', port))
+    tx.close()
+    drops = find_socket(port)[1]
+
+    start = cpu_time_ns(rx.pid)
+    rx.send_signal(signal.SIGCONT)
+    while find_socket(port)[0] > 0:
+      time.sleep(0.005)
+    time.sleep(0.05)    # the last batch is being processed
+    end = cpu_time_ns(rx.pid)
+    return (end - start) / 1e6, drops
+  finally:
+    rx.kill()
+    rx.wait()
+
+
+def main():
+  parser = argparse.ArgumentParser(
+    description='Measures the receive cost of ojph_stream_expand.')
+  parser.add_argument('expand', help='path to ojph_stream_expand')
+  parser.add_argument('-batch', type=int, nargs='+', default=[1, 32, 64],
+                      help='values of -batch to measure')
+  parser.add_argument('-runs', type=int, default=6,
+                      help='runs for each value of -batch')
+  parser.add_argument('-packets', type=int, default=150000,
+                      help='packets sent in each run')
+  parser.add_argument('-size', type=int, default=1420,
+                      help='packet size in bytes')
+  parser.add_argument('-port', type=int, default=47000,
+                      help='receiving port on 127.0.0.1')
+  parser.add_argument('-recv_buf_size', type=int, default=1 << 28,
+                      help='-recv_buf_size of ojph_stream_expand')
+  args = parser.parse_args()
+
+  print('%d packets of %d bytes, %d runs each' %
+        (args.packets, args.size, args.runs))
+  for batch in args.batch:
+    times = []
+    for _ in range(args.runs):
+      ms, drops = run(args, batch, args.port)
+      if drops:
+        print('-batch %d: the kernel dropped %d packets; raise '
+              'net.core.rmem_max, or use fewer -packets' % (batch, drops))
+        continue
+      times.append(ms)
+    if times:
+      times.sort()
+      print('-batch %-3d cpu ms: min %.1f, median %.1f, max %.1f; '
+            '%.2f Mpkt/s at the median' %
+            (batch, times[0], times[len(times) // 2], times[-1],
+             args.packets / times[len(times) // 2] / 1e3))
+
+
+if __name__ == '__main__':
+  main()
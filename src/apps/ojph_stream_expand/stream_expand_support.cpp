@@ -36,7 +36,9 @@
 //***************************************************************************/
 
 #include <cassert>
+#include <chrono>
 #include <cstddef>
+#include <cstring>
 #include "ojph_threads.h"
 #include "threaded_frame_processors.h"
 #include "stream_expand_support.h"
@@ -102,131 +104,322 @@ static inline ui32 clip_seq_num(ui32 n) { return (n & 0xFFFFFF); }
 ///////////////////////////////////////////////////////////////////////////////
 
 ///////////////////////////////////////////////////////////////////////////////
-void packets_handler::init(bool quiet, ui32 num_packets,
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+void packets_infile::open(rtp_packet* packets, size_t size)
+{
+  assert(first == NULL);
+  first = cur = packets;
+  cur_start = pos = 0;
+  this->size = size;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+size_t packets_infile::read(void *ptr, size_t size)
+{
+  ui8 *dp = (ui8 *)ptr;
+  size_t bytes_read = 0;
+  while (bytes_read < size && pos < this->size)
+  {
+    size_t offset = pos - cur_start;
+    size_t cur_size = cur->get_data_size();
+    if (offset >= cur_size) { // move to the next packet
+      cur_start += cur_size;
+      cur = cur->next;
+      continue;
+    }
+    size_t bytes = ojph_min(size - bytes_read, cur_size - offset);
+    memcpy(dp + bytes_read, cur->get_data() + offset, bytes);
+    bytes_read += bytes;
+    pos += bytes;
+  }
+  return bytes_read;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int packets_infile::seek(si64 offset, enum infile_base::seek origin)
+{
+  if (origin == OJPH_SEEK_CUR)
+    offset += (si64)pos;
+  else if (origin == OJPH_SEEK_END)
+    offset += (si64)size;
+  else if (origin != OJPH_SEEK_SET) {
+    assert(0);
+    return -1;
+  }
+  if (offset < 0 || (size_t)offset > size)
+    return -1;
+
+  // read moves cur forward when needed; seeking backwards restarts from 
+  // the first packet
+  pos = (size_t)offset;
+  if (pos < cur_start) {
+    cur = first;
+    cur_start = 0;
+  }
+  while (pos - cur_start >= cur->get_data_size() && cur->next != NULL) {
+    cur_start += cur->get_data_size();
+    cur = cur->next;
+  }
+  return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+void packets_handler::init(bool quiet, ui32 num_packets, ui32 max_packets,
                            frames_handler* frames)
 { 
   assert(this->num_packets == 0);
-  avail = packet_store = new rtp_packet[num_packets];
-  ui32 i = 0;
-  for (; i < num_packets - 1; ++i)
-    packet_store[i].init(packet_store + i + 1);
-  packet_store[i].init(NULL);
-  this->quiet = quiet;
   this->num_packets = num_packets; 
+  max_stores = (max_packets + num_packets - 1) / num_packets;
+  max_stores = max_stores > 0 ? max_stores : 1;
+  grow_packet_store();
+  spare_store = new rtp_packet[num_packets];
+  for (ui32 i = 0; i < num_packets; ++i) {
+    spare_store[i].next = spare;
+    spare = spare_store + i;
+  }
+  ui32 i, ring_size = 2;
+  while (ring_size < 2 * num_packets)
+    ring_size <<= 1;
+  assert(ring_size <= 0x1000000); // sequence numbers are 24 bits
+  ring = new rtp_packet*[ring_size];
+  for (i = 0; i < ring_size; ++i)
+    ring[i] = NULL;
+  ring_mask = ring_size - 1;
+  this->quiet = quiet;
   this->frames = frames;
+  frames->set_packets_handler(this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void packets_handler::grow_packet_store()
+{
+  rtp_packet* store = new rtp_packet[num_packets];
+  packet_stores.push_back(store);
+  for (ui32 i = 0; i < num_packets; ++i)
+    release_packet(store + i);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void packets_handler::recycle_packets(rtp_packet* packets)
+{
+  while (packets) {
+    rtp_packet* p = packets;
+    packets = packets->next;
+    release_packet(p);
+  }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 rtp_packet* packets_handler::exchange(rtp_packet* p)
 {
-  assert(num_packets > 0 && p == in_use);
+  assert(num_packets > 0);
 
   if (p != NULL) {
     if (p->num_bytes == 0)
       return p;
+    --num_held;
+    if (is_spare(p)) { // no packet was available when p was handed out
+      ++dropped_packets;
+      p->next = spare;
+      spare = p;
+    }
+    else
+      process_packet(p);
+  }
 
-    if (last_seq_num == 0) // initialization
-      last_seq_num = clip_seq_num(p->get_seq_num() - 1);
+  // move from avail to the caller -- there can be no packets in avail if
+  // frames hold them, in which case more packets are allocated, up to
+  // max_stores allocations; beyond that, packets are reclaimed from frames,
+  // or a spare packet is handed out.  Spare packets suffice, because the
+  // caller holds fewer than num_packets packets
+  if (num_held >= num_packets)
+    return NULL;
+  if (avail == NULL) {
+    if (packet_stores.size() < max_stores)
+      grow_packet_store();
+    else
+      frames->reclaim_packets();
+  }
+  if (avail != NULL) {
+    p = avail;
+    avail = avail->next;
+  }
+  else {
+    assert(spare != NULL);
+    p = spare;
+    spare = spare->next;
+  }
+  p->next = NULL;
+  ++num_held;
+  return p;
+}
 
-    // packet is old, and is ignored -- no need to included it in the 
-    // lost packets, because this packet was considered lost previously.
-    // This also captures the case where the previous packet and this packet
-    // has the same sequence number, which is rather weird but possible
-    // if some intermediate network unit retransmits packets.
-    if (is_smaller24(p->get_seq_num(), clip_seq_num(last_seq_num + 1)))
-      return p;
-    else if (p->get_seq_num() == clip_seq_num(last_seq_num + 1))
-    {
+///////////////////////////////////////////////////////////////////////////////
+void packets_handler::process_packet(rtp_packet* p)
+{
+  if (last_seq_num == 0) // initialization
+    last_seq_num = clip_seq_num(p->get_seq_num() - 1);
+
+  // packet is old, and is ignored -- no need to included it in the 
+  // lost packets, because this packet was considered lost previously.
+  // This also captures the case where the previous packet and this packet
+  // has the same sequence number, which is rather weird but possible
+  // if some intermediate network unit retransmits packets.
+  if (is_smaller24(p->get_seq_num(), clip_seq_num(last_seq_num + 1)))
+  {
+    release_packet(p);
+    return;
+  }
+
+  // A packet beyond the ring advances it; buffered packets are pushed, and
+  // missing packets are considered lost.  Once the ring is empty, the
+  // remaining sequence numbers are skipped in one step, because a jump in
+  // sequence numbers can be as large as 2^23.
+  ui32 dist = clip_seq_num(p->get_seq_num() - (last_seq_num + 1));
+  if (dist > ring_mask) {
+    ui32 skip = dist - ring_mask;
+    for (; skip > 0 && num_queued > 0; --skip)
       consume_packet();
-      // see if we can push one packet from the top of the buffer
-      if (in_use && in_use->get_seq_num() == clip_seq_num(last_seq_num + 1))
-        consume_packet();
-    }
-    else // sequence larger than expected
-    {
-      // Place the packet in the in_use queue according to its sequence
-      // number; we may have to move it down the queue. The in_use queue is 
-      // always arranged in an ascending order, where the top of the queue 
-      // (pointed to by in_use) has the smallest sequence number.
-      if (in_use->next != NULL) // we have more than 1 packet in queue
-      { 
-        rtp_packet* t = in_use;
-        while (t->next != NULL && 
-          is_greater24(p->get_seq_num(), t->next->get_seq_num()))
-          t = t->next;
-
-        if (t->next != NULL && p->get_seq_num() == t->next->get_seq_num())
-        { // this is a repeated packet and must be removed
-          in_use = in_use->next;
-          p->next = avail;
-          avail = p;
-        }
-        else {
-          if (t == in_use) // at front of queue -- exactly where it should be
-          { } // do nothing
-          else if (t->next == NULL) { // at the end of queue
-            in_use = in_use->next; // remove p from the queue
-            t->next = p;
-            p->next = NULL;
-          }
-          else { // in the middle of the queue
-            in_use = in_use->next; // p removed from the start of queue
-            p->next = t->next;
-            t->next = p;
-          }
-        }
-      }
+    lost_packets += skip;
+    last_seq_num = clip_seq_num(last_seq_num + skip);
+  }
 
-      // If avail == NULL, all packets are being used (in_use), meaning 
-      // the queue is already full. We push packets from to the top of in_use
-      // queue.
-      // If avail != NULL, we push one packet from the top of the buffer, 
-      // if it has the correct sequence number.
-      if (avail == NULL || 
-          in_use->get_seq_num() == clip_seq_num(last_seq_num + 1))
-      {
-        if (avail == NULL)
-          lost_packets += 
-            in_use->get_seq_num() - clip_seq_num(last_seq_num + 1);
-        consume_packet();
-        if (in_use && in_use->get_seq_num() == clip_seq_num(last_seq_num + 1))
-            consume_packet();
-      }
+  // place the packet in its slot; an occupied slot holds a packet with the
+  // same sequence number, and therefore this is a repeated packet
+  ui32 slot = p->get_seq_num() & ring_mask;
+  if (ring[slot] != NULL) {
+    release_packet(p);
+    return;
+  }
+  ring[slot] = p;
+  ++num_queued;
+
+  // If all packets are being used (in the ring or held by the caller), 
+  // the buffer is already full. We push packets from the ring, 
+  // considering missing ones lost, until one packet is pushed.
+  // Otherwise, we push the next packet, if we have it, and one more 
+  // packet if it also has the correct sequence number.
+  if (num_queued + num_held >= num_packets)
+    while (!is_next_packet_ready())
+      consume_packet();
+  if (is_next_packet_ready())
+  {
+    consume_packet();
+    if (is_next_packet_ready())
+      consume_packet();
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void packets_handler::flush()
+{
+  // move all packets from the ring to avail
+  for (ui32 i = 0; i <= ring_mask; ++i)
+    if (ring[i]) {
+      release_packet(ring[i]);
+      ring[i] = NULL;
     }
+  num_queued = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void packets_handler::consume_packet()
+{
+  ui32 slot = next_slot();
+  rtp_packet* p = ring[slot];
+  last_seq_num = clip_seq_num(last_seq_num + 1);
+  if (p != NULL) {
+    assert(p->get_seq_num() == last_seq_num);
+    ring[slot] = NULL;
+    --num_queued;
+    if (!frames->push(p))
+      release_packet(p);
   }
+  else
+    ++lost_packets;
+}
 
-  // move from avail to in_use -- there must be at least one packet in avail
-  assert(avail != NULL);
-  p = avail;
-  avail = avail->next;
-  p->next = in_use;
-  in_use = p;
-  return p;
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+ui64 get_steady_time_ns()
+{
+  using namespace std::chrono;
+  return (ui64)duration_cast<nanoseconds>(
+    steady_clock::now().time_since_epoch()).count();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void packets_handler::flush()
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+void latency_histogram::reset()
 {
-  // move all packets from in_use to avail
-  while (in_use)
-  {
-    rtp_packet *p = in_use;
-    in_use = in_use->next;
-    p->next = avail;
-    avail = p;
+  for (int i = 0; i < num_bins; ++i)
+    bins[i] = 0;
+  count = sum_ns = min_ns = max_ns = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void latency_histogram::add(ui64 ns)
+{
+  ui64 us = ns / 1000;
+  int bin = 0;
+  while (us > 0 && bin < num_bins - 1) {
+    us >>= 1;
+    ++bin;
   }
+  ++bins[bin];
+  min_ns = (count == 0 || ns < min_ns) ? ns : min_ns;
+  max_ns = ns > max_ns ? ns : max_ns;
+  sum_ns += ns;
+  ++count;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void packets_handler::consume_packet()
+double latency_histogram::get_percentile_us(double percent) const
 {
-  last_seq_num = in_use->get_seq_num();
-  frames->push(in_use);
-  // move pack from in_use to avail; the packet must be equal to in_use
-  rtp_packet* p = in_use;
-  in_use = in_use->next;
-  p->next = avail;
-  avail = p;
+  if (count == 0)
+    return 0.0;
+  double max_us = (double)max_ns / 1000.0;
+  ui64 needed = (ui64)((double)count * percent / 100.0 + 0.5);
+  needed = needed < 1 ? 1 : (needed > count ? count : needed);
+  ui64 sum = 0;
+  for (int i = 0; i < num_bins - 1; ++i)
+  {
+    sum += bins[i];
+    if (sum >= needed) {
+      double edge = (double)((ui64)1 << i); // upper edge of bin i
+      return edge < max_us ? edge : max_us;
+    }
+  }
+  return max_us;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -240,11 +433,34 @@ void packets_handler::consume_packet()
 ///////////////////////////////////////////////////////////////////////////////
 void stex_file::notify_file_completion()
 { 
+  time_done = get_steady_time_ns(); // published by the fetch_add below
   int t = done.fetch_add(-1, std::memory_order_acq_rel);
   if (t == 1) // done is 0
     parent->increment_num_complete_files();
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void stex_file::add_packet(rtp_packet* p)
+{
+  p->next = NULL;
+  if (last_packet)
+    last_packet->next = p;
+  else
+    packets = p;
+  last_packet = p;
+  size += p->get_data_size();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool stex_file::write(FILE *fh) const
+{
+  for (rtp_packet* p = packets; p != NULL; p = p->next)
+    if (fwrite(p->get_data(), 1, p->get_data_size(), fh) 
+        != p->get_data_size())
+      return false;
+  return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 //
@@ -258,38 +474,52 @@ frames_handler::~frames_handler()
 { 
   if (storers_store)
     delete[] storers_store;
+  if (decoders_store)
+    delete[] decoders_store;
+  if (writer)
+    delete writer;
   if (files_store) 
     delete[] files_store; 
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void frames_handler::init(bool quiet, const char *target_name, 
-                          thds::thread_pool* thread_pool)
+void frames_handler::init(bool quiet, const char *target_name, bool decode,
+                          bool cb_cache, thds::thread_pool* thread_pool)
 {
   this->quiet = quiet;
   this->num_threads = (ui32)thread_pool->get_num_threads();
   this->target_name = target_name;
   num_files = num_threads + 1;
+  if (target_name && strcmp(target_name, "-") == 0) {
+    writer = new ordered_writer;
+    writer->init(stdout);
+  }
   avail = files_store = new stex_file[num_files];
-  storers_store = new j2k_frame_storer[num_files];
-  ui32 i = 0;
-  for (; i < num_files - 1; ++i) {
-    files_store[i].f.open(2 << 20, false); 
-    files_store[i].f.close();
-    files_store[i].init(this, files_store + i + 1, storers_store + i,
-      target_name);
-    storers_store[i].init(files_store + i, target_name);
+  if (decode)
+    decoders_store = new j2k_frame_decoder[num_files];
+  else
+    storers_store = new j2k_frame_storer[num_files];
+  for (ui32 i = 0; i < num_files; ++i) {
+    thds::worker_thread_base* processor;
+    if (decode) {
+      decoders_store[i].init(files_store + i, target_name, writer, 
+        cb_cache);
+      processor = decoders_store + i;
+    }
+    else {
+      storers_store[i].init(files_store + i, target_name, writer);
+      processor = storers_store + i;
+    }
+    stex_file* next = i + 1 < num_files ? files_store + i + 1 : NULL;
+    files_store[i].init(this, next, processor, target_name);
   }
-  files_store[i].f.open(2 << 20, false); 
-  files_store[i].f.close();
-  files_store[i].init(this, NULL, storers_store + i, target_name);
-  storers_store[i].init(files_store + i, target_name);
   this->thread_pool = thread_pool;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void frames_handler::push(rtp_packet* p)
+bool frames_handler::push(rtp_packet* p)
 {
+  bool kept = false;
   assert(!is_smaller32(p->get_time_stamp(), last_time_stamp));
   assert(!is_smaller24(p->get_seq_num(), last_seq_number));
   last_seq_number = p->get_seq_num();
@@ -297,8 +527,11 @@ void frames_handler::push(rtp_packet* p)
   // check if any of the frames processed in other threads are done
   check_files_in_processing();
 
-  // process newly received packet
-  if (p->get_packet_type() != rtp_packet::PT_BODY)
+  // process newly received packet; a main packet with the time stamp of 
+  // the frame being assembled continues a main header that spans more than
+  // one packet, and is handled as a body packet
+  if (p->get_packet_type() != rtp_packet::PT_BODY && 
+      (in_use == NULL || p->get_time_stamp() != in_use->time_stamp))
   { // main packet payload
 
     // The existence of a previous frame means we did not get the marked
@@ -320,12 +553,26 @@ void frames_handler::push(rtp_packet* p)
       in_use->time_stamp = p->get_time_stamp();
       in_use->last_seen_seq = p->get_seq_num();
       in_use->frame_idx = total_frames;
-      in_use->f.open();
-      in_use->f.write(p->get_data(), p->get_data_size());
+      in_use->cb_caching = p->is_codeblock_caching_used();
+      in_use->time_first = in_use->time_last = p->recv_time;
+      in_use->add_packet(p);
+      kept = true;
     }
     else
       ++lost_frames;
 
+    // interarrival jitter, as in RFC 3550, using the first packet of each
+    // frame; the RTP time stamp has a 90kHz clock
+    if (last_arrival_time != 0)
+    {
+      double d = (double)(p->recv_time - last_arrival_time) / 1000.0
+        - (double)(ui32)(p->get_time_stamp() - last_arrival_ts) / 0.09;
+      d = d < 0.0 ? -d : d;
+      latency.jitter_us += (d - latency.jitter_us) / 16.0;
+    }
+    last_arrival_time = p->recv_time;
+    last_arrival_ts = p->get_time_stamp();
+
     ++total_frames;
     last_time_stamp = p->get_time_stamp();
   }
@@ -338,7 +585,9 @@ void frames_handler::push(rtp_packet* p)
         if (p->get_seq_num() == clip_seq_num(in_use->last_seen_seq + 1))
         {
           in_use->last_seen_seq = p->get_seq_num();
-          in_use->f.write(p->get_data(), p->get_data_size());
+          in_use->time_last = p->recv_time;
+          in_use->add_packet(p);
+          kept = true;
           if (p->is_marked())
             send_to_processing();
         }
@@ -371,6 +620,7 @@ void frames_handler::push(rtp_packet* p)
       }
     }
   }
+  return kept;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -392,7 +642,7 @@ bool frames_handler::flush()
   if (in_use != NULL)
   {
     // move from in_use to avail    
-    in_use->f.close();
+    recycle_file_packets(in_use);
     in_use->next = avail;
     avail = in_use;
     in_use = NULL;
@@ -401,6 +651,24 @@ bool frames_handler::flush()
   return (processing != NULL);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void frames_handler::reclaim_packets()
+{
+  // a complete file holds at least one packet
+  bool complete = num_complete_files.load(std::memory_order_acquire) > 0;
+  check_files_in_processing();
+  if (!complete && in_use != NULL)
+  {
+    // drop the frame being assembled; packets that follow are ignored, 
+    // because no frame is being written
+    recycle_file_packets(in_use);
+    in_use->next = avail;
+    avail = in_use;
+    in_use = NULL;
+    ++lost_frames;
+  }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void frames_handler::check_files_in_processing()
 {
@@ -411,14 +679,17 @@ void frames_handler::check_files_in_processing()
     stex_file* f = processing, *pf = NULL;
     while(f != NULL && nf > 0)
     {
-      num_complete_files.fetch_add(-1, std::memory_order_relaxed);
-
       if (f->done.load(std::memory_order_acquire) == 0)
       {
+        num_complete_files.fetch_add(-1, std::memory_order_relaxed);
+        latency.processing.add(f->time_done - f->time_handed);
+        latency.total.add(f->time_done - f->time_first);
+
         // move f from processing to avail
+        recycle_file_packets(f);
         f->time_stamp = 0;
         f->last_seen_seq = 0;
-        f->frame_idx = 0;
+        f->frame_idx = f->out_idx = 0;
         if (f == processing)
         {
           processing = processing->next;
@@ -443,17 +714,28 @@ void frames_handler::check_files_in_processing()
   }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void frames_handler::recycle_file_packets(stex_file* f)
+{
+  packets->recycle_packets(f->packets);
+  f->packets = f->last_packet = NULL;
+  f->size = 0;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void frames_handler::send_to_processing()
 {
-  in_use->f.close();
+  latency.assembly.add(in_use->time_last - in_use->time_first);
   if (target_name) {
+    in_use->time_handed = get_steady_time_ns();
     in_use->next = processing;
     processing = in_use;
     in_use->done.store(1, std::memory_order_relaxed);
-    thread_pool->add_task(in_use->storer);
+    in_use->out_idx = num_out_frames++;
+    thread_pool->add_task(in_use->processor);
   }
   else {
+    recycle_file_packets(in_use);
     in_use->next = avail;
     avail = in_use;
   }
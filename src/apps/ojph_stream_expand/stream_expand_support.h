@@ -40,6 +40,8 @@
 
 #include <atomic>
 #include <cassert>
+#include <cstdio>
+#include <vector>
 #include "ojph_base.h"
 #include "ojph_file.h"
 #include "ojph_sockets.h"
@@ -47,7 +49,7 @@
 namespace ojph
 {
   namespace thds 
-  { class thread_pool; }
+  { class thread_pool; class worker_thread_base; }
 
 namespace stex // stream expand
 {
@@ -58,6 +60,8 @@ class frames_handler;
 
 // defined elsewhere
 struct j2k_frame_storer;
+struct j2k_frame_decoder;
+class ordered_writer;
 
 ///////////////////////////////////////////////////////////////////////////////
 //
@@ -92,7 +96,7 @@ public:
   /**
    *  @brief default constructor
    */
-  rtp_packet() { num_bytes = 0; next = NULL; }
+  rtp_packet() { num_bytes = 0; recv_time = 0; next = NULL; }
 
   /**
    *  @brief Call this to link packets.
@@ -207,6 +211,8 @@ public:
                                         // ethernet packet are only 1500
   ui8 data[max_size];                   //!<data in the packet
   ui32 num_bytes;                       //!<number of bytes 
+  ui64 recv_time;                       //!<reception time, see 
+                                        // get_steady_time_ns()
   rtp_packet* next;                     //!<used for linking packets
 };
 
@@ -218,6 +224,57 @@ public:
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+/*****************************************************************************/
+/** @brief reads a j2k codestream held in the payloads of a chain of packets
+ * 
+ *  This allows decoding a frame directly from the packets in which it was
+ *  received, without first copying the payloads into one buffer.
+ */
+class packets_infile : public infile_base
+{
+public:
+  /**
+   *  @brief default constructor
+   */
+  packets_infile() { close(); }
+  /**
+   *  @brief default destructor
+   */
+  ~packets_infile() override { }
+
+  /**
+   *  @brief call this function to read from a chain of packets
+   *
+   *  @param packets the first packet in the chain, linked by next
+   *  @param size the total number of payload bytes in the chain
+   */
+  void open(rtp_packet* packets, size_t size);
+
+  //read reads size bytes, returns the number of bytes read
+  size_t read(void *ptr, size_t size) override;
+  //seek returns 0 on success
+  int seek(si64 offset, enum infile_base::seek origin) override;
+  si64 tell() override { return (si64)pos; }
+  bool eof() override { return pos >= size; }
+  void close() override 
+  { first = cur = NULL; cur_start = pos = size = 0; }
+
+private:
+  rtp_packet *first;    //!<first packet in the chain
+  rtp_packet *cur;      //!<the packet holding the byte at pos
+  size_t cur_start;     //!<the position of the first byte of cur
+  size_t pos;           //!<current read position
+  size_t size;          //!<total number of bytes in the chain
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
 /*****************************************************************************/
 /** @brief Interprets new packets, buffers them if needed.
  * 
@@ -241,7 +298,13 @@ public:
  *  might delay picking up the next packet from the operating system network
  *  stack.
  * 
- *  Packets in the buffer are arranged according to their sequence number.
+ *  Buffered packets are stored in a ring, indexed by their sequence number
+ *  modulo the ring size; this makes placing a packet and finding the next
+ *  packet in sequence O(1) operations.  The ring size is a power of 2 that
+ *  is at least twice the number of packets, so that it is the number of 
+ *  packets that normally limits re-ordering.  A packet that lies beyond 
+ *  the ring advances the ring, pushing buffered packets and considering 
+ *  missing ones lost.
  *  
  */
 class packets_handler
@@ -253,31 +316,45 @@ public:
   packets_handler()
   {
     quiet = false;
-    avail = in_use = NULL; 
-    last_seq_num = lost_packets = 0;
+    avail = NULL; 
+    ring = NULL;
+    ring_mask = 0;
+    num_queued = num_held = 0;
+    last_seq_num = lost_packets = dropped_packets = 0;
     frames = NULL;
-    num_packets = 0;
-    packet_store = NULL;
+    num_packets = max_stores = 0;
+    spare_store = spare = NULL;
   }
   /**
    *  @brief default destructor
    */
   ~packets_handler()
-  { if (packet_store) delete[] packet_store; }
+  { 
+    if (ring) delete[] ring;
+    for (size_t i = 0; i < packet_stores.size(); ++i)
+      delete[] packet_stores[i];
+    if (spare_store) delete[] spare_store;
+  }
 
 public:
   /**
    *  @brief call this to initialize packets_handler
    *
-   *  This function creates a chain of packets that is for packet re-ordering
+   *  This function creates a chain of packets and a ring for packet 
+   *  re-ordering
    *
    *  @param quiet no messages are printed when true -- as of this writing
    *         the object prints no messages
    *  @param num_packets the number of packets in the chain
+   *  @param max_packets the maximum number of packets that are allocated,
+   *         including those held by frames; it is rounded up to a 
+   *         multiple of num_packets
    *  @param frames a pointer to the frames_handler object that will be 
-   *         receive the packets
+   *         receive the packets; this object registers itself with frames,
+   *         which returns packets once their frames are processed
    */
-  void init(bool quiet, ui32 num_packets, frames_handler* frames);
+  void init(bool quiet, ui32 num_packets, ui32 max_packets, 
+            frames_handler* frames);
 
   /**
    *  @brief Call this function to get a packet from the packet chain.
@@ -285,14 +362,35 @@ public:
    *  This function is an input-output function.  First time call to this 
    *  function passes a null pointer, and gets a pointer to use. Subsequent
    *  calls passes the pointer that was obtained earlier to get a new pointer.
-   *  This function supplies one pointer only.
+   *  A packet with num_bytes of 0 is returned as is.
+   *
+   *  Once max_packets are allocated and none is available, frames_handler
+   *  is asked to reclaim packets, which may drop the frame being
+   *  assembled.  If this does not help, the caller receives a spare 
+   *  packet, which is dropped when it is passed back; it is counted as a 
+   *  dropped packet, and also as a lost one, because its sequence number 
+   *  is missing.
+   *
+   *  The caller can hold several packets at the same time, for example to
+   *  receive a batch of packets in one system call, by calling this 
+   *  function once for each packet; packets held by the caller reduce the
+   *  number of packets available for re-ordering.
    *
    *  @param  p a pointer to a packet that was previously obtained by calling
    *          this function.
-   *  @return returns a pointer to a packet
+   *  @return returns a pointer to a packet, or NULL if the caller holds
+   *          all packets
    */
   rtp_packet* exchange(rtp_packet* p);
 
+  /**
+   *  @brief frames_handler calls this function to return the packets of a
+   *         frame after the frame has been processed
+   *
+   *  @param packets a chain of packets, linked by next
+   */
+  void recycle_packets(rtp_packet* packets);
+
   /**
    *  @brief This function provides information about the observed number 
    *          of lost packets
@@ -301,6 +399,14 @@ public:
    */
   ui32 get_num_lost_packets() const { return lost_packets; }
 
+  /**
+   *  @brief This function provides the number of packets that were 
+   *         dropped because no packet memory was available
+   *
+   *  @return returns number of dropped packets up to the time of the call
+   */
+  ui32 get_num_dropped_packets() const { return dropped_packets; }
+
   /**
    *  @brief This function is not used, and therefore it is not clear how to 
    *         use it.
@@ -309,22 +415,163 @@ public:
 
 private:
   /**
-   *  @brief This function sends the packet in in_use (oldest) to frames 
-   *         handler object.
+   *  @brief This function places a newly received packet in the ring, and 
+   *         sends packets that are in order to frames handler.
+   * 
+   *  @param p a received packet, which is not in any chain
+   */
+  void process_packet(rtp_packet* p);
+
+  /**
+   *  @brief This function advances the ring by one sequence number, 
+   *         sending the next expected packet, if any, to frames handler 
+   *         object, or counting it as lost otherwise.
    * 
    */
   void consume_packet();
 
+  /**
+   *  @brief returns the ring slot of the next expected packet
+   */
+  ui32 next_slot() const { return (last_seq_num + 1) & ring_mask; }
+
+  /**
+   *  @brief returns true if the ring holds the next expected packet
+   */
+  bool is_next_packet_ready() const { return ring[next_slot()] != NULL; }
+
+  /**
+   *  @brief returns a packet to the chain of available packets
+   */
+  void release_packet(rtp_packet* p) { p->next = avail; avail = p; }
+
+  /**
+   *  @brief returns true if p is one of the spare packets
+   */
+  bool is_spare(const rtp_packet* p) const 
+  { return p >= spare_store && p < spare_store + num_packets; }
+
+  /**
+   *  @brief allocates num_packets more packets, and adds them to avail
+   *
+   *  Frames hold on to their packets until they are processed, and 
+   *  therefore, the number of packets grows with frame size, up to 
+   *  max_stores allocations; only the packets in the ring and those held
+   *  by the caller count towards num_packets.
+   */
+  void grow_packet_store();
+
 private:
   bool quiet;                //!<no informational info is printed when true
   rtp_packet* avail;         //!<start of available packets chain
-  rtp_packet* in_use;        //!<start of used packet chain
+  rtp_packet** ring;         //!<buffered packets, indexed by sequence num.
+  ui32 ring_mask;            //!<ring size - 1, where ring size is a power
+                             //  of 2
+  ui32 num_queued;           //!<number of packets in the ring
+  ui32 num_held;             //!<number of packets held by the caller
   ui32 last_seq_num;         //!<the last observed sequence number
   ui32 lost_packets;         //!<number of lost packets -- just statistics
+  ui32 dropped_packets;      //!<number of packets received in spare packets
   frames_handler* frames;    //!<frames object
 
-  ui32 num_packets;          //!<maximum number of packets in packet_store
-  rtp_packet* packet_store;  //!<address of packet memory allocation
+  ui32 num_packets;          //!<maximum number of packets in the ring or
+                             //  held by the caller
+  ui32 max_stores;           //!<maximum number of packet stores
+  std::vector<rtp_packet*> 
+    packet_stores;           //!<addresses of packet memory allocations
+  rtp_packet* spare_store;   //!<num_packets packets, used when packet
+                             //  memory is exhausted
+  rtp_packet* spare;         //!<start of available spare packets chain
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*****************************************************************************/
+/** @brief returns the time of a monotonic clock in nanoseconds
+ *
+ *  This is used to time the reception and the processing of frames.
+ */
+ui64 get_steady_time_ns();
+
+/*****************************************************************************/
+/** @brief A histogram of latencies with logarithmic bins
+ *
+ *  Bin 0 counts latencies below 1 microsecond, and bin i > 0 counts 
+ *  latencies from 2^(i-1) up to, but excluding, 2^i microseconds; the last
+ *  bin also counts all larger latencies.
+ */
+struct latency_histogram
+{
+  static constexpr int num_bins = 32; //!<the last bin starts at 2^30 us
+
+  /**
+   *  @brief default constructor
+   */
+  latency_histogram() { reset(); }
+
+  /**
+   *  @brief removes all samples
+   */
+  void reset();
+
+  /**
+   *  @brief adds one sample
+   *
+   *  @param ns is the latency in nanoseconds
+   */
+  void add(ui64 ns);
+
+  /**
+   *  @brief returns the mean latency in microseconds, or 0 without samples
+   */
+  double get_mean_us() const 
+  { return count ? (double)sum_ns / (double)count / 1000.0 : 0.0; }
+
+  /**
+   *  @brief returns an upper bound for a percentile in microseconds
+   *
+   *  The upper edge of the bin holding the percentile is returned, which 
+   *  is at most the largest observed latency.
+   *
+   *  @param percent is the percentile, from 0 to 100
+   */
+  double get_percentile_us(double percent) const;
+
+  ui64 bins[num_bins];    //!<number of samples in each bin
+  ui64 count;             //!<total number of samples
+  ui64 sum_ns;            //!<sum of all samples
+  ui64 min_ns;            //!<smallest sample, or 0 without samples
+  ui64 max_ns;            //!<largest sample
+};
+
+/*****************************************************************************/
+/** @brief latency statistics of received frames
+ *
+ *  The reception time of a frame's first packet, of its last packet (the
+ *  marked packet for complete frames), the time the frame is handed to a
+ *  worker thread, and the time the worker is done storing or decoding it 
+ *  are recorded for every frame.  Reception times are taken when packets
+ *  are received, before reordering.
+ */
+struct frame_latency_stats
+{
+  /**
+   *  @brief default constructor
+   */
+  frame_latency_stats() { jitter_us = 0.0; }
+
+  latency_histogram assembly;   //!<first packet to last packet
+  latency_histogram processing; //!<handed to a worker to stored/decoded,
+                                // which includes waiting for a thread
+  latency_histogram total;      //!<first packet to stored/decoded
+  double jitter_us;             //!<RFC 3550 interarrival jitter, computed 
+                                // from the first packet of each frame
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -341,13 +588,17 @@ private:
  *  This objects holds a j2k codestream file.  The codestream is identified 
  *  by its timestamp. Once complete the file is pushed to saver.
  * 
+ *  The codestream is held in the payloads of the chain of packets in which
+ *  it was received; the packets are returned to packets_handler once the
+ *  file is processed.
+ * 
  *  File chains can be created using the \"next\" member variable.
  * 
  *  This object is handled by frames_handler, and therefore, it does not 
  *  have many functions.  stex_file does not create any objects of its own.
  * 
- *  The object also serves to pass information to the j2k_frame_storer, 
- *  which is run by another thread
+ *  The object also serves to pass information to the j2k_frame_storer or
+ *  the j2k_frame_decoder, which is run by another thread
  * 
  */
 struct stex_file {
@@ -359,10 +610,14 @@ public:
   { 
     time_stamp = last_seen_seq = 0; 
     done.store(0, std::memory_order_relaxed);
-    frame_idx = 0;
+    packets = last_packet = NULL;
+    size = 0;
+    frame_idx = out_idx = 0;
+    cb_caching = false;
+    time_first = time_last = time_handed = time_done = 0;
     parent = NULL;
     name_template = NULL;
-    storer = NULL;
+    processor = NULL;
     next = NULL; 
   }
 
@@ -375,16 +630,17 @@ public:
    *  @param parent is a pointer to the object holding this file, which is
    *         frames_handler
    *  @param next is used to chain files
-   *  @param storer this object is used to store j2k codestreams
+   *  @param processor this object is used to store or decode j2k 
+   *         codestreams
    *  @param name_template file name template to use for storeing files
    */
-  void init(frames_handler* parent, stex_file* next, j2k_frame_storer *storer,
-            const char *name_template)
+  void init(frames_handler* parent, stex_file* next, 
+            thds::worker_thread_base *processor, const char *name_template)
   {
     this->parent = parent;
     this->name_template = name_template;
     this->next = next;
-    this->storer = storer;
+    this->processor = processor;
   }
 
   /**
@@ -397,16 +653,43 @@ public:
    */
   void notify_file_completion();
 
+  /**
+   *  @brief appends a packet's payload to the codestream
+   *
+   *  @param p is the packet, which becomes part of this file until it is
+   *         recycled
+   */
+  void add_packet(rtp_packet* p);
+
+  /**
+   *  @brief writes the codestream to a file
+   *
+   *  @param fh is the target file
+   *  @return true on success
+   */
+  bool write(FILE *fh) const;
+
 public:  
-  ojph::mem_outfile f;    //!<holds in-memory j2k codestream
+  rtp_packet* packets;    //!<chain of packets holding the j2k codestream
+  rtp_packet* last_packet;//!<the last packet in the chain
+  size_t size;            //!<number of codestream bytes in the chain
   ui32 time_stamp;        //!<time stamp at which this file must be displayed
   ui32 last_seen_seq;     //!<the last seen RTP sequence number
   std::atomic_int done;   //!<saving is completed when 0 is reached
   ui32 frame_idx;         //!<frame number in the sequence
+  bool cb_caching;        //!<the frame signals codeblock caching
+  ui32 out_idx;           //!<position of this frame in the output stream
+  ui64 time_first;        //!<reception time of the first packet
+  ui64 time_last;         //!<reception time of the last packet
+  ui64 time_handed;       //!<time this file was handed to processor
+  ui64 time_done;         //!<time processing completed; it is set by the 
+                          // processing thread before done reaches 0
   frames_handler* parent; //!<the object holding this frame
 
   const char *name_template; //!<name template for saved files
-  j2k_frame_storer* storer;  //!<stores a j2k frame using another thread
+  thds::worker_thread_base* 
+    processor;               //!<stores or decodes a j2k frame using 
+                             //  another thread
 
   stex_file* next;        //!<used to create files chain
 };
@@ -443,6 +726,12 @@ public:
     num_complete_files.store(0);
     thread_pool = NULL;
     storers_store = NULL;
+    decoders_store = NULL;
+    packets = NULL;
+    writer = NULL;
+    num_out_frames = 0;
+    last_arrival_time = 0;
+    last_arrival_ts = 0;
   }
   /**
    *  @brief default destructor
@@ -457,13 +746,27 @@ public:
    *
    *  @param quiet when true, no messages are printed -- as of this writing
    *         the object prints no messages
-   *  @param target_name a template for the saved file names
+   *  @param target_name a template for the saved file names, or \"-\" 
+   *         to write all frames to stdout
+   *  @param decode when true, frames are decoded and raw samples are
+   *         saved; otherwise, j2k codestreams are saved
+   *  @param cb_cache when true, decoded codeblocks are cached so that
+   *         codeblocks repeated from earlier frames are not decoded
    *  @param thread_pool a thread pool for processing j2k codestreams
-   *         (saving)
+   *         (saving or decoding)
    * 
    */
-  void init(bool quiet, const char *target_name, 
-            thds::thread_pool* thread_pool);
+  void init(bool quiet, const char *target_name, bool decode, 
+            bool cb_cache, thds::thread_pool* thread_pool);
+
+  /**
+   *  @brief call this function to set the object that receives the packets
+   *         of processed frames
+   *
+   *  @param packets the packets_handler that supplies packets
+   */
+  void set_packets_handler(packets_handler* packets) 
+  { this->packets = packets; }
 
   /**
    *  @brief call this function to push rtp_packets to this object
@@ -473,8 +776,11 @@ public:
    *  smaller than the last observed sequential number is ignored.
    *
    *  @param p returns a pointer to the packet.
+   *  @return true if the packet became part of a frame, in which case it is
+   *          returned later using packets_handler::recycle_packets;
+   *          false if the packet can be reused immediately.
    */
-  void push(rtp_packet* p);
+  bool push(rtp_packet* p);
 
   /**
    *  @brief call this function to collect statistics about frames
@@ -485,10 +791,32 @@ public:
    *  @param trunc_frames returns the number of truncated frames
    *  @param lost_frames returns the number of lost frames -- for which the
    *                     main header payload packet was not received, but
-   *                     time stamp was observed
+   *                     time stamp was observed, or that were dropped
+   *                     because packets ran out
    */
   void get_stats(ui32& total_frames, ui32& trunc_frames, ui32& lost_frames);
 
+  /**
+   *  @brief call this function to collect latency statistics of frames
+   *
+   *  This must be called from the thread that pushes packets.  Frames that
+   *  are still being processed are not included.
+   *
+   *  @param stats receives a copy of the statistics
+   */
+  void get_latency_stats(frame_latency_stats& stats) const
+  { stats = latency; }
+
+  /**
+   *  @brief packets_handler calls this function when it runs out of 
+   *         packets, to get packets back
+   *
+   *  The packets of frames whose processing is complete are returned; if
+   *  there are none, the frame being assembled is dropped, counting it as
+   *  lost, and its packets are returned.
+   */
+  void reclaim_packets();
+
   /**
    *  @brief This function is not used, and therefore it is not clear how to
    *         use it.
@@ -517,6 +845,13 @@ private:
    */
   void check_files_in_processing();
 
+  /**
+   *  @brief returns the packets of a file to packets_handler
+   *
+   *  @param f the file; this must be called from the receiving thread
+   */
+  void recycle_file_packets(stex_file* f);
+
   /**
    *  @brief Handles complete/truncated files and send them for storing
    *
@@ -536,6 +871,7 @@ private:
   ui32 total_frames;        //!<total number of frames that were observed
   ui32 trunc_frames;        //!<truncated frames (because of a packet lostt)
   ui32 lost_frames;         //!<frames for which main header was not received
+                            //  or that were dropped
   stex_file* files_store;   //!<address for allocated files
   stex_file* in_use;        //!<the frame that is being filled with data
   stex_file* avail;         //!<available frames structures
@@ -546,6 +882,15 @@ private:
     thread_pool;            //!<thread pool for processing frames
   j2k_frame_storer* 
     storers_store;          //!<address for allocated frame storers
+  j2k_frame_decoder* 
+    decoders_store;         //!<address for allocated frame decoders
+  ordered_writer* writer;   //!<writes frames to stdout in order, or NULL
+  packets_handler* packets; //!<receives the packets of processed frames
+  ui32 num_out_frames;      //!<number of frames sent to writer
+  frame_latency_stats 
+    latency;                //!<latency statistics of frames
+  ui64 last_arrival_time;   //!<reception time of the last frame, for jitter
+  ui32 last_arrival_ts;     //!<RTP time stamp of the last frame
 };
 
 } // !stex namespace
@@ -35,6 +35,11 @@
 // Date: 23 April 2024
 //***************************************************************************/
 
+#include <cstring>
+#include "ojph_codestream.h"
+#include "ojph_params.h"
+#include "ojph_mem.h"
+#include "ojph_message.h"
 #include "threaded_frame_processors.h"
 
 namespace ojph
@@ -50,15 +55,228 @@ namespace stex
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+///////////////////////////////////////////////////////////////////////////////
+void ordered_writer::write(ui32 ticket, const void *data, size_t size)
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  condition.wait(lock, [this, ticket] { return next_ticket == ticket; });
+  if (size > 0 && fwrite(data, 1, size, fh) != size) {
+    OJPH_INFO(0x02000011, "Failed to write frame %d to the output stream",
+      ticket);
+  }
+  fflush(fh);
+  ++next_ticket;
+  lock.unlock();
+  condition.notify_all();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ordered_writer::write(ui32 ticket, const stex_file* file)
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  condition.wait(lock, [this, ticket] { return next_ticket == ticket; });
+  if (!file->write(fh)) {
+    OJPH_INFO(0x02000011, "Failed to write frame %d to the output stream",
+      ticket);
+  }
+  fflush(fh);
+  ++next_ticket;
+  lock.unlock();
+  condition.notify_all();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
 void j2k_frame_storer::execute()
 {
   //printf("saving file with index %d\n", file->frame_idx);
-  char buf[128], name[128];
-  snprintf(buf, 128, "%s.j2c", file->name_template);
-  snprintf(name, 128, buf, file->frame_idx);
-  file->f.write_to_file(name);
+  if (writer)
+    writer->write(file->out_idx, file);
+  else {
+    char buf[128], name[128];
+    snprintf(buf, 128, "%s.j2c", name_template);
+    snprintf(name, 128, buf, file->frame_idx);
+    FILE *fh = fopen(name, "wb");
+    if (fh == NULL) {
+      OJPH_INFO(0x02000014, "Failed to open %s for writing", name);
+    }
+    else {
+      if (!file->write(fh))
+        OJPH_INFO(0x02000015, "Failed writing to %s", name);
+      fclose(fh);
+    }
+  }
+  file->notify_file_completion();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// converts a decoded line to bytes_per_sample bytes per sample, clipping
+// samples to the range of the component
+static void convert_line(const line_buf *line, ui8 *dp, ui32 width,
+                         ui32 bit_depth, bool is_signed, 
+                         ui32 bytes_per_sample)
+{
+  si32 min_val = is_signed ? -(1 << (bit_depth - 1)) : 0;
+  si32 max_val = is_signed ? (1 << (bit_depth - 1)) - 1 
+                           : (si32)((1u << bit_depth) - 1);
+  const si32 *sp = line->i32;
+  if (bytes_per_sample == 1)
+    for (ui32 i = width; i > 0; --i) {
+      si32 val = *sp++;
+      val = val >= min_val ? val : min_val;
+      val = val <= max_val ? val : max_val;
+      *dp++ = (ui8)val;
+    }
+  else {
+    ui16 *p = (ui16 *)dp;
+    for (ui32 i = width; i > 0; --i) {
+      si32 val = *sp++;
+      val = val >= min_val ? val : min_val;
+      val = val <= max_val ? val : max_val;
+      *p++ = (ui16)val;
+    }
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+size_t j2k_frame_decoder::decode()
+{
+  packets_infile infile;
+  infile.open(file->packets, file->size);
+
+  ojph::codestream codestream;
+  codestream.enable_resilience(); // frames can be truncated
+  codestream.read_headers(&infile);
+  if (use_cb_cache || file->cb_caching)
+    codestream.set_codeblock_cache(&cb_cache);
+
+  param_siz siz = codestream.access_siz();
+  ui32 num_comps = siz.get_num_components();
+  ui32 max_bit_depth = 0;
+  size_t num_samples = 0;
+  for (ui32 c = 0; c < num_comps; ++c) {
+    max_bit_depth = ojph_max(max_bit_depth, siz.get_bit_depth(c));
+    num_samples += (size_t)siz.get_recon_width(c) * siz.get_recon_height(c);
+  }
+  if (max_bit_depth > 16)
+    OJPH_ERROR(0x02000011, "Decoding frame %d failed; decoded frames can "
+      "have a bit depth of up to 16 bits, but the codestream has %d bits",
+      file->frame_idx, max_bit_depth);
+  ui32 bytes_per_sample = max_bit_depth > 8 ? 2 : 1;
+  size_t frame_size = num_samples * bytes_per_sample;
+  if (frame_size > buf_size) {
+    ui8 *t = (ui8 *)realloc(buf, frame_size);
+    if (t == NULL)
+      OJPH_ERROR(0x02000012, "Decoding frame %d failed; cannot allocate "
+        "%zu bytes for the decoded frame", file->frame_idx, frame_size);
+    buf = t;
+    buf_size = frame_size;
+  }
+
+  // Colour transformed codestreams can only be pulled line-interleaved,
+  // which needs all components to have the same size
+  bool planar = !codestream.access_cod().is_using_color_transform();
+  if (!planar) {
+    point ds = siz.get_downsampling(0);
+    for (ui32 c = 1; c < num_comps; ++c) {
+      point t = siz.get_downsampling(c);
+      if (t.x != ds.x || t.y != ds.y)
+        OJPH_ERROR(0x02000013, "Decoding frame %d failed; all components "
+          "of a colour transformed codestream must have the same "
+          "downsampling", file->frame_idx);
+    }
+  }
+  codestream.set_planar(planar);
+  codestream.create();
+
+  if (planar)
+  {
+    ui8 *dp = buf;
+    for (ui32 c = 0; c < num_comps; ++c)
+    {
+      ui32 width = siz.get_recon_width(c);
+      ui32 height = siz.get_recon_height(c);
+      ui32 bit_depth = siz.get_bit_depth(c);
+      bool is_signed = siz.is_signed(c);
+      for (ui32 y = 0; y < height; ++y)
+      {
+        ui32 comp_num;
+        line_buf *line = codestream.pull(comp_num);
+        assert(comp_num == c);
+        convert_line(line, dp, width, bit_depth, is_signed, 
+          bytes_per_sample);
+        dp += (size_t)width * bytes_per_sample;
+      }
+    }
+  }
+  else
+  {
+    ui32 width = siz.get_recon_width(0);
+    ui32 height = siz.get_recon_height(0);
+    size_t plane_size = (size_t)width * height * bytes_per_sample;
+    for (ui32 y = 0; y < height; ++y)
+      for (ui32 c = 0; c < num_comps; ++c)
+      {
+        ui32 comp_num;
+        line_buf *line = codestream.pull(comp_num);
+        assert(comp_num == c);
+        ui8 *dp = buf + plane_size * c;
+        dp += (size_t)y * width * bytes_per_sample;
+        convert_line(line, dp, width, siz.get_bit_depth(c), 
+          siz.is_signed(c), bytes_per_sample);
+      }
+  }
+  codestream.close();
+
+  return frame_size;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void j2k_frame_decoder::execute()
+{
+  size_t frame_size = 0;
+  try {
+    frame_size = decode();
+  }
+  catch (const std::exception&)
+  {
+    // the error is already reported; the frame is dropped
+    frame_size = 0;
+  }
+
+  if (writer)
+    writer->write(file->out_idx, buf, frame_size);
+  else if (frame_size > 0) {
+    char buf[128], name[128];
+    snprintf(buf, 128, "%s.yuv", name_template);
+    snprintf(name, 128, buf, file->frame_idx);
+    FILE *fh = fopen(name, "wb");
+    if (fh == NULL) {
+      OJPH_INFO(0x02000012, "Failed to open %s for writing", name);
+    }
+    else {
+      if (fwrite(this->buf, 1, frame_size, fh) != frame_size)
+        OJPH_INFO(0x02000013, "Failed writing to %s", name);
+      fclose(fh);
+    }
+  }
   file->notify_file_completion();
 }
 
 } // !stex namespace
-} // !ojph namespace
\ No newline at end of file
+} // !ojph namespace
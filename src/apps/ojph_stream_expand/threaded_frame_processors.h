@@ -38,7 +38,10 @@
 #ifndef THREADED_FRAME_PROCESSOR_H
 #define THREADED_FRAME_PROCESSOR_H
 
+#include <cstdio>
+#include <cstdlib>
 #include "ojph_threads.h"
+#include "ojph_codestream.h"
 #include "stream_expand_support.h"
 
 namespace ojph
@@ -57,6 +60,66 @@ namespace stex
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+/*****************************************************************************/
+/** @brief Writes frames to one output stream, such as stdout, in order.
+ * 
+ *  Frames are processed concurrently by the threads of the thread_pool,
+ *  and can complete out of order.  Each frame is given a ticket, in the
+ *  order it is sent for processing, and a thread that finishes processing 
+ *  a frame waits until the frames with earlier tickets are written.
+ *  Tickets are handed to the thread_pool in order, which processes them in
+ *  order, and therefore a waiting thread cannot block an earlier ticket.
+ */
+class ordered_writer
+{
+public:
+  /**
+   * @brief default construction
+   */
+  ordered_writer() { fh = NULL; next_ticket = 0; }
+
+public:
+  /**
+   *  @brief call this function to set the output stream
+   * 
+   *  @param fh is the output stream, which must be opened in binary mode
+   */
+  void init(FILE *fh) { this->fh = fh; }
+
+  /**
+   *  @brief writes data when all frames with earlier tickets are written
+   * 
+   *  @param ticket is the frame's position in the output stream
+   *  @param data is the data to write
+   *  @param size is the number of bytes to write; it can be 0 for a frame
+   *         that could not be processed, which releases the ticket.
+   */
+  void write(ui32 ticket, const void *data, size_t size);
+
+  /**
+   *  @brief writes the codestream of a file when all frames with earlier
+   *         tickets are written
+   * 
+   *  @param ticket is the frame's position in the output stream
+   *  @param file is the file, whose codestream is held in packets
+   */
+  void write(ui32 ticket, const stex_file* file);
+
+private:
+  FILE *fh;                           //!<output stream
+  ui32 next_ticket;                   //!<the next ticket to write
+  std::mutex mutex;                   //!<protects next_ticket
+  std::condition_variable condition;  //!<signals a change in next_ticket
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
 /*****************************************************************************/
 /** @brief Saves a j2k frame to disk without decoding.
  * 
@@ -70,6 +133,7 @@ public:
   j2k_frame_storer() {
     file = NULL;
     name_template = NULL;
+    writer = NULL;
   }
   /**
    * @brief default destructor doing nothing
@@ -83,11 +147,15 @@ public:
    *  @param file is a stex_file holding the j2k codestream with other
    *         variables.
    *  @param name_template holds the a filename template
+   *  @param writer when not NULL, codestreams are written to this
+   *         ordered_writer instead of individual files
    */
-  void init(stex_file* file, const char* name_template)
+  void init(stex_file* file, const char* name_template,
+            ordered_writer* writer)
   {
     this->file = file;
     this->name_template = name_template;
+    this->writer = writer;
   }
 
   /**
@@ -99,6 +167,90 @@ public:
 private:
   stex_file* file;            //!<a j2k codestream file with other variables
   const char* name_template;  //!<a template for the target file name
+  ordered_writer* writer;     //!<when not NULL, the target output stream
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*****************************************************************************/
+/** @brief Decodes a j2k frame and saves the raw decoded samples.
+ * 
+ *  The codestream is decoded directly from the memory of the stex_file.
+ *  Decoded frames are saved in planar form, one component after the
+ *  other, using one byte per sample for bit depths up to 8, and two bytes
+ *  in the machine's native byte order for bit depths up to 16; this is the
+ *  same layout as .yuv files.  Colour transformed codestreams produce
+ *  planar RGB.
+ */
+struct j2k_frame_decoder : public thds::worker_thread_base
+{
+public:  
+  /**
+   * @brief default construction
+   */
+  j2k_frame_decoder() {
+    file = NULL;
+    name_template = NULL;
+    writer = NULL;
+    buf = NULL;
+    buf_size = 0;
+    use_cb_cache = false;
+  }
+  /**
+   * @brief default destructor, which frees the frame buffer
+   */
+  ~j2k_frame_decoder() override { if (buf) free(buf); }
+
+public:  
+  /**
+   *  @brief call this function to initialize its members
+   * 
+   *  @param file is a stex_file holding the j2k codestream with other
+   *         variables.
+   *  @param name_template holds the a filename template
+   *  @param writer when not NULL, decoded frames are written to this
+   *         ordered_writer instead of individual files
+   *  @param use_cb_cache when true, decoded codeblocks are cached across
+   *         the frames decoded by this object; frames that signal 
+   *         codeblock caching use the cache regardless
+   */
+  void init(stex_file* file, const char* name_template,
+            ordered_writer* writer, bool use_cb_cache)
+  {
+    this->file = file;
+    this->name_template = name_template;
+    this->writer = writer;
+    this->use_cb_cache = use_cb_cache;
+  }
+
+  /**
+   * @brief A thread from the thread_pool call this function to execute 
+   *        the task
+   */
+  void execute() override;
+
+private:
+  /**
+   * @brief decodes the codestream in file into buf
+   *
+   * @return the number of bytes of the decoded frame
+   */
+  size_t decode();
+
+private:
+  stex_file* file;            //!<a j2k codestream file with other variables
+  const char* name_template;  //!<a template for the target file name
+  ordered_writer* writer;     //!<when not NULL, the target output stream
+  ui8* buf;                   //!<holds the decoded frame
+  size_t buf_size;            //!<the size of buf in bytes
+  bool use_cb_cache;          //!<true to use cb_cache for all frames
+  codeblock_cache cb_cache;   //!<decoded codeblocks of earlier frames
 };
 
 } // !stex namespace
@@ -0,0 +1,328 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, Aous Naman
+// Copyright (c) 2026, Kakadu Software Pty Ltd, Australia
+// Copyright (c) 2026, The University of New South Wales, Australia
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: ojph_async_file.cpp
+// Author: Aous Naman
+// Date: 19 October 2026
+//***************************************************************************/
+
+#include <cassert>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+
+#include "ojph_arch.h"
+#include "ojph_message.h"
+#include "ojph_async_file.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#ifdef OJPH_OS_WINDOWS
+  #include <io.h>
+#else
+  #include <unistd.h>
+#endif
+
+namespace ojph
+{
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+async_outfile::async_outfile()
+{
+  fd = -1;
+  direct = false;
+  buf_size = 0;
+  file_end = 0;
+  cur = tasks;
+  failed = false;
+  for (int i = 0; i < 2; ++i)
+    tasks[i].owner = this;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+async_outfile::~async_outfile()
+{
+  if (fd != -1)
+  {
+    try {
+      close();
+    }
+    catch (const std::exception&) { // the error is already reported
+    }
+  }
+  for (int i = 0; i < 2; ++i)
+    if (tasks[i].store)
+      free(tasks[i].store);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void async_outfile::open(const char *filename, size_t buffer_size,
+                         bool direct_io)
+{
+  assert(fd == -1);
+  direct = false;
+#ifdef OJPH_OS_WINDOWS
+  ojph_unused(direct_io);
+  fd = _open(filename, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY,
+             _S_IREAD | _S_IWRITE);
+#else
+  int flags = O_WRONLY | O_CREAT | O_TRUNC;
+  #ifdef O_DIRECT
+  if (direct_io)
+  { // some file systems, such as tmpfs, do not support O_DIRECT
+    fd = ::open(filename, flags | O_DIRECT, 0644);
+    direct = fd != -1;
+  }
+  #else
+  ojph_unused(direct_io);
+  #endif
+  if (fd == -1)
+    fd = ::open(filename, flags, 0644);
+#endif
+  if (fd == -1)
+    OJPH_ERROR(0x000A0001, "unable to open file %s for writing", filename);
+
+  // buffers are a multiple of, and aligned to, direct_io_alignment
+  const size_t align = direct_io_alignment;
+  size_t size = ojph_max(buffer_size, align);
+  size = (size + align - 1) & ~(align - 1);
+  if (size != buf_size)
+  {
+    for (int i = 0; i < 2; ++i)
+    {
+      if (tasks[i].store)
+        free(tasks[i].store);
+      tasks[i].store = (ui8*)malloc(size + align - 1);
+      if (tasks[i].store == NULL)
+      {
+        buf_size = 0;
+        OJPH_ERROR(0x000A0002, "unable to allocate buffers for file %s",
+          filename);
+      }
+      size_t p = ((size_t)tasks[i].store + align - 1) & ~(align - 1);
+      tasks[i].data = (ui8*)p;
+    }
+    buf_size = size;
+  }
+
+  for (int i = 0; i < 2; ++i)
+  {
+    tasks[i].used = 0;
+    tasks[i].offset = 0;
+    tasks[i].busy = false;
+  }
+  cur = tasks;
+  file_end = 0;
+  failed = false;
+  if (writer.get_num_threads() == 0)
+    writer.init(1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+size_t async_outfile::write(const void *ptr, size_t size)
+{
+  assert(fd != -1);
+  check_error();
+  const ui8 *p = (const ui8 *)ptr;
+  size_t bytes_left = size;
+  while (bytes_left > 0)
+  {
+    size_t bytes = ojph_min(bytes_left, buf_size - cur->used);
+    memcpy(cur->data + cur->used, p, bytes);
+    cur->used += bytes;
+    p += bytes;
+    bytes_left -= bytes;
+    if (cur->used == buf_size)
+      submit(tell());
+  }
+  return size;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int async_outfile::seek(si64 offset, enum outfile_base::seek origin)
+{
+  assert(fd != -1);
+  check_error();
+  si64 pos;
+  if (origin == OJPH_SEEK_SET)
+    pos = offset;
+  else if (origin == OJPH_SEEK_CUR)
+    pos = tell() + offset;
+  else if (origin == OJPH_SEEK_END)
+    pos = ojph_max(file_end, tell()) + offset;
+  else
+    return -1;
+
+  if (pos < 0)
+    return -1;
+  if (pos != tell())
+    submit(pos);
+  return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void async_outfile::flush()
+{
+  assert(fd != -1);
+  submit(tell());
+  wait_for(tasks[0]);
+  wait_for(tasks[1]);
+  check_error();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void async_outfile::close()
+{
+  assert(fd != -1);
+  submit(tell());
+  wait_for(tasks[0]);
+  wait_for(tasks[1]);
+#ifdef OJPH_OS_WINDOWS
+  _close(fd);
+#else
+  ::close(fd);
+#endif
+  fd = -1;
+  check_error();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void async_outfile::submit(si64 next_offset)
+{
+  write_task *t = cur;
+  if (t->used > 0)
+  {
+    file_end = ojph_max(file_end, t->offset + (si64)t->used);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      t->busy = true;
+    }
+    writer.add_task(t);
+    cur = t == tasks ? tasks + 1 : tasks;
+    wait_for(*cur);
+  }
+  cur->used = 0;
+  cur->offset = next_offset;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void async_outfile::wait_for(write_task& task)
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  condition.wait(lock, [&task] { return !task.busy; });
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void async_outfile::check_error()
+{
+  bool error;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    error = failed;
+    failed = false;
+  }
+  if (error)
+    OJPH_ERROR(0x000A0003, "error writing to a file");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool async_outfile::write_task_data(const write_task& task)
+{
+  const ui8 *p = task.data;
+  size_t bytes_left = task.used;
+  si64 offset = task.offset;
+#ifdef OJPH_OS_WINDOWS
+  if (_lseeki64(fd, offset, SEEK_SET) != offset)
+    return false;
+  while (bytes_left > 0)
+  {
+    int bytes = _write(fd, p, (unsigned)ojph_min(bytes_left, (size_t)1 << 30));
+    if (bytes <= 0)
+      return false;
+    p += bytes;
+    bytes_left -= (size_t)bytes;
+  }
+  return true;
+#else
+  #ifdef O_DIRECT
+  // O_DIRECT needs aligned offsets and sizes; other buffers, such as the
+  // last one, are written through the page cache
+  bool unaligned = direct && ((ui64)offset % direct_io_alignment != 0 
+    || bytes_left % direct_io_alignment != 0);
+  if (unaligned)
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_DIRECT);
+  #endif
+
+  bool success = true;
+  while (bytes_left > 0 && success)
+  {
+    ssize_t bytes = pwrite(fd, p, bytes_left, (off_t)offset);
+    if (bytes < 0 && errno == EINTR)
+      continue;
+    success = bytes > 0;
+    if (success)
+    {
+      p += bytes;
+      bytes_left -= (size_t)bytes;
+      offset += bytes;
+    }
+  }
+
+  #ifdef O_DIRECT
+  if (unaligned)
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_DIRECT);
+  #endif
+  return success;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void async_outfile::write_task::execute()
+{
+  bool success = owner->write_task_data(*this);
+  std::lock_guard<std::mutex> lock(owner->mutex);
+  if (!success)
+    owner->failed = true;
+  busy = false;
+  owner->condition.notify_all();
+}
+
+} // !ojph namespace
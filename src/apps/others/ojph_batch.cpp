@@ -0,0 +1,369 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, Aous Naman
+// Copyright (c) 2026, Kakadu Software Pty Ltd, Australia
+// Copyright (c) 2026, The University of New South Wales, Australia
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: ojph_batch.cpp
+// Author: Aous Naman
+// Date: 19 October 2026
+//***************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <mutex>
+
+#include "ojph_arch.h"
+#include "ojph_message.h"
+#include "ojph_threads.h"
+#include "ojph_batch.h"
+
+#ifdef OJPH_OS_WINDOWS
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+  #include <sys/types.h>
+  #include <sys/stat.h>
+#else
+  #include <dirent.h>
+  #include <sys/stat.h>
+#endif
+
+namespace ojph
+{
+namespace batch
+{
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+static bool is_directory(const char *name)
+{
+#ifdef OJPH_OS_WINDOWS
+  DWORD attr = GetFileAttributesA(name);
+  return attr != INVALID_FILE_ATTRIBUTES
+    && (attr & FILE_ATTRIBUTE_DIRECTORY) != 0;
+#else
+  struct stat st;
+  return stat(name, &st) == 0 && S_ISDIR(st.st_mode);
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static ui64 get_file_size(const char *name)
+{
+#ifdef OJPH_OS_WINDOWS
+  struct __stat64 st;
+  return _stat64(name, &st) == 0 ? (ui64)st.st_size : 0;
+#else
+  struct stat st;
+  return stat(name, &st) == 0 ? (ui64)st.st_size : 0;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static bool has_extension(const char *name, const char * const *extensions)
+{
+  const char *ext = strrchr(name, '.');
+  if (ext == NULL)
+    return false;
+  for (; *extensions != NULL; ++extensions)
+  {
+    const char *p = ext, *q = *extensions;
+    while (*p && tolower(*p) == tolower(*q)) { ++p; ++q; }
+    if (*p == 0 && *q == 0)
+      return true;
+  }
+  return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void list_directory(const char *dir_name,
+                           const char * const *extensions,
+                           std::vector<std::string>& files)
+{
+  std::string dir(dir_name);
+  if (!dir.empty() && dir.back() != '/' && dir.back() != '\\')
+    dir += '/';
+
+#ifdef OJPH_OS_WINDOWS
+  WIN32_FIND_DATAA data;
+  HANDLE h = FindFirstFileA((dir + "*").c_str(), &data);
+  if (h == INVALID_HANDLE_VALUE)
+    OJPH_ERROR(0x00090001, "Unable to open directory %s", dir_name);
+  do {
+    if ((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0
+        && has_extension(data.cFileName, extensions))
+      files.push_back(dir + data.cFileName);
+  } while (FindNextFileA(h, &data));
+  FindClose(h);
+#else
+  DIR *d = opendir(dir_name);
+  if (d == NULL)
+    OJPH_ERROR(0x00090001, "Unable to open directory %s", dir_name);
+  struct dirent *e;
+  while ((e = readdir(d)) != NULL)
+  {
+    if (e->d_name[0] == '.' || !has_extension(e->d_name, extensions))
+      continue;
+    std::string name = dir + e->d_name;
+    struct stat st;
+    if (stat(name.c_str(), &st) == 0 && S_ISREG(st.st_mode))
+      files.push_back(name);
+  }
+  closedir(d);
+#endif
+
+  std::sort(files.begin(), files.end());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void read_list_file(const char *list_name,
+                           std::vector<std::string>& files)
+{
+  FILE *f = fopen(list_name, "r");
+  if (f == NULL)
+    OJPH_ERROR(0x00090002, "Unable to open file %s", list_name);
+
+  std::string line;
+  int c;
+  do {
+    c = fgetc(f);
+    if (c == '\n' || c == EOF)
+    {
+      while (!line.empty() && (line.back() == '\r' || line.back() == ' '
+             || line.back() == '\t'))
+        line.pop_back();
+      if (!line.empty() && line[0] != '#')
+        files.push_back(line);
+      line.clear();
+    }
+    else
+      line += (char)c;
+  } while (c != EOF);
+  fclose(f);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void collect_files(const char *source, const char * const *extensions,
+                   std::vector<std::string>& files)
+{
+  files.clear();
+  if (is_directory(source))
+    list_directory(source, extensions, files);
+  else
+    read_list_file(source, files);
+  if (files.empty())
+    OJPH_ERROR(0x00090003, "No files to process were found in %s", source);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::string make_output_filename(const char *output_dir,
+                                 const char *input_filename,
+                                 const char *extension)
+{
+  const char *name = input_filename;
+  for (const char *p = input_filename; *p; ++p)
+    if (*p == '/' || *p == '\\')
+      name = p + 1;
+  const char *ext = strrchr(name, '.');
+  size_t len = ext ? (size_t)(ext - name) : strlen(name);
+
+  std::string result(output_dir);
+  if (!result.empty() && result.back() != '/' && result.back() != '\\')
+    result += '/';
+  result.append(name, len);
+  result += extension;
+  return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void check_output_filenames(const std::vector<std::string>& inputs,
+                            const std::vector<std::string>& outputs)
+{
+  assert(inputs.size() == outputs.size());
+  std::vector<size_t> order(outputs.size());
+  for (size_t i = 0; i < order.size(); ++i)
+    order[i] = i;
+  std::sort(order.begin(), order.end(), 
+    [&outputs](size_t a, size_t b) { return outputs[a] < outputs[b]; });
+  for (size_t i = 1; i < order.size(); ++i)
+    if (outputs[order[i - 1]] == outputs[order[i]])
+      OJPH_ERROR(0x00090004, "%s and %s would both be written to %s; "
+        "please rename one of them, or process them in separate batches",
+        inputs[order[i - 1]].c_str(), inputs[order[i]].c_str(),
+        outputs[order[i]].c_str());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+//
+//
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+/*****************************************************************************/
+/** @brief The state shared by the threads of a batch
+ */
+struct batch_state
+{
+  const std::vector<std::string> *inputs;
+  const std::vector<std::string> *outputs;
+  std::atomic<size_t> next_file;   // the next file to hand out
+  std::atomic<ui32> num_failed;
+  std::atomic<ui64> input_bytes, output_bytes;
+  std::mutex mutex;
+  std::condition_variable cv;
+  ui32 num_running;                // tasks that have not finished yet
+};
+
+/*****************************************************************************/
+/** @brief A thread_pool task that processes files until none is left
+ */
+class batch_task : public thds::worker_thread_base
+{
+public:
+  batch_task() { state = NULL; processor = NULL; }
+  void init(batch_state *state, file_processor *processor)
+  { this->state = state; this->processor = processor; }
+
+  void execute() override
+  {
+    process_files();
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (--state->num_running == 0)
+      state->cv.notify_one();
+  }
+
+  void process_files()
+  {
+    size_t num_files = state->inputs->size();
+    size_t i;
+    while ((i = state->next_file.fetch_add(1)) < num_files)
+    {
+      const char *in = (*state->inputs)[i].c_str();
+      const char *out = (*state->outputs)[i].c_str();
+      try {
+        processor->process(in, out);
+        state->input_bytes += get_file_size(in);
+        state->output_bytes += get_file_size(out);
+      }
+      catch (const std::exception& e)
+      {
+        const char *p = e.what();
+        if (strncmp(p, "ojph error", 10) != 0)
+          printf("%s\n", p);
+        printf("Failed to process %s\n", in);
+        ++state->num_failed;
+      }
+    }
+  }
+
+private:
+  batch_state *state;
+  file_processor *processor;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+void run(const std::vector<std::string>& inputs,
+         const std::vector<std::string>& outputs,
+         file_processor **processors, ui32 num_processors,
+         batch_stats& stats)
+{
+  assert(inputs.size() == outputs.size() && num_processors > 0);
+
+  batch_state state;
+  state.inputs = &inputs;
+  state.outputs = &outputs;
+  state.next_file = 0;
+  state.num_failed = 0;
+  state.input_bytes = state.output_bytes = 0;
+  state.num_running = num_processors;
+
+  std::chrono::steady_clock::time_point begin =
+    std::chrono::steady_clock::now();
+
+  std::vector<batch_task> tasks(num_processors);
+  for (ui32 i = 0; i < num_processors; ++i)
+    tasks[i].init(&state, processors[i]);
+
+  if (num_processors == 1)
+    tasks[0].process_files();
+  else
+  {
+    thds::thread_pool pool;
+    pool.init(num_processors);
+    for (ui32 i = 0; i < num_processors; ++i)
+      pool.add_task(&tasks[i]);
+    std::unique_lock<std::mutex> lock(state.mutex);
+    state.cv.wait(lock, [&state] { return state.num_running == 0; });
+  }
+
+  std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - begin;
+
+  stats.num_files = (ui32)inputs.size();
+  stats.num_failed = state.num_failed;
+  stats.input_bytes = state.input_bytes;
+  stats.output_bytes = state.output_bytes;
+  stats.elapsed_secs = elapsed.count();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void print_stats(const batch_stats& stats)
+{
+  double in_mb = (double)stats.input_bytes / 1048576.0;
+  double out_mb = (double)stats.output_bytes / 1048576.0;
+  double secs = stats.elapsed_secs > 0.0 ? stats.elapsed_secs : 1e-9;
+  printf("Processed %u of %u files in %f seconds\n",
+    stats.num_files - stats.num_failed, stats.num_files,
+    stats.elapsed_secs);
+  printf("Input = %.3f MB, output = %.3f MB\n", in_mb, out_mb);
+  printf("Throughput = %.3f files/s, %.3f MB/s input, "
+    "%.3f MB/s output\n", (stats.num_files - stats.num_failed) / secs,
+    in_mb / secs, out_mb / secs);
+}
+
+} // !batch namespace
+} // !ojph namespace
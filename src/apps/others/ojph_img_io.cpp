@@ -36,6 +36,7 @@
 //***************************************************************************/
 
 
+#include <cctype>
 #include <cstdlib>
 #include <cstring>
 
@@ -44,6 +45,20 @@
 #include "ojph_mem.h"
 #include "ojph_message.h"
 
+#ifdef OJPH_OS_WINDOWS
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+  #include <fcntl.h>
+  #include <io.h>
+#elif !defined(OJPH_EMSCRIPTEN)
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
 namespace ojph {
 
   /////////////////////////////////////////////////////////////////////////////
@@ -232,6 +247,890 @@ namespace ojph {
     }
   }
 
+  void gen_cvrt_32b1c_to_16ub1c_le_msb10(const line_buf *ln0, 
+                                         const line_buf *ln1, 
+                                         const line_buf *ln2, void *dp, 
+                                         ui32 bit_depth, ui32 count)
+  {
+    ojph_unused(ln1);
+    ojph_unused(ln2);
+    int max_val = (1<<bit_depth) - 1;
+    const si32 *sp = ln0->i32;
+    ui16* p = (ui16*)dp;
+    for (; count > 0; --count)
+    {
+      int val = *sp++;
+      val = val >= 0 ? val : 0;
+      val = val <= max_val ? val : max_val;
+      *p++ = (ui16)(val << 6);
+    }
+  }
+
+  void gen_cvrt_8ub1c_to_32b1c(const void *sp, si32 *dp, ui32 comp_num, 
+                               ui32 count)
+  {
+    ojph_unused(comp_num);
+    const ui8 *p = (const ui8*)sp;
+    for (; count > 0; --count)
+      *dp++ = (si32)*p++;
+  }
+
+  void gen_cvrt_8ub3c_to_32b1c(const void *sp, si32 *dp, ui32 comp_num, 
+                               ui32 count)
+  {
+    const ui8 *p = (const ui8*)sp + comp_num;
+    for (; count > 0; --count, p += 3)
+      *dp++ = (si32)*p;
+  }
+
+  void gen_cvrt_8sb1c_to_32b1c(const void *sp, si32 *dp, ui32 comp_num, 
+                               ui32 count)
+  {
+    ojph_unused(comp_num);
+    const si8 *p = (const si8*)sp;
+    for (; count > 0; --count)
+      *dp++ = (si32)*p++;
+  }
+
+  void gen_cvrt_16ub1c_le_to_32b1c(const void *sp, si32 *dp, ui32 comp_num, 
+                                   ui32 count)
+  {
+    ojph_unused(comp_num);
+    const ui16 *p = (const ui16*)sp;
+    for (; count > 0; --count)
+      *dp++ = (si32)*p++;
+  }
+
+  void gen_cvrt_16ub3c_le_to_32b1c(const void *sp, si32 *dp, ui32 comp_num, 
+                                   ui32 count)
+  {
+    const ui16 *p = (const ui16*)sp + comp_num;
+    for (; count > 0; --count, p += 3)
+      *dp++ = (si32)*p;
+  }
+
+  void gen_cvrt_16ub1c_be_to_32b1c(const void *sp, si32 *dp, ui32 comp_num, 
+                                   ui32 count)
+  {
+    ojph_unused(comp_num);
+    const ui16 *p = (const ui16*)sp;
+    for (; count > 0; --count)
+      *dp++ = (si32)be2le(*p++);
+  }
+
+  void gen_cvrt_16ub3c_be_to_32b1c(const void *sp, si32 *dp, ui32 comp_num, 
+                                   ui32 count)
+  {
+    const ui16 *p = (const ui16*)sp + comp_num;
+    for (; count > 0; --count, p += 3)
+      *dp++ = (si32)be2le(*p);
+  }
+
+  void gen_cvrt_16sb1c_le_to_32b1c(const void *sp, si32 *dp, ui32 comp_num, 
+                                   ui32 count)
+  {
+    ojph_unused(comp_num);
+    const si16 *p = (const si16*)sp;
+    for (; count > 0; --count)
+      *dp++ = (si32)*p++;
+  }
+
+  void gen_cvrt_10b3c_le_to_32b1c(const void *sp, si32 *dp, ui32 comp_num, 
+                                  ui32 count)
+  {
+    ui32 shift = 22 - 10 * comp_num;
+    const ui32 *p = (const ui32*)sp;
+    for (; count > 0; --count)
+      *dp++ = (si32)((*p++ >> shift) & 0x3FF);
+  }
+
+  void gen_cvrt_10b3c_be_to_32b1c(const void *sp, si32 *dp, ui32 comp_num, 
+                                  ui32 count)
+  {
+    ui32 shift = 22 - 10 * comp_num;
+    const ui32 *p = (const ui32*)sp;
+    for (; count > 0; --count)
+      *dp++ = (si32)((be2le(*p++) >> shift) & 0x3FF);
+  }
+
+  void gen_cvrt_8ub2c_to_32b1c(const void *sp, si32 *dp, ui32 comp_num, 
+                               ui32 count)
+  {
+    const ui8 *p = (const ui8*)sp + comp_num;
+    for (; count > 0; --count, p += 2)
+      *dp++ = (si32)*p;
+  }
+
+  void gen_cvrt_8ub4c_to_32b1c(const void *sp, si32 *dp, ui32 comp_num, 
+                               ui32 count)
+  {
+    const ui8 *p = (const ui8*)sp + comp_num;
+    for (; count > 0; --count, p += 4)
+      *dp++ = (si32)*p;
+  }
+
+  void gen_cvrt_16ub2c_le_to_32b1c(const void *sp, si32 *dp, ui32 comp_num, 
+                                   ui32 count)
+  {
+    const ui16 *p = (const ui16*)sp + comp_num;
+    for (; count > 0; --count, p += 2)
+      *dp++ = (si32)*p;
+  }
+
+  void gen_cvrt_16ub1c_le_msb10_to_32b1c(const void *sp, si32 *dp, 
+                                         ui32 comp_num, ui32 count)
+  {
+    ojph_unused(comp_num);
+    const ui16 *p = (const ui16*)sp;
+    for (; count > 0; --count)
+      *dp++ = (si32)(*p++ >> 6);
+  }
+
+  void gen_cvrt_16ub2c_le_msb10_to_32b1c(const void *sp, si32 *dp, 
+                                         ui32 comp_num, ui32 count)
+  {
+    const ui16 *p = (const ui16*)sp + comp_num;
+    for (; count > 0; --count, p += 2)
+      *dp++ = (si32)(*p >> 6);
+  }
+
+  // a v210 group of 4 32-bit words holds 6 Y, 3 Cb, and 3 Cr samples; 
+  // these give the word and the bit position of each sample of a component
+  // in a group
+  static const ui32 v210_word[3][6] = 
+    { {0, 1, 1, 2, 3, 3}, {0, 1, 2}, {0, 2, 3} };
+  static const ui32 v210_shift[3][6] = 
+    { {10, 0, 20, 10, 0, 20}, {0, 10, 20}, {20, 0, 10} };
+
+  void gen_cvrt_v210_to_32b1c(const void *sp, si32 *dp, ui32 comp_num, 
+                              ui32 count)
+  {
+    const ui32 *word = v210_word[comp_num], *shift = v210_shift[comp_num];
+    ui32 samples_per_group = comp_num == 0 ? 6 : 3;
+    const ui32 *p = (const ui32*)sp;
+    for (ui32 i = 0; count > 0; --count)
+    {
+      *dp++ = (si32)((p[word[i]] >> shift[i]) & 0x3FF);
+      if (++i == samples_per_group)
+      {
+        i = 0;
+        p += 4;
+      }
+    }
+  }
+
+  void gen_cvrt_32b1c_to_8ub2c(const line_buf *ln, void *dp, 
+                               ui32 comp_num, ui32 bit_depth, ui32 count)
+  {
+    int max_val = (1 << bit_depth) - 1;
+    const si32 *sp = ln->i32;
+    ui8 *p = (ui8*)dp + comp_num;
+    for (; count > 0; --count, p += 2)
+    {
+      int val = *sp++;
+      val = val >= 0 ? val : 0;
+      val = val <= max_val ? val : max_val;
+      *p = (ui8)val;
+    }
+  }
+
+  void gen_cvrt_32b1c_to_8ub4c(const line_buf *ln, void *dp, 
+                               ui32 comp_num, ui32 bit_depth, ui32 count)
+  {
+    int max_val = (1 << bit_depth) - 1;
+    const si32 *sp = ln->i32;
+    ui8 *p = (ui8*)dp + comp_num;
+    for (; count > 0; --count, p += 4)
+    {
+      int val = *sp++;
+      val = val >= 0 ? val : 0;
+      val = val <= max_val ? val : max_val;
+      *p = (ui8)val;
+    }
+  }
+
+  void gen_cvrt_32b1c_to_16ub2c_le(const line_buf *ln, void *dp, 
+                                   ui32 comp_num, ui32 bit_depth, 
+                                   ui32 count)
+  {
+    int max_val = (1 << bit_depth) - 1;
+    const si32 *sp = ln->i32;
+    ui16 *p = (ui16*)dp + comp_num;
+    for (; count > 0; --count, p += 2)
+    {
+      int val = *sp++;
+      val = val >= 0 ? val : 0;
+      val = val <= max_val ? val : max_val;
+      *p = (ui16)val;
+    }
+  }
+
+  void gen_cvrt_32b1c_to_16ub2c_le_msb10(const line_buf *ln, void *dp, 
+                                         ui32 comp_num, ui32 bit_depth, 
+                                         ui32 count)
+  {
+    int max_val = (1 << bit_depth) - 1;
+    const si32 *sp = ln->i32;
+    ui16 *p = (ui16*)dp + comp_num;
+    for (; count > 0; --count, p += 2)
+    {
+      int val = *sp++;
+      val = val >= 0 ? val : 0;
+      val = val <= max_val ? val : max_val;
+      *p = (ui16)(val << 6);
+    }
+  }
+
+  void gen_cvrt_32b1c_to_v210(const line_buf *ln, void *dp, 
+                              ui32 comp_num, ui32 bit_depth, ui32 count)
+  {
+    int max_val = (1 << bit_depth) - 1;
+    const ui32 *word = v210_word[comp_num], *shift = v210_shift[comp_num];
+    ui32 samples_per_group = comp_num == 0 ? 6 : 3;
+    const si32 *sp = ln->i32;
+    ui32 *p = (ui32*)dp;
+    for (ui32 i = 0; count > 0; --count)
+    {
+      int val = *sp++;
+      val = val >= 0 ? val : 0;
+      val = val <= max_val ? val : max_val;
+      ui32 &w = p[word[i]];
+      w = (w & ~(0x3FFu << shift[i])) | ((ui32)val << shift[i]);
+      if (++i == samples_per_group)
+      {
+        i = 0;
+        p += 4;
+      }
+    }
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  //
+  // Memory-mapped files
+  //
+  //
+  ////////////////////////////////////////////////////////////////////////////
+
+  /////////////////////////////////////////////////////////////////////////////
+  bool mmap_in_file::open(const char* filename, bool sequential)
+  {
+    assert(data == NULL);
+#ifdef OJPH_OS_WINDOWS
+    HANDLE f = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, 
+      OPEN_EXISTING, sequential ? FILE_FLAG_SEQUENTIAL_SCAN : 0, NULL);
+    if (f == INVALID_HANDLE_VALUE)
+      return false;
+    LARGE_INTEGER sz;
+    if (!GetFileSizeEx(f, &sz) || sz.QuadPart <= 0 
+        || (ui64)sz.QuadPart > (ui64)SIZE_MAX)
+    {
+      CloseHandle(f);
+      return false;
+    }
+    HANDLE m = CreateFileMappingA(f, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (m == NULL)
+    {
+      CloseHandle(f);
+      return false;
+    }
+    void* p = MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0);
+    if (p == NULL)
+    {
+      CloseHandle(m);
+      CloseHandle(f);
+      return false;
+    }
+    file_h = f;
+    map_h = m;
+    data = (const ui8*)p;
+    data_size = (size_t)sz.QuadPart;
+    return true;
+#elif defined(OJPH_EMSCRIPTEN)
+    ojph_unused(filename);
+    ojph_unused(sequential);
+    return false;
+#else
+    int f = ::open(filename, O_RDONLY);
+    if (f == -1)
+      return false;
+    struct stat st;
+    if (fstat(f, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0
+        || (ui64)st.st_size > (ui64)SIZE_MAX)
+    {
+      ::close(f);
+      return false;
+    }
+    void* p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, f, 0);
+    if (p == MAP_FAILED)
+    {
+      ::close(f);
+      return false;
+    }
+    if (sequential)
+      madvise(p, (size_t)st.st_size, MADV_SEQUENTIAL);
+    fd = f;
+    data = (const ui8*)p;
+    data_size = (size_t)st.st_size;
+    return true;
+#endif
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void mmap_in_file::close()
+  {
+#ifdef OJPH_OS_WINDOWS
+    if (data)
+      UnmapViewOfFile(data);
+    if (map_h)
+      CloseHandle(map_h);
+    if (file_h)
+      CloseHandle(file_h);
+#elif !defined(OJPH_EMSCRIPTEN)
+    if (data)
+      munmap((void*)data, data_size);
+    if (fd != -1)
+      ::close(fd);
+#endif
+    data = NULL;
+    data_size = 0;
+    fd = -1;
+    file_h = map_h = NULL;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // the size of the windows of an mmap_out_file; a multiple of the 
+  // granularity of mapping offsets of supported systems
+  static const size_t mmap_out_window_size = (size_t)1 << 24;
+
+  /////////////////////////////////////////////////////////////////////////////
+  bool mmap_out_file::open(const char* filename)
+  {
+    assert(!is_open());
+    if (is_standard_stream(filename))
+      return false;
+    window = NULL;
+    window_start = pos = 0;
+    window_size = mmap_out_window_size;
+#ifdef OJPH_OS_WINDOWS
+    HANDLE f = CreateFileA(filename, GENERIC_READ | GENERIC_WRITE, 0, NULL,
+      CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, 
+      NULL);
+    if (f == INVALID_HANDLE_VALUE)
+      return false;
+    if (GetFileType(f) != FILE_TYPE_DISK)
+    {
+      CloseHandle(f);
+      return false;
+    }
+    file_h = f;
+    return true;
+#elif defined(OJPH_EMSCRIPTEN)
+    ojph_unused(filename);
+    return false;
+#else
+    int f = ::open(filename, O_RDWR | O_CREAT | O_TRUNC, 0666);
+    if (f == -1)
+      return false;
+    struct stat st;
+    if (fstat(f, &st) != 0 || !S_ISREG(st.st_mode))
+    {
+      ::close(f);
+      return false;
+    }
+    fd = f;
+    return true;
+#endif
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  bool mmap_out_file::map_window()
+  {
+    unmap_window();
+    window_start = pos;
+#if !defined(OJPH_OS_LINUX) && !defined(OJPH_EMSCRIPTEN)
+    si64 end = window_start + (si64)window_size;
+#endif
+#ifdef OJPH_OS_WINDOWS
+    // the mapping object extends the file to the end of the window
+    HANDLE m = CreateFileMappingA(file_h, NULL, PAGE_READWRITE, 
+      (DWORD)((ui64)end >> 32), (DWORD)end, NULL);
+    if (m == NULL)
+      return false;
+    void* p = MapViewOfFile(m, FILE_MAP_WRITE, 
+      (DWORD)((ui64)window_start >> 32), (DWORD)window_start, window_size);
+    if (p == NULL)
+    {
+      CloseHandle(m);
+      return false;
+    }
+    map_h = m;
+#elif defined(OJPH_EMSCRIPTEN)
+    return false;
+#else
+    // reserving the window's blocks reports a full disk here, rather than
+    // by a signal when the mapped memory is written
+  #ifdef OJPH_OS_LINUX
+    if (posix_fallocate(fd, (off_t)window_start, (off_t)window_size) != 0)
+      return false;
+  #else
+    if (ftruncate(fd, (off_t)end) != 0)
+      return false;
+  #endif
+    void* p = mmap(NULL, window_size, PROT_READ | PROT_WRITE, MAP_SHARED, 
+                   fd, (off_t)window_start);
+    if (p == MAP_FAILED)
+      return false;
+    madvise(p, window_size, MADV_SEQUENTIAL);
+#endif
+    window = (ui8*)p;
+    return true;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void mmap_out_file::unmap_window()
+  {
+    if (window == NULL)
+      return;
+#ifdef OJPH_OS_WINDOWS
+    UnmapViewOfFile(window);
+    CloseHandle(map_h);
+    map_h = NULL;
+#elif !defined(OJPH_EMSCRIPTEN)
+    munmap(window, window_size);
+#endif
+    window = NULL;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  bool mmap_out_file::write(const void* p, size_t size)
+  {
+    assert(is_open());
+    const ui8* sp = (const ui8*)p;
+    while (size > 0)
+    {
+      si64 window_end = window_start + (si64)window_size;
+      if (window == NULL || pos >= window_end)
+      {
+        if (!map_window())
+          return false;
+        window_end = window_start + (si64)window_size;
+      }
+      size_t bytes = ojph_min(size, (size_t)(window_end - pos));
+      memcpy(window + (pos - window_start), sp, bytes);
+      pos += (si64)bytes;
+      sp += bytes;
+      size -= bytes;
+    }
+    return true;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void mmap_out_file::close()
+  {
+    unmap_window();
+#ifdef OJPH_OS_WINDOWS
+    if (file_h)
+    {
+      LARGE_INTEGER end;
+      end.QuadPart = pos;
+      SetFilePointerEx(file_h, end, NULL, FILE_BEGIN);
+      SetEndOfFile(file_h);
+      CloseHandle(file_h);
+    }
+#elif !defined(OJPH_EMSCRIPTEN)
+    if (fd != -1)
+    {
+      if (ftruncate(fd, (off_t)pos) != 0)
+        OJPH_WARN(0x03000201, "unable to set the size of a mapped file");
+      ::close(fd);
+    }
+#endif
+    window_start = pos = 0;
+    fd = -1;
+    file_h = map_h = NULL;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // writes count samples of size bytes each to mapped if it is open, or to
+  // fh otherwise; returns the number of samples written, as fwrite does
+  static
+  size_t write_samples(mmap_out_file& mapped, FILE* fh, const void* p,
+                       size_t size, size_t count)
+  {
+    if (mapped.is_open())
+      return mapped.write(p, size * count) ? count : 0;
+    return fwrite(p, size, count, fh);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  bool is_standard_stream(const char* filename)
+  {
+    return strcmp(filename, "-") == 0;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  FILE* open_output_file(const char* filename)
+  {
+    if (!is_standard_stream(filename))
+      return fopen(filename, "wb");
+
+    // the buffer can only be set before the first write
+    static bool first_use = true;
+    if (first_use)
+    {
+#ifdef OJPH_OS_WINDOWS
+      _setmode(_fileno(stdout), _O_BINARY);
+#endif
+      setvbuf(stdout, NULL, _IOFBF, (size_t)1 << 20);
+      first_use = false;
+    }
+    return stdout;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void close_output_file(FILE* fh)
+  {
+    if (fh == stdout)
+      fflush(fh);
+    else
+      fclose(fh);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  const char* stdin_copy_file::open(const char* ext)
+  {
+    assert(name[0] == '\0');
+    const char* dot = ext[0] == '.' ? "" : ".";
+    FILE *fh = NULL;
+#ifdef OJPH_OS_WINDOWS
+    // GetTempFileNameA creates a file with a unique name, which is kept 
+    // until close(), so that the name with ext appended remains unique
+    char dir[MAX_PATH + 1];
+    DWORD len = GetTempPathA(sizeof(dir), dir);
+    if (len == 0 || len > sizeof(dir) 
+        || GetTempFileNameA(dir, "ojph", 0, base_name) == 0)
+      OJPH_ERROR(0x03000241, "Unable to create a temporary file for the "
+        "standard input");
+    snprintf(name, max_name, "%s%s%s", base_name, dot, ext);
+    fh = fopen(name, "wb");
+    _setmode(_fileno(stdin), _O_BINARY);
+#else
+    const char* dir = getenv("TMPDIR");
+    dir = dir && dir[0] ? dir : "/tmp";
+    int n = snprintf(name, max_name, "%s/ojph_stdin_XXXXXX%s%s", 
+      dir, dot, ext);
+    if (n <= 0 || n >= max_name)
+    {
+      name[0] = '\0';
+      OJPH_ERROR(0x03000242, "The name of the temporary file for the "
+        "standard input is too long");
+    }
+    int fd = mkstemps(name, (int)(strlen(dot) + strlen(ext)));
+    if (fd == -1)
+    {
+      name[0] = '\0';
+      OJPH_ERROR(0x03000241, "Unable to create a temporary file for the "
+        "standard input");
+    }
+    fh = fdopen(fd, "wb");
+#endif
+    if (fh == NULL)
+    {
+      close();
+      OJPH_ERROR(0x03000241, "Unable to create a temporary file for the "
+        "standard input");
+    }
+
+    const size_t chunk_size = (size_t)1 << 20;
+    void *chunk = malloc(chunk_size);
+    bool success = chunk != NULL;
+    size_t bytes;
+    while (success && (bytes = fread(chunk, 1, chunk_size, stdin)) > 0)
+      success = fwrite(chunk, 1, bytes, fh) == bytes;
+    success = success && ferror(stdin) == 0;
+    free(chunk);
+    if (fclose(fh) != 0 || !success)
+    {
+      close();
+      OJPH_ERROR(0x03000243, "Unable to copy the standard input into a "
+        "temporary file");
+    }
+    return name;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void stdin_copy_file::close()
+  {
+    if (name[0] != '\0')
+      remove(name);
+    if (base_name[0] != '\0')
+      remove(base_name);
+    name[0] = base_name[0] = '\0';
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  //
+  // Input accelerators -- selection
+  //
+  //
+  ////////////////////////////////////////////////////////////////////////////
+
+  /////////////////////////////////////////////////////////////////////////////
+  // the order of these must match that of the tables in get_in_converter
+  enum in_cvrt_type : ui32 {
+    ICT_8UB1C, ICT_8UB3C, ICT_8SB1C, ICT_16UB1C_LE, ICT_16UB3C_LE,
+    ICT_16UB1C_BE, ICT_16UB3C_BE, ICT_16SB1C_LE, ICT_10B3C_LE, ICT_10B3C_BE,
+    ICT_8UB2C, ICT_8UB4C, ICT_16UB2C_LE, ICT_16UB1C_LE_MSB10, 
+    ICT_16UB2C_LE_MSB10, ICT_V210
+  };
+
+  /////////////////////////////////////////////////////////////////////////////
+  // returns the fastest implementation of an input converter for this 
+  // machine
+  static
+  in_conversion_fun get_in_converter(in_cvrt_type type)
+  {
+#if !defined(OJPH_ENABLE_WASM_SIMD) || !defined(OJPH_EMSCRIPTEN)
+
+    static const in_conversion_fun gen_funs[] = {
+      gen_cvrt_8ub1c_to_32b1c,
+      gen_cvrt_8ub3c_to_32b1c,
+      gen_cvrt_8sb1c_to_32b1c,
+      gen_cvrt_16ub1c_le_to_32b1c,
+      gen_cvrt_16ub3c_le_to_32b1c,
+      gen_cvrt_16ub1c_be_to_32b1c,
+      gen_cvrt_16ub3c_be_to_32b1c,
+      gen_cvrt_16sb1c_le_to_32b1c,
+      gen_cvrt_10b3c_le_to_32b1c,
+      gen_cvrt_10b3c_be_to_32b1c,
+      gen_cvrt_8ub2c_to_32b1c,
+      gen_cvrt_8ub4c_to_32b1c,
+      gen_cvrt_16ub2c_le_to_32b1c,
+      gen_cvrt_16ub1c_le_msb10_to_32b1c,
+      gen_cvrt_16ub2c_le_msb10_to_32b1c,
+      gen_cvrt_v210_to_32b1c
+    };
+    in_conversion_fun f = gen_funs[type];
+
+  #ifndef OJPH_DISABLE_SIMD
+
+    #if (defined(OJPH_ARCH_X86_64) || defined(OJPH_ARCH_I386))
+
+      #ifndef OJPH_DISABLE_SSE4
+        static const in_conversion_fun sse41_funs[] = {
+          sse41_cvrt_8ub1c_to_32b1c,
+          sse41_cvrt_8ub3c_to_32b1c,
+          sse41_cvrt_8sb1c_to_32b1c,
+          sse41_cvrt_16ub1c_le_to_32b1c,
+          sse41_cvrt_16ub3c_le_to_32b1c,
+          sse41_cvrt_16ub1c_be_to_32b1c,
+          sse41_cvrt_16ub3c_be_to_32b1c,
+          sse41_cvrt_16sb1c_le_to_32b1c,
+          sse41_cvrt_10b3c_le_to_32b1c,
+          sse41_cvrt_10b3c_be_to_32b1c,
+          sse41_cvrt_8ub2c_to_32b1c,
+          sse41_cvrt_8ub4c_to_32b1c,
+          sse41_cvrt_16ub2c_le_to_32b1c,
+          sse41_cvrt_16ub1c_le_msb10_to_32b1c,
+          sse41_cvrt_16ub2c_le_msb10_to_32b1c,
+          sse41_cvrt_v210_to_32b1c
+        };
+        if (get_cpu_ext_level() >= X86_CPU_EXT_LEVEL_SSE41)
+          f = sse41_funs[type];
+      #endif // !OJPH_DISABLE_SSE4
+
+      #ifndef OJPH_DISABLE_AVX2
+        static const in_conversion_fun avx2_funs[] = {
+          avx2_cvrt_8ub1c_to_32b1c,
+          avx2_cvrt_8ub3c_to_32b1c,
+          avx2_cvrt_8sb1c_to_32b1c,
+          avx2_cvrt_16ub1c_le_to_32b1c,
+          avx2_cvrt_16ub3c_le_to_32b1c,
+          avx2_cvrt_16ub1c_be_to_32b1c,
+          avx2_cvrt_16ub3c_be_to_32b1c,
+          avx2_cvrt_16sb1c_le_to_32b1c,
+          avx2_cvrt_10b3c_le_to_32b1c,
+          avx2_cvrt_10b3c_be_to_32b1c,
+          avx2_cvrt_8ub2c_to_32b1c,
+          avx2_cvrt_8ub4c_to_32b1c,
+          avx2_cvrt_16ub2c_le_to_32b1c,
+          avx2_cvrt_16ub1c_le_msb10_to_32b1c,
+          avx2_cvrt_16ub2c_le_msb10_to_32b1c,
+          sse41_cvrt_v210_to_32b1c // did not find a better avx2 one
+        };
+        if (get_cpu_ext_level() >= X86_CPU_EXT_LEVEL_AVX2)
+          f = avx2_funs[type];
+      #endif // !OJPH_DISABLE_AVX2
+
+    #elif defined(OJPH_ARCH_ARM)
+
+    #endif // !(defined(OJPH_ARCH_X86_64) || defined(OJPH_ARCH_I386))
+
+  #endif // !OJPH_DISABLE_SIMD
+
+#else // OJPH_ENABLE_WASM_SIMD
+
+    static const in_conversion_fun sse41_funs[] = {
+      sse41_cvrt_8ub1c_to_32b1c,
+      sse41_cvrt_8ub3c_to_32b1c,
+      sse41_cvrt_8sb1c_to_32b1c,
+      sse41_cvrt_16ub1c_le_to_32b1c,
+      sse41_cvrt_16ub3c_le_to_32b1c,
+      sse41_cvrt_16ub1c_be_to_32b1c,
+      sse41_cvrt_16ub3c_be_to_32b1c,
+      sse41_cvrt_16sb1c_le_to_32b1c,
+      sse41_cvrt_10b3c_le_to_32b1c,
+      sse41_cvrt_10b3c_be_to_32b1c,
+      sse41_cvrt_8ub2c_to_32b1c,
+      sse41_cvrt_8ub4c_to_32b1c,
+      sse41_cvrt_16ub2c_le_to_32b1c,
+      sse41_cvrt_16ub1c_le_msb10_to_32b1c,
+      sse41_cvrt_16ub2c_le_msb10_to_32b1c,
+      sse41_cvrt_v210_to_32b1c
+    };
+    in_conversion_fun f = sse41_funs[type];
+
+#endif // !OJPH_ENABLE_WASM_SIMD
+
+    return f;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  //
+  // Output and packing accelerators -- selection
+  //
+  //
+  ////////////////////////////////////////////////////////////////////////////
+
+  /////////////////////////////////////////////////////////////////////////////
+  // the order of these must match that of the tables in get_out_converter
+  enum out_cvrt_type : ui32 {
+    OCT_8UB1C, OCT_16UB1C_LE, OCT_16UB1C_LE_MSB10
+  };
+
+  /////////////////////////////////////////////////////////////////////////////
+  // returns the fastest implementation of a single-component output 
+  // converter for this machine
+  static
+  conversion_fun get_out_converter(out_cvrt_type type)
+  {
+#if !defined(OJPH_ENABLE_WASM_SIMD) || !defined(OJPH_EMSCRIPTEN)
+
+    static const conversion_fun gen_funs[] = {
+      gen_cvrt_32b1c_to_8ub1c,
+      gen_cvrt_32b1c_to_16ub1c_le,
+      gen_cvrt_32b1c_to_16ub1c_le_msb10
+    };
+    conversion_fun f = gen_funs[type];
+
+  #ifndef OJPH_DISABLE_SIMD
+
+    #if (defined(OJPH_ARCH_X86_64) || defined(OJPH_ARCH_I386))
+
+      #ifndef OJPH_DISABLE_SSE4
+        static const conversion_fun sse41_funs[] = {
+          sse41_cvrt_32b1c_to_8ub1c,
+          sse41_cvrt_32b1c_to_16ub1c_le,
+          sse41_cvrt_32b1c_to_16ub1c_le_msb10
+        };
+        if (get_cpu_ext_level() >= X86_CPU_EXT_LEVEL_SSE41)
+          f = sse41_funs[type];
+      #endif // !OJPH_DISABLE_SSE4
+
+      #ifndef OJPH_DISABLE_AVX2
+        static const conversion_fun avx2_funs[] = {
+          avx2_cvrt_32b1c_to_8ub1c,
+          avx2_cvrt_32b1c_to_16ub1c_le,
+          sse41_cvrt_32b1c_to_16ub1c_le_msb10 // did not find a better one
+        };
+        if (get_cpu_ext_level() >= X86_CPU_EXT_LEVEL_AVX2)
+          f = avx2_funs[type];
+      #endif // !OJPH_DISABLE_AVX2
+
+    #elif defined(OJPH_ARCH_ARM)
+
+    #endif // !(defined(OJPH_ARCH_X86_64) || defined(OJPH_ARCH_I386))
+
+  #endif // !OJPH_DISABLE_SIMD
+
+#else // OJPH_ENABLE_WASM_SIMD
+
+    static const conversion_fun sse41_funs[] = {
+      sse41_cvrt_32b1c_to_8ub1c,
+      sse41_cvrt_32b1c_to_16ub1c_le,
+      sse41_cvrt_32b1c_to_16ub1c_le_msb10
+    };
+    conversion_fun f = sse41_funs[type];
+
+#endif // !OJPH_ENABLE_WASM_SIMD
+
+    return f;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // the order of these must match that of the tables in get_pack_converter
+  enum pack_cvrt_type : ui32 {
+    PCT_8UB2C, PCT_8UB4C, PCT_16UB2C_LE, PCT_16UB2C_LE_MSB10, PCT_V210
+  };
+
+  /////////////////////////////////////////////////////////////////////////////
+  // returns the fastest implementation of a packing converter for this 
+  // machine; did not find avx2 implementations better than sse41
+  static
+  pack_conversion_fun get_pack_converter(pack_cvrt_type type)
+  {
+#if !defined(OJPH_ENABLE_WASM_SIMD) || !defined(OJPH_EMSCRIPTEN)
+
+    static const pack_conversion_fun gen_funs[] = {
+      gen_cvrt_32b1c_to_8ub2c,
+      gen_cvrt_32b1c_to_8ub4c,
+      gen_cvrt_32b1c_to_16ub2c_le,
+      gen_cvrt_32b1c_to_16ub2c_le_msb10,
+      gen_cvrt_32b1c_to_v210
+    };
+    pack_conversion_fun f = gen_funs[type];
+
+  #ifndef OJPH_DISABLE_SIMD
+
+    #if (defined(OJPH_ARCH_X86_64) || defined(OJPH_ARCH_I386))
+
+      #ifndef OJPH_DISABLE_SSE4
+        static const pack_conversion_fun sse41_funs[] = {
+          sse41_cvrt_32b1c_to_8ub2c,
+          sse41_cvrt_32b1c_to_8ub4c,
+          sse41_cvrt_32b1c_to_16ub2c_le,
+          sse41_cvrt_32b1c_to_16ub2c_le_msb10,
+          sse41_cvrt_32b1c_to_v210
+        };
+        if (get_cpu_ext_level() >= X86_CPU_EXT_LEVEL_SSE41)
+          f = sse41_funs[type];
+      #endif // !OJPH_DISABLE_SSE4
+
+    #elif defined(OJPH_ARCH_ARM)
+
+    #endif // !(defined(OJPH_ARCH_X86_64) || defined(OJPH_ARCH_I386))
+
+  #endif // !OJPH_DISABLE_SIMD
+
+#else // OJPH_ENABLE_WASM_SIMD
+
+    static const pack_conversion_fun sse41_funs[] = {
+      sse41_cvrt_32b1c_to_8ub2c,
+      sse41_cvrt_32b1c_to_8ub4c,
+      sse41_cvrt_32b1c_to_16ub2c_le,
+      sse41_cvrt_32b1c_to_16ub2c_le_msb10,
+      sse41_cvrt_32b1c_to_v210
+    };
+    pack_conversion_fun f = sse41_funs[type];
+
+#endif // !OJPH_ENABLE_WASM_SIMD
+
+    return f;
+  }
+
 
   ////////////////////////////////////////////////////////////////////////////
   //
@@ -293,8 +1192,15 @@ namespace ojph {
     bytes_per_sample = max_val > 255 ? 2 : 1;
     max_val_num_bits = 32u - count_leading_zeros(max_val);
     bit_depth[2] = bit_depth[1] = bit_depth [0] = max_val_num_bits;
+    if (bytes_per_sample == 1)
+      converter = get_in_converter(num_comps == 1 ? ICT_8UB1C : ICT_8UB3C);
+    else
+      converter = 
+        get_in_converter(num_comps == 1 ? ICT_16UB1C_BE : ICT_16UB3C_BE);
     fgetc(fh);
     start_of_data = ojph_ftell(fh);
+    if (use_mmap)
+      mapped.open(filename); // on failure, the file is read using fh
 
     // allocate linebuffer to hold a line of image data
     if (temp_buf_byte_size < num_comps * width * bytes_per_sample)
@@ -342,34 +1248,44 @@ namespace ojph {
 
     if (planar || comp_num == 0)
     {
-      size_t result = fread(
-        temp_buf, bytes_per_sample, num_ele_per_line, fh);
-      if (result != num_ele_per_line)
+      if (mapped.is_open())
+      {
+        size_t line_bytes = (size_t)num_ele_per_line * bytes_per_sample;
+        size_t offset = (size_t)start_of_data;
+        offset += (size_t)cur_line * line_bytes;
+        if (offset + line_bytes > mapped.get_size())
+        {
+          close();
+          OJPH_ERROR(0x03000011, "not enough data in file %s", fname);
+        }
+        line_data = mapped.get_data() + offset;
+        // 16-bit samples are read as ui16, which must be aligned
+        if (bytes_per_sample == 2 && ((size_t)line_data & 1))
+        {
+          memcpy(temp_buf, line_data, line_bytes);
+          line_data = temp_buf;
+        }
+      }
+      else
       {
-        close();
-        OJPH_ERROR(0x03000011, "not enough data in file %s", fname);
+        size_t result = fread(
+          temp_buf, bytes_per_sample, num_ele_per_line, fh);
+        if (result != num_ele_per_line)
+        {
+          close();
+          OJPH_ERROR(0x03000011, "not enough data in file %s", fname);
+        }
+        line_data = temp_buf;
       }
       if (++cur_line >= height)
       {
         cur_line = 0;
-        ojph_fseek(fh, start_of_data, SEEK_SET); //handles plannar reading
+        if (!mapped.is_open()) //handles plannar reading
+          ojph_fseek(fh, start_of_data, SEEK_SET);
       }
     }
 
-    if (bytes_per_sample == 1)
-    {
-      const ui8* sp = (ui8*)temp_buf + comp_num;
-      si32* dp = line->i32;
-      for (ui32 i = width; i > 0; --i, sp+=num_comps)
-        *dp++ = (si32)*sp;
-    }
-    else
-    {
-      const ui16* sp = (ui16*)temp_buf + comp_num;
-      si32* dp = line->i32;
-      for (ui32 i = width; i > 0; --i, sp+=num_comps)
-        *dp++ = (si32)be2le(*sp);
-    }
+    converter(line_data, line->i32, comp_num, width);
 
     return width;
   }
@@ -402,12 +1318,18 @@ namespace ojph {
           OJPH_WARN(0x03000022, "file was renamed %s\n", filename);
         }
       }
-      fh = fopen(filename, "wb");
-      if (fh == NULL)
-        OJPH_ERROR(0x03000023,
-          "unable to open file %s for writing", filename);
+      if (!use_mmap || !mapped.open(filename))
+      {
+        fh = open_output_file(filename);
+        if (fh == NULL)
+          OJPH_ERROR(0x03000023,
+            "unable to open file %s for writing", filename);
+      }
 
-      fprintf(fh, "P5\n%d %d\n%d\n", width, height, (1 << bit_depth) - 1);
+      char header[64];
+      int header_len = snprintf(header, sizeof(header), 
+        "P5\n%d %d\n%d\n", width, height, (1 << bit_depth) - 1);
+      write_samples(mapped, fh, header, 1, (size_t)header_len);
       buffer_size = (size_t)width * bytes_per_sample;
       buffer = (ui8*)malloc(buffer_size);
     }
@@ -427,12 +1349,18 @@ namespace ojph {
           OJPH_WARN(0x03000025, "file was renamed %s\n", filename);
         }
       }
-      fh = fopen(filename, "wb");
-      if (fh == NULL)
-        OJPH_ERROR(0x03000026,
-          "unable to open file %s for writing", filename);
-      int result = //the number of written characters
-        fprintf(fh, "P6\n%d %d\n%d\n", width, height, (1 << bit_depth) - 1);
+      if (!use_mmap || !mapped.open(filename))
+      {
+        fh = open_output_file(filename);
+        if (fh == NULL)
+          OJPH_ERROR(0x03000026,
+            "unable to open file %s for writing", filename);
+      }
+      char header[64];
+      int header_len = snprintf(header, sizeof(header), 
+        "P6\n%d %d\n%d\n", width, height, (1 << bit_depth) - 1);
+      size_t result = //the number of written characters
+        write_samples(mapped, fh, header, 1, (size_t)header_len);
       if (result == 0)
         OJPH_ERROR(0x03000027, "error writing to file %s", filename);
       buffer_size = (size_t)width * num_components * (size_t)bytes_per_sample;
@@ -538,7 +1466,7 @@ namespace ojph {
   ////////////////////////////////////////////////////////////////////////////
   ui32 ppm_out::write(const line_buf* line, ui32 comp_num)
   {
-    assert(fh);
+    assert(fh || mapped.is_open());
 
     lptr[comp_num] = line;
     if (comp_num == num_components - 1)
@@ -546,8 +1474,8 @@ namespace ojph {
       assert(lptr[0] != lptr[1]);
       assert((lptr[1]!=lptr[2] && num_components==3) || num_components==1);
       converter(lptr[0], lptr[1], lptr[2], buffer, bit_depth, width);
-      size_t result = fwrite(buffer,
-                              bytes_per_sample, samples_per_line, fh);
+      size_t result = write_samples(mapped, fh, buffer,
+                                    bytes_per_sample, samples_per_line);
       if (result != samples_per_line)
         OJPH_ERROR(0x03000041, "error writing to file %s", fname);
     }
@@ -610,6 +1538,8 @@ namespace ojph {
 
     fgetc(fh);
     start_of_data = ojph_ftell(fh);
+    if (use_mmap) // lines are read bottom-up, so no read-ahead is requested
+      mapped.open(filename, false);
 
     // alloc. linebuffer to hold a line of image data, if more than 1 comp.
     if (temp_buf_byte_size < num_comps * (size_t)width * sizeof(float))
@@ -657,32 +1587,58 @@ namespace ojph {
       si64 loc = start_of_data;
       loc += (size_t)(height-1 - cur_line) * (size_t)num_comps 
            * (size_t)width * sizeof(float);
-      if (ojph_fseek(fh, loc, SEEK_SET) != 0)
+      if (mapped.is_open())
       {
-        close();
-        OJPH_ERROR(0x03000061, "Error seeking in file %s", fname);
+        size_t line_bytes = (size_t)num_comps * (size_t)width * sizeof(float);
+        if ((size_t)loc + line_bytes > mapped.get_size())
+        {
+          close();
+          OJPH_ERROR(0x03000062, "Not enough data in file %s", fname);
+        }
+        const ui8* p = mapped.get_data() + loc;
+        if ((size_t)p & (sizeof(float) - 1)) // samples must be aligned
+        {
+          memcpy(temp_buf, p, line_bytes);
+          line_data = temp_buf;
+        }
+        else
+          line_data = (const float*)p;
       }
-      size_t result = 
-        fread(temp_buf, sizeof(float), (size_t)num_comps * (size_t)width, fh);
-      if (result != (size_t)num_comps * (size_t)width)
+      else
       {
-        close();
-        OJPH_ERROR(0x03000062, "Not enough data in file %s", fname);
+        if (ojph_fseek(fh, loc, SEEK_SET) != 0)
+        {
+          close();
+          OJPH_ERROR(0x03000061, "Error seeking in file %s", fname);
+        }
+        size_t result = fread(temp_buf, sizeof(float), 
+                              (size_t)num_comps * (size_t)width, fh);
+        if (result != (size_t)num_comps * (size_t)width)
+        {
+          close();
+          OJPH_ERROR(0x03000062, "Not enough data in file %s", fname);
+        }
+        line_data = temp_buf;
       }
       if (++cur_line >= height)
         cur_line = 0;
     }
 
+    union {
+      const si32* s;
+      const ui32* u;
+      const float* f;
+    } sp;
     union {
       si32* s;
       ui32* u;
       float* f;
-    } sp, dp;
+    } dp;
 
     if (little_endian)
     {
       ui32 shift = 32 - bit_depth[comp_num];
-      sp.f = temp_buf + comp_num;
+      sp.f = line_data + comp_num;
       dp.f = line->f32;
       if (shift)
         for (ui32 i = width; i > 0; --i, sp.f += num_comps) 
@@ -697,7 +1653,7 @@ namespace ojph {
     }
     else {
       ui32 shift = 32 - bit_depth[comp_num];
-      sp.f = temp_buf + comp_num;
+      sp.f = line_data + comp_num;
       dp.f = line->f32;
       if (shift)
         for (ui32 i = width; i > 0; --i, sp.f += num_comps) {
@@ -1300,11 +2256,20 @@ namespace ojph {
     if (fh == 0)
       OJPH_ERROR(0x030000D1, "Unable to open file %s", filename);
 
-    //need to extract info from filename
+    size_t len = strlen(filename);
+    is_y4m = len >= 4 && (strncmp(filename + len - 4, ".y4m", 4) == 0
+                       || strncmp(filename + len - 4, ".Y4M", 4) == 0);
+    start_of_data = 0;
+    if (is_y4m)
+      read_y4m_header(filename);
 
     assert(num_com == 1 || num_com == 3);
     for (ui32 i = 0; i < num_com; ++i)
+    {
       bytes_per_sample[i] = bit_depth[i] > 8 ? 2 : 1;
+      converter[i] = get_in_converter(
+        bytes_per_sample[i] == 1 ? ICT_8UB1C : ICT_16UB1C_LE);
+    }
     ui32 max_byte_width = width[0] * bytes_per_sample[0];
     comp_address[0] = 0;
     for (ui32 i = 1; i < num_com; ++i)
@@ -1315,35 +2280,250 @@ namespace ojph {
     }
     temp_buf = malloc(max_byte_width);
     fname = filename;
+
+    ui32 lc = num_com - 1;
+    frame_size = comp_address[lc];
+    frame_size += (si64)width[lc] * height[lc] * bytes_per_sample[lc];
+    ojph_fseek(fh, 0, SEEK_END);
+    file_size = ojph_ftell(fh);
+
+    mapped_pos = 0;
+    if (use_mmap)
+      mapped.open(filename); // on failure, the file is read using fh
+
+    cur_frame = 0;
+    cur_frame_offset = start_of_data;
+    if (!is_y4m)
+      set_position(0);
+    else if (!seek_frame(0))
+    {
+      close();
+      OJPH_ERROR(0x030000D2, "file %s does not hold a whole frame", 
+        filename);
+    }
   }
 
   ////////////////////////////////////////////////////////////////////////////
-  ui32 yuv_in::read(const line_buf* line, ui32 comp_num)
+  void yuv_in::read_y4m_header(const char* filename)
   {
-    assert(comp_num < num_com);
-    size_t result = fread(temp_buf, bytes_per_sample[comp_num],
-                          width[comp_num], fh);
-    if (result != width[comp_num])
+    // the header is "YUV4MPEG2" followed by parameters, each starting with
+    // a space and a letter, and ends with a newline
+    char header[1024];
+    if (fgets(header, sizeof(header), fh) == NULL 
+        || strncmp(header, "YUV4MPEG2", 9) != 0)
     {
       close();
-      OJPH_ERROR(0x030000E1, "not enough data in file %s", fname);
+      OJPH_ERROR(0x030000D3, "file %s is not a y4m file", filename);
+    }
+    size_t len = strlen(header);
+    if (header[len - 1] != '\n')
+    {
+      close();
+      OJPH_ERROR(0x030000D4, "the header of file %s is too long", filename);
+    }
+    start_of_data = (si64)len;
+
+    ui32 w = 0, h = 0;
+    const char *cs = "420jpeg"; // the default colour space
+    size_t cs_len = strlen(cs);
+    char *p = header + 9;
+    while (*p == ' ')
+    {
+      ++p;
+      char *end = p;
+      while (*end != ' ' && *end != '\n')
+        ++end;
+      if (*p == 'W')
+        w = (ui32)strtoul(p + 1, NULL, 10);
+      else if (*p == 'H')
+        h = (ui32)strtoul(p + 1, NULL, 10);
+      else if (*p == 'C')
+      {
+        cs = p + 1;
+        cs_len = (size_t)(end - cs);
+      }
+      p = end;
+    }
+    if (w == 0 || h == 0)
+    {
+      close();
+      OJPH_ERROR(0x030000D5, "file %s has no valid width or height", 
+        filename);
+    }
+
+    // colour spaces are 420jpeg, 420paldv, 420mpeg2, 420, 422, 444, 411,
+    // and mono, for 8-bit samples; the number of bits follows a 'p' for 
+    // higher bit depths, as in 420p10, or follows mono, as in mono16
+    ui32 nc = 3, bd = 8;
+    point ds(1, 1);
+    const char *suffix = cs + 3;
+    if (cs_len >= 4 && strncmp(cs, "mono", 4) == 0)
+    {
+      nc = 1;
+      suffix = cs + 4;
+    }
+    else if (cs_len >= 3 && strncmp(cs, "420", 3) == 0)
+      ds = point(2, 2);
+    else if (cs_len >= 3 && strncmp(cs, "422", 3) == 0)
+      ds = point(2, 1);
+    else if (cs_len >= 3 && strncmp(cs, "411", 3) == 0)
+      ds = point(4, 1);
+    else if (cs_len < 3 || strncmp(cs, "444", 3) != 0)
+      cs_len = 0; // unsupported
+    size_t suffix_len = cs_len ? cs_len - (size_t)(suffix - cs) : 0;
+    if (suffix_len > 0)
+    {
+      if (*suffix == 'p' && nc == 3)
+        ++suffix, --suffix_len;
+      char *end;
+      bd = (ui32)strtoul(suffix, &end, 10);
+      if (end != suffix + suffix_len)
+        bd = (strncmp(suffix, "jpeg", suffix_len) == 0 
+           || strncmp(suffix, "paldv", suffix_len) == 0
+           || strncmp(suffix, "mpeg2", suffix_len) == 0) ? 8 : 0;
+    }
+    if (cs_len == 0 || bd < 8 || bd > 16)
+    {
+      close();
+      OJPH_ERROR(0x030000D6, "unsupported colour space %.*s in file %s", 
+        (int)cs_len, cs, filename);
+    }
+
+    point subsampling[3] = { point(1, 1), ds, ds };
+    set_img_props(size(w, h), nc, nc, subsampling);
+    set_bit_depth(1, &bd);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  si64 yuv_in::skip_y4m_frame_header(si64 offset)
+  {
+    // a frame header is "FRAME", followed by optional parameters and a 
+    // newline; returns the offset of the frame's samples, or -1 if no 
+    // frame header is found at offset
+    const si64 max_header_size = 1024;
+    if (mapped.is_open())
+    {
+      const ui8 *p = mapped.get_data();
+      si64 size = (si64)mapped.get_size();
+      if (offset + 6 > size || memcmp(p + offset, "FRAME", 5) != 0)
+        return -1;
+      si64 end = ojph_min(size, offset + max_header_size);
+      for (si64 i = offset + 5; i < end; ++i)
+        if (p[i] == '\n')
+          return i + 1;
     }
+    else
+    {
+      char t[5];
+      if (ojph_fseek(fh, offset, SEEK_SET) != 0 
+          || fread(t, 1, 5, fh) != 5 || memcmp(t, "FRAME", 5) != 0)
+        return -1;
+      for (si64 i = offset + 5; i < offset + max_header_size; ++i)
+      {
+        int c = fgetc(fh);
+        if (c == EOF)
+          break;
+        if (c == '\n')
+          return i + 1;
+      }
+    }
+    return -1;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void yuv_in::set_position(si64 offset)
+  {
+    if (mapped.is_open())
+      mapped_pos = (size_t)offset;
+    else
+      ojph_fseek(fh, offset, SEEK_SET);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  bool yuv_in::seek_frame(ui32 frame_idx)
+  {
+    assert(fh);
+    if (!is_y4m)
+    {
+      si64 offset = (si64)frame_idx * frame_size;
+      if (offset + frame_size > file_size)
+        return false;
+      cur_frame = frame_idx;
+      set_position(offset);
+      return true;
+    }
+
+    // frame headers can have different lengths, so a frame is found by 
+    // skipping the frames before it, starting from the current frame
+    ui32 frame = cur_frame;
+    si64 offset = cur_frame_offset;
+    if (frame_idx < frame)
+    {
+      frame = 0;
+      offset = start_of_data;
+    }
+    si64 data = skip_y4m_frame_header(offset);
+    while (data >= 0 && frame < frame_idx)
+    {
+      offset = data + frame_size;
+      ++frame;
+      data = skip_y4m_frame_header(offset);
+    }
+    if (data < 0 || data + frame_size > file_size)
+      return false;
+    cur_frame = frame;
+    cur_frame_offset = offset;
+    set_position(data);
+    return true;
+  }
 
-    if (bytes_per_sample[comp_num] == 1)
+  ////////////////////////////////////////////////////////////////////////////
+  ui32 yuv_in::get_num_frames()
+  {
+    assert(fh);
+    if (!is_y4m)
+      return (ui32)(file_size / frame_size);
+
+    ui32 count = 0;
+    si64 data = skip_y4m_frame_header(start_of_data);
+    while (data >= 0 && data + frame_size <= file_size)
     {
-      const ui8* sp = (ui8*)temp_buf;
-      si32* dp = line->i32;
-      for (ui32 i = width[comp_num]; i > 0; --i, ++sp)
-        *dp++ = (si32)*sp;
+      ++count;
+      data = skip_y4m_frame_header(data + frame_size);
+    }
+    seek_frame(cur_frame); // reading continues from the current frame
+    return count;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  ui32 yuv_in::read(const line_buf* line, ui32 comp_num)
+  {
+    assert(comp_num < num_com);
+    const void *sp = temp_buf;
+    if (mapped.is_open())
+    {
+      size_t line_bytes = (size_t)bytes_per_sample[comp_num]*width[comp_num];
+      if (mapped_pos + line_bytes > mapped.get_size())
+      {
+        close();
+        OJPH_ERROR(0x030000E1, "not enough data in file %s", fname);
+      }
+      sp = mapped.get_data() + mapped_pos;
+      mapped_pos += line_bytes;
     }
     else
     {
-      const ui16* sp = (ui16*)temp_buf;
-      si32* dp = line->i32;
-      for (ui32 i = width[comp_num]; i > 0; --i, ++sp)
-        *dp++ = (si32)*sp;
+      size_t result = fread(temp_buf, bytes_per_sample[comp_num],
+                            width[comp_num], fh);
+      if (result != width[comp_num])
+      {
+        close();
+        OJPH_ERROR(0x030000E1, "not enough data in file %s", fname);
+      }
     }
 
+    converter[comp_num](sp, line->i32, 0, width[comp_num]);
+
     return width[comp_num];
   }
 
@@ -1418,9 +2598,12 @@ namespace ojph {
   void yuv_out::open(char *filename)
   {
     assert(fh == NULL); //configure before open
-    fh = fopen(filename, "wb");
-    if (fh == 0)
-      OJPH_ERROR(0x03000111, "Unable to open file %s", filename);
+    if (!use_mmap || !mapped.open(filename))
+    {
+      fh = open_output_file(filename);
+      if (fh == 0)
+        OJPH_ERROR(0x03000111, "Unable to open file %s", filename);
+    }
     fname = filename;
   }
 
@@ -1446,7 +2629,7 @@ namespace ojph {
   ////////////////////////////////////////////////////////////////////////////
   ui32 yuv_out::write(const line_buf* line, ui32 comp_num)
   {
-    assert(fh);
+    assert(fh || mapped.is_open());
     assert(comp_num < num_components);
 
     int max_val = (1<<bit_depth) - 1;
@@ -1462,7 +2645,7 @@ namespace ojph {
         val = val <= max_val ? val : max_val;
         *dp++ = (ui16)val;
       }
-      if (fwrite(buffer, 2, w, fh) != w)
+      if (write_samples(mapped, fh, buffer, 2, w) != w)
         OJPH_ERROR(0x03000121, "unable to write to file %s", fname);
     }
     else
@@ -1476,7 +2659,7 @@ namespace ojph {
         val = val <= max_val ? val : max_val;
         *dp++ = (ui8)val;
       }
-      if (fwrite(buffer, 1, w, fh) != w)
+      if (write_samples(mapped, fh, buffer, 1, w) != w)
         OJPH_ERROR(0x03000122, "unable to write to file %s", fname);
     }
 
@@ -1504,6 +2687,18 @@ namespace ojph {
     buffer_size = (size_t)width * bytes_per_sample;
     buffer = (ui8*)malloc(buffer_size);
     fname = filename;
+
+    // 24- and 32-bit samples are converted in read()
+    converter = NULL;
+    if (bytes_per_sample == 1)
+      converter = get_in_converter(is_signed ? ICT_8SB1C : ICT_8UB1C);
+    else if (bytes_per_sample == 2)
+      converter = get_in_converter(is_signed ? ICT_16SB1C_LE 
+                                             : ICT_16UB1C_LE);
+
+    mapped_pos = 0;
+    if (use_mmap)
+      mapped.open(filename); // on failure, the file is read using fh
   }
 
   ////////////////////////////////////////////////////////////////////////////
@@ -1511,11 +2706,30 @@ namespace ojph {
   {
     ojph_unused(comp_num);
     assert(comp_num == 0);
-    size_t result = fread(buffer, bytes_per_sample, width, fh);
-    if (result != width)
+    const void *sp = buffer;
+    if (mapped.is_open())
     {
-      close();
-      OJPH_ERROR(0x03000132, "not enough data in file %s", fname);
+      size_t line_bytes = (size_t)bytes_per_sample * width;
+      if (mapped_pos + line_bytes > mapped.get_size())
+      {
+        close();
+        OJPH_ERROR(0x03000132, "not enough data in file %s", fname);
+      }
+      sp = mapped.get_data() + mapped_pos;
+      mapped_pos += line_bytes;
+      // 24-bit samples are read as 32-bit words, which can read beyond
+      // the end of the file; these, and 32-bit samples, are copied
+      if (converter == NULL)
+        memcpy(buffer, sp, line_bytes);
+    }
+    else
+    {
+      size_t result = fread(buffer, bytes_per_sample, width, fh);
+      if (result != width)
+      {
+        close();
+        OJPH_ERROR(0x03000132, "not enough data in file %s", fname);
+      }
     }
 
     if (bytes_per_sample > 3)
@@ -1555,34 +2769,8 @@ namespace ojph {
         }
       }
     }
-    else if (bytes_per_sample > 1)
-    {
-      si32* dp = line->i32;
-      if (is_signed) {
-        const si16* sp = (si16*)buffer;
-        for (ui32 i = width; i > 0; --i, ++sp)
-          *dp++ = *sp;
-      }
-      else {
-        const ui16* sp = (ui16*)buffer;
-        for (ui32 i = width; i > 0; --i, ++sp)
-          *dp++ = (si32)*sp;
-      }
-    }
     else
-    {
-      si32* dp = line->i32;
-      if (is_signed) {
-        const si8* sp = (si8*)buffer;
-        for (ui32 i = width; i > 0; --i, ++sp)
-          *dp++ = *sp;
-      }
-      else {
-        const ui8* sp = (ui8*)buffer;
-        for (ui32 i = width; i > 0; --i, ++sp)
-          *dp++ = (si32)*sp;
-      }
-    }
+      converter(sp, line->i32, 0, width);
 
     return width;
   }
@@ -1622,9 +2810,12 @@ namespace ojph {
   void raw_out::open(char *filename)
   {
     assert(fh == NULL); //configure before open
-    fh = fopen(filename, "wb");
-    if (fh == 0)
-      OJPH_ERROR(0x03000141, "Unable to open file %s", filename);
+    if (!use_mmap || !mapped.open(filename))
+    {
+      fh = open_output_file(filename);
+      if (fh == 0)
+        OJPH_ERROR(0x03000141, "Unable to open file %s", filename);
+    }
     fname = filename;
   }
 
@@ -1653,7 +2844,7 @@ namespace ojph {
   ui32 raw_out::write(const line_buf* line, ui32 comp_num)
   {
     ojph_unused(comp_num);
-    assert(fh);
+    assert(fh || mapped.is_open());
     assert(comp_num == 0);
 
     if (is_signed) 
@@ -1669,7 +2860,8 @@ namespace ojph {
           val = val >= lower_val ? val : lower_val;
           *dp++ = (si32)val;
         }
-        if (fwrite(buffer, bytes_per_sample, width, fh) != width)
+        if (write_samples(mapped, fh, buffer, bytes_per_sample, width)
+            != width)
           OJPH_ERROR(0x03000151, "unable to write to file %s", fname);
       }
       else if (bytes_per_sample > 2)
@@ -1685,7 +2877,8 @@ namespace ojph {
           // this only works for little endian architecture
           dp = (si32*)((ui8*)dp + 3);
         }
-        if (fwrite(buffer, bytes_per_sample, width, fh) != width)
+        if (write_samples(mapped, fh, buffer, bytes_per_sample, width)
+            != width)
           OJPH_ERROR(0x03000152, "unable to write to file %s", fname);
       }
       else if (bytes_per_sample > 1)
@@ -1699,7 +2892,8 @@ namespace ojph {
           val = val >= lower_val ? val : lower_val;
           *dp++ = (si16)val;
         }
-        if (fwrite(buffer, bytes_per_sample, width, fh) != width)
+        if (write_samples(mapped, fh, buffer, bytes_per_sample, width)
+            != width)
           OJPH_ERROR(0x03000153, "unable to write to file %s", fname);
       }
       else
@@ -1713,7 +2907,8 @@ namespace ojph {
           val = val >= lower_val ? val : lower_val;
           *dp++ = (si8)val;
         }
-        if (fwrite(buffer, bytes_per_sample, width, fh) != width)
+        if (write_samples(mapped, fh, buffer, bytes_per_sample, width)
+            != width)
           OJPH_ERROR(0x03000154, "unable to write to file %s", fname);
       }
     }
@@ -1730,7 +2925,8 @@ namespace ojph {
           val = val >= lower_val ? val : lower_val;
           *dp++ = (ui32)val;
         }
-        if (fwrite(buffer, bytes_per_sample, width, fh) != width)
+        if (write_samples(mapped, fh, buffer, bytes_per_sample, width)
+            != width)
           OJPH_ERROR(0x03000155, "unable to write to file %s", fname);
       }
       else if (bytes_per_sample > 2)
@@ -1746,7 +2942,8 @@ namespace ojph {
           // this only works for little endian architecture
           dp = (ui32*)((ui8*)dp + 3);
         }
-        if (fwrite(buffer, bytes_per_sample, width, fh) != width)
+        if (write_samples(mapped, fh, buffer, bytes_per_sample, width)
+            != width)
           OJPH_ERROR(0x03000156, "unable to write to file %s", fname);
       }
       else if (bytes_per_sample > 1)
@@ -1760,7 +2957,8 @@ namespace ojph {
           val = val >= lower_val ? val : lower_val;
           *dp++ = (ui16)val;
         }
-        if (fwrite(buffer, bytes_per_sample, width, fh) != width)
+        if (write_samples(mapped, fh, buffer, bytes_per_sample, width)
+            != width)
           OJPH_ERROR(0x03000157, "unable to write to file %s", fname);
       }
       else
@@ -1774,7 +2972,8 @@ namespace ojph {
           val = val >= lower_val ? val : lower_val;
           *dp++ = (ui8)val;
         }
-        if (fwrite(buffer, bytes_per_sample, width, fh) != width)
+        if (write_samples(mapped, fh, buffer, bytes_per_sample, width)
+            != width)
           OJPH_ERROR(0x03000158, "unable to write to file %s", fname);
       }
     }
@@ -2021,13 +3220,16 @@ namespace ojph {
         "for file %s", 
         number_of_32_bit_words_per_line * sizeof(ui32), filename);
 
-    // allocate line_buffer_16bit_samples to hold a line of image data in memory
-    line_buffer_16bit_samples = 
-      (ui16*) malloc((size_t)width * num_comps * sizeof(ui16));
-    if (NULL == line_buffer_16bit_samples)
-      OJPH_ERROR(0x03000179, "Unable to allocate %d bytes for "
-        "line_buffer_16bit_samples[] for file %s", 
-        (size_t)width * num_comps * sizeof(ui16), filename);
+    // samples are extracted directly from the file's 32bit words; other 
+    // formats are reported when reading
+    converter = NULL;
+    if (10 == bitdepth_for_image_element_1 && 3 == num_comps 
+        && packing_for_image_element_1 == 1)
+      converter = get_in_converter(
+        is_byte_swapping_necessary ? ICT_10B3C_BE : ICT_10B3C_LE);
+    else if (16 == bitdepth_for_image_element_1 && 3 == num_comps)
+      converter = get_in_converter(
+        is_byte_swapping_necessary ? ICT_16UB3C_BE : ICT_16UB3C_LE);
 
     cur_line = 0;
 
@@ -2050,56 +3252,7 @@ namespace ojph {
         OJPH_ERROR(0x03000181, "Error reading file %s", fname);
       }
 
-      if (true == is_byte_swapping_necessary)
-      {
-        if (16 == bitdepth_for_image_element_1)
-        {
-          ui16* line_buffer_ptr = (ui16*)line_buffer;
-          for (size_t i = 0; i < 2*number_of_32_bit_words_per_line; i++)
-          {
-            line_buffer_ptr[i] = be2le(line_buffer_ptr[i]);
-          }
-        }
-        else
-        {
-          ui32* line_buffer_ptr = (ui32*)line_buffer;
-          for (size_t i = 0; i < number_of_32_bit_words_per_line; i++)
-          {
-            line_buffer_ptr[i] = be2le(line_buffer_ptr[i]);
-          }
-        }
-      }
-
-      // extract samples from 32bit words from file read into 
-      // RGB ordered buffer
-      ui32 word_index = 0;
-      if (10 == bitdepth_for_image_element_1 && 3 == num_comps 
-          && packing_for_image_element_1 == 1)
-      {
-        ui32* line_buffer_ptr = (ui32*)line_buffer;
-        for (ui32 i = 0; i < number_of_samples_per_line; i += 3)
-        {
-          // R
-          line_buffer_16bit_samples[i + 0] = 
-            (ui16) ((line_buffer_ptr[word_index] & 0xFFC00000) >> 22);
-          // G
-          line_buffer_16bit_samples[i + 1] = 
-            (ui16) ((line_buffer_ptr[word_index] & 0x003FF000) >> 12);
-          // B
-          line_buffer_16bit_samples[i + 2] = 
-            (ui16) ((line_buffer_ptr[word_index] & 0x00000FFC) >>  2);
-          word_index++;
-        }
-      }
-      else if (16 == bitdepth_for_image_element_1 && 3 == num_comps)
-      {
-        ui16* line_buffer_ptr = (ui16*)line_buffer;
-        for (ui32 i = 0; i < number_of_samples_per_line; i++)
-        {
-          line_buffer_16bit_samples[i] = line_buffer_ptr[i];
-        }
-      }
-      else
+      if (converter == NULL)
       {
         OJPH_ERROR(0x03000182, "file %s uses DPX image formats that are not "
           "yet supported by this software\n bitdepth_for_image_element_1 = "
@@ -2112,12 +3265,293 @@ namespace ojph {
       cur_line++;
     }
 
-    // copy sample data from the unpacked line buffer into a 
-    // single-component buffer to be used by the openjph core
-    const ui16* sp = (ui16*)line_buffer_16bit_samples + comp_num;
-    si32* dp = line->i32;
-    for (ui32 i = width; i > 0; --i, sp += num_comps)
-      *dp++ = (si32)*sp;
+    // extract the samples of comp_num from the line read from the file,
+    // swapping bytes if needed
+    converter(line_buffer, line->i32, comp_num, width);
+
+    return width;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  //
+  //
+  //
+  //
+  ////////////////////////////////////////////////////////////////////////////
+
+  ////////////////////////////////////////////////////////////////////////////
+  packed_yuv_format get_packed_yuv_format(const char *filename)
+  {
+    static const char *exts[] = { ".v210", ".uyvy", ".nv12", ".p010", 
+                                  ".p016" };
+    static const packed_yuv_format formats[] = { PYF_V210, PYF_UYVY, 
+                                                 PYF_NV12, PYF_P010, 
+                                                 PYF_P016 };
+    const char *v = strrchr(filename, '.');
+    if (v == NULL || strlen(v) != 5)
+      return PYF_UNKNOWN;
+    for (int i = 0; i < 5; ++i)
+    {
+      int j = 0;
+      while (j < 5 && exts[i][j] == tolower(v[j]))
+        ++j;
+      if (j == 5)
+        return formats[i];
+    }
+    return PYF_UNKNOWN;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void packed_yuv_layout::init(packed_yuv_format format, const size& s)
+  {
+    if (s.w == 0 || s.h == 0)
+      OJPH_ERROR(0x03000211, "packed yuv images must have positive "
+        "dimensions");
+    this->format = format;
+    ui32 cw = ojph_div_ceil(s.w, 2u), ch = ojph_div_ceil(s.h, 2u);
+    if (format == PYF_V210 || format == PYF_UYVY)
+    {
+      // 4:2:2, where all components are in the same lines
+      size_t stride;
+      if (format == PYF_V210) {
+        bit_depth = 10;
+        stride = (size_t)ojph_div_ceil(s.w, 48u) * 128;
+        cvrt_comp[0] = 0; cvrt_comp[1] = 1; cvrt_comp[2] = 2;
+      }
+      else {
+        bit_depth = 8;
+        stride = (size_t)cw * 4;
+        cvrt_comp[0] = 1; cvrt_comp[1] = 0; cvrt_comp[2] = 2;
+      }
+      for (int c = 0; c < 3; ++c)
+      {
+        subsampling[c] = c == 0 ? point(1, 1) : point(2, 1);
+        width[c] = c == 0 ? s.w : cw;
+        height[c] = s.h;
+        plane_offset[c] = 0;
+        line_stride[c] = stride;
+      }
+      frame_size = stride * s.h;
+    }
+    else if (format == PYF_NV12 || format == PYF_P010 
+             || format == PYF_P016)
+    {
+      // 4:2:0, a Y plane followed by a plane of interleaved Cb and Cr
+      bit_depth = format == PYF_NV12 ? 8 : (format == PYF_P010 ? 10 : 16);
+      size_t bytes_per_sample = format == PYF_NV12 ? 1 : 2;
+      subsampling[0] = point(1, 1);
+      width[0] = s.w;
+      height[0] = s.h;
+      plane_offset[0] = 0;
+      line_stride[0] = bytes_per_sample * s.w;
+      cvrt_comp[0] = 0;
+      for (int c = 1; c < 3; ++c)
+      {
+        subsampling[c] = point(2, 2);
+        width[c] = cw;
+        height[c] = ch;
+        plane_offset[c] = line_stride[0] * s.h;
+        line_stride[c] = bytes_per_sample * 2 * cw;
+        cvrt_comp[c] = (ui32)c - 1;
+      }
+      frame_size = plane_offset[1] + line_stride[1] * ch;
+    }
+    else
+      OJPH_ERROR(0x03000212, "unknown packed yuv format");
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  //
+  //
+  //
+  //
+  ////////////////////////////////////////////////////////////////////////////
+
+  ////////////////////////////////////////////////////////////////////////////
+  void packed_yuv_in::open(const char* filename)
+  {
+    assert(fh == NULL);
+    packed_yuv_format format = get_packed_yuv_format(filename);
+    if (format == PYF_UNKNOWN)
+      OJPH_ERROR(0x03000221, "file %s does not have the extension of a "
+        "packed yuv format", filename);
+    layout.init(format, img_size);
+
+    fh = fopen(filename, "rb");
+    if (fh == 0)
+      OJPH_ERROR(0x03000222, "Unable to open file %s", filename);
+    fname = filename;
+    ojph_fseek(fh, 0, SEEK_END);
+    si64 file_size = ojph_ftell(fh);
+    if (file_size < (si64)layout.frame_size)
+    {
+      close();
+      OJPH_ERROR(0x03000223, "file %s does not hold a whole frame of "
+        "%u x %u pixels", filename, img_size.w, img_size.h);
+    }
+    ojph_fseek(fh, 0, SEEK_SET);
+    file_pos = 0;
+
+    switch (format)
+    {
+    case PYF_V210:
+      converter[0] = converter[1] = converter[2] = get_in_converter(ICT_V210);
+      break;
+    case PYF_UYVY:
+      converter[0] = get_in_converter(ICT_8UB2C);
+      converter[1] = converter[2] = get_in_converter(ICT_8UB4C);
+      break;
+    case PYF_NV12:
+      converter[0] = get_in_converter(ICT_8UB1C);
+      converter[1] = converter[2] = get_in_converter(ICT_8UB2C);
+      break;
+    case PYF_P010:
+      converter[0] = get_in_converter(ICT_16UB1C_LE_MSB10);
+      converter[1] = converter[2] = get_in_converter(ICT_16UB2C_LE_MSB10);
+      break;
+    default: // PYF_P016
+      converter[0] = get_in_converter(ICT_16UB1C_LE);
+      converter[1] = converter[2] = get_in_converter(ICT_16UB2C_LE);
+      break;
+    }
+    for (int c = 0; c < 3; ++c)
+      cur_line[c] = 0;
+
+    if (use_mmap)
+      mapped.open(filename); // on failure, the file is read using fh
+
+    // allocate a buffer to hold the longest line
+    size_t max_stride = ojph_max(layout.line_stride[0], 
+                                 layout.line_stride[1]);
+    if (!mapped.is_open() && temp_buf_byte_size < max_stride)
+    {
+      void *t = temp_buf ? realloc(temp_buf, max_stride) 
+                         : malloc(max_stride);
+      if (t == NULL)
+      {
+        close();
+        OJPH_ERROR(0x03000224, "Unable to allocate memory for reading "
+          "file %s", filename);
+      }
+      temp_buf = t;
+      temp_buf_byte_size = max_stride;
+    }
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  ui32 packed_yuv_in::read(const line_buf* line, ui32 comp_num)
+  {
+    assert(comp_num < 3 && cur_line[comp_num] < layout.height[comp_num]);
+    size_t stride = layout.line_stride[comp_num];
+    size_t offset = layout.plane_offset[comp_num];
+    offset += stride * cur_line[comp_num]++;
+
+    const void *sp = temp_buf;
+    if (mapped.is_open())
+      sp = mapped.get_data() + offset; // open() checked the file size
+    else
+    {
+      if (file_pos != (si64)offset)
+        ojph_fseek(fh, (si64)offset, SEEK_SET);
+      if (fread(temp_buf, 1, stride, fh) != stride)
+      {
+        close();
+        OJPH_ERROR(0x03000225, "not enough data in file %s", fname);
+      }
+      file_pos = (si64)(offset + stride);
+    }
+
+    ui32 width = layout.width[comp_num];
+    converter[comp_num](sp, line->i32, layout.cvrt_comp[comp_num], width);
+    return width;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  //
+  //
+  //
+  //
+  ////////////////////////////////////////////////////////////////////////////
+
+  ////////////////////////////////////////////////////////////////////////////
+  void packed_yuv_out::open(char *filename)
+  {
+    assert(fh == NULL && buffer != NULL); //configure before open
+    if (!use_mmap || !mapped.open(filename))
+    {
+      fh = open_output_file(filename);
+      if (fh == 0)
+        OJPH_ERROR(0x03000231, "Unable to open file %s", filename);
+    }
+    fname = filename;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void packed_yuv_out::configure(packed_yuv_format format, ui32 width, 
+                                 ui32 height)
+  {
+    assert(fh == NULL);
+    layout.init(format, size(width, height));
+
+    plane_converter = NULL;
+    switch (format)
+    {
+    case PYF_V210:
+      packer[0] = packer[1] = packer[2] = get_pack_converter(PCT_V210);
+      break;
+    case PYF_UYVY:
+      packer[0] = get_pack_converter(PCT_8UB2C);
+      packer[1] = packer[2] = get_pack_converter(PCT_8UB4C);
+      break;
+    case PYF_NV12:
+      plane_converter = get_out_converter(OCT_8UB1C);
+      packer[1] = packer[2] = get_pack_converter(PCT_8UB2C);
+      break;
+    case PYF_P010:
+      plane_converter = get_out_converter(OCT_16UB1C_LE_MSB10);
+      packer[1] = packer[2] = get_pack_converter(PCT_16UB2C_LE_MSB10);
+      break;
+    default: // PYF_P016
+      plane_converter = get_out_converter(OCT_16UB1C_LE);
+      packer[1] = packer[2] = get_pack_converter(PCT_16UB2C_LE);
+      break;
+    }
+    if (plane_converter)
+      packer[0] = NULL;
+
+    // padding and unused bits of the frame are zero
+    if (buffer)
+      free(buffer);
+    buffer = (ui8*)calloc(layout.frame_size, 1);
+    if (buffer == NULL)
+      OJPH_ERROR(0x03000232, "Unable to allocate memory for a frame");
+    lines_left = layout.height[0] + layout.height[1] + layout.height[2];
+    for (int c = 0; c < 3; ++c)
+      cur_line[c] = 0;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  ui32 packed_yuv_out::write(const line_buf* line, ui32 comp_num)
+  {
+    assert(fh || mapped.is_open());
+    assert(comp_num < 3 && cur_line[comp_num] < layout.height[comp_num]);
+
+    ui8 *dp = buffer + layout.plane_offset[comp_num];
+    dp += layout.line_stride[comp_num] * cur_line[comp_num]++;
+    ui32 width = layout.width[comp_num];
+    if (packer[comp_num])
+      packer[comp_num](line, dp, layout.cvrt_comp[comp_num], 
+                       layout.bit_depth, width);
+    else
+      plane_converter(line, NULL, NULL, dp, layout.bit_depth, width);
+
+    if (--lines_left == 0 
+        && write_samples(mapped, fh, buffer, 1, layout.frame_size) 
+           != layout.frame_size)
+      OJPH_ERROR(0x03000233, "unable to write to file %s", fname);
 
     return width;
   }
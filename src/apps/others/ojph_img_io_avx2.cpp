@@ -353,6 +353,293 @@ namespace ojph {
       *p++ = be2le((ui16) val);
     }    
   }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_8ub1c_to_32b1c(const void *sp, si32 *dp, ui32 comp_num, 
+                                ui32 count)
+  {
+    const ui8 *p = (const ui8*)sp;
+    ui32 i = 0;
+    for ( ; i + 16 <= count; i += 16, p += 16, dp += 16)
+    {
+      __m128i t = _mm_loadu_si128((__m128i*)p);
+      _mm256_storeu_si256((__m256i*)dp, _mm256_cvtepu8_epi32(t));
+      t = _mm_srli_si128(t, 8);
+      _mm256_storeu_si256((__m256i*)dp + 1, _mm256_cvtepu8_epi32(t));
+    }
+    gen_cvrt_8ub1c_to_32b1c(p, dp, comp_num, count - i);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_8ub3c_to_32b1c(const void *sp, si32 *dp, ui32 comp_num, 
+                                ui32 count)
+  {
+    const __m256i m = _mm256_setr_epi8(
+      0, -1, -1, -1, 3, -1, -1, -1, 6, -1, -1, -1, 9, -1, -1, -1,
+      0, -1, -1, -1, 3, -1, -1, -1, 6, -1, -1, -1, 9, -1, -1, -1);
+    const ui8 *p = (const ui8*)sp;
+    ui32 i = 0;
+    // the lower lane holds pixels 0 to 3, and the upper lane pixels 4 to
+    // 7; the second load reads 4 bytes beyond the 8 pixels, and therefore
+    // 2 more pixels must exist
+    for ( ; i + 10 <= count; i += 8, p += 24, dp += 8)
+    {
+      __m256i t = _mm256_inserti128_si256(_mm256_castsi128_si256(
+        _mm_loadu_si128((__m128i*)(p + comp_num))),
+        _mm_loadu_si128((__m128i*)(p + comp_num + 12)), 1);
+      _mm256_storeu_si256((__m256i*)dp, _mm256_shuffle_epi8(t, m));
+    }
+    gen_cvrt_8ub3c_to_32b1c(p, dp, comp_num, count - i);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_8sb1c_to_32b1c(const void *sp, si32 *dp, ui32 comp_num, 
+                                ui32 count)
+  {
+    const si8 *p = (const si8*)sp;
+    ui32 i = 0;
+    for ( ; i + 16 <= count; i += 16, p += 16, dp += 16)
+    {
+      __m128i t = _mm_loadu_si128((__m128i*)p);
+      _mm256_storeu_si256((__m256i*)dp, _mm256_cvtepi8_epi32(t));
+      t = _mm_srli_si128(t, 8);
+      _mm256_storeu_si256((__m256i*)dp + 1, _mm256_cvtepi8_epi32(t));
+    }
+    gen_cvrt_8sb1c_to_32b1c(p, dp, comp_num, count - i);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  static inline
+  void avx2_cvrt_16b1c_to_32b1c(const ui16 *p, si32 *dp, ui32 count, 
+                                bool is_signed, bool swap)
+  {
+    const __m128i m = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 
+                                    9, 8, 11, 10, 13, 12, 15, 14);
+    for ( ; count >= 8; count -= 8, p += 8, dp += 8)
+    {
+      __m128i t = _mm_loadu_si128((__m128i*)p);
+      if (swap)
+        t = _mm_shuffle_epi8(t, m);
+      __m256i u = is_signed ? _mm256_cvtepi16_epi32(t) 
+                            : _mm256_cvtepu16_epi32(t);
+      _mm256_storeu_si256((__m256i*)dp, u);
+    }
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_16ub1c_le_to_32b1c(const void *sp, si32 *dp, 
+                                    ui32 comp_num, ui32 count)
+  {
+    ui32 n = count & ~7u;
+    avx2_cvrt_16b1c_to_32b1c((const ui16*)sp, dp, n, false, false);
+    gen_cvrt_16ub1c_le_to_32b1c((const ui16*)sp + n, dp + n, comp_num, 
+      count - n);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_16ub1c_be_to_32b1c(const void *sp, si32 *dp, 
+                                    ui32 comp_num, ui32 count)
+  {
+    ui32 n = count & ~7u;
+    avx2_cvrt_16b1c_to_32b1c((const ui16*)sp, dp, n, false, true);
+    gen_cvrt_16ub1c_be_to_32b1c((const ui16*)sp + n, dp + n, comp_num, 
+      count - n);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_16sb1c_le_to_32b1c(const void *sp, si32 *dp, 
+                                    ui32 comp_num, ui32 count)
+  {
+    ui32 n = count & ~7u;
+    avx2_cvrt_16b1c_to_32b1c((const ui16*)sp, dp, n, true, false);
+    gen_cvrt_16sb1c_le_to_32b1c((const ui16*)sp + n, dp + n, comp_num, 
+      count - n);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // extracts one component from 3 interleaved 16-bit components; the
+  // lower lane holds pixels 0 to 3, and the upper lane pixels 4 to 7.  In
+  // each lane, 2 pixels are taken from each of 2 loads; the last load 
+  // reads beyond the 8 pixels, and 2 more pixels must exist
+  static inline
+  ui32 avx2_cvrt_16b3c_to_32b1c(const ui16 *p, si32 *dp, ui32 count,
+                                bool swap)
+  {
+    __m256i m0, m1;
+    if (swap) {
+      m0 = _mm256_setr_epi8(
+        1, 0, -1, -1, 7, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        1, 0, -1, -1, 7, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+      m1 = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, 1, 0, -1, -1, 7, 6, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, 1, 0, -1, -1, 7, 6, -1, -1);
+    }
+    else {
+      m0 = _mm256_setr_epi8(
+        0, 1, -1, -1, 6, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 1, -1, -1, 6, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+      m1 = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, 0, 1, -1, -1, 6, 7, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, 0, 1, -1, -1, 6, 7, -1, -1);
+    }
+    ui32 i = 0;
+    for ( ; i + 10 <= count; i += 8, p += 24, dp += 8)
+    {
+      __m256i t = _mm256_inserti128_si256(_mm256_castsi128_si256(
+        _mm_loadu_si128((__m128i*)p)), _mm_loadu_si128((__m128i*)(p + 12)),
+        1);
+      __m256i u = _mm256_inserti128_si256(_mm256_castsi128_si256(
+        _mm_loadu_si128((__m128i*)(p + 6))), 
+        _mm_loadu_si128((__m128i*)(p + 18)), 1);
+      t = _mm256_or_si256(_mm256_shuffle_epi8(t, m0), 
+                          _mm256_shuffle_epi8(u, m1));
+      _mm256_storeu_si256((__m256i*)dp, t);
+    }
+    return i;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_16ub3c_le_to_32b1c(const void *sp, si32 *dp, 
+                                    ui32 comp_num, ui32 count)
+  {
+    const ui16 *p = (const ui16*)sp;
+    ui32 n = avx2_cvrt_16b3c_to_32b1c(p + comp_num, dp, count, false);
+    gen_cvrt_16ub3c_le_to_32b1c(p + 3 * n, dp + n, comp_num, count - n);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_16ub3c_be_to_32b1c(const void *sp, si32 *dp, 
+                                    ui32 comp_num, ui32 count)
+  {
+    const ui16 *p = (const ui16*)sp;
+    ui32 n = avx2_cvrt_16b3c_to_32b1c(p + comp_num, dp, count, true);
+    gen_cvrt_16ub3c_be_to_32b1c(p + 3 * n, dp + n, comp_num, count - n);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  static inline
+  void avx2_cvrt_10b3c_to_32b1c(const ui32 *p, si32 *dp, ui32 comp_num,
+                                ui32 count, bool swap)
+  {
+    const __m256i m = _mm256_setr_epi8(
+      3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+      3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    const __m256i mask = _mm256_set1_epi32(0x3FF);
+    const __m128i shift = _mm_cvtsi32_si128((int)(22 - 10 * comp_num));
+    for ( ; count >= 8; count -= 8, p += 8, dp += 8)
+    {
+      __m256i t = _mm256_loadu_si256((__m256i*)p);
+      if (swap)
+        t = _mm256_shuffle_epi8(t, m);
+      t = _mm256_and_si256(_mm256_srl_epi32(t, shift), mask);
+      _mm256_storeu_si256((__m256i*)dp, t);
+    }
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_10b3c_le_to_32b1c(const void *sp, si32 *dp, 
+                                   ui32 comp_num, ui32 count)
+  {
+    ui32 n = count & ~7u;
+    avx2_cvrt_10b3c_to_32b1c((const ui32*)sp, dp, comp_num, n, false);
+    gen_cvrt_10b3c_le_to_32b1c((const ui32*)sp + n, dp + n, comp_num, 
+      count - n);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_10b3c_be_to_32b1c(const void *sp, si32 *dp, 
+                                   ui32 comp_num, ui32 count)
+  {
+    ui32 n = count & ~7u;
+    avx2_cvrt_10b3c_to_32b1c((const ui32*)sp, dp, comp_num, n, true);
+    gen_cvrt_10b3c_be_to_32b1c((const ui32*)sp + n, dp + n, comp_num, 
+      count - n);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_8ub2c_to_32b1c(const void *sp, si32 *dp, ui32 comp_num, 
+                                ui32 count)
+  {
+    // gathers the 8 samples of comp_num in 16 bytes into the lower 8 bytes
+    const __m128i m = _mm_add_epi8(
+      _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 0, 2, 4, 6, 8, 10, 12, 14),
+      _mm_set1_epi8((char)comp_num));
+    const ui8 *p = (const ui8*)sp;
+    ui32 i = 0;
+    for ( ; i + 8 <= count; i += 8, p += 16, dp += 8)
+    {
+      __m128i t = _mm_loadu_si128((__m128i*)p);
+      t = _mm_shuffle_epi8(t, m);
+      _mm256_storeu_si256((__m256i*)dp, _mm256_cvtepu8_epi32(t));
+    }
+    gen_cvrt_8ub2c_to_32b1c(p, dp, comp_num, count - i);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // extracts the bits of comp_num from 32-bit words, each holding a sample
+  // of every component, and removes the lower unused bits of samples held 
+  // in the MSBs
+  static inline
+  void avx2_cvrt_32b_fields_to_32b1c(const ui32 *p, si32 *dp, ui32 count, 
+                                     ui32 shift, int mask_val)
+  {
+    const __m128i sh = _mm_cvtsi32_si128((int)shift);
+    const __m256i mask = _mm256_set1_epi32(mask_val);
+    for ( ; count > 0; count -= 8, p += 8, dp += 8)
+    {
+      __m256i t = _mm256_loadu_si256((__m256i*)p);
+      t = _mm256_and_si256(_mm256_srl_epi32(t, sh), mask);
+      _mm256_storeu_si256((__m256i*)dp, t);
+    }
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_8ub4c_to_32b1c(const void *sp, si32 *dp, ui32 comp_num, 
+                                ui32 count)
+  {
+    ui32 n = count & ~7u;
+    avx2_cvrt_32b_fields_to_32b1c((const ui32*)sp, dp, n, 8 * comp_num, 
+      0xFF);
+    gen_cvrt_8ub4c_to_32b1c((const ui32*)sp + n, dp + n, comp_num, 
+      count - n);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_16ub2c_le_to_32b1c(const void *sp, si32 *dp, 
+                                    ui32 comp_num, ui32 count)
+  {
+    ui32 n = count & ~7u;
+    avx2_cvrt_32b_fields_to_32b1c((const ui32*)sp, dp, n, 16 * comp_num, 
+      0xFFFF);
+    gen_cvrt_16ub2c_le_to_32b1c((const ui32*)sp + n, dp + n, comp_num, 
+      count - n);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_16ub2c_le_msb10_to_32b1c(const void *sp, si32 *dp, 
+                                          ui32 comp_num, ui32 count)
+  {
+    ui32 n = count & ~7u;
+    avx2_cvrt_32b_fields_to_32b1c((const ui32*)sp, dp, n, 
+      16 * comp_num + 6, 0x3FF);
+    gen_cvrt_16ub2c_le_msb10_to_32b1c((const ui32*)sp + n, dp + n, 
+      comp_num, count - n);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void avx2_cvrt_16ub1c_le_msb10_to_32b1c(const void *sp, si32 *dp, 
+                                          ui32 comp_num, ui32 count)
+  {
+    const ui16 *p = (const ui16*)sp;
+    ui32 i = 0;
+    for ( ; i + 8 <= count; i += 8, p += 8, dp += 8)
+    {
+      __m128i t = _mm_loadu_si128((__m128i*)p);
+      t = _mm_srli_epi16(t, 6);
+      _mm256_storeu_si256((__m256i*)dp, _mm256_cvtepu16_epi32(t));
+    }
+    gen_cvrt_16ub1c_le_msb10_to_32b1c(p, dp, comp_num, count - i);
+  }
 }
 
 #endif
@@ -508,6 +508,570 @@ namespace ojph {
       *p++ = be2le((ui16) val);
     }
   }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void sse41_cvrt_8ub1c_to_32b1c(const void *sp, si32 *dp, ui32 comp_num, 
+                                 ui32 count)
+  {
+    const ui8 *p = (const ui8*)sp;
+    ui32 i = 0;
+    for ( ; i + 16 <= count; i += 16, p += 16, dp += 16)
+    {
+      __m128i t = _mm_loadu_si128((__m128i*)p);
+      _mm_storeu_si128((__m128i*)dp, _mm_cvtepu8_epi32(t));
+      t = _mm_srli_si128(t, 4);
+      _mm_storeu_si128((__m128i*)dp + 1, _mm_cvtepu8_epi32(t));
+      t = _mm_srli_si128(t, 4);
+      _mm_storeu_si128((__m128i*)dp + 2, _mm_cvtepu8_epi32(t));
+      t = _mm_srli_si128(t, 4);
+      _mm_storeu_si128((__m128i*)dp + 3, _mm_cvtepu8_epi32(t));
+    }
+    gen_cvrt_8ub1c_to_32b1c(p, dp, comp_num, count - i);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void sse41_cvrt_8ub3c_to_32b1c(const void *sp, si32 *dp, ui32 comp_num, 
+                                 ui32 count)
+  {
+    const __m128i m = _mm_setr_epi8(0, -1, -1, -1, 3, -1, -1, -1, 
+                                    6, -1, -1, -1, 9, -1, -1, -1);
+    const ui8 *p = (const ui8*)sp;
+    ui32 i = 0;
+    // each load reads 16 bytes, of which 12 are used; 2 more pixels 
+    // must exist for the remaining bytes
+    for ( ; i + 6 <= count; i += 4, p += 12, dp += 4)
+    {
+      __m128i t = _mm_loadu_si128((__m128i*)(p + comp_num));
+      _mm_storeu_si128((__m128i*)dp, _mm_shuffle_epi8(t, m));
+    }
+    gen_cvrt_8ub3c_to_32b1c(p, dp, comp_num, count - i);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void sse41_cvrt_8sb1c_to_32b1c(const void *sp, si32 *dp, ui32 comp_num, 
+                                 ui32 count)
+  {
+    const si8 *p = (const si8*)sp;
+    ui32 i = 0;
+    for ( ; i + 16 <= count; i += 16, p += 16, dp += 16)
+    {
+      __m128i t = _mm_loadu_si128((__m128i*)p);
+      _mm_storeu_si128((__m128i*)dp, _mm_cvtepi8_epi32(t));
+      t = _mm_srli_si128(t, 4);
+      _mm_storeu_si128((__m128i*)dp + 1, _mm_cvtepi8_epi32(t));
+      t = _mm_srli_si128(t, 4);
+      _mm_storeu_si128((__m128i*)dp + 2, _mm_cvtepi8_epi32(t));
+      t = _mm_srli_si128(t, 4);
+      _mm_storeu_si128((__m128i*)dp + 3, _mm_cvtepi8_epi32(t));
+    }
+    gen_cvrt_8sb1c_to_32b1c(p, dp, comp_num, count - i);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  static inline
+  void sse41_cvrt_16b1c_to_32b1c(const ui16 *p, si32 *dp, ui32 count, 
+                                 bool is_signed, bool swap)
+  {
+    const __m128i m = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 
+                                    9, 8, 11, 10, 13, 12, 15, 14);
+    for ( ; count >= 8; count -= 8, p += 8, dp += 8)
+    {
+      __m128i t = _mm_loadu_si128((__m128i*)p);
+      if (swap)
+        t = _mm_shuffle_epi8(t, m);
+      __m128i u = _mm_srli_si128(t, 8);
+      if (is_signed) {
+        t = _mm_cvtepi16_epi32(t);
+        u = _mm_cvtepi16_epi32(u);
+      }
+      else {
+        t = _mm_cvtepu16_epi32(t);
+        u = _mm_cvtepu16_epi32(u);
+      }
+      _mm_storeu_si128((__m128i*)dp, t);
+      _mm_storeu_si128((__m128i*)dp + 1, u);
+    }
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void sse41_cvrt_16ub1c_le_to_32b1c(const void *sp, si32 *dp, 
+                                     ui32 comp_num, ui32 count)
+  {
+    ui32 n = count & ~7u;
+    sse41_cvrt_16b1c_to_32b1c((const ui16*)sp, dp, n, false, false);
+    gen_cvrt_16ub1c_le_to_32b1c((const ui16*)sp + n, dp + n, comp_num, 
+      count - n);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void sse41_cvrt_16ub1c_be_to_32b1c(const void *sp, si32 *dp, 
+                                     ui32 comp_num, ui32 count)
+  {
+    ui32 n = count & ~7u;
+    sse41_cvrt_16b1c_to_32b1c((const ui16*)sp, dp, n, false, true);
+    gen_cvrt_16ub1c_be_to_32b1c((const ui16*)sp + n, dp + n, comp_num, 
+      count - n);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void sse41_cvrt_16sb1c_le_to_32b1c(const void *sp, si32 *dp, 
+                                     ui32 comp_num, ui32 count)
+  {
+    ui32 n = count & ~7u;
+    sse41_cvrt_16b1c_to_32b1c((const ui16*)sp, dp, n, true, false);
+    gen_cvrt_16sb1c_le_to_32b1c((const ui16*)sp + n, dp + n, comp_num, 
+      count - n);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // extracts one component from 3 interleaved 16-bit components; pixels 0
+  // and 1 are taken from the load at p, and pixels 2 and 3 from the load
+  // at p + 6, which reads beyond the 4 pixels; 2 more pixels must exist
+  static inline
+  ui32 sse41_cvrt_16b3c_to_32b1c(const ui16 *p, si32 *dp, ui32 count,
+                                 bool swap)
+  {
+    __m128i m0, m1;
+    if (swap) {
+      m0 = _mm_setr_epi8(1, 0, -1, -1, 7, 6, -1, -1, 
+                         -1, -1, -1, -1, -1, -1, -1, -1);
+      m1 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, 
+                         1, 0, -1, -1, 7, 6, -1, -1);
+    }
+    else {
+      m0 = _mm_setr_epi8(0, 1, -1, -1, 6, 7, -1, -1, 
+                         -1, -1, -1, -1, -1, -1, -1, -1);
+      m1 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, 
+                         0, 1, -1, -1, 6, 7, -1, -1);
+    }
+    ui32 i = 0;
+    for ( ; i + 6 <= count; i += 4, p += 12, dp += 4)
+    {
+      __m128i t = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)p), m0);
+      __m128i u = _mm_shuffle_epi8(_mm_loadu_si128((__m128i*)(p + 6)), m1);
+      _mm_storeu_si128((__m128i*)dp, _mm_or_si128(t, u));
+    }
+    return i;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void sse41_cvrt_16ub3c_le_to_32b1c(const void *sp, si32 *dp, 
+                                     ui32 comp_num, ui32 count)
+  {
+    const ui16 *p = (const ui16*)sp;
+    ui32 n = sse41_cvrt_16b3c_to_32b1c(p + comp_num, dp, count, false);
+    gen_cvrt_16ub3c_le_to_32b1c(p + 3 * n, dp + n, comp_num, count - n);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void sse41_cvrt_16ub3c_be_to_32b1c(const void *sp, si32 *dp, 
+                                     ui32 comp_num, ui32 count)
+  {
+    const ui16 *p = (const ui16*)sp;
+    ui32 n = sse41_cvrt_16b3c_to_32b1c(p + comp_num, dp, count, true);
+    gen_cvrt_16ub3c_be_to_32b1c(p + 3 * n, dp + n, comp_num, count - n);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  static inline
+  void sse41_cvrt_10b3c_to_32b1c(const ui32 *p, si32 *dp, ui32 comp_num,
+                                 ui32 count, bool swap)
+  {
+    const __m128i m = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 
+                                    11, 10, 9, 8, 15, 14, 13, 12);
+    const __m128i mask = _mm_set1_epi32(0x3FF);
+    const __m128i shift = _mm_cvtsi32_si128((int)(22 - 10 * comp_num));
+    for ( ; count >= 4; count -= 4, p += 4, dp += 4)
+    {
+      __m128i t = _mm_loadu_si128((__m128i*)p);
+      if (swap)
+        t = _mm_shuffle_epi8(t, m);
+      t = _mm_and_si128(_mm_srl_epi32(t, shift), mask);
+      _mm_storeu_si128((__m128i*)dp, t);
+    }
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void sse41_cvrt_10b3c_le_to_32b1c(const void *sp, si32 *dp, 
+                                    ui32 comp_num, ui32 count)
+  {
+    ui32 n = count & ~3u;
+    sse41_cvrt_10b3c_to_32b1c((const ui32*)sp, dp, comp_num, n, false);
+    gen_cvrt_10b3c_le_to_32b1c((const ui32*)sp + n, dp + n, comp_num, 
+      count - n);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void sse41_cvrt_10b3c_be_to_32b1c(const void *sp, si32 *dp, 
+                                    ui32 comp_num, ui32 count)
+  {
+    ui32 n = count & ~3u;
+    sse41_cvrt_10b3c_to_32b1c((const ui32*)sp, dp, comp_num, n, true);
+    gen_cvrt_10b3c_be_to_32b1c((const ui32*)sp + n, dp + n, comp_num, 
+      count - n);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void sse41_cvrt_8ub2c_to_32b1c(const void *sp, si32 *dp, ui32 comp_num, 
+                                 ui32 count)
+  {
+    // gathers the 8 samples of comp_num in 16 bytes into the lower 8 bytes
+    const __m128i m = _mm_add_epi8(
+      _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 0, 2, 4, 6, 8, 10, 12, 14),
+      _mm_set1_epi8((char)comp_num));
+    const ui8 *p = (const ui8*)sp;
+    ui32 i = 0;
+    for ( ; i + 8 <= count; i += 8, p += 16, dp += 8)
+    {
+      __m128i t = _mm_loadu_si128((__m128i*)p);
+      t = _mm_shuffle_epi8(t, m);
+      _mm_storeu_si128((__m128i*)dp, _mm_cvtepu8_epi32(t));
+      t = _mm_srli_si128(t, 4);
+      _mm_storeu_si128((__m128i*)dp + 1, _mm_cvtepu8_epi32(t));
+    }
+    gen_cvrt_8ub2c_to_32b1c(p, dp, comp_num, count - i);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void sse41_cvrt_8ub4c_to_32b1c(const void *sp, si32 *dp, ui32 comp_num, 
+                                 ui32 count)
+  {
+    const __m128i shift = _mm_cvtsi32_si128((int)(8 * comp_num));
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    const ui8 *p = (const ui8*)sp;
+    ui32 i = 0;
+    for ( ; i + 4 <= count; i += 4, p += 16, dp += 4)
+    {
+      __m128i t = _mm_loadu_si128((__m128i*)p);
+      t = _mm_and_si128(_mm_srl_epi32(t, shift), mask);
+      _mm_storeu_si128((__m128i*)dp, t);
+    }
+    gen_cvrt_8ub4c_to_32b1c(p, dp, comp_num, count - i);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // extracts the 16-bit samples of comp_num from pairs of samples, and
+  // removes the lower unused bits of samples held in the MSBs
+  static inline
+  void sse41_cvrt_16b2c_to_32b1c(const ui16 *p, si32 *dp, ui32 comp_num, 
+                                 ui32 count, ui32 lsbs, int mask_val)
+  {
+    const __m128i shift = _mm_cvtsi32_si128((int)(16 * comp_num + lsbs));
+    const __m128i mask = _mm_set1_epi32(mask_val);
+    for ( ; count > 0; count -= 4, p += 8, dp += 4)
+    {
+      __m128i t = _mm_loadu_si128((__m128i*)p);
+      t = _mm_and_si128(_mm_srl_epi32(t, shift), mask);
+      _mm_storeu_si128((__m128i*)dp, t);
+    }
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void sse41_cvrt_16ub2c_le_to_32b1c(const void *sp, si32 *dp, 
+                                     ui32 comp_num, ui32 count)
+  {
+    ui32 n = count & ~3u;
+    sse41_cvrt_16b2c_to_32b1c((const ui16*)sp, dp, comp_num, n, 0, 0xFFFF);
+    gen_cvrt_16ub2c_le_to_32b1c((const ui16*)sp + 2 * n, dp + n, comp_num, 
+      count - n);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void sse41_cvrt_16ub2c_le_msb10_to_32b1c(const void *sp, si32 *dp, 
+                                           ui32 comp_num, ui32 count)
+  {
+    ui32 n = count & ~3u;
+    sse41_cvrt_16b2c_to_32b1c((const ui16*)sp, dp, comp_num, n, 6, 0x3FF);
+    gen_cvrt_16ub2c_le_msb10_to_32b1c((const ui16*)sp + 2 * n, dp + n, 
+      comp_num, count - n);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void sse41_cvrt_16ub1c_le_msb10_to_32b1c(const void *sp, si32 *dp, 
+                                           ui32 comp_num, ui32 count)
+  {
+    const ui16 *p = (const ui16*)sp;
+    ui32 i = 0;
+    for ( ; i + 8 <= count; i += 8, p += 8, dp += 8)
+    {
+      __m128i t = _mm_loadu_si128((__m128i*)p);
+      t = _mm_srli_epi16(t, 6);
+      _mm_storeu_si128((__m128i*)dp, _mm_cvtepu16_epi32(t));
+      t = _mm_srli_si128(t, 8);
+      _mm_storeu_si128((__m128i*)dp + 1, _mm_cvtepu16_epi32(t));
+    }
+    gen_cvrt_16ub1c_le_msb10_to_32b1c(p, dp, comp_num, count - i);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void sse41_cvrt_v210_to_32b1c(const void *sp, si32 *dp, ui32 comp_num, 
+                                ui32 count)
+  {
+    // s0, s1, and s2 hold the first, second, and third 10-bit field of 
+    // each of the 4 words of a group; samples are gathered from them by 
+    // blending 32-bit lanes (2 bits per lane in the masks)
+    const __m128i mask = _mm_set1_epi32(0x3FF);
+    const ui32 *p = (const ui32*)sp;
+    ui32 i = 0;
+    if (comp_num == 0)
+    {
+      // Y is s1[0], s0[1], s2[1], s1[2], s0[3], s2[3]
+      for ( ; i + 6 <= count; i += 6, p += 4, dp += 6)
+      {
+        __m128i a = _mm_loadu_si128((__m128i*)p);
+        __m128i s0 = _mm_and_si128(a, mask);
+        __m128i s1 = _mm_and_si128(_mm_srli_epi32(a, 10), mask);
+        __m128i s2 = _mm_and_si128(_mm_srli_epi32(a, 20), mask);
+        __m128i t = _mm_shuffle_epi32(s1, _MM_SHUFFLE(2, 0, 0, 0));
+        t = _mm_blend_epi16(t, s0, 0x0C);
+        t = _mm_blend_epi16(t, _mm_shuffle_epi32(s2, 0x55), 0x30);
+        _mm_storeu_si128((__m128i*)dp, t);
+        t = _mm_shuffle_epi32(s0, 0xFF);
+        t = _mm_blend_epi16(t, _mm_shuffle_epi32(s2, 0xFF), 0x0C);
+        _mm_storel_epi64((__m128i*)(dp + 4), t);
+      }
+    }
+    else 
+    {
+      // Cb is s0[0], s1[1], s2[2], and Cr is s2[0], s0[2], s1[3]; 4 
+      // samples are stored for 3, and therefore 1 more sample must exist
+      for ( ; i + 4 <= count; i += 3, p += 4, dp += 3)
+      {
+        __m128i a = _mm_loadu_si128((__m128i*)p);
+        __m128i s0 = _mm_and_si128(a, mask);
+        __m128i s1 = _mm_and_si128(_mm_srli_epi32(a, 10), mask);
+        __m128i s2 = _mm_and_si128(_mm_srli_epi32(a, 20), mask);
+        __m128i t;
+        if (comp_num == 1)
+        {
+          t = _mm_blend_epi16(s0, s1, 0x0C);
+          t = _mm_blend_epi16(t, s2, 0x30);
+        }
+        else
+        {
+          t = _mm_shuffle_epi32(s0, _MM_SHUFFLE(3, 3, 2, 0));
+          t = _mm_blend_epi16(s2, t, 0x0C);
+          t = _mm_blend_epi16(t, _mm_shuffle_epi32(s1, 0xFF), 0x30);
+        }
+        _mm_storeu_si128((__m128i*)dp, t);
+      }
+    }
+    gen_cvrt_v210_to_32b1c(p, dp, comp_num, count - i);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void sse41_cvrt_32b1c_to_16ub1c_le_msb10(const line_buf *ln0, 
+                                           const line_buf *ln1, 
+                                           const line_buf *ln2, void *dp, 
+                                           ui32 bit_depth, ui32 count)
+  {
+    ojph_unused(ln1);
+    ojph_unused(ln2);
+
+    __m128i max_val_vec = _mm_set1_epi32((1 << bit_depth) - 1);
+    __m128i zero = _mm_setzero_si128();
+    const si32 *sp = ln0->i32;
+    ui16* p = (ui16 *)dp;
+
+    // 8 entries in each loop
+    for ( ; count >= 8; count -= 8, sp += 8, p += 8) 
+    {
+      __m128i a, b;
+      a = _mm_loadu_si128((__m128i*)sp);
+      a = _mm_max_epi32(a, zero);
+      a = _mm_min_epi32(a, max_val_vec);
+      b = _mm_loadu_si128((__m128i*)sp + 1);
+      b = _mm_max_epi32(b, zero);
+      b = _mm_min_epi32(b, max_val_vec);
+      a = _mm_slli_epi16(_mm_packus_epi32(a, b), 6);
+      _mm_storeu_si128((__m128i*)p, a);
+    }
+
+    int max_val = (1<<bit_depth) - 1;
+    for ( ; count > 0; --count)
+    {
+      int val = *sp++;
+      val = val >= 0 ? val : 0;
+      val = val <= max_val ? val : max_val;
+      *p++ = (ui16)(val << 6);
+    }
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // the packing kernels replace the bits of comp_num in each 16 bytes of 
+  // the line, and leave the remaining samples to the gen_ kernels, which 
+  // are given a line_buf that starts at the first remaining sample
+  static inline
+  const line_buf *remaining_samples(const line_buf *ln, const si32 *sp, 
+                                    line_buf &tail)
+  {
+    tail = *ln;
+    tail.i32 = (si32*)sp;
+    return &tail;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void sse41_cvrt_32b1c_to_8ub2c(const line_buf *ln, void *dp, 
+                                 ui32 comp_num, ui32 bit_depth, ui32 count)
+  {
+    __m128i max_val_vec = _mm_set1_epi32((1 << bit_depth) - 1);
+    __m128i zero = _mm_setzero_si128();
+    __m128i shift = _mm_cvtsi32_si128((int)(8 * comp_num));
+    __m128i keep = _mm_set1_epi16((si16)(comp_num == 0 ? 0xFF00 : 0x00FF));
+    const si32 *sp = ln->i32;
+    ui8 *p = (ui8*)dp;
+
+    for ( ; count >= 8; count -= 8, sp += 8, p += 16)
+    {
+      __m128i a, b;
+      a = _mm_loadu_si128((__m128i*)sp);
+      a = _mm_max_epi32(a, zero);
+      a = _mm_min_epi32(a, max_val_vec);
+      b = _mm_loadu_si128((__m128i*)sp + 1);
+      b = _mm_max_epi32(b, zero);
+      b = _mm_min_epi32(b, max_val_vec);
+      a = _mm_sll_epi16(_mm_packus_epi32(a, b), shift);
+      b = _mm_and_si128(_mm_loadu_si128((__m128i*)p), keep);
+      _mm_storeu_si128((__m128i*)p, _mm_or_si128(a, b));
+    }
+
+    line_buf tail;
+    gen_cvrt_32b1c_to_8ub2c(remaining_samples(ln, sp, tail), p, comp_num, 
+      bit_depth, count);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // stores 4 samples in the bits of 32-bit words selected by field, after
+  // shifting them left by shift
+  static inline
+  void sse41_pack_32b1c_to_4c(const si32 *sp, ui32 *p, ui32 count, 
+                              ui32 bit_depth, ui32 shift, ui32 field)
+  {
+    __m128i max_val_vec = _mm_set1_epi32((1 << bit_depth) - 1);
+    __m128i zero = _mm_setzero_si128();
+    __m128i sh = _mm_cvtsi32_si128((int)shift);
+    __m128i keep = _mm_set1_epi32((int)~field);
+    for ( ; count > 0; count -= 4, sp += 4, p += 4)
+    {
+      __m128i a = _mm_loadu_si128((__m128i*)sp);
+      a = _mm_max_epi32(a, zero);
+      a = _mm_min_epi32(a, max_val_vec);
+      a = _mm_sll_epi32(a, sh);
+      __m128i b = _mm_and_si128(_mm_loadu_si128((__m128i*)p), keep);
+      _mm_storeu_si128((__m128i*)p, _mm_or_si128(a, b));
+    }
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void sse41_cvrt_32b1c_to_8ub4c(const line_buf *ln, void *dp, 
+                                 ui32 comp_num, ui32 bit_depth, ui32 count)
+  {
+    ui32 n = count & ~3u;
+    sse41_pack_32b1c_to_4c(ln->i32, (ui32*)dp, n, bit_depth, 8 * comp_num,
+      0xFFu << (8 * comp_num));
+    line_buf tail;
+    gen_cvrt_32b1c_to_8ub4c(remaining_samples(ln, ln->i32 + n, tail), 
+      (ui32*)dp + n, comp_num, bit_depth, count - n);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void sse41_cvrt_32b1c_to_16ub2c_le(const line_buf *ln, void *dp, 
+                                     ui32 comp_num, ui32 bit_depth, 
+                                     ui32 count)
+  {
+    ui32 n = count & ~3u;
+    sse41_pack_32b1c_to_4c(ln->i32, (ui32*)dp, n, bit_depth, 16 * comp_num,
+      0xFFFFu << (16 * comp_num));
+    line_buf tail;
+    gen_cvrt_32b1c_to_16ub2c_le(remaining_samples(ln, ln->i32 + n, tail), 
+      (ui32*)dp + n, comp_num, bit_depth, count - n);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void sse41_cvrt_32b1c_to_16ub2c_le_msb10(const line_buf *ln, void *dp, 
+                                           ui32 comp_num, ui32 bit_depth, 
+                                           ui32 count)
+  {
+    ui32 n = count & ~3u;
+    sse41_pack_32b1c_to_4c(ln->i32, (ui32*)dp, n, bit_depth, 
+      16 * comp_num + 6, 0xFFFFu << (16 * comp_num));
+    line_buf tail;
+    gen_cvrt_32b1c_to_16ub2c_le_msb10(
+      remaining_samples(ln, ln->i32 + n, tail), (ui32*)dp + n, comp_num, 
+      bit_depth, count - n);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  void sse41_cvrt_32b1c_to_v210(const line_buf *ln, void *dp, 
+                                ui32 comp_num, ui32 bit_depth, ui32 count)
+  {
+    // the samples of a group are moved into the lanes of the words that 
+    // hold them, and multiplied by powers of 2 to reach their fields; the
+    // multiplier is zero for a word without a sample
+    __m128i max_val_vec = _mm_set1_epi32((1 << bit_depth) - 1);
+    __m128i zero = _mm_setzero_si128();
+    const si32 *sp = ln->i32;
+    ui32 *p = (ui32*)dp;
+    if (comp_num == 0)
+    {
+      // Y0 to Y5 are at word 0 bit 10, word 1 bits 0 and 20, word 2 bit 
+      // 10, and word 3 bits 0 and 20
+      const __m128i m0 = _mm_setr_epi32(1 << 10, 1, 1 << 10, 1);
+      const __m128i m1 = _mm_setr_epi32(0, 1 << 20, 0, 1 << 20);
+      const __m128i keep = _mm_setr_epi32(~(0x3FF << 10), 
+        ~(0x3FF | (0x3FF << 20)), ~(0x3FF << 10), ~(0x3FF | (0x3FF << 20)));
+      for ( ; count >= 6; count -= 6, sp += 6, p += 4)
+      {
+        __m128i a = _mm_loadu_si128((__m128i*)sp);
+        a = _mm_max_epi32(a, zero);
+        a = _mm_min_epi32(a, max_val_vec);
+        __m128i b = _mm_loadl_epi64((__m128i*)(sp + 4));
+        b = _mm_max_epi32(b, zero);
+        b = _mm_min_epi32(b, max_val_vec);
+        // [Y0, Y1, Y3, Y4] and [-, Y2, -, Y5]
+        __m128i t = _mm_shuffle_epi32(a, _MM_SHUFFLE(3, 3, 1, 0));
+        t = _mm_blend_epi16(t, _mm_shuffle_epi32(b, 0x00), 0xC0);
+        __m128i u = _mm_shuffle_epi32(a, 0xAA);
+        u = _mm_blend_epi16(u, _mm_shuffle_epi32(b, 0x55), 0xC0);
+        t = _mm_or_si128(_mm_mullo_epi32(t, m0), _mm_mullo_epi32(u, m1));
+        u = _mm_and_si128(_mm_loadu_si128((__m128i*)p), keep);
+        _mm_storeu_si128((__m128i*)p, _mm_or_si128(t, u));
+      }
+    }
+    else
+    {
+      // Cb0 to Cb2 are at word 0 bit 0, word 1 bit 10, and word 2 bit 20,
+      // and Cr0 to Cr2 at word 0 bit 20, word 2 bit 0, and word 3 bit 10;
+      // 4 samples are loaded for 3
+      bool is_cr = comp_num == 2;
+      __m128i m, keep;
+      if (!is_cr)
+      {
+        m = _mm_setr_epi32(1, 1 << 10, 1 << 20, 0);
+        keep = _mm_setr_epi32(~0x3FF, ~(0x3FF << 10), ~(0x3FF << 20), -1);
+      }
+      else
+      {
+        m = _mm_setr_epi32(1 << 20, 0, 1, 1 << 10);
+        keep = _mm_setr_epi32(~(0x3FF << 20), -1, ~0x3FF, ~(0x3FF << 10));
+      }
+      for ( ; count >= 4; count -= 3, sp += 3, p += 4)
+      {
+        __m128i a = _mm_loadu_si128((__m128i*)sp);
+        a = _mm_max_epi32(a, zero);
+        a = _mm_min_epi32(a, max_val_vec);
+        if (is_cr) // [Cr0, Cr0, Cr1, Cr2]
+          a = _mm_shuffle_epi32(a, _MM_SHUFFLE(2, 1, 0, 0));
+        a = _mm_mullo_epi32(a, m);
+        __m128i b = _mm_and_si128(_mm_loadu_si128((__m128i*)p), keep);
+        _mm_storeu_si128((__m128i*)p, _mm_or_si128(a, b));
+      }
+    }
+
+    line_buf tail;
+    gen_cvrt_32b1c_to_v210(remaining_samples(ln, sp, tail), p, comp_num, 
+      bit_depth, count);
+  }
 }
 
 #endif
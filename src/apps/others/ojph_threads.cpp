@@ -86,8 +86,11 @@ void thread_pool::start_thread(thread_pool* tp)
     // setup the condition variable
     std::unique_lock<std::mutex> lock(tp->mutex);
     // wait releases the mutex, blocks until notified (or spuriously), 
-    // and acquire the mutex
-    tp->condition.wait(lock);
+    // and acquire the mutex; tasks added while all threads were busy are
+    // picked up without waiting for another notification
+    tp->condition.wait(lock, [tp] { 
+      return !tp->tasks.empty() || tp->stop.load(std::memory_order_acquire);
+    });
   
     if(tp->stop.load(std::memory_order_acquire))
       return;
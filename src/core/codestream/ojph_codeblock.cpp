@@ -44,6 +44,7 @@
 #include "ojph_params.h"
 #include "ojph_codestream_local.h"
 #include "ojph_codeblock.h"
+#include "ojph_codeblock_cache.h"
 #include "ojph_subband.h"
 #include "ojph_resolution.h"
 
@@ -107,6 +108,7 @@ namespace ojph {
       this->stripe_causal = coc->get_block_vertical_causality();
       this->zero_block = false;
       this->coded_cb = coded_cb;
+      this->cache = codestream->get_codeblock_cache();
 
       this->codeblock_functions.init(reversible);
     }
@@ -136,6 +138,24 @@ namespace ojph {
       }
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void codeblock::push(line_buf *line, const lifting_step* s,
+                         const line_buf *other, bool even, float K_inv)
+    {
+      // complete the last horizontal lifting step, then convert to sign
+      // and magnitude and keep max_val
+      assert(precision == BUF32);
+      assert(line->flags & line_buf::LFT_32BIT);
+      assert(other->flags & line_buf::LFT_32BIT);
+      const si32 *sp = line->i32 + line_offset;
+      const si32 *op = other->i32 + line_offset + (even ? 1 : 0);
+      ui32 *dp = buf32 + cur_line * stride;
+      this->codeblock_functions.tx_lift_to_cb32(s, sp, op, dp, K_max, K_inv,
+                                                delta_inv, cb_size.w,
+                                                max_val32);
+      ++cur_line;
+    }
+
     //////////////////////////////////////////////////////////////////////////
     void codeblock::encode(mem_elastic_allocator *elastic)
     {
@@ -148,10 +168,19 @@ namespace ojph {
           assert(coded_cb->missing_msbs > 0);
           assert(coded_cb->missing_msbs < K_max);
           coded_cb->num_passes = 1;
-          
+
+          cb_cache_entry* entry = NULL;
+          ui32 desc[cb_cache_entry::desc_size];
+          ui64 hash = 0;
+          if (cache && reuse_encoded(elastic, entry, desc, hash))
+            return;
+
           this->codeblock_functions.encode_cb32(buf32, K_max-1, 1,
             cb_size.w, cb_size.h, stride, coded_cb->pass_length,
             elastic, coded_cb->next_coded);
+
+          if (entry)
+            keep_encoded(entry, desc, hash);
         }
       }
       else
@@ -164,14 +193,74 @@ namespace ojph {
           assert(coded_cb->missing_msbs > 0);
           assert(coded_cb->missing_msbs < K_max);
           coded_cb->num_passes = 1;
-          
+
+          cb_cache_entry* entry = NULL;
+          ui32 desc[cb_cache_entry::desc_size];
+          ui64 hash = 0;
+          if (cache && reuse_encoded(elastic, entry, desc, hash))
+            return;
+
           this->codeblock_functions.encode_cb64(buf64, K_max-1, 1,
             cb_size.w, cb_size.h, stride, coded_cb->pass_length,
             elastic, coded_cb->next_coded);
+
+          if (entry)
+            keep_encoded(entry, desc, hash);
         }
       }
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    bool codeblock::reuse_encoded(mem_elastic_allocator *elastic,
+                                  cb_cache_entry*& entry, ui32* desc, 
+                                  ui64& hash)
+    {
+      // the coded data of a codeblock depend only on its samples, its 
+      // size, and K_max; encoding entries are distinguished from decoding
+      // ones by the encoder flag added to precision
+      desc[0] = cb_size.w; desc[1] = cb_size.h; 
+      desc[2] = precision | 0x100; desc[3] = K_max;
+      for (int i = 4; i < cb_cache_entry::desc_size; ++i)
+        desc[i] = 0;
+
+      size_t row_bytes = (size_t)cb_size.w * precision;
+      size_t stride_bytes = (size_t)stride * precision;
+      hash = codeblock_cache::hash_rows(buf32, row_bytes, cb_size.h, 
+                                        stride_bytes);
+      cb_cache_key key;
+      parent->get_cache_key(coded_cb, key);
+      bool hit;
+      entry = cache->lookup(key, desc, hash, buf32, row_bytes, cb_size.h,
+                            stride_bytes, hit);
+      if (!hit)
+        return false;
+
+      // the output is pass lengths, followed by the coded data
+      const ui32* sp = (const ui32*)codeblock_cache::get_output(entry);
+      coded_cb->pass_length[0] = sp[0];
+      coded_cb->pass_length[1] = sp[1];
+      ui32 num_bytes = sp[0] + sp[1];
+      elastic->get_buffer(num_bytes, coded_cb->next_coded);
+      memcpy(coded_cb->next_coded->buf, sp + 2, num_bytes);
+      coded_cb->next_coded->avail_size -= num_bytes;
+      return true;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void codeblock::keep_encoded(cb_cache_entry* entry, const ui32* desc,
+                                 ui64 hash)
+    {
+      assert(coded_cb->next_coded && coded_cb->next_coded->next_list == NULL);
+      ui32 num_bytes = coded_cb->pass_length[0] + coded_cb->pass_length[1];
+      size_t row_bytes = (size_t)cb_size.w * precision;
+      size_t stride_bytes = (size_t)stride * precision;
+      ui32* dp = (ui32*)cache->store(entry, desc, hash, buf32, row_bytes, 
+        cb_size.h, stride_bytes, 2 * sizeof(ui32) + num_bytes);
+      dp[0] = coded_cb->pass_length[0];
+      dp[1] = coded_cb->pass_length[1];
+      memcpy(dp + 2, coded_cb->next_coded->buf, num_bytes);
+    }
+
     //////////////////////////////////////////////////////////////////////////
     void codeblock::recreate(const size &cb_size, coded_cb_header* coded_cb)
     {
@@ -190,6 +279,42 @@ namespace ojph {
       if (coded_cb->pass_length[0] > 0 && coded_cb->num_passes > 0 &&
           coded_cb->next_coded != NULL)
       {
+        // a codeblock whose coded data, and decoding parameters, are 
+        // identical to those of the same codeblock in an earlier frame 
+        // is not decoded; its earlier decoded samples are used
+        const ui8* data = 
+          coded_cb->next_coded->buf + coded_cb_header::prefix_buf_size;
+        size_t num_bytes = 
+          (size_t)coded_cb->pass_length[0] + coded_cb->pass_length[1];
+        cb_cache_entry* entry = NULL;
+        ui32 desc[cb_cache_entry::desc_size] = { 
+          cb_size.w, cb_size.h, precision, stripe_causal ? 1u : 0u,
+          coded_cb->missing_msbs, coded_cb->num_passes,
+          coded_cb->pass_length[0], coded_cb->pass_length[1] };
+        ui64 hash = 0;
+        size_t row_bytes = (size_t)cb_size.w * precision;
+        if (cache)
+        {
+          cb_cache_key key;
+          parent->get_cache_key(coded_cb, key);
+          hash = codeblock_cache::hash_rows(data, num_bytes, 1, num_bytes);
+          bool hit;
+          entry = cache->lookup(key, desc, hash, data, num_bytes, 1, 
+                                num_bytes, hit);
+          if (hit)
+          {
+            const ui8* sp = (const ui8*)codeblock_cache::get_output(entry);
+            ui8* dp = (ui8*)buf32;
+            size_t stride_bytes = (size_t)stride * precision;
+            for (ui32 y = 0; y < cb_size.h; ++y) {
+              memcpy(dp, sp, row_bytes);
+              sp += row_bytes;
+              dp += stride_bytes;
+            }
+            return;
+          }
+        }
+
         bool result;
         if (precision == BUF32)
         {
@@ -218,6 +343,18 @@ namespace ojph {
           else
             OJPH_ERROR(0x000300A1, "Error decoding a codeblock.");
         }
+        else if (entry)
+        {
+          ui8* dp = (ui8*)cache->store(entry, desc, hash, data, num_bytes,
+                                       1, num_bytes, row_bytes * cb_size.h);
+          const ui8* sp = (const ui8*)buf32;
+          size_t stride_bytes = (size_t)stride * precision;
+          for (ui32 y = 0; y < cb_size.h; ++y) {
+            memcpy(dp, sp, row_bytes);
+            sp += stride_bytes;
+            dp += row_bytes;
+          }
+        }
       }
       else
         zero_block = true;
@@ -260,5 +397,27 @@ namespace ojph {
       assert(cur_line <= cb_size.h);
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void codeblock::pull_line(line_buf *line, const lifting_step* s,
+                              const line_buf *other, bool even, float K)
+    {
+      // convert from sign and magnitude, then perform the first horizontal
+      // lifting step; a zero block has its buffer row cleared so that it
+      // goes through the same path
+      assert(precision == BUF32);
+      assert(line->flags & line_buf::LFT_32BIT);
+      assert(other->flags & line_buf::LFT_32BIT);
+      si32 *dp = line->i32 + line_offset;
+      const si32 *op = other->i32 + line_offset + (even ? 0 : 1);
+      ui32 *sp = buf32 + cur_line * stride;
+      if (zero_block)
+        this->codeblock_functions.mem_clear(sp, cb_size.w * sizeof(ui32));
+      this->codeblock_functions.tx_lift_from_cb32(s, sp, dp, op, K_max, delta,
+                                                  K, cb_size.w);
+
+      ++cur_line;
+      assert(cur_line <= cb_size.h);
+    }
+
   }
 }
\ No newline at end of file
@@ -60,6 +60,8 @@ namespace ojph {
     struct precinct;
     class subband;
     struct coded_cb_header;
+    class codeblock_cache;
+    struct cb_cache_entry;
 
     //////////////////////////////////////////////////////////////////////////
     class codeblock
@@ -78,11 +80,20 @@ namespace ojph {
                           coded_cb_header* coded_cb, ui32 K_max, 
                           int tbx0, ui32 precision, ui32 comp_idx);
       void push(line_buf *line);
+      void push(line_buf *line, const lifting_step* s,
+                const line_buf *other, bool even, float K_inv);
       void encode(mem_elastic_allocator *elastic);
       void recreate(const size& cb_size, coded_cb_header* coded_cb);
 
       void decode();
       void pull_line(line_buf *line);
+      void pull_line(line_buf *line, const lifting_step* s,
+                     const line_buf *other, bool even, float K);
+
+    private:
+      bool reuse_encoded(mem_elastic_allocator *elastic, 
+                         cb_cache_entry*& entry, ui32* desc, ui64& hash);
+      void keep_encoded(cb_cache_entry* entry, const ui32* desc, ui64 hash);
 
     private:
       ui32 precision;
@@ -108,6 +119,7 @@ namespace ojph {
         ui64 max_val64[4]; // supports up to 256 bits
       };
       coded_cb_header* coded_cb;
+      codeblock_cache* cache; // when not NULL, blocks are cached
       codeblock_fun codeblock_functions;
     };
 
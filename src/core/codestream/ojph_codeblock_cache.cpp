@@ -0,0 +1,228 @@
+
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2019, Aous Naman 
+// Copyright (c) 2019, Kakadu Software Pty Ltd, Australia
+// Copyright (c) 2019, The University of New South Wales, Australia
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// 
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// This file is part of the OpenJPH software implementation.
+// File: ojph_codeblock_cache.cpp
+// Author: Aous Naman
+// Date: 19 October 2026
+//***************************************************************************/
+
+
+#include <cstdlib>
+#include <cstring>
+
+#include "ojph_message.h"
+#include "ojph_codeblock_cache.h"
+
+namespace ojph {
+
+  namespace local
+  {
+
+    //////////////////////////////////////////////////////////////////////////
+    static const ui64 hash_mul = 0x9E3779B97F4A7C15ULL;
+
+    //////////////////////////////////////////////////////////////////////////
+    static inline ui64 hash_mix(ui64 h, ui64 v)
+    {
+      h = (h ^ v) * hash_mul;
+      return h ^ (h >> 29);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    codeblock_cache::codeblock_cache()
+    {
+      entries = NULL;
+      capacity = num_used = 0;
+      hits = misses = 0;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    codeblock_cache::~codeblock_cache()
+    {
+      clear();
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void codeblock_cache::clear()
+    {
+      for (ui32 i = 0; i < capacity; ++i)
+        if (entries[i].store)
+          free(entries[i].store);
+      free(entries);
+      entries = NULL;
+      capacity = num_used = 0;
+      hits = misses = 0;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    ui64 codeblock_cache::hash_rows(const void* data, size_t row_bytes,
+                                    ui32 num_rows, size_t stride_bytes)
+    {
+      ui64 h = row_bytes * num_rows;
+      const ui8* row = (const ui8*)data;
+      for (ui32 y = 0; y < num_rows; ++y, row += stride_bytes)
+      {
+        const ui8* p = row;
+        size_t n = row_bytes;
+        for (; n >= 8; n -= 8, p += 8) {
+          ui64 v;
+          memcpy(&v, p, 8);
+          h = hash_mix(h, v);
+        }
+        if (n > 0) {
+          ui64 v = 0;
+          memcpy(&v, p, n);
+          h = hash_mix(h, v);
+        }
+      }
+      return h;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    ui64 codeblock_cache::hash_key(const cb_cache_key& key)
+    {
+      ui64 h = hash_mix(key.band_org, key.band_id);
+      return hash_mix(h, key.cb_idx);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    bool codeblock_cache::compare_rows(const ui8* stored, const void* data,
+                                       size_t row_bytes, ui32 num_rows,
+                                       size_t stride_bytes)
+    {
+      const ui8* row = (const ui8*)data;
+      for (ui32 y = 0; y < num_rows; ++y) {
+        if (memcmp(stored, row, row_bytes) != 0)
+          return false;
+        stored += row_bytes;
+        row += stride_bytes;
+      }
+      return true;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void codeblock_cache::grow()
+    {
+      ui32 new_capacity = capacity ? capacity * 2 : 1024;
+      cb_cache_entry* t = 
+        (cb_cache_entry*)calloc(new_capacity, sizeof(cb_cache_entry));
+      if (t == NULL)
+        OJPH_ERROR(0x000300F1, "cannot allocate memory for the codeblock "
+          "cache");
+
+      // move entries to their new slots
+      ui32 mask = new_capacity - 1;
+      for (ui32 i = 0; i < capacity; ++i)
+        if (entries[i].used)
+        {
+          ui32 s = (ui32)hash_key(entries[i].key) & mask;
+          while (t[s].used)
+            s = (s + 1) & mask;
+          t[s] = entries[i];
+        }
+      free(entries);
+      entries = t;
+      capacity = new_capacity;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    cb_cache_entry* codeblock_cache::lookup(const cb_cache_key& key,
+                                            const ui32* desc, ui64 hash,
+                                            const void* data, 
+                                            size_t row_bytes, ui32 num_rows,
+                                            size_t stride_bytes, bool& hit)
+    {
+      if (2 * (num_used + 1) > capacity)
+        grow();
+
+      // find the slot of key, or an empty slot for it
+      ui32 mask = capacity - 1;
+      ui32 s = (ui32)hash_key(key) & mask;
+      while (entries[s].used)
+      {
+        const cb_cache_key& k = entries[s].key;
+        if (k.band_org == key.band_org && k.band_id == key.band_id
+            && k.cb_idx == key.cb_idx)
+          break;
+        s = (s + 1) & mask;
+      }
+      cb_cache_entry* e = entries + s;
+      if (!e->used) {
+        e->used = true;
+        e->key = key;
+        ++num_used;
+      }
+
+      hit = e->valid && e->hash == hash 
+        && e->in_bytes == row_bytes * num_rows
+        && memcmp(e->desc, desc, sizeof(e->desc)) == 0
+        && compare_rows(e->store, data, row_bytes, num_rows, stride_bytes);
+      if (hit)
+        ++hits;
+      else {
+        e->valid = false;
+        ++misses;
+      }
+      return e;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void* codeblock_cache::store(cb_cache_entry* e, const ui32* desc, 
+                                 ui64 hash, const void* data, 
+                                 size_t row_bytes, ui32 num_rows,
+                                 size_t stride_bytes, size_t out_bytes)
+    {
+      size_t in_bytes = row_bytes * num_rows;
+      if (in_bytes + out_bytes > e->capacity)
+      {
+        ui8* t = (ui8*)realloc(e->store, in_bytes + out_bytes);
+        if (t == NULL)
+          OJPH_ERROR(0x000300F2, "cannot allocate memory for the codeblock "
+            "cache");
+        e->store = t;
+        e->capacity = in_bytes + out_bytes;
+      }
+
+      ui8* dp = e->store;
+      const ui8* sp = (const ui8*)data;
+      for (ui32 y = 0; y < num_rows; ++y, dp += row_bytes, sp += stride_bytes)
+        memcpy(dp, sp, row_bytes);
+      memcpy(e->desc, desc, sizeof(e->desc));
+      e->hash = hash;
+      e->in_bytes = in_bytes;
+      e->out_bytes = out_bytes;
+      e->valid = true;
+      return e->store + in_bytes;
+    }
+
+  }
+}
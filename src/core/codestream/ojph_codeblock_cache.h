@@ -0,0 +1,134 @@
+
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2019, Aous Naman 
+// Copyright (c) 2019, Kakadu Software Pty Ltd, Australia
+// Copyright (c) 2019, The University of New South Wales, Australia
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// 
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// 
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+// 
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// This file is part of the OpenJPH software implementation.
+// File: ojph_codeblock_cache.h
+// Author: Aous Naman
+// Date: 19 October 2026
+//***************************************************************************/
+
+
+#ifndef OJPH_CODEBLOCK_CACHE_H
+#define OJPH_CODEBLOCK_CACHE_H
+
+#include <cstddef>
+#include "ojph_defs.h"
+
+namespace ojph {
+
+  namespace local {
+
+    //////////////////////////////////////////////////////////////////////////
+    // identifies a codeblock across frames; a subband is identified by the
+    // origin of its rectangle, which differs between the tiles, together
+    // with its component, resolution, and band numbers
+    struct cb_cache_key
+    {
+      ui64 band_org;  // band_rect.org.x in the upper 32 bits, org.y below
+      ui32 band_id;   // comp_num << 8 | res_num << 2 | band_num
+      ui32 cb_idx;    // codeblock index within the subband, in raster order
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    // one cached codeblock; input bytes are followed by output bytes in
+    // store.  For decoding, the input is the coded data, and the output is
+    // decoded samples; for encoding, the input is the samples, and the 
+    // output is pass lengths followed by coded data.  desc holds the 
+    // parameters that, together with the input, determine the output
+    struct cb_cache_entry
+    {
+      static const int desc_size = 8;
+
+      cb_cache_key key;
+      bool used;              // the slot holds a codeblock
+      bool valid;             // output corresponds to input
+      ui64 hash;              // hash of the input
+      ui32 desc[desc_size];   // parameters
+      size_t in_bytes, out_bytes, capacity;
+      ui8* store;
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    // Keeps the last input and output of codeblocks, so that the work of
+    // a codeblock can be skipped when its input, in the same location, is
+    // identical to the input of an earlier frame.  Inputs are compared in 
+    // full, not only by their hash, so the output is always the one that 
+    // would have been produced.  This object is not thread-safe; it can be
+    // used by one codestream at a time.
+    class codeblock_cache
+    {
+    public:
+      codeblock_cache();
+      ~codeblock_cache();
+
+      void clear();
+      void get_stats(ui64& hits, ui64& misses) const
+      { hits = this->hits; misses = this->misses; }
+
+      // hashes num_rows rows of row_bytes each, stride_bytes apart
+      static ui64 hash_rows(const void* data, size_t row_bytes, 
+                            ui32 num_rows, size_t stride_bytes);
+
+      // finds the entry of key, creating it if needed; hit is set if the
+      // entry's output can be used, i.e., when desc and input match.  On
+      // a miss, the entry is invalidated until store() is called.  The 
+      // entry remains valid until the next call to lookup.
+      cb_cache_entry* lookup(const cb_cache_key& key, const ui32* desc,
+                             ui64 hash, const void* data, size_t row_bytes,
+                             ui32 num_rows, size_t stride_bytes, bool& hit);
+
+      // copies desc and the input into entry, and returns the location of
+      // out_bytes bytes, in which the caller writes the output
+      void* store(cb_cache_entry* entry, const ui32* desc, ui64 hash,
+                  const void* data, size_t row_bytes, ui32 num_rows,
+                  size_t stride_bytes, size_t out_bytes);
+
+      static const void* get_output(const cb_cache_entry* entry)
+      { return entry->store + entry->in_bytes; }
+
+    private:
+      void grow();
+      static ui64 hash_key(const cb_cache_key& key);
+      static bool compare_rows(const ui8* stored, const void* data, 
+                               size_t row_bytes, ui32 num_rows,
+                               size_t stride_bytes);
+
+    private:
+      cb_cache_entry* entries;
+      ui32 capacity;          // number of slots, a power of 2
+      ui32 num_used;          // number of used slots
+      ui64 hits, misses;
+    };
+
+  }
+}
+
+#endif // !OJPH_CODEBLOCK_CACHE_H
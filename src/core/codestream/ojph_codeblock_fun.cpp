@@ -100,6 +100,40 @@ namespace ojph {
     void wasm_rev_tx_to_cb64(const void *sp, ui64 *dp, ui32 K_max,
                              float delta_inv, ui32 count, ui64* max_val);
 
+    //////////////////////////////////////////////////////////////////////////
+    void  gen_rev_tx_lift_to_cb32(const lifting_step* s, const void *sp,
+                                  const void *op, ui32 *dp, ui32 K_max,
+                                  float K_inv, float delta_inv, ui32 count,
+                                  ui32* max_val);
+    void sse2_rev_tx_lift_to_cb32(const lifting_step* s, const void *sp,
+                                  const void *op, ui32 *dp, ui32 K_max,
+                                  float K_inv, float delta_inv, ui32 count,
+                                  ui32* max_val);
+    void avx2_rev_tx_lift_to_cb32(const lifting_step* s, const void *sp,
+                                  const void *op, ui32 *dp, ui32 K_max,
+                                  float K_inv, float delta_inv, ui32 count,
+                                  ui32* max_val);
+    void wasm_rev_tx_lift_to_cb32(const lifting_step* s, const void *sp,
+                                  const void *op, ui32 *dp, ui32 K_max,
+                                  float K_inv, float delta_inv, ui32 count,
+                                  ui32* max_val);
+    void  gen_irv_tx_lift_to_cb32(const lifting_step* s, const void *sp,
+                                  const void *op, ui32 *dp, ui32 K_max,
+                                  float K_inv, float delta_inv, ui32 count,
+                                  ui32* max_val);
+    void sse2_irv_tx_lift_to_cb32(const lifting_step* s, const void *sp,
+                                  const void *op, ui32 *dp, ui32 K_max,
+                                  float K_inv, float delta_inv, ui32 count,
+                                  ui32* max_val);
+    void avx2_irv_tx_lift_to_cb32(const lifting_step* s, const void *sp,
+                                  const void *op, ui32 *dp, ui32 K_max,
+                                  float K_inv, float delta_inv, ui32 count,
+                                  ui32* max_val);
+    void wasm_irv_tx_lift_to_cb32(const lifting_step* s, const void *sp,
+                                  const void *op, ui32 *dp, ui32 K_max,
+                                  float K_inv, float delta_inv, ui32 count,
+                                  ui32* max_val);
+
     //////////////////////////////////////////////////////////////////////////
     void  gen_rev_tx_from_cb32(const ui32 *sp, void *dp, ui32 K_max,
                                float delta, ui32 count);
@@ -118,6 +152,39 @@ namespace ojph {
     void wasm_irv_tx_from_cb32(const ui32 *sp, void *dp, ui32 K_max,
                                float delta, ui32 count);
 
+    void  gen_rev_tx_lift_from_cb32(const lifting_step* s,
+                                    const ui32 *sp, void *dp,
+                                    const void *op, ui32 K_max,
+                                    float delta, float K, ui32 count);
+    void sse2_rev_tx_lift_from_cb32(const lifting_step* s,
+                                    const ui32 *sp, void *dp,
+                                    const void *op, ui32 K_max,
+                                    float delta, float K, ui32 count);
+    void avx2_rev_tx_lift_from_cb32(const lifting_step* s,
+                                    const ui32 *sp, void *dp,
+                                    const void *op, ui32 K_max,
+                                    float delta, float K, ui32 count);
+    void wasm_rev_tx_lift_from_cb32(const lifting_step* s,
+                                    const ui32 *sp, void *dp,
+                                    const void *op, ui32 K_max,
+                                    float delta, float K, ui32 count);
+    void  gen_irv_tx_lift_from_cb32(const lifting_step* s,
+                                    const ui32 *sp, void *dp,
+                                    const void *op, ui32 K_max,
+                                    float delta, float K, ui32 count);
+    void sse2_irv_tx_lift_from_cb32(const lifting_step* s,
+                                    const ui32 *sp, void *dp,
+                                    const void *op, ui32 K_max,
+                                    float delta, float K, ui32 count);
+    void avx2_irv_tx_lift_from_cb32(const lifting_step* s,
+                                    const ui32 *sp, void *dp,
+                                    const void *op, ui32 K_max,
+                                    float delta, float K, ui32 count);
+    void wasm_irv_tx_lift_from_cb32(const lifting_step* s,
+                                    const ui32 *sp, void *dp,
+                                    const void *op, ui32 K_max,
+                                    float delta, float K, ui32 count);
+
     void  gen_rev_tx_from_cb64(const ui64 *sp, void *dp, ui32 K_max,
                                float delta, ui32 count);
     void sse2_rev_tx_from_cb64(const ui64 *sp, void *dp, ui32 K_max,
@@ -137,12 +204,16 @@ namespace ojph {
       mem_clear = gen_mem_clear;
       if (reversible) {
         tx_to_cb32 = gen_rev_tx_to_cb32;
+        tx_lift_to_cb32 = gen_rev_tx_lift_to_cb32;
         tx_from_cb32 = gen_rev_tx_from_cb32;
+        tx_lift_from_cb32 = gen_rev_tx_lift_from_cb32;
       }
       else
       {
         tx_to_cb32 = gen_irv_tx_to_cb32;
+        tx_lift_to_cb32 = gen_irv_tx_lift_to_cb32;
         tx_from_cb32 = gen_irv_tx_from_cb32;
+        tx_lift_from_cb32 = gen_irv_tx_lift_from_cb32;
       }
       encode_cb32 = ojph_encode_codeblock32;
 
@@ -176,11 +247,15 @@ namespace ojph {
           find_max_val32 = sse2_find_max_val32;
           if (reversible) {
             tx_to_cb32 = sse2_rev_tx_to_cb32;
+            tx_lift_to_cb32 = sse2_rev_tx_lift_to_cb32;
             tx_from_cb32 = sse2_rev_tx_from_cb32;
+            tx_lift_from_cb32 = sse2_rev_tx_lift_from_cb32;
           }
           else {
             tx_to_cb32 = sse2_irv_tx_to_cb32;
+            tx_lift_to_cb32 = sse2_irv_tx_lift_to_cb32;
             tx_from_cb32 = sse2_irv_tx_from_cb32;
+            tx_lift_from_cb32 = sse2_irv_tx_lift_from_cb32;
           }
           find_max_val64 = sse2_find_max_val64;
           if (reversible) {
@@ -211,11 +286,15 @@ namespace ojph {
           find_max_val32 = avx2_find_max_val32;
           if (reversible) {
             tx_to_cb32 = avx2_rev_tx_to_cb32;
+            tx_lift_to_cb32 = avx2_rev_tx_lift_to_cb32;
             tx_from_cb32 = avx2_rev_tx_from_cb32;
+            tx_lift_from_cb32 = avx2_rev_tx_lift_from_cb32;
           }
           else {
             tx_to_cb32 = avx2_irv_tx_to_cb32;
+            tx_lift_to_cb32 = avx2_irv_tx_lift_to_cb32;
             tx_from_cb32 = avx2_irv_tx_from_cb32;
+            tx_lift_from_cb32 = avx2_irv_tx_lift_from_cb32;
           }
           encode_cb32 = ojph_encode_codeblock_avx2;
           bool result = initialize_block_encoder_tables_avx2();
@@ -256,11 +335,15 @@ namespace ojph {
       mem_clear = wasm_mem_clear;
       if (reversible) {
         tx_to_cb32 = wasm_rev_tx_to_cb32;
+        tx_lift_to_cb32 = wasm_rev_tx_lift_to_cb32;
         tx_from_cb32 = wasm_rev_tx_from_cb32;
+        tx_lift_from_cb32 = wasm_rev_tx_lift_from_cb32;
       }
       else {
         tx_to_cb32 = wasm_irv_tx_to_cb32;
+        tx_lift_to_cb32 = wasm_irv_tx_lift_to_cb32;
         tx_from_cb32 = wasm_irv_tx_from_cb32;
+        tx_lift_from_cb32 = wasm_irv_tx_lift_from_cb32;
       }
       encode_cb32 = ojph_encode_codeblock32;
 
@@ -62,6 +62,16 @@ namespace ojph {
     typedef void (*tx_to_cb_fun64)(const void *sp, ui64 *dp, ui32 K_max,
                                    float delta_inv, ui32 count, ui64* max_val);
 
+    // define the signature of a function that completes the last
+    // horizontal lifting step on a line and transfers the result from
+    // subbands to codeblocks; sample i of sp is updated from op[i - 1] and
+    // op[i] of the other subband
+    typedef void (*tx_lift_to_cb_fun32)(const lifting_step* s,
+                                        const void *sp, const void *op,
+                                        ui32 *dp, ui32 K_max, float K_inv,
+                                        float delta_inv, ui32 count,
+                                        ui32* max_val);
+
     // define line transfer function signature from codeblock to subband
     typedef void (*tx_from_cb_fun32)(const ui32 *sp, void *dp, ui32 K_max,
                                      float delta, ui32 count);
@@ -69,6 +79,15 @@ namespace ojph {
     typedef void (*tx_from_cb_fun64)(const ui64 *sp, void *dp, ui32 K_max,
                                      float delta, ui32 count);
 
+    // define the signature of a function that transfers samples from
+    // codeblocks to subbands and performs the first horizontal synthesis
+    // lifting step; sample i of dp is updated from op[i - 1] and op[i] of
+    // the other subband, after dequantization and multiplication by K
+    typedef void (*tx_lift_from_cb_fun32)(const lifting_step* s,
+                                          const ui32 *sp, void *dp,
+                                          const void *op, ui32 K_max,
+                                          float delta, float K, ui32 count);
+
     // define the block decoder function signature
     typedef bool (*cb_decoder_fun32)(ui8* coded_data, ui32* decoded_data,
       ui32 missing_msbs, ui32 num_passes, ui32 lengths1, ui32 lengths2,
@@ -104,10 +123,18 @@ namespace ojph {
       // a pointer to function transferring samples from subbands to codeblocks
       tx_to_cb_fun32 tx_to_cb32;
       tx_to_cb_fun64 tx_to_cb64;
+
+      // a pointer to function completing the last horizontal lifting step
+      // while transferring samples from subbands to codeblocks
+      tx_lift_to_cb_fun32 tx_lift_to_cb32;
      
       // a pointer to function transferring samples from codeblocks to subbands
       tx_from_cb_fun32 tx_from_cb32;
       tx_from_cb_fun64 tx_from_cb64;
+
+      // a pointer to function transferring samples from codeblocks to
+      // subbands while performing the first horizontal lifting step
+      tx_lift_from_cb_fun32 tx_lift_from_cb32;
      
       // a pointer to the decoder function
       cb_decoder_fun32 decode_cb32;
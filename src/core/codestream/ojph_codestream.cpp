@@ -43,6 +43,7 @@
 #include "ojph_params.h"
 #include "ojph_codestream.h"
 #include "ojph_codestream_local.h"
+#include "ojph_codeblock_cache.h"
 
 namespace ojph {
 
@@ -160,6 +161,12 @@ namespace ojph {
     state->enable_resilience();
   }
 
+  ////////////////////////////////////////////////////////////////////////////
+  void codestream::set_codeblock_cache(codeblock_cache* cache)
+  {
+    state->set_codeblock_cache(cache ? cache->state : NULL);
+  }
+
   ////////////////////////////////////////////////////////////////////////////
   void codestream::read_headers(infile_base *file)
   {
@@ -186,6 +193,12 @@ namespace ojph {
     return state->pull(comp_num);
   }
 
+  ////////////////////////////////////////////////////////////////////////////
+  void codestream::pull_frame(void* dst, size_t stride, ui32 format)
+  {
+    state->pull_frame(dst, stride, format);
+  }
+
 
   ////////////////////////////////////////////////////////////////////////////
   void codestream::flush()
@@ -205,4 +218,42 @@ namespace ojph {
     return state->exchange(line, next_component);
   }
 
+  ////////////////////////////////////////////////////////////////////////////
+  void codestream::push_frame(const void* src, size_t stride, ui32 format)
+  {
+    state->push_frame(src, stride, format);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  //
+  //
+  //
+  //
+  ////////////////////////////////////////////////////////////////////////////
+
+  ////////////////////////////////////////////////////////////////////////////
+  codeblock_cache::codeblock_cache()
+  {
+    state = new local::codeblock_cache;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  codeblock_cache::~codeblock_cache()
+  {
+    if (state) delete state;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void codeblock_cache::clear()
+  {
+    state->clear();
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void codeblock_cache::get_stats(ui64& hits, ui64& misses) const
+  {
+    state->get_stats(hits, misses);
+  }
+
 }
@@ -42,6 +42,8 @@
 #include <immintrin.h>
 #include "ojph_defs.h"
 #include "ojph_arch.h"
+#include "ojph_params.h"
+#include "ojph_params_local.h"
 
 namespace ojph {
   namespace local {
@@ -163,6 +165,130 @@ namespace ojph {
       _mm256_storeu_si256((__m256i*)max_val, tmax);
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    static inline
+    __m256i avx2_rev_lift_term(const si32 *o, __m256i va, __m256i vb,
+                               __m256i neg, bool mul, ui8 e)
+    {
+      __m256i o1 = _mm256_loadu_si256((__m256i*)(o - 1));
+      __m256i o2 = _mm256_loadu_si256((__m256i*)o);
+      __m256i t = _mm256_add_epi32(o1, o2);
+      if (mul)
+        t = _mm256_mullo_epi32(va, t);
+      else // a is 1 or -1, negate using 1's complement + 1 when -1
+        t = _mm256_sub_epi32(_mm256_xor_si256(t, neg), neg);
+      return _mm256_srai_epi32(_mm256_add_epi32(vb, t), e);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_rev_tx_lift_to_cb32(const lifting_step* s, const void *sp,
+                                  const void *op, ui32 *dp, ui32 K_max,
+                                  float K_inv, float delta_inv, ui32 count,
+                                  ui32* max_val)
+    {
+      ojph_unused(K_inv);
+      ojph_unused(delta_inv);
+
+      // complete the lifting step, convert to sign and magnitude and keep
+      // max_val
+      const si32 a = s->rev.Aatk;
+      const bool mul = a != 1 && a != -1;
+      const ui8 e = s->rev.Eatk;
+      __m256i va = _mm256_set1_epi32(a);
+      __m256i vb = _mm256_set1_epi32(s->rev.Batk);
+      __m256i neg = _mm256_set1_epi32(a == -1 ? -1 : 0);
+      ui32 shift = 31 - K_max;
+      __m256i m0 = _mm256_set1_epi32(INT_MIN);
+      __m256i tmax = _mm256_loadu_si256((__m256i*)max_val);
+      const si32 *p = (const si32*)sp;
+      const si32 *o = (const si32*)op;
+      for ( ; count >= 8; count -= 8, p += 8, o += 8, dp += 8)
+      {
+        __m256i v = _mm256_loadu_si256((__m256i*)p);
+        v = _mm256_add_epi32(v, avx2_rev_lift_term(o, va, vb, neg, mul, e));
+        __m256i sign = _mm256_and_si256(v, m0);
+        __m256i val = _mm256_abs_epi32(v);
+        val = _mm256_slli_epi32(val, (int)shift);
+        tmax = _mm256_or_si256(tmax, val);
+        val = _mm256_or_si256(val, sign);
+        _mm256_storeu_si256((__m256i*)dp, val);
+      }
+      if (count)
+      {
+        __m256i v = _mm256_loadu_si256((__m256i*)p);
+        v = _mm256_add_epi32(v, avx2_rev_lift_term(o, va, vb, neg, mul, e));
+        __m256i sign = _mm256_and_si256(v, m0);
+        __m256i val = _mm256_abs_epi32(v);
+        val = _mm256_slli_epi32(val, (int)shift);
+
+        __m256i c = _mm256_set1_epi32((si32)count);
+        __m256i idx = _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+        __m256i mask = _mm256_cmpgt_epi32(c, idx);
+        c = _mm256_and_si256(val, mask);
+        tmax = _mm256_or_si256(tmax, c);
+
+        val = _mm256_or_si256(val, sign);
+        _mm256_storeu_si256((__m256i*)dp, val);
+      }
+      _mm256_storeu_si256((__m256i*)max_val, tmax);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_irv_tx_lift_to_cb32(const lifting_step* s, const void *sp,
+                                  const void *op, ui32 *dp, ui32 K_max,
+                                  float K_inv, float delta_inv, ui32 count,
+                                  ui32* max_val)
+    {
+      ojph_unused(K_max);
+
+      // complete the lifting step, quantize, convert to sign and magnitude
+      // and keep max_val
+      __m256 f = _mm256_set1_ps(s->irv.Aatk);
+      __m256 k = _mm256_set1_ps(K_inv);
+      __m256 d = _mm256_set1_ps(delta_inv);
+      __m256i m0 = _mm256_set1_epi32(INT_MIN);
+      __m256i tmax = _mm256_loadu_si256((__m256i*)max_val);
+      const float *p = (const float*)sp;
+      const float *o = (const float*)op;
+      for ( ; count >= 8; count -= 8, p += 8, o += 8, dp += 8)
+      {
+        __m256 m = _mm256_loadu_ps(o);
+        __m256 n = _mm256_loadu_ps(o - 1);
+        __m256 vf = _mm256_loadu_ps(p);
+        vf = _mm256_add_ps(vf, _mm256_mul_ps(f, _mm256_add_ps(m, n)));
+        vf = _mm256_mul_ps(vf, k);
+        vf = _mm256_mul_ps(vf, d);                // multiply
+        __m256i val = _mm256_cvtps_epi32(vf);     // convert to int
+        __m256i sign = _mm256_and_si256(val, m0); // get sign
+        val = _mm256_abs_epi32(val);
+        tmax = _mm256_or_si256(tmax, val);
+        val = _mm256_or_si256(val, sign);
+        _mm256_storeu_si256((__m256i*)dp, val);
+      }
+      if (count)
+      {
+        __m256 m = _mm256_loadu_ps(o);
+        __m256 n = _mm256_loadu_ps(o - 1);
+        __m256 vf = _mm256_loadu_ps(p);
+        vf = _mm256_add_ps(vf, _mm256_mul_ps(f, _mm256_add_ps(m, n)));
+        vf = _mm256_mul_ps(vf, k);
+        vf = _mm256_mul_ps(vf, d);                // multiply
+        __m256i val = _mm256_cvtps_epi32(vf);     // convert to int
+        __m256i sign = _mm256_and_si256(val, m0); // get sign
+        val = _mm256_abs_epi32(val);
+
+        __m256i c = _mm256_set1_epi32((si32)count);
+        __m256i idx = _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+        __m256i mask = _mm256_cmpgt_epi32(c, idx);
+        c = _mm256_and_si256(val, mask);
+        tmax = _mm256_or_si256(tmax, c);
+
+        val = _mm256_or_si256(val, sign);
+        _mm256_storeu_si256((__m256i*)dp, val);
+      }
+      _mm256_storeu_si256((__m256i*)max_val, tmax);
+    }
+
     //////////////////////////////////////////////////////////////////////////
     void avx2_rev_tx_from_cb32(const ui32 *sp, void *dp, ui32 K_max, 
                                float delta, ui32 count)
@@ -201,6 +327,64 @@ namespace ojph {
       }
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_rev_tx_lift_from_cb32(const lifting_step* s, const ui32 *sp,
+                                    void *dp, const void *op, ui32 K_max,
+                                    float delta, float K, ui32 count)
+    {
+      ojph_unused(delta);
+      ojph_unused(K);
+
+      // convert to sign and magnitude and perform the lifting step
+      const si32 a = s->rev.Aatk;
+      const bool mul = a != 1 && a != -1;
+      const ui8 e = s->rev.Eatk;
+      __m256i va = _mm256_set1_epi32(a);
+      __m256i vb = _mm256_set1_epi32(s->rev.Batk);
+      __m256i neg = _mm256_set1_epi32(a == -1 ? -1 : 0);
+      ui32 shift = 31 - K_max;
+      __m256i m1 = _mm256_set1_epi32(INT_MAX);
+      si32 *p = (si32*)dp;
+      const si32 *o = (const si32*)op;
+      for (ui32 i = 0; i < count; i += 8, sp += 8, p += 8, o += 8)
+      {
+        __m256i v = _mm256_load_si256((__m256i*)sp);
+        __m256i val = _mm256_and_si256(v, m1);
+        val = _mm256_srli_epi32(val, (int)shift);
+        val = _mm256_sign_epi32(val, v);
+        __m256i t = avx2_rev_lift_term(o, va, vb, neg, mul, e);
+        val = _mm256_sub_epi32(val, t);
+        _mm256_storeu_si256((__m256i*)p, val);
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_irv_tx_lift_from_cb32(const lifting_step* s, const ui32 *sp,
+                                    void *dp, const void *op, ui32 K_max,
+                                    float delta, float K, ui32 count)
+    {
+      ojph_unused(K_max);
+      __m256i m1 = _mm256_set1_epi32(INT_MAX);
+      __m256 d = _mm256_set1_ps(delta);
+      __m256 k = _mm256_set1_ps(K);
+      __m256 f = _mm256_set1_ps(s->irv.Aatk);
+      float *p = (float*)dp;
+      const float *o = (const float*)op;
+      for (ui32 i = 0; i < count; i += 8, sp += 8, p += 8, o += 8)
+      {
+        __m256i v = _mm256_load_si256((__m256i*)sp);
+        __m256i vali = _mm256_and_si256(v, m1);
+        __m256  valf = _mm256_cvtepi32_ps(vali);
+        valf = _mm256_mul_ps(valf, d);
+        __m256i sign = _mm256_andnot_si256(m1, v);
+        valf = _mm256_or_ps(valf, _mm256_castsi256_ps(sign));
+        valf = _mm256_mul_ps(valf, k);
+        __m256 t = _mm256_add_ps(_mm256_loadu_ps(o - 1), _mm256_loadu_ps(o));
+        valf = _mm256_sub_ps(valf, _mm256_mul_ps(f, t));
+        _mm256_storeu_ps(p, valf);
+      }
+    }
+
     //////////////////////////////////////////////////////////////////////////
     void avx2_rev_tx_to_cb64(const void *sp, ui64 *dp, ui32 K_max, 
                              float delta_inv, ui32 count, ui64* max_val)
@@ -37,6 +37,8 @@
 
 #include "ojph_defs.h"
 #include "ojph_arch.h"
+#include "ojph_params.h"
+#include "ojph_params_local.h"
 
 namespace ojph {
   namespace local {
@@ -120,6 +122,61 @@ namespace ojph {
       *max_val = tmax;
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void gen_rev_tx_lift_to_cb32(const lifting_step* s, const void *sp,
+                                 const void *op, ui32 *dp, ui32 K_max,
+                                 float K_inv, float delta_inv, ui32 count,
+                                 ui32* max_val)
+    {
+      ojph_unused(K_inv);
+      ojph_unused(delta_inv);
+      const si32 a = s->rev.Aatk;
+      const si32 b = s->rev.Batk;
+      const ui8 e = s->rev.Eatk;
+      ui32 shift = 31 - K_max;
+      // complete the lifting step, convert to sign and magnitude and keep
+      // max_val
+      ui32 tmax = *max_val;
+      const si32 *p = (const si32*)sp;
+      const si32 *o = (const si32*)op;
+      for (ui32 i = count; i > 0; --i, ++o)
+      {
+        si32 v = *p++ + ((b + a * (o[-1] + o[0])) >> e);
+        ui32 sign = v >= 0 ? 0U : 0x80000000U;
+        ui32 val = (ui32)(v >= 0 ? v : -v);
+        val <<= shift;
+        *dp++ = sign | val;
+        tmax |= val; // it is more efficient to use or than max
+      }
+      *max_val = tmax;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_irv_tx_lift_to_cb32(const lifting_step* s, const void *sp,
+                                 const void *op, ui32 *dp, ui32 K_max,
+                                 float K_inv, float delta_inv, ui32 count,
+                                 ui32* max_val)
+    {
+      ojph_unused(K_max);
+      const float a = s->irv.Aatk;
+      // complete the lifting step, quantize, convert to sign and magnitude
+      // and keep max_val
+      ui32 tmax = *max_val;
+      const float *p = (const float*)sp;
+      const float *o = (const float*)op;
+      for (ui32 i = count; i > 0; --i, ++o)
+      {
+        float v = *p++ + a * (o[-1] + o[0]);
+        v *= K_inv;
+        si32 t = ojph_trunc(v * delta_inv);
+        ui32 sign = t >= 0 ? 0U : 0x80000000U;
+        ui32 val = (ui32)(t >= 0 ? t : -t);
+        *dp++ = sign | val;
+        tmax |= val; // it is more efficient to use or than max
+      }
+      *max_val = tmax;
+    }
+
     //////////////////////////////////////////////////////////////////////////
     void gen_rev_tx_from_cb32(const ui32 *sp, void *dp, ui32 K_max,
                               float delta, ui32 count)
@@ -166,6 +223,49 @@ namespace ojph {
         *p++ = (v & 0x80000000U) ? -val : val;
       }
     }
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_rev_tx_lift_from_cb32(const lifting_step* s, const ui32 *sp,
+                                   void *dp, const void *op, ui32 K_max,
+                                   float delta, float K, ui32 count)
+    {
+      ojph_unused(delta);
+      ojph_unused(K);
+      const si32 a = s->rev.Aatk;
+      const si32 b = s->rev.Batk;
+      const ui8 e = s->rev.Eatk;
+      ui32 shift = 31 - K_max;
+      //convert to sign and magnitude and perform the lifting step
+      si32 *p = (si32*)dp;
+      const si32 *o = (const si32*)op;
+      for (ui32 i = count; i > 0; --i, ++o)
+      {
+        ui32 v = *sp++;
+        si32 val = (v & 0x7FFFFFFFU) >> shift;
+        val = (v & 0x80000000U) ? -val : val;
+        *p++ = val - ((b + a * (o[-1] + o[0])) >> e);
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_irv_tx_lift_from_cb32(const lifting_step* s, const ui32 *sp,
+                                   void *dp, const void *op, ui32 K_max,
+                                   float delta, float K, ui32 count)
+    {
+      ojph_unused(K_max);
+      const float a = s->irv.Aatk;
+      //dequantize, multiply by K, and perform the lifting step
+      float *p = (float*)dp;
+      const float *o = (const float*)op;
+      for (ui32 i = count; i > 0; --i, ++o)
+      {
+        ui32 v = *sp++;
+        float val = (float)(v & 0x7FFFFFFFU) * delta;
+        val = (v & 0x80000000U) ? -val : val;
+        val *= K;
+        *p++ = val - a * (o[-1] + o[0]);
+      }
+    }
     
  }
 }
\ No newline at end of file
@@ -41,6 +41,7 @@
 
 #include "ojph_mem.h"
 #include "ojph_params.h"
+#include "ojph_codestream.h"
 #include "ojph_codestream_local.h"
 #include "ojph_tile.h"
 
@@ -70,12 +71,14 @@ namespace ojph {
       profile = OJPH_PN_UNDEFINED;
       tilepart_div = OJPH_TILEPART_NO_DIVISIONS;
       need_tlm = false;
+      num_tileparts = 0;
 
       cur_comp = 0;
       cur_line = 0;
       cur_tile_row = 0;
       resilient = false;
       skipped_res_for_read = skipped_res_for_recon = 0;
+      cb_cache = NULL;
 
       precinct_scratch_needed_bytes = 0;
 
@@ -209,7 +212,7 @@ namespace ojph {
       //get tiles
       tiles = this->allocator->post_alloc_obj<tile>((size_t)num_tiles.area());
 
-      ui32 num_tileparts = 0;
+      num_tileparts = 0;
       point index;
       rect tile_rect;
       ojph::param_siz sz = access_siz();
@@ -1105,19 +1108,80 @@ namespace ojph {
     void codestream::flush()
     {
       si32 repeat = (si32)num_tiles.area();
-      for (si32 i = 0; i < repeat; ++i)
+      size_t total = 2; // EOC
+      for (si32 i = 0; i < repeat; ++i) {
         tiles[i].prepare_for_flush();
+        total += tiles[i].get_num_bytes();
+      }
+      total += 14 * (size_t)num_tileparts; // SOT and SOD markers
+      if (need_tlm)
+        total += 6 + 6 * (size_t)num_tileparts; // Stlm is 0x60
+      outfile->reserve(total);
+      gather.open(outfile);
       if (need_tlm)
       { //write tlm
         for (si32 i = 0; i < repeat; ++i)
           tiles[i].fill_tlm(&tlm);
-        tlm.write(outfile);
+        tlm.write(&gather);
       }
       for (si32 i = 0; i < repeat; ++i)
-        tiles[i].flush(outfile);
+        tiles[i].flush(&gather);
       ui16 t = swap_byte(JP2K_MARKER::EOC);
-      if (!outfile->write(&t, 2))
+      gather.write(&t, 2);
+      gather.flush();
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    //
+    //
+    //
+    //
+    //
+    //////////////////////////////////////////////////////////////////////////
+
+    //////////////////////////////////////////////////////////////////////////
+    size_t gather_outfile::write(const void *ptr, size_t size)
+    {
+      if (size > max_copy)
+        add(ptr, size);
+      else if (size > 0)
+      {
+        // add() must not flush, since that would reuse store
+        if (copied + size > copy_size || num_vecs == max_vecs)
+          flush();
+        ui8 *dp = store + copied;
+        memcpy(dp, ptr, size);
+        copied += size;
+        io_vec *last = num_vecs > 0 ? vecs + num_vecs - 1 : NULL;
+        if (last && (const ui8*)last->ptr + last->size == dp)
+        { // merge with the previous copy
+          last->size += size;
+          pending += size;
+        }
+        else
+          add(dp, size);
+      }
+      return size;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void gather_outfile::add(const void *ptr, size_t size)
+    {
+      if (num_vecs == max_vecs)
+        flush();
+      vecs[num_vecs].ptr = ptr;
+      vecs[num_vecs].size = size;
+      ++num_vecs;
+      pending += size;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void gather_outfile::flush()
+    {
+      if (num_vecs > 0 && file->write_vec(vecs, num_vecs) != pending)
         OJPH_ERROR(0x00030071, "Error writing to file");
+      num_vecs = 0;
+      copied = pending = 0;
     }
 
     //////////////////////////////////////////////////////////////////////////
@@ -1180,6 +1244,124 @@ namespace ojph {
       return this->lines + cur_comp;
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void codestream::push_frame(const void* src, size_t stride, ui32 format)
+    {
+      typedef ojph::codestream cs;
+      ui32 type = format & cs::PF_TYPE_MASK;
+      bool planar_in = (format & cs::PF_PLANAR) != 0;
+      ui32 bytes = type == cs::PF_UINT8 ? 1 : type == cs::PF_UINT16 ? 2 
+                 : type == cs::PF_FLOAT16 ? 2 : type == cs::PF_FLOAT32 ? 4 
+                 : 0;
+      if (bytes == 0 || (format & ~(cs::PF_TYPE_MASK | cs::PF_PLANAR)))
+        OJPH_ERROR(0x000300E5, "unsupported pixel format 0x%x", format);
+
+      bool is_float = type == cs::PF_FLOAT16 || type == cs::PF_FLOAT32;
+      ui32 max_width = 0;
+      bool same_dims = true;
+      for (ui32 c = 0; c < num_comps; ++c)
+      {
+        max_width = ojph_max(max_width, comp_size[c].w);
+        ui32 limit = is_float ? 24 : 8 * bytes;
+        if (siz.get_bit_depth(c) > limit)
+          OJPH_ERROR(0x000300E6, "component %d has a bit depth of %d, "
+            "which is not supported with pixel format 0x%x", c,
+            siz.get_bit_depth(c), format);
+        same_dims = same_dims && comp_size[c].w == comp_size[0].w
+                              && comp_size[c].h == comp_size[0].h;
+        bool same = same_dims && siz.get_bit_depth(c) == siz.get_bit_depth(0)
+                              && siz.is_signed(c) == siz.is_signed(0);
+        if (!same && !planar_in)
+          OJPH_ERROR(0x000300E7, "interleaved input requires components "
+            "of the same dimensions, bit depth, and signedness");
+      }
+      if (stride < (size_t)max_width * (planar_in ? 1 : num_comps) * bytes)
+        OJPH_ERROR(0x000300E8, "the stride of %zu bytes is too small for "
+          "the input rows", stride);
+
+      // components are pushed in groups, one group after the other, and
+      // the components of a group row by row; the colour transform needs
+      // components 0 to 2 of a row together, whatever the other 
+      // components are
+      const ui8* planes = (const ui8*)src; // start of plane of component c
+      for (ui32 first = 0; first < num_comps; )
+      {
+        ui32 end = first + frame_group_size(first, planar_in);
+        ui32 height = comp_size[first].h;
+        ui32 tile_row = 0;
+        for (ui32 y = 0; y < height; ++y)
+        {
+          const ui8* sp = planes + y * stride;
+          if (planar_in)
+            for (ui32 c = first; c < end; ++c, sp += height * stride)
+              push_frame_line(sp, 1, lines + c, type);
+          else
+            push_frame_line(sp, num_comps, lines, type);
+          for (ui32 c = first; c < end; ++c)
+            push_frame_row(c, tile_row);
+        }
+        planes += (end - first) * height * stride;
+        first = end;
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    ui32 codestream::frame_group_size(ui32 first, bool planar_io) const
+    {
+      if (!planar_io)
+        return num_comps; // all components have the same dimensions
+      if (first == 0 && employ_color_transform)
+        return 3;
+      return 1;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void codestream::push_frame_row(ui32 comp_num, ui32& tile_row)
+    {
+      bool success = false;
+      while (!success)
+      {
+        success = true;
+        for (ui32 i = 0; i < num_tiles.w; ++i)
+        {
+          ui32 idx = i + tile_row * num_tiles.w;
+          if ((success &= tiles[idx].push(lines + comp_num, comp_num)) 
+              == false)
+            break;
+        }
+        tile_row += success == false ? 1 : 0;
+        assert(tile_row < num_tiles.h);
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void codestream::push_frame_line(const void* sp, ui32 repeat,
+                                     line_buf* dst, ui32 type)
+    {
+      typedef ojph::codestream cs;
+      ui32 c = (ui32)(dst - lines);
+      ui32 bit_depth = siz.get_bit_depth(c);
+      si32 offset = siz.is_signed(c) ? (si32)(1u << (bit_depth - 1)) : 0;
+      si32 max_val = (si32)((1u << bit_depth) - 1);
+      ui32 width = comp_size[c].w;
+      if (type == cs::PF_UINT8)
+        deinterleave_from_ui8((const ui8*)sp, repeat, dst, offset, max_val,
+          width);
+      else if (type == cs::PF_UINT16)
+        deinterleave_from_ui16((const ui16*)sp, repeat, dst, offset,
+          max_val, width);
+      else
+      {
+        float mul = (float)(1u << bit_depth);
+        if (type == cs::PF_FLOAT32)
+          deinterleave_from_float((const float*)sp, repeat, dst, mul,
+            -offset, max_val - offset, width);
+        else
+          deinterleave_from_half((const ui16*)sp, repeat, dst, mul,
+            -offset, max_val - offset, width);
+      }
+    }
+
     //////////////////////////////////////////////////////////////////////////
     line_buf* codestream::pull(ui32 &comp_num)
     {
@@ -1190,7 +1372,7 @@ namespace ojph {
         for (ui32 i = 0; i < num_tiles.w; ++i)
         {
           ui32 idx = i + cur_tile_row * num_tiles.w;
-          if ((success &= tiles[idx].pull(lines + cur_comp, cur_comp)) == false)
+          if ((success &= tiles[idx].pull(lines, cur_comp)) == false)
             break;
         }
         cur_tile_row += success == false ? 1 : 0;
@@ -1228,5 +1410,103 @@ namespace ojph {
       return lines + comp_num;
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void codestream::pull_frame(void* dst, size_t stride, ui32 format)
+    {
+      typedef ojph::codestream cs;
+      ui32 type = format & cs::PF_TYPE_MASK;
+      bool planar_out = (format & cs::PF_PLANAR) != 0;
+      ui32 bytes = type == cs::PF_UINT8 ? 1 : type == cs::PF_UINT16 ? 2 
+                 : type == cs::PF_FLOAT32 ? 4 : 0;
+      if (bytes == 0 || (format & ~(cs::PF_TYPE_MASK | cs::PF_PLANAR)))
+        OJPH_ERROR(0x000300E1, "unsupported pixel format 0x%x", format);
+
+      ui32 max_width = 0;
+      bool same_dims = true;
+      for (ui32 c = 0; c < num_comps; ++c)
+      {
+        max_width = ojph_max(max_width, recon_comp_size[c].w);
+        if (type != cs::PF_FLOAT32 && siz.get_bit_depth(c) > 8 * bytes)
+          OJPH_ERROR(0x000300E2, "component %d has a bit depth of %d, "
+            "which does not fit in %d-bit samples", c,
+            siz.get_bit_depth(c), 8 * bytes);
+        same_dims = same_dims && recon_comp_size[c].w == recon_comp_size[0].w
+                              && recon_comp_size[c].h == recon_comp_size[0].h;
+        bool same = same_dims && siz.get_bit_depth(c) == siz.get_bit_depth(0)
+                              && siz.is_signed(c) == siz.is_signed(0);
+        if (!same && !planar_out)
+          OJPH_ERROR(0x000300E3, "interleaved output requires components "
+            "of the same dimensions, bit depth, and signedness");
+      }
+      if (stride < (size_t)max_width * (planar_out ? 1 : num_comps) * bytes)
+        OJPH_ERROR(0x000300E4, "the stride of %zu bytes is too small for "
+          "the output rows", stride);
+
+      // rows are written where they belong, so the order of pulling is 
+      // free, except that the colour transform produces components 0 to 2
+      // of a row together; components are pulled in groups, one group
+      // after the other, and the components of a group row by row
+      ui8* planes = (ui8*)dst;     // start of the plane of component c
+      for (ui32 first = 0; first < num_comps; )
+      {
+        ui32 end = first + frame_group_size(first, planar_out);
+        ui32 height = recon_comp_size[first].h;
+        ui32 tile_row = 0;
+        for (ui32 y = 0; y < height; ++y)
+        {
+          for (ui32 c = first; c < end; ++c)
+            pull_frame_row(c, tile_row);
+          ui8* dp = planes + y * stride;
+          if (planar_out)
+            for (ui32 c = first; c < end; ++c, dp += height * stride)
+              pull_frame_line(lines + c, 1, dp, type);
+          else
+            pull_frame_line(lines, num_comps, dp, type);
+        }
+        planes += (end - first) * height * stride;
+        first = end;
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void codestream::pull_frame_row(ui32 comp_num, ui32& tile_row)
+    {
+      bool success = false;
+      while (!success)
+      {
+        success = true;
+        for (ui32 i = 0; i < num_tiles.w; ++i)
+        {
+          ui32 idx = i + tile_row * num_tiles.w;
+          if ((success &= tiles[idx].pull(lines, comp_num)) == false)
+            break;
+        }
+        tile_row += success == false ? 1 : 0;
+        assert(tile_row < num_tiles.h);
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void codestream::pull_frame_line(const line_buf* src, ui32 repeat,
+                                     void* dp, ui32 type)
+    {
+      ui32 c = (ui32)(src - lines);
+      ui32 bit_depth = siz.get_bit_depth(c);
+      si32 offset = siz.is_signed(c) ? (si32)(1u << (bit_depth - 1)) : 0;
+      if (type == ojph::codestream::PF_FLOAT32)
+        interleave_to_float(src, repeat, (float*)dp,
+          1.0f / (float)(1ull << bit_depth), recon_comp_size[c].w);
+      else
+      {
+        si32 max_val = (si32)((1u << bit_depth) - 1);
+        if (type == ojph::codestream::PF_UINT8)
+          interleave_to_ui8(src, repeat, (ui8*)dp, offset, max_val,
+            recon_comp_size[c].w);
+        else
+          interleave_to_ui16(src, repeat, (ui16*)dp, offset, max_val,
+            recon_comp_size[c].w);
+      }
+    }
+
   }
 }
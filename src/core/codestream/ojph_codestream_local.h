@@ -40,6 +40,7 @@
 #define OJPH_CODESTREAM_LOCAL_H
 
 #include "ojph_defs.h"
+#include "ojph_file.h"
 #include "ojph_params_local.h"
 
 namespace ojph {
@@ -63,6 +64,40 @@ namespace ojph {
     //////////////////////////////////////////////////////////////////////////
     //defined elsewhere
     class tile;
+    class codeblock_cache;
+
+    //////////////////////////////////////////////////////////////////////////
+    // Collects the writes of codestream::flush(), and passes them to a file
+    // as gather writes of up to max_vecs pieces, rather than one write per
+    // packet header or codeblock.  Writes of up to max_copy bytes, such as
+    // marker segments and empty packets, are copied, and consecutive ones
+    // are merged.  Larger writes are referenced; they hold coded data, 
+    // which stay valid until flush() is called.
+    class gather_outfile : public outfile_base
+    {
+    public:
+      gather_outfile() { file = NULL; num_vecs = 0; copied = pending = 0; }
+
+      void open(outfile_base *file) 
+      { this->file = file; num_vecs = 0; copied = pending = 0; }
+      size_t write(const void *ptr, size_t size) override;
+      si64 tell() override { return file->tell() + (si64)pending; }
+      void flush() override;
+
+    private:
+      void add(const void *ptr, size_t size);
+
+    private:
+      static const ui32 max_vecs = 1024;
+      static const size_t max_copy = 64;
+      static const size_t copy_size = 4096;
+      outfile_base *file;
+      io_vec vecs[max_vecs];
+      ui8 store[copy_size];  // copies of small writes
+      ui32 num_vecs;
+      size_t copied;         // bytes used in store
+      size_t pending;        // bytes not yet passed to file
+    };
 
     //////////////////////////////////////////////////////////////////////////
     class codestream
@@ -97,10 +132,13 @@ namespace ojph {
       outfile_base* get_file() { return outfile; }
 
       line_buf* exchange(line_buf* line, ui32& next_component);
+      void push_frame(const void* src, size_t stride, ui32 format);
       void write_headers(outfile_base *file, const comment_exchange* comments,
                          ui32 num_comments);
       void enable_resilience();
       bool is_resilient() { return resilient; }
+      void set_codeblock_cache(codeblock_cache* cache) { cb_cache = cache; }
+      codeblock_cache* get_codeblock_cache() { return cb_cache; }
       void read_headers(infile_base *file);
       void restrict_input_resolution(ui32 skipped_res_for_data,
         ui32 skipped_res_for_recon);
@@ -110,6 +148,7 @@ namespace ojph {
       void set_tilepart_divisions(ui32 value);
       void request_tlm_marker(bool needed);
       line_buf* pull(ui32 &comp_num);
+      void pull_frame(void* dst, size_t stride, ui32 format);
       void flush();
       void close();
 
@@ -127,6 +166,25 @@ namespace ojph {
       ui32 get_skipped_res_for_read()
       { return skipped_res_for_read; }
 
+    private:
+      // converts, and deinterleaves when repeat > 1, one row of a 
+      // push_frame() input into the lines starting at dst
+      void push_frame_line(const void* sp, ui32 repeat, line_buf* dst,
+                           ui32 type);
+      // converts, and interleaves when repeat > 1, the lines starting at
+      // src into one row of a pull_frame() output
+      void pull_frame_line(const line_buf* src, ui32 repeat, void* dp,
+                           ui32 type);
+      // pushes one row of component comp_num to the tiles of tile_row,
+      // moving to the next tile row when these are full
+      void push_frame_row(ui32 comp_num, ui32& tile_row);
+      // pulls one row of component comp_num from the tiles of tile_row,
+      // moving to the next tile row when these are exhausted
+      void pull_frame_row(ui32 comp_num, ui32& tile_row);
+      // the number of components, starting from first, that push_frame()
+      // and pull_frame() process together, row by row
+      ui32 frame_group_size(ui32 first, bool planar_io) const;
+
     private:
       ui32 precinct_scratch_needed_bytes;
       ui8* precinct_scratch;
@@ -137,6 +195,7 @@ namespace ojph {
       ui32 cur_tile_row;
       bool resilient;
       ui32 skipped_res_for_read, skipped_res_for_recon;
+      codeblock_cache* cb_cache; // not owned; NULL when not used
 
     private:
       size num_tiles;
@@ -150,6 +209,7 @@ namespace ojph {
       int profile;
       ui32 tilepart_div;     // tilepart division value
       bool need_tlm;         // true if tlm markers are needed
+      ui32 num_tileparts;    // number of tile-parts in the codestream
       
     private:
       param_siz siz;         // image and tile size
@@ -169,6 +229,7 @@ namespace ojph {
       mem_elastic_allocator *elastic_alloc;
       outfile_base *outfile;
       infile_base *infile;
+      gather_outfile gather; // used by flush()
     };
 
   }
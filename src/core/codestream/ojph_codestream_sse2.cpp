@@ -41,6 +41,8 @@
 #include <climits>
 #include <immintrin.h>
 #include "ojph_defs.h"
+#include "ojph_params.h"
+#include "ojph_params_local.h"
 
 namespace ojph {
   namespace local {
@@ -175,6 +177,153 @@ namespace ojph {
       _mm_storeu_si128((__m128i*)max_val, tmax);
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void sse2_rev_tx_lift_to_cb32(const lifting_step* s, const void *sp,
+                                  const void *op, ui32 *dp, ui32 K_max,
+                                  float K_inv, float delta_inv, ui32 count,
+                                  ui32* max_val)
+    {
+      ojph_unused(K_inv);
+      ojph_unused(delta_inv);
+
+      const si32 a = s->rev.Aatk;
+      const si32 b = s->rev.Batk;
+      const ui8 e = s->rev.Eatk;
+      ui32 shift = 31 - K_max;
+      const si32 *p = (const si32*)sp;
+      const si32 *o = (const si32*)op;
+      if (a != 1 && a != -1)
+      { // general case, 32bit multiplication is not supported in sse2
+        ui32 tmax = *max_val;
+        for (ui32 i = count; i > 0; --i, ++o)
+        {
+          si32 v = *p++ + ((b + a * (o[-1] + o[0])) >> e);
+          ui32 sign = v >= 0 ? 0U : 0x80000000U;
+          ui32 val = (ui32)(v >= 0 ? v : -v);
+          val <<= shift;
+          *dp++ = sign | val;
+          tmax |= val;
+        }
+        *max_val = tmax;
+        return;
+      }
+
+      // complete the lifting step, convert to sign and magnitude and keep
+      // max_val; for a = -1, the sum is negated using 1's complement + 1
+      __m128i neg = _mm_set1_epi32(a == -1 ? -1 : 0);
+      __m128i vb = _mm_set1_epi32(b);
+      __m128i m0 = _mm_set1_epi32(INT_MIN);
+      __m128i zero = _mm_setzero_si128();
+      __m128i one = _mm_set1_epi32(1);
+      __m128i tmax = _mm_loadu_si128((__m128i*)max_val);
+      for ( ; count >= 4; count -= 4, p += 4, o += 4, dp += 4)
+      {
+        __m128i o1 = _mm_loadu_si128((__m128i*)(o - 1));
+        __m128i o2 = _mm_loadu_si128((__m128i*)o);
+        __m128i t = _mm_add_epi32(o1, o2);
+        t = _mm_sub_epi32(_mm_xor_si128(t, neg), neg);
+        t = _mm_srai_epi32(_mm_add_epi32(vb, t), e);
+        __m128i v = _mm_add_epi32(_mm_loadu_si128((__m128i*)p), t);
+        __m128i sign = _mm_cmplt_epi32(v, zero);
+        __m128i val = _mm_xor_si128(v, sign); // negate 1's complement
+        __m128i ones = _mm_and_si128(sign, one);
+        val = _mm_add_epi32(val, ones);        // 2's complement
+        sign = _mm_and_si128(sign, m0);
+        val = _mm_slli_epi32(val, (int)shift);
+        tmax = _mm_or_si128(tmax, val);
+        val = _mm_or_si128(val, sign);
+        _mm_storeu_si128((__m128i*)dp, val);
+      }
+      if (count)
+      {
+        __m128i o1 = _mm_loadu_si128((__m128i*)(o - 1));
+        __m128i o2 = _mm_loadu_si128((__m128i*)o);
+        __m128i t = _mm_add_epi32(o1, o2);
+        t = _mm_sub_epi32(_mm_xor_si128(t, neg), neg);
+        t = _mm_srai_epi32(_mm_add_epi32(vb, t), e);
+        __m128i v = _mm_add_epi32(_mm_loadu_si128((__m128i*)p), t);
+        __m128i sign = _mm_cmplt_epi32(v, zero);
+        __m128i val = _mm_xor_si128(v, sign); // negate 1's complement
+        __m128i ones = _mm_and_si128(sign, one);
+        val = _mm_add_epi32(val, ones);        // 2's complement
+        sign = _mm_and_si128(sign, m0);
+        val = _mm_slli_epi32(val, (int)shift);
+
+        __m128i c = _mm_set1_epi32((si32)count);
+        __m128i idx = _mm_set_epi32(3, 2, 1, 0);
+        __m128i mask = _mm_cmpgt_epi32(c, idx);
+        c = _mm_and_si128(val, mask);
+        tmax = _mm_or_si128(tmax, c);
+
+        val = _mm_or_si128(val, sign);
+        _mm_storeu_si128((__m128i*)dp, val);
+      }
+      _mm_storeu_si128((__m128i*)max_val, tmax);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void sse2_irv_tx_lift_to_cb32(const lifting_step* s, const void *sp,
+                                  const void *op, ui32 *dp, ui32 K_max,
+                                  float K_inv, float delta_inv, ui32 count,
+                                  ui32* max_val)
+    {
+      ojph_unused(K_max);
+
+      // complete the lifting step, quantize, convert to sign and magnitude
+      // and keep max_val
+      __m128 f = _mm_set1_ps(s->irv.Aatk);
+      __m128 k = _mm_set1_ps(K_inv);
+      __m128 d = _mm_set1_ps(delta_inv);
+      __m128i zero = _mm_setzero_si128();
+      __m128i one = _mm_set1_epi32(1);
+      __m128i tmax = _mm_loadu_si128((__m128i*)max_val);
+      const float *p = (const float*)sp;
+      const float *o = (const float*)op;
+      for ( ; count >= 4; count -= 4, p += 4, o += 4, dp += 4)
+      {
+        __m128 m = _mm_loadu_ps(o);
+        __m128 n = _mm_loadu_ps(o - 1);
+        __m128 vf = _mm_loadu_ps(p);
+        vf = _mm_add_ps(vf, _mm_mul_ps(f, _mm_add_ps(m, n)));
+        vf = _mm_mul_ps(vf, k);
+        vf = _mm_mul_ps(vf, d);                    // multiply
+        __m128i val = _mm_cvtps_epi32(vf);         // convert to int
+        __m128i sign = _mm_cmplt_epi32(val, zero); // get sign
+        val = _mm_xor_si128(val, sign);            // negate 1's complement
+        __m128i ones = _mm_and_si128(sign, one);
+        val = _mm_add_epi32(val, ones);            // 2's complement
+        tmax = _mm_or_si128(tmax, val);
+        sign = _mm_slli_epi32(sign, 31);
+        val = _mm_or_si128(val, sign);
+        _mm_storeu_si128((__m128i*)dp, val);
+      }
+      if (count)
+      {
+        __m128 m = _mm_loadu_ps(o);
+        __m128 n = _mm_loadu_ps(o - 1);
+        __m128 vf = _mm_loadu_ps(p);
+        vf = _mm_add_ps(vf, _mm_mul_ps(f, _mm_add_ps(m, n)));
+        vf = _mm_mul_ps(vf, k);
+        vf = _mm_mul_ps(vf, d);                    // multiply
+        __m128i val = _mm_cvtps_epi32(vf);         // convert to int
+        __m128i sign = _mm_cmplt_epi32(val, zero); // get sign
+        val = _mm_xor_si128(val, sign);            // negate 1's complement
+        __m128i ones = _mm_and_si128(sign, one);
+        val = _mm_add_epi32(val, ones);            // 2's complement
+
+        __m128i c = _mm_set1_epi32((si32)count);
+        __m128i idx = _mm_set_epi32(3, 2, 1, 0);
+        __m128i mask = _mm_cmpgt_epi32(c, idx);
+        c = _mm_and_si128(val, mask);
+        tmax = _mm_or_si128(tmax, c);
+
+        sign = _mm_slli_epi32(sign, 31);
+        val = _mm_or_si128(val, sign);
+        _mm_storeu_si128((__m128i*)dp, val);
+      }
+      _mm_storeu_si128((__m128i*)max_val, tmax);
+    }
+
     //////////////////////////////////////////////////////////////////////////
     void sse2_rev_tx_from_cb32(const ui32 *sp, void *dp, ui32 K_max, 
                                float delta, ui32 count)
@@ -218,6 +367,85 @@ namespace ojph {
       }
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void sse2_rev_tx_lift_from_cb32(const lifting_step* s, const ui32 *sp,
+                                    void *dp, const void *op, ui32 K_max,
+                                    float delta, float K, ui32 count)
+    {
+      ojph_unused(delta);
+      ojph_unused(K);
+
+      const si32 a = s->rev.Aatk;
+      const si32 b = s->rev.Batk;
+      const ui8 e = s->rev.Eatk;
+      ui32 shift = 31 - K_max;
+      si32 *p = (si32*)dp;
+      const si32 *o = (const si32*)op;
+      if (a != 1 && a != -1)
+      { // general case, 32bit multiplication is not supported in sse2
+        for (ui32 i = count; i > 0; --i, ++o)
+        {
+          ui32 v = *sp++;
+          si32 val = (v & 0x7FFFFFFFU) >> shift;
+          val = (v & 0x80000000U) ? -val : val;
+          *p++ = val - ((b + a * (o[-1] + o[0])) >> e);
+        }
+        return;
+      }
+
+      // convert to sign and magnitude and perform the lifting step; for
+      // a = -1, the sum is negated using 1's complement + 1
+      __m128i neg = _mm_set1_epi32(a == -1 ? -1 : 0);
+      __m128i vb = _mm_set1_epi32(b);
+      __m128i m1 = _mm_set1_epi32(INT_MAX);
+      __m128i zero = _mm_setzero_si128();
+      __m128i one = _mm_set1_epi32(1);
+      for (ui32 i = 0; i < count; i += 4, sp += 4, p += 4, o += 4)
+      {
+        __m128i v = _mm_load_si128((__m128i*)sp);
+        __m128i val = _mm_and_si128(v, m1);
+        val = _mm_srli_epi32(val, (int)shift);
+        __m128i sign = _mm_cmplt_epi32(v, zero);
+        val = _mm_xor_si128(val, sign); // negate 1's complement
+        __m128i ones = _mm_and_si128(sign, one);
+        val = _mm_add_epi32(val, ones); // 2's complement
+        __m128i o1 = _mm_loadu_si128((__m128i*)(o - 1));
+        __m128i o2 = _mm_loadu_si128((__m128i*)o);
+        __m128i t = _mm_add_epi32(o1, o2);
+        t = _mm_sub_epi32(_mm_xor_si128(t, neg), neg);
+        t = _mm_srai_epi32(_mm_add_epi32(vb, t), e);
+        val = _mm_sub_epi32(val, t);
+        _mm_storeu_si128((__m128i*)p, val);
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void sse2_irv_tx_lift_from_cb32(const lifting_step* s, const ui32 *sp,
+                                    void *dp, const void *op, ui32 K_max,
+                                    float delta, float K, ui32 count)
+    {
+      ojph_unused(K_max);
+      __m128i m1 = _mm_set1_epi32(INT_MAX);
+      __m128 d = _mm_set1_ps(delta);
+      __m128 k = _mm_set1_ps(K);
+      __m128 f = _mm_set1_ps(s->irv.Aatk);
+      float *p = (float*)dp;
+      const float *o = (const float*)op;
+      for (ui32 i = 0; i < count; i += 4, sp += 4, p += 4, o += 4)
+      {
+        __m128i v = _mm_load_si128((__m128i*)sp);
+        __m128i vali = _mm_and_si128(v, m1);
+        __m128  valf = _mm_cvtepi32_ps(vali);
+        valf = _mm_mul_ps(valf, d);
+        __m128i sign = _mm_andnot_si128(m1, v);
+        valf = _mm_or_ps(valf, _mm_castsi128_ps(sign));
+        valf = _mm_mul_ps(valf, k);
+        __m128 t = _mm_add_ps(_mm_loadu_ps(o - 1), _mm_loadu_ps(o));
+        valf = _mm_sub_ps(valf, _mm_mul_ps(f, t));
+        _mm_storeu_ps(p, valf);
+      }
+    }
+
     //////////////////////////////////////////////////////////////////////////
     void sse2_rev_tx_to_cb64(const void *sp, ui64 *dp, ui32 K_max, 
                              float delta_inv, ui32 count, ui64* max_val)
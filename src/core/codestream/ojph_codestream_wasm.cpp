@@ -40,6 +40,8 @@
 #include <wasm_simd128.h>
 
 #include "ojph_defs.h"
+#include "ojph_params.h"
+#include "ojph_params_local.h"
 
 namespace ojph {
   namespace local {
@@ -173,6 +175,129 @@ namespace ojph {
       wasm_v128_store(max_val, tmax);
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void wasm_rev_tx_lift_to_cb32(const lifting_step* s, const void *sp,
+                                  const void *op, ui32 *dp, ui32 K_max,
+                                  float K_inv, float delta_inv, ui32 count,
+                                  ui32* max_val)
+    {
+      ojph_unused(K_inv);
+      ojph_unused(delta_inv);
+
+      // complete the lifting step, convert to sign and magnitude and keep
+      // max_val
+      const ui8 e = s->rev.Eatk;
+      v128_t va = wasm_i32x4_splat(s->rev.Aatk);
+      v128_t vb = wasm_i32x4_splat(s->rev.Batk);
+      ui32 shift = 31 - K_max;
+      v128_t m0 = wasm_i32x4_splat(INT_MIN);
+      v128_t zero = wasm_i32x4_splat(0);
+      v128_t one = wasm_i32x4_splat(1);
+      v128_t tmax = wasm_v128_load(max_val);
+      const si32 *p = (const si32*)sp;
+      const si32 *o = (const si32*)op;
+      for ( ; count >= 4; count -= 4, p += 4, o += 4, dp += 4)
+      {
+        v128_t t = wasm_i32x4_add(wasm_v128_load(o - 1), wasm_v128_load(o));
+        t = wasm_i32x4_add(vb, wasm_i32x4_mul(va, t));
+        v128_t v = wasm_i32x4_add(wasm_v128_load(p), wasm_i32x4_shr(t, e));
+        v128_t sign = wasm_i32x4_lt(v, zero);
+        v128_t val = wasm_v128_xor(v, sign); // negate 1's complement
+        v128_t ones = wasm_v128_and(sign, one);
+        val = wasm_i32x4_add(val, ones);     // 2's complement
+        sign = wasm_v128_and(sign, m0);
+        val = wasm_i32x4_shl(val, shift);
+        tmax = wasm_v128_or(tmax, val);
+        val = wasm_v128_or(val, sign);
+        wasm_v128_store(dp, val);
+      }
+      if (count)
+      {
+        v128_t t = wasm_i32x4_add(wasm_v128_load(o - 1), wasm_v128_load(o));
+        t = wasm_i32x4_add(vb, wasm_i32x4_mul(va, t));
+        v128_t v = wasm_i32x4_add(wasm_v128_load(p), wasm_i32x4_shr(t, e));
+        v128_t sign = wasm_i32x4_lt(v, zero);
+        v128_t val = wasm_v128_xor(v, sign); // negate 1's complement
+        v128_t ones = wasm_v128_and(sign, one);
+        val = wasm_i32x4_add(val, ones);     // 2's complement
+        sign = wasm_v128_and(sign, m0);
+        val = wasm_i32x4_shl(val, shift);
+
+        v128_t c = wasm_i32x4_splat((si32)count);
+        v128_t idx = wasm_i32x4_make(0, 1, 2, 3);
+        v128_t mask = wasm_i32x4_gt(c, idx);
+        c = wasm_v128_and(val, mask);
+        tmax = wasm_v128_or(tmax, c);
+
+        val = wasm_v128_or(val, sign);
+        wasm_v128_store(dp, val);
+      }
+      wasm_v128_store(max_val, tmax);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void wasm_irv_tx_lift_to_cb32(const lifting_step* s, const void *sp,
+                                  const void *op, ui32 *dp, ui32 K_max,
+                                  float K_inv, float delta_inv, ui32 count,
+                                  ui32* max_val)
+    {
+      ojph_unused(K_max);
+
+      // complete the lifting step, quantize, convert to sign and magnitude
+      // and keep max_val
+      v128_t f = wasm_f32x4_splat(s->irv.Aatk);
+      v128_t k = wasm_f32x4_splat(K_inv);
+      v128_t d = wasm_f32x4_splat(delta_inv);
+      v128_t zero = wasm_i32x4_splat(0);
+      v128_t one = wasm_i32x4_splat(1);
+      v128_t tmax = wasm_v128_load(max_val);
+      const float *p = (const float*)sp;
+      const float *o = (const float*)op;
+      for ( ; count >= 4; count -= 4, p += 4, o += 4, dp += 4)
+      {
+        v128_t m = wasm_v128_load(o);
+        v128_t n = wasm_v128_load(o - 1);
+        v128_t vf = wasm_v128_load(p);
+        vf = wasm_f32x4_add(vf, wasm_f32x4_mul(f, wasm_f32x4_add(m, n)));
+        vf = wasm_f32x4_mul(vf, k);
+        vf = wasm_f32x4_mul(vf, d);                   // multiply
+        v128_t val = wasm_i32x4_trunc_sat_f32x4(vf);  // convert to signed int
+        v128_t sign = wasm_i32x4_lt(val, zero);       // get sign
+        val = wasm_v128_xor(val, sign);               // negate 1's complement
+        v128_t ones = wasm_v128_and(sign, one);
+        val = wasm_i32x4_add(val, ones);              // 2's complement
+        tmax = wasm_v128_or(tmax, val);
+        sign = wasm_i32x4_shl(sign, 31);
+        val = wasm_v128_or(val, sign);
+        wasm_v128_store(dp, val);
+      }
+      if (count)
+      {
+        v128_t m = wasm_v128_load(o);
+        v128_t n = wasm_v128_load(o - 1);
+        v128_t vf = wasm_v128_load(p);
+        vf = wasm_f32x4_add(vf, wasm_f32x4_mul(f, wasm_f32x4_add(m, n)));
+        vf = wasm_f32x4_mul(vf, k);
+        vf = wasm_f32x4_mul(vf, d);                   // multiply
+        v128_t val = wasm_i32x4_trunc_sat_f32x4(vf);  // convert to signed int
+        v128_t sign = wasm_i32x4_lt(val, zero);       // get sign
+        val = wasm_v128_xor(val, sign);               // negate 1's complement
+        v128_t ones = wasm_v128_and(sign, one);
+        val = wasm_i32x4_add(val, ones);              // 2's complement
+
+        v128_t c = wasm_i32x4_splat((si32)count);
+        v128_t idx = wasm_i32x4_make(0, 1, 2, 3);
+        v128_t mask = wasm_i32x4_gt(c, idx);
+        c = wasm_v128_and(val, mask);
+        tmax = wasm_v128_or(tmax, c);
+
+        sign = wasm_i32x4_shl(sign, 31);
+        val = wasm_v128_or(val, sign);
+        wasm_v128_store(dp, val);
+      }
+      wasm_v128_store(max_val, tmax);
+    }
+
     //////////////////////////////////////////////////////////////////////////
     void wasm_rev_tx_from_cb32(const ui32 *sp, void *dp, ui32 K_max, 
                                float delta, ui32 count)
@@ -216,6 +341,67 @@ namespace ojph {
       }
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void wasm_rev_tx_lift_from_cb32(const lifting_step* s, const ui32 *sp,
+                                    void *dp, const void *op, ui32 K_max,
+                                    float delta, float K, ui32 count)
+    {
+      ojph_unused(delta);
+      ojph_unused(K);
+
+      // convert to sign and magnitude and perform the lifting step
+      const ui8 e = s->rev.Eatk;
+      v128_t va = wasm_i32x4_splat(s->rev.Aatk);
+      v128_t vb = wasm_i32x4_splat(s->rev.Batk);
+      ui32 shift = 31 - K_max;
+      v128_t m1 = wasm_i32x4_splat(INT_MAX);
+      v128_t zero = wasm_i32x4_splat(0);
+      v128_t one = wasm_i32x4_splat(1);
+      si32 *p = (si32*)dp;
+      const si32 *o = (const si32*)op;
+      for (ui32 i = 0; i < count; i += 4, sp += 4, p += 4, o += 4)
+      {
+        v128_t v = wasm_v128_load((v128_t*)sp);
+        v128_t val = wasm_v128_and(v, m1);
+        val = wasm_i32x4_shr(val, shift);
+        v128_t sign = wasm_i32x4_lt(v, zero);
+        val = wasm_v128_xor(val, sign); // negate 1's complement
+        v128_t ones = wasm_v128_and(sign, one);
+        val = wasm_i32x4_add(val, ones); // 2's complement
+        v128_t t = wasm_i32x4_add(wasm_v128_load(o - 1), wasm_v128_load(o));
+        t = wasm_i32x4_add(vb, wasm_i32x4_mul(va, t));
+        val = wasm_i32x4_sub(val, wasm_i32x4_shr(t, e));
+        wasm_v128_store(p, val);
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void wasm_irv_tx_lift_from_cb32(const lifting_step* s, const ui32 *sp,
+                                    void *dp, const void *op, ui32 K_max,
+                                    float delta, float K, ui32 count)
+    {
+      ojph_unused(K_max);
+      v128_t m1 = wasm_i32x4_splat(INT_MAX);
+      v128_t d = wasm_f32x4_splat(delta);
+      v128_t k = wasm_f32x4_splat(K);
+      v128_t f = wasm_f32x4_splat(s->irv.Aatk);
+      float *p = (float*)dp;
+      const float *o = (const float*)op;
+      for (ui32 i = 0; i < count; i += 4, sp += 4, p += 4, o += 4)
+      {
+        v128_t v = wasm_v128_load((v128_t*)sp);
+        v128_t vali = wasm_v128_and(v, m1);
+        v128_t  valf = wasm_f32x4_convert_i32x4(vali);
+        valf = wasm_f32x4_mul(valf, d);
+        v128_t sign = wasm_v128_andnot(v, m1);
+        valf = wasm_v128_or(valf, sign);
+        valf = wasm_f32x4_mul(valf, k);
+        v128_t t = wasm_f32x4_add(wasm_v128_load(o - 1), wasm_v128_load(o));
+        valf = wasm_f32x4_sub(valf, wasm_f32x4_mul(f, t));
+        wasm_v128_store(p, valf);
+      }
+    }
+
     //////////////////////////////////////////////////////////////////////////
     void wasm_rev_tx_to_cb64(const void *sp, ui64 *dp, ui32 K_max, 
                              float delta_inv, ui32 count, ui64* max_val)
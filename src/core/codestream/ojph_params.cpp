@@ -2469,14 +2469,12 @@ namespace ojph {
     void param_atk::init_irv97()
     {
       Satk = 0x4a00;     // illegal because ATK = 0
-      Katk = (float)1.230174104914001;
+      Katk = irv97_K;
       Natk = 4;
       // next is (A-4) in T.801 second line
       Latk = (ui16)(5 + Natk + sizeof(float) * (1 + Natk));
-      d[0].irv.Aatk = (float)0.443506852043971;
-      d[1].irv.Aatk = (float)0.882911075530934;
-      d[2].irv.Aatk = (float)-0.052980118572961;
-      d[3].irv.Aatk = (float)-1.586134342059924;
+      for (int i = 0; i < 4; ++i)
+        d[i].irv.Aatk = irv97_A[i];
     }
 
     //////////////////////////////////////////////////////////////////////////
@@ -2494,5 +2492,24 @@ namespace ojph {
       d[1].rev.Eatk = 1;
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    bool param_atk::is_irv97() const
+    {
+      if (is_reversible() || Natk != 4 || Katk != irv97_K)
+        return false;
+      for (int i = 0; i < 4; ++i)
+        if (d[i].irv.Aatk != irv97_A[i])
+          return false;
+      return true;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    bool param_atk::is_rev53() const
+    {
+      return is_reversible() && Natk == 2
+        && d[0].rev.Aatk == 1 && d[0].rev.Batk == 2 && d[0].rev.Eatk == 2
+        && d[1].rev.Aatk == -1 && d[1].rev.Batk == 1 && d[1].rev.Eatk == 1;
+    }
+
   } // !local namespace
 }  // !ojph namespace
@@ -975,6 +975,13 @@ namespace ojph {
       rev_data rev;
     };
 
+    // the scaling factor and lifting coefficients of the default 9/7
+    // irreversible wavelet, in the order of its lifting steps
+    constexpr float irv97_K = (float)1.230174104914001;
+    constexpr float irv97_A[4] = {
+      (float)0.443506852043971, (float)0.882911075530934,
+      (float)-0.052980118572961, (float)-1.586134342059924 };
+
     struct param_atk
     {
       // Limitations:
@@ -1015,6 +1022,8 @@ namespace ojph {
       }
       void init_irv97();
       void init_rev53();
+      bool is_irv97() const;
+      bool is_rev53() const;
       void link(param_atk* next) 
       { assert(this->next == NULL); this->next = next; alloced_next = false; }
 
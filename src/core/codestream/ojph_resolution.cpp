@@ -204,6 +204,8 @@ namespace ojph {
         ui32 num_steps = atk->get_num_steps();
         allocator->pre_alloc_obj<line_buf>(num_steps + 2);
         allocator->pre_alloc_obj<lifting_buf>(num_steps + 2);
+        allocator->pre_alloc_obj<vert_step_lines>(num_steps);
+        allocator->pre_alloc_obj<const lifting_step*>(num_steps);
 
         const param_qcd* qp = codestream->access_qcd()->get_qcc(comp_num);
         ui32 precision = qp->propose_precision(cdp);
@@ -467,6 +469,8 @@ namespace ojph {
         // create line buffers and lifting_bufs
         lines = allocator->post_alloc_obj<line_buf>(num_steps + 2);
         ssp = allocator->post_alloc_obj<lifting_buf>(num_steps + 2);
+        step_lines = allocator->post_alloc_obj<vert_step_lines>(num_steps);
+        steps = allocator->post_alloc_obj<const lifting_step*>(num_steps);
         sig = ssp + num_steps;
         aug = ssp + num_steps + 1;
 
@@ -519,6 +523,17 @@ namespace ojph {
               allocator->post_alloc_data<float>(width, 1), width, 1);
         }
 
+        // the horizontal lifting step next to the subbands, which is the
+        // last in analysis and the first in synthesis, is fused with
+        // (de)quantization for 32bit lines only
+        fuse_horz_step = res_num > 0 && num_steps > 0 &&
+          res_rect.siz.w > 1 && (!reversible || precision <= 32);
+
+        // the default 5/3 and 9/7 wavelets have kernels that perform all
+        // the vertical lifting steps in one pass
+        fuse_vert_steps = reversible
+          ? atk->is_rev53() && precision <= 32 : atk->is_irv97();
+
         cur_line = 0;
         rows_to_produce = res_rect.siz.h;
         vert_even = (res_rect.org.y & 1) == 0;
@@ -569,32 +584,15 @@ namespace ojph {
           do
           {
             //vertical transform
-            for (ui32 i = 0; i < num_steps; ++i)
-            {
-              if (aug->active && (sig->active || ssp[i].active))
-              {
-                line_buf* dp = aug->line;
-                line_buf* sp1 = sig->active ? sig->line : ssp[i].line;
-                line_buf* sp2 = ssp[i].active ? ssp[i].line : sig->line;
-                const lifting_step* s = atk->get_step(num_steps - i - 1);
-                rev_vert_step(s, sp1, sp2, dp, width, false);
-              }
-              lifting_buf t = *aug; *aug = ssp[i]; ssp[i] = *sig; *sig = t;
-            }
+            vert_ana_lifting();
 
             if (aug->active) {
-              rev_horz_ana(atk, bands[2].get_line(),
-                bands[3].get_line(), aug->line, width, horz_even);
-              bands[2].push_line();
-              bands[3].push_line();
+              horz_ana_and_push(aug->line, true);
               aug->active = false;
               --rows_to_produce;
             }
             if (sig->active) {
-              rev_horz_ana(atk, child_res->get_line(),
-                bands[1].get_line(), sig->line, width, horz_even);
-              bands[1].push_line();
-              child_res->push_line();
+              horz_ana_and_push(sig->line, false);
               sig->active = false;
               --rows_to_produce;
             };
@@ -605,10 +603,7 @@ namespace ojph {
         {
           if (vert_even) {
             // horizontal transform
-            rev_horz_ana(atk, child_res->get_line(),
-              bands[1].get_line(), sig->line, width, horz_even);
-            bands[1].push_line();
-            child_res->push_line();
+            horz_ana_and_push(sig->line, false);
           }
           else
           {
@@ -627,10 +622,7 @@ namespace ojph {
                 *sp++ <<= 1;
             }
             // horizontal transform
-            rev_horz_ana(atk, bands[2].get_line(),
-              bands[3].get_line(), aug->line, width, horz_even);
-            bands[2].push_line();
-            bands[3].push_line();
+            horz_ana_and_push(aug->line, true);
           }
         }
       }
@@ -646,38 +638,15 @@ namespace ojph {
           do
           {
             //vertical transform
-            for (ui32 i = 0; i < num_steps; ++i)
-            {
-              if (aug->active && (sig->active || ssp[i].active))
-              {
-                line_buf* dp = aug->line;
-                line_buf* sp1 = sig->active ? sig->line : ssp[i].line;
-                line_buf* sp2 = ssp[i].active ? ssp[i].line : sig->line;
-                const lifting_step* s = atk->get_step(num_steps - i - 1);
-                irv_vert_step(s, sp1, sp2, dp, width, false);
-              }
-              lifting_buf t = *aug; *aug = ssp[i]; ssp[i] = *sig; *sig = t;
-            }
+            vert_ana_lifting();
 
             if (aug->active) {
-              const float K = atk->get_K();
-              irv_vert_times_K(K, aug->line, width);
-
-              irv_horz_ana(atk, bands[2].get_line(),
-                bands[3].get_line(), aug->line, width, horz_even);
-              bands[2].push_line();
-              bands[3].push_line();
+              horz_ana_and_push(aug->line, true);
               aug->active = false;
               --rows_to_produce;
             }
             if (sig->active) {
-              const float K_inv = 1.0f / atk->get_K();
-              irv_vert_times_K(K_inv, sig->line, width);
-
-              irv_horz_ana(atk, child_res->get_line(),
-                bands[1].get_line(), sig->line, width, horz_even);
-              bands[1].push_line();
-              child_res->push_line();
+              horz_ana_and_push(sig->line, false);
               sig->active = false;
               --rows_to_produce;
             };
@@ -688,10 +657,7 @@ namespace ojph {
         {
           if (vert_even) {
             // horizontal transform
-            irv_horz_ana(atk, child_res->get_line(),
-              bands[1].get_line(), sig->line, width, horz_even);
-            bands[1].push_line();
-            child_res->push_line();
+            horz_ana_and_push(sig->line, false);
           }
           else
           {
@@ -700,15 +666,219 @@ namespace ojph {
             for (ui32 i = width; i > 0; --i)
               *sp++ *= 2.0f;
             // horizontal transform
-            irv_horz_ana(atk, bands[2].get_line(),
-              bands[3].get_line(), aug->line, width, horz_even);
-            bands[2].push_line();
-            bands[3].push_line();
+            horz_ana_and_push(aug->line, true);
           }
         }
       }
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    // The lines of the vertical lifting steps are collected first; rotating
+    // the lifting buffers only exchanges lines, so the steps can be
+    // performed afterwards.  The default wavelets use kernels that perform
+    // all the steps in one pass; otherwise, the steps are applied to one
+    // strip of columns at a time, so that the lines of a strip stay in
+    // cache from one step to the next, which matters for wide images.
+    static const ui32 vert_strip_width = 1024; // samples, multiple of 16
+
+    //////////////////////////////////////////////////////////////////////////
+    static void get_line_strip(line_buf* dst, const line_buf* src, ui32 x)
+    {
+      size_t bytes = src->flags & line_buf::LFT_SIZE_MASK;
+      *dst = *src;
+      dst->p = (ui8*)src->p + (size_t)x * bytes;
+      dst->size -= x;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    ui32 resolution::collect_vert_steps(bool synthesis)
+    {
+      ui32 n = 0;
+      for (ui32 i = 0; i < num_steps; ++i)
+      {
+        if (aug->active && (sig->active || ssp[i].active))
+        {
+          step_lines[n].sig = sig->active ? sig->line : ssp[i].line;
+          step_lines[n].other = ssp[i].active ? ssp[i].line : sig->line;
+          step_lines[n].aug = aug->line;
+          steps[n++] = atk->get_step(synthesis ? i : num_steps - i - 1);
+        }
+        lifting_buf t = *aug; *aug = ssp[i]; ssp[i] = *sig; *sig = t;
+      }
+      return n;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void resolution::apply_vert_steps(ui32 n, line_buf *times_K,
+                                      line_buf *times_K_inv, bool synthesis)
+    {
+      // the irreversible synthesis scales the newly arrived lines before
+      // the lifting steps, while analysis scales its output after them
+      float K = reversible ? 1.0f : atk->get_K();
+      ui32 width = res_rect.siz.w;
+      for (ui32 x = 0; x < width; x += vert_strip_width)
+      {
+        ui32 w = ojph_min(width - x, vert_strip_width);
+        line_buf l1, l2, l3;
+        if (synthesis && times_K) {
+          get_line_strip(&l1, times_K, x);
+          irv_vert_times_K(K, &l1, w);
+        }
+        if (synthesis && times_K_inv) {
+          get_line_strip(&l1, times_K_inv, x);
+          irv_vert_times_K(1.0f / K, &l1, w);
+        }
+        for (ui32 i = 0; i < n; ++i)
+        {
+          get_line_strip(&l1, step_lines[i].sig, x);
+          get_line_strip(&l2, step_lines[i].other, x);
+          get_line_strip(&l3, step_lines[i].aug, x);
+          if (reversible)
+            rev_vert_step(steps[i], &l1, &l2, &l3, w, synthesis);
+          else
+            irv_vert_step(steps[i], &l1, &l2, &l3, w, synthesis);
+        }
+        if (!synthesis && times_K) {
+          get_line_strip(&l1, times_K, x);
+          irv_vert_times_K(K, &l1, w);
+        }
+        if (!synthesis && times_K_inv) {
+          get_line_strip(&l1, times_K_inv, x);
+          irv_vert_times_K(1.0f / K, &l1, w);
+        }
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void resolution::vert_ana_lifting()
+    {
+      ui32 n = collect_vert_steps(false);
+
+      // the irreversible transform scales the low-pass output by K and
+      // the high-pass output by 1/K
+      line_buf *times_K = NULL, *times_K_inv = NULL;
+      if (!reversible) {
+        times_K = aug->active ? aug->line : NULL;
+        times_K_inv = sig->active ? sig->line : NULL;
+      }
+
+      // fewer steps are needed near the top and bottom edges
+      if (fuse_vert_steps && n == num_steps)
+      {
+        if (reversible)
+          rev_vert_53(step_lines, res_rect.siz.w, false);
+        else
+          irv_vert_97(step_lines, times_K, times_K_inv, res_rect.siz.w,
+                      false);
+      }
+      else
+        apply_vert_steps(n, times_K, times_K_inv, false);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void resolution::vert_syn_lifting(line_buf *times_K,
+                                      line_buf *times_K_inv)
+    {
+      // times_K and times_K_inv are the newly arrived lines of the
+      // irreversible transform, which are scaled by K and 1/K before the
+      // lifting steps
+      ui32 n = collect_vert_steps(true);
+
+      // fewer steps are needed near the top and bottom edges
+      if (fuse_vert_steps && n == num_steps)
+      {
+        if (reversible)
+          rev_vert_53(step_lines, res_rect.siz.w, true);
+        else
+          irv_vert_97(step_lines, times_K, times_K_inv, res_rect.siz.w,
+                      true);
+      }
+      else
+        apply_vert_steps(n, times_K, times_K_inv, true);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void resolution::horz_ana_and_push(line_buf *src, bool aug_row)
+    {
+      ui32 width = res_rect.siz.w;
+      line_buf *ldst = aug_row ? bands[2].get_line() : child_res->get_line();
+      line_buf *hdst = bands[aug_row ? 3 : 1].get_line();
+
+      // The last lifting step produces the low-pass subband when the number
+      // of steps is even.  Unless that subband is passed to the next
+      // resolution, the last step is fused with codeblock quantization.
+      bool last_is_low = (num_steps & 1) == 0;
+      subband *last_band = NULL;
+      if (fuse_horz_step)
+      {
+        if (!last_is_low)
+          last_band = bands + (aug_row ? 3 : 1);
+        else if (aug_row)
+          last_band = bands + 2;
+      }
+
+      if (last_band == NULL)
+      {
+        if (reversible)
+          rev_horz_ana(atk, ldst, hdst, src, width, horz_even, false);
+        else
+          irv_horz_ana(atk, ldst, hdst, src, width, horz_even, false);
+        if (aug_row) {
+          bands[2].push_line();
+          bands[3].push_line();
+        }
+        else {
+          bands[1].push_line();
+          child_res->push_line();
+        }
+        return;
+      }
+
+      if (reversible)
+        rev_horz_ana(atk, ldst, hdst, src, width, horz_even, true);
+      else
+        irv_horz_ana(atk, ldst, hdst, src, width, horz_even, true);
+
+      // the other subband, which the last lifting step reads from
+      line_buf *other = last_is_low ? hdst : ldst;
+      ui32 l_width = (width + (horz_even ? 1 : 0)) >> 1;
+      ui32 other_width = last_is_low ? width - l_width : l_width;
+      bool even = ((num_steps & 1) != 0) == horz_even;
+
+      // extension
+      if (reversible)
+      {
+        si32 *sp = other->i32;
+        sp[-1] = sp[0];
+        sp[other_width] = sp[other_width - 1];
+      }
+      else
+      {
+        float *sp = other->f32;
+        sp[-1] = sp[0];
+        sp[other_width] = sp[other_width - 1];
+      }
+
+      // last lifting step and quantization
+      const lifting_step* s = atk->get_step(0);
+      if (reversible)
+        last_band->push_line(s, other, even, 1.0f);
+      else
+      {
+        const float K = atk->get_K();
+        last_band->push_line(s, other, even, 1.0f / K);
+        irv_vert_times_K(K, other, other_width);
+      }
+
+      // push the other subband
+      if (!aug_row)
+        child_res->push_line();
+      else if (last_band == bands + 2)
+        bands[3].push_line();
+      else
+        bands[2].push_line();
+    }
+
     //////////////////////////////////////////////////////////////////////////
     line_buf* resolution::pull_line()
     {
@@ -743,7 +913,7 @@ namespace ojph {
                 if (vert_even) { // even
                   if (transform_flags & HORZ_TRX)
                     rev_horz_syn(atk, aug->line, child_res->pull_line(), 
-                      bands[1].pull_line(), width, horz_even);
+                      bands[1].pull_line(), width, horz_even, false);
                   else
                     memcpy(aug->line->p, child_res->pull_line()->p,
                       (size_t)width 
@@ -755,8 +925,7 @@ namespace ojph {
                 }
                 else {
                   if (transform_flags & HORZ_TRX)
-                    rev_horz_syn(atk, sig->line, bands[2].pull_line(), 
-                      bands[3].pull_line(), width, horz_even);
+                    pull_and_horz_syn(sig->line);
                   else
                     memcpy(sig->line->p, bands[2].pull_line()->p,
                       (size_t)width 
@@ -768,18 +937,7 @@ namespace ojph {
               }
 
               //vertical transform
-              for (ui32 i = 0; i < num_steps; ++i)
-              {
-                if (aug->active && (sig->active || ssp[i].active))
-                {
-                  line_buf* dp = aug->line;
-                  line_buf* sp1 = sig->active ? sig->line : ssp[i].line;
-                  line_buf* sp2 = ssp[i].active ? ssp[i].line : sig->line;
-                  const lifting_step* s = atk->get_step(i);
-                  rev_vert_step(s, sp1, sp2, dp, width, true);
-                }
-                lifting_buf t = *aug; *aug = ssp[i]; ssp[i] = *sig; *sig = t;
-              }
+              vert_syn_lifting(NULL, NULL);
 
               if (aug->active) {
                 aug->active = false;
@@ -796,7 +954,7 @@ namespace ojph {
             if (vert_even) {
               if (transform_flags & HORZ_TRX)
                 rev_horz_syn(atk, aug->line, child_res->pull_line(),
-                  bands[1].pull_line(), width, horz_even);
+                  bands[1].pull_line(), width, horz_even, false);
               else
                 memcpy(aug->line->p, child_res->pull_line()->p,
                   (size_t)width 
@@ -805,8 +963,7 @@ namespace ojph {
             else
             {
               if (transform_flags & HORZ_TRX)
-                rev_horz_syn(atk, aug->line, bands[2].pull_line(),
-                  bands[3].pull_line(), width, horz_even);
+                pull_and_horz_syn(aug->line);
               else
                 memcpy(aug->line->p, bands[2].pull_line()->p,
                   (size_t)width 
@@ -836,6 +993,9 @@ namespace ojph {
               sig->active = false;
               return sig->line;
             };
+            // the lines to be scaled by K and 1/K, which is performed
+            // together with the vertical transform
+            line_buf *times_K = NULL, *times_K_inv = NULL;
             for (;;)
             {
               //horizontal transform
@@ -844,48 +1004,32 @@ namespace ojph {
                 if (vert_even) { // even
                   if (transform_flags & HORZ_TRX)
                     irv_horz_syn(atk, aug->line, child_res->pull_line(), 
-                      bands[1].pull_line(), width, horz_even);
+                      bands[1].pull_line(), width, horz_even, false);
                   else 
                     memcpy(aug->line->f32, child_res->pull_line()->f32,
                       width * sizeof(float));
                   aug->active = true;
                   vert_even = !vert_even;
                   ++cur_line;
-
-                  const float K = atk->get_K();
-                  irv_vert_times_K(K, aug->line, width);
-
+                  times_K = aug->line;
                   continue;
                 }
                 else {
                   if (transform_flags & HORZ_TRX)
-                    irv_horz_syn(atk, sig->line, bands[2].pull_line(), 
-                      bands[3].pull_line(), width, horz_even);
+                    pull_and_horz_syn(sig->line);
                   else
                     memcpy(sig->line->f32, bands[2].pull_line()->f32,
                       width * sizeof(float));
                   sig->active = true;
                   vert_even = !vert_even;
                   ++cur_line;
-
-                  const float K_inv = 1.0f / atk->get_K();
-                  irv_vert_times_K(K_inv, sig->line, width);
+                  times_K_inv = sig->line;
                 }
               }
 
               //vertical transform
-              for (ui32 i = 0; i < num_steps; ++i)
-              {
-                if (aug->active && (sig->active || ssp[i].active))
-                {
-                  line_buf* dp = aug->line;
-                  line_buf* sp1 = sig->active ? sig->line : ssp[i].line;
-                  line_buf* sp2 = ssp[i].active ? ssp[i].line : sig->line;
-                  const lifting_step* s = atk->get_step(i);
-                  irv_vert_step(s, sp1, sp2, dp, width, true);
-                }
-                lifting_buf t = *aug; *aug = ssp[i]; ssp[i] = *sig; *sig = t;
-              }
+              vert_syn_lifting(times_K, times_K_inv);
+              times_K = times_K_inv = NULL;
 
               if (aug->active) {
                 aug->active = false;
@@ -902,7 +1046,7 @@ namespace ojph {
             if (vert_even) {
               if (transform_flags & HORZ_TRX)
                 irv_horz_syn(atk, aug->line, child_res->pull_line(),
-                  bands[1].pull_line(), width, horz_even);
+                  bands[1].pull_line(), width, horz_even, false);
               else
                 memcpy(aug->line->f32, child_res->pull_line()->f32,
                   width * sizeof(float));
@@ -910,8 +1054,7 @@ namespace ojph {
             else
             {
               if (transform_flags & HORZ_TRX)
-                irv_horz_syn(atk, aug->line, bands[2].pull_line(),
-                  bands[3].pull_line(), width, horz_even);
+                pull_and_horz_syn(aug->line);
              else
                 memcpy(aug->line->f32, bands[2].pull_line()->f32,
                   width * sizeof(float));
@@ -929,7 +1072,7 @@ namespace ojph {
         {
           if (transform_flags & HORZ_TRX)
             rev_horz_syn(atk, aug->line, child_res->pull_line(),
-              bands[1].pull_line(), width, horz_even);
+              bands[1].pull_line(), width, horz_even, false);
           else
             memcpy(aug->line->p, child_res->pull_line()->p,
               (size_t)width * (aug->line->flags & line_buf::LFT_SIZE_MASK));
@@ -939,7 +1082,7 @@ namespace ojph {
         {
           if (transform_flags & HORZ_TRX)
             irv_horz_syn(atk, aug->line, child_res->pull_line(),
-              bands[1].pull_line(), width, horz_even);
+              bands[1].pull_line(), width, horz_even, false);
           else
             memcpy(aug->line->f32, child_res->pull_line()->f32,
               width * sizeof(float));
@@ -948,6 +1091,52 @@ namespace ojph {
       }
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void resolution::pull_and_horz_syn(line_buf *dst)
+    {
+      ui32 width = res_rect.siz.w;
+
+      // The first synthesis lifting step updates the low-pass subband from
+      // the high-pass one; it is fused with codeblock dequantization.
+      if (!fuse_horz_step || !bands[2].exists() || !bands[3].exists())
+      {
+        if (reversible)
+          rev_horz_syn(atk, dst, bands[2].pull_line(), bands[3].pull_line(),
+            width, horz_even, false);
+        else
+          irv_horz_syn(atk, dst, bands[2].pull_line(), bands[3].pull_line(),
+            width, horz_even, false);
+        return;
+      }
+
+      line_buf *hsrc = bands[3].pull_line();
+      ui32 h_width = (width + (horz_even ? 0 : 1)) >> 1;
+
+      // multiply by 1/K and extension
+      const float K = reversible ? 1.0f : atk->get_K();
+      if (reversible)
+      {
+        si32 *sp = hsrc->i32;
+        sp[-1] = sp[0];
+        sp[h_width] = sp[h_width - 1];
+      }
+      else
+      {
+        irv_vert_times_K(1.0f / K, hsrc, h_width);
+        float *sp = hsrc->f32;
+        sp[-1] = sp[0];
+        sp[h_width] = sp[h_width - 1];
+      }
+
+      // dequantization and first lifting step
+      const lifting_step* s = atk->get_step(0);
+      line_buf *lsrc = bands[2].pull_line(s, hsrc, horz_even, K);
+      if (reversible)
+        rev_horz_syn(atk, dst, lsrc, hsrc, width, horz_even, true);
+      else
+        irv_horz_syn(atk, dst, lsrc, hsrc, width, horz_even, true);
+    }
+
     //////////////////////////////////////////////////////////////////////////
     ui32 resolution::prepare_precinct()
     {
@@ -57,6 +57,11 @@ namespace ojph {
     struct precinct;
     class subband;
 
+    //////////////////////////////////////////////////////////////////////////
+    //defined elsewhere
+    struct vert_step_lines;
+    union lifting_step;
+
     //////////////////////////////////////////////////////////////////////////
     class resolution
     {
@@ -95,6 +100,15 @@ namespace ojph {
       ui32 get_num_bytes() const { return num_bytes; }
       ui32 get_num_bytes(ui32 resolution_num) const;
 
+    private:
+      ui32 collect_vert_steps(bool synthesis);
+      void apply_vert_steps(ui32 n, line_buf *times_K,
+                            line_buf *times_K_inv, bool synthesis);
+      void vert_ana_lifting();
+      void vert_syn_lifting(line_buf *times_K, line_buf *times_K_inv);
+      void horz_ana_and_push(line_buf *src, bool aug_row);
+      void pull_and_horz_syn(line_buf *dst);
+
     private:
       bool reversible, skipped_res_for_read, skipped_res_for_recon;
       ui32 num_steps;
@@ -107,6 +121,8 @@ namespace ojph {
       line_buf* lines;                           // used to store lines
       lifting_buf *ssp;                          // step state pointer
       lifting_buf *aug, *sig;
+      vert_step_lines *step_lines;               // lines of collected steps
+      const lifting_step **steps;                // and their lifting steps
       subband *bands;
       tile_comp *parent_comp;
       resolution *parent_res, *child_res;
@@ -124,6 +140,7 @@ namespace ojph {
       ui32 cur_line;
       ui32 rows_to_produce;
       bool vert_even, horz_even;
+      bool fuse_horz_step, fuse_vert_steps;
       mem_elastic_allocator *elastic;
     };
 
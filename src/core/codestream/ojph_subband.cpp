@@ -46,6 +46,7 @@
 #include "ojph_subband.h"
 #include "ojph_resolution.h"
 #include "ojph_codeblock.h"
+#include "ojph_codeblock_cache.h"
 #include "ojph_precinct.h"
 
 namespace ojph {
@@ -219,6 +220,15 @@ namespace ojph {
         lines->wrap(allocator->post_alloc_data<float>(width, 1), width, 1);
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void subband::get_cache_key(const coded_cb_header* cb, 
+                                cb_cache_key& key) const
+    {
+      key.band_org = ((ui64)band_rect.org.x << 32) | band_rect.org.y;
+      key.band_id = (parent->get_comp_num() << 8) | (res_num << 2) | band_num;
+      key.cb_idx = (ui32)(cb - coded_cbs);
+    }
+
     //////////////////////////////////////////////////////////////////////////
     void subband::get_cb_indices(const size& num_precincts,
                                  precinct *precincts)
@@ -296,6 +306,25 @@ namespace ojph {
       //push to codeblocks
       for (ui32 i = 0; i < num_blocks.w; ++i)
         blocks[i].push(lines + 0);
+      finish_pushed_line();
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void subband::push_line(const lifting_step* s, const line_buf* other,
+                            bool even, float K_inv)
+    {
+      if (empty)
+        return;
+
+      //complete the last horizontal lifting step while pushing to codeblocks
+      for (ui32 i = 0; i < num_blocks.w; ++i)
+        blocks[i].push(lines + 0, s, other, even, K_inv);
+      finish_pushed_line();
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void subband::finish_pushed_line()
+    {
       if (++cur_line >= cur_cb_height)
       {
         for (ui32 i = 0; i < num_blocks.w; ++i)
@@ -337,7 +366,36 @@ namespace ojph {
       if (empty)
         return lines;
 
+      prepare_pulled_line();
+
       //pull from codeblocks
+      for (ui32 i = 0; i < num_blocks.w; ++i)
+        blocks[i].pull_line(lines + 0);
+
+      return lines;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    line_buf *subband::pull_line(const lifting_step* s, const line_buf* other,
+                                 bool even, float K)
+    {
+      if (empty)
+        return lines;
+
+      prepare_pulled_line();
+
+      //perform the first horizontal lifting step while pulling from
+      //codeblocks
+      for (ui32 i = 0; i < num_blocks.w; ++i)
+        blocks[i].pull_line(lines + 0, s, other, even, K);
+
+      return lines;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void subband::prepare_pulled_line()
+    {
+      //decode a new row of codeblocks when the current one is exhausted
       if (--cur_line <= 0)
       {
         if (cur_cb_row < num_blocks.h)
@@ -370,12 +428,6 @@ namespace ojph {
       }
 
       assert(cur_line >= 0);
-
-      //pull from codeblocks
-      for (ui32 i = 0; i < num_blocks.w; ++i)
-        blocks[i].pull_line(lines + 0);
-
-      return lines;
     }
 
   }
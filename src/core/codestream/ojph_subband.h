@@ -57,6 +57,8 @@ namespace ojph {
     struct precinct;
     class codeblock;
     struct coded_cb_header;
+    struct cb_cache_key;
+    union lifting_step;
   
   //////////////////////////////////////////////////////////////////////////
     class subband
@@ -88,14 +90,23 @@ namespace ojph {
       void exchange_buf(line_buf* l);
       line_buf* get_line() { return lines; }
       void push_line();
+      void push_line(const lifting_step* s, const line_buf* other, bool even,
+                     float K_inv);
 
       void get_cb_indices(const size& num_precincts, precinct *precincts);
       float get_delta() { return delta; }
       bool exists() { return !empty; }
 
       line_buf* pull_line();
+      line_buf* pull_line(const lifting_step* s, const line_buf* other,
+                          bool even, float K);
       resolution* get_parent() { return parent; }
       const resolution* get_parent() const { return parent; }
+      void get_cache_key(const coded_cb_header* cb, cb_cache_key& key) const;
+
+    private:
+      void finish_pushed_line();
+      void prepare_pulled_line();
 
     private:
       bool empty;                  // true if the subband has no pixels or
@@ -52,6 +52,41 @@ namespace ojph {
   namespace local
   {
 
+    //////////////////////////////////////////////////////////////////////////
+    // Sample conversion and the colour transform can be performed together,
+    // in one pass, when the first three components have the same geometry,
+    // bit depth, and signedness, none of them employs the type 3 NLT, and
+    // tile-component lines hold 32 bit samples.
+    static bool can_fuse_colour_transform(codestream *codestream)
+    {
+      constexpr ui8 type3 = 
+        param_nlt::nonlinearity::OJPH_NLT_BINARY_COMPLEMENT_NLT;
+
+      const param_siz *szp = codestream->get_siz();
+      const param_nlt *nlp = codestream->get_nlt();
+      for (ui32 c = 0; c < 3; ++c)
+      {
+        point ds0 = szp->get_downsampling(0), ds = szp->get_downsampling(c);
+        if (ds.x != ds0.x || ds.y != ds0.y ||
+            szp->get_bit_depth(c) != szp->get_bit_depth(0) ||
+            szp->is_signed(c) != szp->is_signed(0))
+          return false;
+
+        ui8 bd, nl_type; bool is;
+        if (nlp->get_nonlinear_transform(c, bd, is, nl_type) && 
+            nl_type == type3)
+          return false;
+
+        const param_cod *cdp = codestream->get_coc(c);
+        if (cdp->is_reversible()) {
+          const param_qcd *qp = codestream->access_qcd()->get_qcc(c);
+          if (qp->propose_precision(cdp) > 32)
+            return false;
+        }
+      }
+      return true;
+    }
+
     //////////////////////////////////////////////////////////////////////////
     void tile::pre_alloc(codestream *codestream, const rect& tile_rect,
                          const rect& recon_tile_rect, ui32& num_tileparts)
@@ -157,6 +192,9 @@ namespace ojph {
             reversible[1] ? "reversible" : "irreversible",
             reversible[2] ? "reversible" : "irreversible");
 
+        if (can_fuse_colour_transform(codestream))
+          return; // no intermediate lines are needed
+
         allocator->pre_alloc_obj<line_buf>(3);
         if (reversible[0])
           for (int i = 0; i < 3; ++i)
@@ -270,6 +308,8 @@ namespace ojph {
         num_bits[i] = szp->get_bit_depth(i);
         is_signed[i] = szp->is_signed(i);
         bool result = nlp->get_nonlinear_transform(i, bd, is, nlt_type3[i]);
+        if (result == false) // nlt_type3 is otherwise left uninitialized
+          nlt_type3[i] = param_nlt::nonlinearity::OJPH_NLT_NO_NLT;
         if (result == true && (bd != num_bits[i] || is != is_signed[i]))
           OJPH_ERROR(0x000300A1, "Mismatch between Ssiz (bit_depth = %d, "
             "is_signed = %s) from SIZ marker segment, and BDnlt "
@@ -285,7 +325,11 @@ namespace ojph {
       //allocate lines
       const param_cod* cdp = codestream->get_cod();
       this->employ_color_transform = cdp->is_employing_color_transform();
-      if (this->employ_color_transform)
+      this->fuse_colour_transform = this->employ_color_transform && 
+        can_fuse_colour_transform(codestream);
+      for (int i = 0; i < 3; ++i)
+        ct_src_lines[i] = NULL;
+      if (this->employ_color_transform && !this->fuse_colour_transform)
       {
         num_lines = 3;
         lines = allocator->post_alloc_obj<line_buf>(num_lines);
@@ -347,6 +391,33 @@ namespace ojph {
         }
         comps[comp_num].push_line();
       }
+      else if (fuse_colour_transform)
+      {
+        // the source lines of components 0 and 1 remain valid until
+        // component 2 is pushed; all three are then consumed in one pass
+        ct_src_lines[comp_num] = line;
+        if (comp_num == 2)
+        {
+          ui32 comp_width = comp_rects[comp_num].siz.w;
+          if (reversible[comp_num])
+          {
+            si64 shift = (si64)1 << (num_bits[comp_num] - 1);
+            shift = is_signed[comp_num] ? 0 : -shift;
+            rev_convert_rct_forward(ct_src_lines[0], ct_src_lines[1],
+              ct_src_lines[2], line_offsets[comp_num],
+              comps[0].get_line(), comps[1].get_line(), comps[2].get_line(),
+              shift, comp_width);
+          }
+          else
+            irv_convert_to_float_ict_forward(ct_src_lines[0], 
+              ct_src_lines[1], ct_src_lines[2], line_offsets[comp_num],
+              comps[0].get_line(), comps[1].get_line(), comps[2].get_line(),
+              num_bits[comp_num], is_signed[comp_num], comp_width);
+          comps[0].push_line();
+          comps[1].push_line();
+          comps[2].push_line();
+        }
+      }
       else
       {
         si64 shift = (si64)1 << (num_bits[comp_num] - 1);
@@ -400,7 +471,7 @@ namespace ojph {
     }
 
     //////////////////////////////////////////////////////////////////////////
-    bool tile::pull(line_buf* tgt_line, ui32 comp_num)
+    bool tile::pull(line_buf* tgt_lines, ui32 comp_num)
     {
       constexpr ui8 type3 = 
         param_nlt::nonlinearity::OJPH_NLT_BINARY_COMPLEMENT_NLT;
@@ -411,6 +482,8 @@ namespace ojph {
 
       cur_line[comp_num]++;
 
+      line_buf *tgt_line = tgt_lines + comp_num;
+
       if (!employ_color_transform || num_comps == 1)
       {
         line_buf *src_line = comps[comp_num].pull_line();
@@ -443,6 +516,30 @@ namespace ojph {
       {
         assert(num_comps >= 3);
         ui32 comp_width = recon_comp_rects[comp_num].siz.w;
+        if (fuse_colour_transform && comp_num < 3)
+        {
+          // all three components are produced when component 0 is pulled;
+          // the lines of components 1 and 2 are not touched by the caller
+          // until they are pulled
+          if (comp_num == 0)
+          {
+            if (reversible[comp_num])
+            {
+              si64 shift = (si64)1 << (num_bits[comp_num] - 1);
+              shift = is_signed[comp_num] ? 0 : shift;
+              rct_backward_rev_convert(comps[0].pull_line(), 
+                comps[1].pull_line(), comps[2].pull_line(), tgt_lines + 0,
+                tgt_lines + 1, tgt_lines + 2, line_offsets[comp_num],
+                shift, comp_width);
+            }
+            else
+              ict_backward_irv_convert_to_integer(comps[0].pull_line(),
+                comps[1].pull_line(), comps[2].pull_line(), tgt_lines + 0,
+                tgt_lines + 1, tgt_lines + 2, line_offsets[comp_num],
+                num_bits[comp_num], is_signed[comp_num], comp_width);
+          }
+          return true;
+        }
         if (comp_num == 0)
         {
           if (reversible[comp_num])
@@ -67,11 +67,12 @@ namespace ojph {
 
       bool push(line_buf *line, ui32 comp_num);
       void prepare_for_flush();
+      ui32 get_num_bytes() const { return num_bytes; }
       void fill_tlm(param_tlm* tlm);
       void flush(outfile_base *file);
       void parse_tile_header(const param_sot& sot, infile_base *file,
                              const ui64& tile_start_location);
-      bool pull(line_buf *, ui32 comp_num);
+      bool pull(line_buf *tgt_lines, ui32 comp_num);
       rect get_tile_rect() { return tile_rect; }
 
     private:
@@ -82,6 +83,8 @@ namespace ojph {
       ui32 num_lines;
       line_buf* lines;
       bool employ_color_transform, resilient;
+      bool fuse_colour_transform; // conversion and colour transform in 1 pass
+      line_buf *ct_src_lines[3];  // source lines held until component 2
       bool *reversible;
       rect *comp_rects, *recon_comp_rects;
       ui32 *line_offsets;
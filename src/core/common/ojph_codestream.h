@@ -50,6 +50,7 @@ namespace ojph {
   //local prototyping
   namespace local {
     class codestream;
+    class codeblock_cache;
   };
 
   ////////////////////////////////////////////////////////////////////////////
@@ -64,6 +65,7 @@ namespace ojph {
   class line_buf;
   class outfile_base;
   class infile_base;
+  class codeblock_cache;
 
   ////////////////////////////////////////////////////////////////////////////
   /**
@@ -87,6 +89,24 @@ namespace ojph {
    */
   class OJPH_EXPORT codestream
   {
+  public:
+    /**
+     *  @brief Sample formats of user buffers passed to 
+     *         codestream::push_frame() and codestream::pull_frame().
+     *
+     *  One sample type is combined, using bitwise or, with PF_PLANAR when 
+     *  components are stored one after the other rather than interleaved.
+     *  PF_FLOAT16 is only supported by push_frame().
+     */
+    enum pixel_format : ui32 {
+      PF_UINT8   = 0x01, // unsigned 8-bit samples
+      PF_UINT16  = 0x02, // unsigned 16-bit samples, in native byte order
+      PF_FLOAT32 = 0x04, // 32-bit float samples
+      PF_FLOAT16 = 0x08, // IEEE 754 half-precision samples
+      PF_TYPE_MASK = 0x0F,
+      PF_PLANAR  = 0x10, // components are not interleaved
+    };
+
   public:
     /**
      *  @brief default constructor
@@ -237,6 +257,37 @@ namespace ojph {
     
     line_buf* exchange(line_buf* line, ui32& next_component);
 
+    /**
+     * @brief This call pushes a complete image from user memory into a
+     *        writing (encoding) codestream; it is called after 
+     *        codestream::write_headers(), and replaces all calls to 
+     *        codestream::exchange() for the image.
+     *
+     *        For PF_UINT8 and PF_UINT16, samples are clamped to the range
+     *        of their component's bit depth, which must not exceed that of
+     *        the input, and signed components are offset by minus half
+     *        their range; this is the inverse of pull_frame().  For 
+     *        PF_FLOAT32 and PF_FLOAT16, samples are multiplied by 
+     *        2^bit_depth, rounded, and clamped to the component's range;
+     *        unsigned samples are expected in [0, 1), and signed samples in
+     *        [-0.5, 0.5).  Bit depths of float inputs must not exceed 24.
+     *
+     *        Interleaved input requires components that have the same 
+     *        dimensions, bit depth, and signedness.  For planar input, the
+     *        rows of each component follow those of the previous 
+     *        component, and components can have different dimensions;
+     *        with the colour transform, only components 0 to 2 must have
+     *        the same dimensions.  The setting of codestream::set_planar()
+     *        does not matter.
+     *
+     * @param src points to the first row of the input.
+     * @param stride is the distance in bytes between consecutive rows,
+     *               which must be large enough for the widest row.
+     * @param format is a member of pixel_format, possibly combined with
+     *               PF_PLANAR.
+     */
+    void push_frame(const void* src, size_t stride, ui32 format);
+
     /**
      * @brief This is the last call to a writing (encoding) codestream.
      *        This will write encoded bitstream data to the file.  This
@@ -255,6 +306,29 @@ namespace ojph {
      */
     void enable_resilience();             // before read_headers
 
+    /**
+     * @brief Attaches a codeblock cache to a codestream; call before 
+     *        codestream::write_headers() for a writing (encoding) 
+     *        codestream, or before codestream::create() for a reading 
+     *        (decoding) codestream.
+     *
+     *        When decoding, codeblocks whose coded data are identical to 
+     *        those of the same codeblock in an earlier codestream decoded
+     *        with the same cache are not decoded again; their cached 
+     *        samples are used.  When encoding, codeblocks whose samples 
+     *        are identical to those of the same codeblock in an earlier
+     *        codestream encoded with the same cache are not encoded again;
+     *        their cached coded data are used.  This benefits sequences of
+     *        frames with mostly static content, such as screen content or 
+     *        surveillance video.  The results are identical to those 
+     *        obtained without a cache.
+     *
+     * @param cache The cache, which must outlive this codestream; it must
+     *              not be used by more than one codestream at a time.
+     *              NULL detaches the cache.
+     */
+    void set_codeblock_cache(codeblock_cache* cache); // before create
+
     /**
      * @brief This call reads the headers of a codestream.  It is for a
      *        reading (or decoding) codestream, and should be called 
@@ -308,6 +382,35 @@ namespace ojph {
      */
     line_buf* pull(ui32 &comp_num);
 
+    /**
+     * @brief This call pulls a complete image from a decoding (reading) 
+     *        codestream into user memory; it is called after 
+     *        codestream::create(), and replaces all calls to 
+     *        codestream::pull() for the image.
+     *
+     *        For PF_UINT8 and PF_UINT16, samples of signed components are 
+     *        offset by half their range, and all samples are clamped to 
+     *        the range of their bit depth, which must not exceed that of
+     *        the output.  For PF_FLOAT32, samples are divided by 
+     *        2^bit_depth, so that unsigned samples lie in [0, 1), and 
+     *        signed samples in [-0.5, 0.5).
+     *
+     *        Interleaved output requires components that have the same 
+     *        dimensions, bit depth, and signedness.  For planar output, 
+     *        the rows of each component follow those of the previous 
+     *        component, and components can have different dimensions;
+     *        with the colour transform, only components 0 to 2 must have
+     *        the same dimensions.  The setting of codestream::set_planar()
+     *        does not matter.
+     *
+     * @param dst points to the first row of the output.
+     * @param stride is the distance in bytes between consecutive rows,
+     *               which must be large enough for the widest row.
+     * @param format is a member of pixel_format, possibly combined with
+     *               PF_PLANAR.
+     */
+    void pull_frame(void* dst, size_t stride, ui32 format);
+
     /**
      * @brief Call this function to close the underlying file; works for both
      *        encoding and decoding codestreams.
@@ -365,6 +468,49 @@ namespace ojph {
     local::codestream* state;
   };
 
+  ////////////////////////////////////////////////////////////////////////////
+  /**
+   *  @brief Holds codeblocks across the encoding or decoding of frames.
+   *
+   *  See codestream::set_codeblock_cache().  The cache keeps the coded 
+   *  data and the samples of the last frame for each codeblock location;
+   *  codeblocks are matched by a hash of their input, the coded data when
+   *  decoding or the samples when encoding, confirmed by a full 
+   *  comparison.  A cache should be used for either encoding or decoding.
+   */
+  class OJPH_EXPORT codeblock_cache
+  {
+  public:
+    /**
+     *  @brief default constructor; the cache starts empty.
+     */
+    codeblock_cache();
+
+    /**
+     *  @brief default destructor; releases all cached codeblocks.
+     */
+    ~codeblock_cache();
+
+    /**
+     *  @brief Removes all cached codeblocks, and resets the statistics.
+     */
+    void clear();
+
+    /**
+     *  @brief Returns the number of codeblocks that were found in the 
+     *         cache, and the number that were not.
+     *
+     *  @param hits receives the number of codeblocks that were reused
+     *  @param misses receives the number of codeblocks that were decoded,
+     *         or encoded
+     */
+    void get_stats(ui64& hits, ui64& misses) const;
+
+  private:
+    friend class codestream;
+    local::codeblock_cache* state;
+  };
+
 }
 
 #endif // !OJPH_CODESTREAM_H
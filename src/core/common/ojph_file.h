@@ -70,6 +70,14 @@ namespace ojph {
 #endif
 
 
+  ////////////////////////////////////////////////////////////////////////////
+  // a piece of data for gather writes, similar to POSIX struct iovec
+  struct io_vec
+  {
+    const void *ptr;
+    size_t size;
+  };
+
   ////////////////////////////////////////////////////////////////////////////
   class OJPH_EXPORT outfile_base
   {
@@ -83,6 +91,18 @@ namespace ojph {
     virtual ~outfile_base() {}
 
     virtual size_t write(const void *ptr, size_t size) = 0;
+    //write_vec writes count pieces, one after another, returns the number
+    //of bytes written; files can override it to write them in one go
+    virtual size_t write_vec(const io_vec *vecs, ui32 count)
+    {
+      size_t total = 0;
+      for (ui32 i = 0; i < count; ++i)
+        total += write(vecs[i].ptr, vecs[i].size);
+      return total;
+    }
+    //reserve is a hint that about num_bytes more bytes will be written;
+    //files can use it to allocate their storage in one go
+    virtual void reserve(size_t num_bytes) { ojph_unused(num_bytes); }
     virtual si64 tell() { return 0; }
     virtual int seek(si64 offset, enum outfile_base::seek origin) 
     { 
@@ -102,6 +122,8 @@ namespace ojph {
 
     void open(const char *filename);
     size_t write(const void *ptr, size_t size) override;
+    //write_vec uses writev, where available
+    size_t write_vec(const io_vec *vecs, ui32 count) override;
     si64 tell() override;
     void flush() override;
     void close() override;
@@ -122,10 +144,30 @@ namespace ojph {
    *  this class grows with the addition of new data.
    *
    *  memory data can be accessed using get_data()
+   *
+   *  The memory buffer can also be supplied by the caller, in which case
+   *  the codestream is written directly into it.
    */
   class OJPH_EXPORT mem_outfile : public outfile_base
   {
   public:
+    /**
+     *  @brief The type of functions that provide a larger buffer when the
+     *         data outgrow a buffer supplied by the caller.
+     *
+     *  Like realloc, the function receives the current buffer, which
+     *  holds the data written so far, and must return a buffer of at
+     *  least needed_size bytes holding the same data, or NULL on failure.
+     *
+     *  @param arg is the argument passed to open.
+     *  @param buffer is the current buffer.
+     *  @param needed_size is the minimum size of the new buffer.
+     *  @param new_size receives the size of the new buffer.
+     *  @return the new buffer, or NULL on failure.
+     */
+    typedef void* (*overflow_fun)(void *arg, void *buffer,
+                                  size_t needed_size, size_t *new_size);
+
     /**  A constructor */
     mem_outfile();
     /**  A destructor */
@@ -143,6 +185,25 @@ namespace ojph {
      */
     void open(size_t initial_size = 65536, bool clear_mem = false);
 
+    /**  
+     *  @brief Call this function to open a memory file that writes into
+     *         a buffer owned by the caller.
+     *
+     *  No memory is allocated or copied while the data fit in buffer.  If
+     *  they outgrow it, overflow is called to obtain a larger buffer; 
+     *  without overflow, the data are moved to memory allocated by this
+     *  object, which then grows as usual.  The caller's buffers are never
+     *  freed by this object, and must outlive its use of them.
+     * 
+     *  @param buffer is the buffer to write into.
+     *  @param size is the size of buffer in bytes.
+     *  @param overflow is called when the data outgrow the buffer; it can
+     *         be NULL.
+     *  @param arg is passed to overflow.
+     */
+    void open(void *buffer, size_t size, overflow_fun overflow = NULL,
+              void *arg = NULL);
+
     /**  
      *  @brief Call this function to write data to the memory file.
 	   *
@@ -154,6 +215,30 @@ namespace ojph {
      */
     size_t write(const void *ptr, size_t size) override;
 
+    /**  
+     *  @brief Call this function to write many pieces of data to the 
+     *         memory file.
+     *
+     *  The memory buffer is expanded once for all the pieces.
+     *
+     *  @param vecs points to the pieces.
+     *  @param count the number of pieces.
+     *  @return the number of bytes written.
+     */
+    size_t write_vec(const io_vec *vecs, ui32 count) override;
+
+    /**  
+     *  @brief Call this function to expand the memory buffer, in one go,
+     *         such that the next num_bytes bytes can be written without
+     *         reallocation.
+     *
+     *  The codestream calls this function with the exact size of the
+     *  tile data before writing them.
+     *
+     *  @param num_bytes the number of bytes that are about to be written.
+     */
+    void reserve(size_t num_bytes) override;
+
     /** 
      *  @brief Call this function to know the file size (i.e., number of 
      *         bytes used to store the file).
@@ -197,6 +282,14 @@ namespace ojph {
      */
     const ui8* get_data() const { return buf; }
 
+    /** 
+     *  @brief Call this function to get the number of bytes written to the
+     *         memory file, which is the extent of the data it holds.
+     *
+     *  @return the used size in bytes.
+     */
+    size_t get_used_size() const { return used_size; }
+
     /** 
      *  @brief Call this function to write the memory file data to a file
 	   *
@@ -215,15 +308,68 @@ namespace ojph {
      */
     void expand_storage(size_t new_size, bool clear_all);
 
+    /**
+     *  @brief This function replaces a buffer supplied by the caller with
+     *         one that can hold needed_size bytes.
+     * 
+     *  The new buffer is obtained from overflow, if available; otherwise,
+     *  it is allocated by this object, and stops being external.
+     * 
+     * @param needed_size  Minimum size of the new buffer
+     */
+    void expand_external(size_t needed_size);
+
   private:
     bool is_open;
     bool clear_mem;
+    bool external;          // true if buf is owned by the caller
+    overflow_fun overflow;  // provides larger external buffers, or NULL
+    void *overflow_arg;     // the argument of overflow
     size_t buf_size;
     size_t used_size;
     ui8 *buf;
     ui8 *cur_ptr;
   };
 
+  //*************************************************************************/
+  /**  @brief stream_outfile writes j2k codestreams to a file descriptor,
+   *         such as that of the standard output or of a pipe
+   *
+   *  Data are collected in a large buffer, which is written with few
+   *  system calls; the stream is not seekable.  The file descriptor is
+   *  not owned by this object; close() writes the buffered data without
+   *  closing the descriptor, and the object can be opened again.
+   */
+  class OJPH_EXPORT stream_outfile : public outfile_base
+  {
+  public:
+    /**  A constructor */
+    stream_outfile() { fd = -1; buf = NULL; buf_size = used = 0; written = 0; }
+    /**  A destructor; buffered data are written, ignoring errors */
+    ~stream_outfile() override;
+
+    /**
+     *  @brief Call this function to start writing to a file descriptor
+     *
+     *  On Windows, the descriptor is switched to binary mode.
+     *
+     *  @param fd is an open file descriptor; 1 is the standard output.
+     *  @param buffer_size is the size of the buffer, 1MB by default.
+     */
+    void open(int fd, size_t buffer_size = 1 << 20);
+    size_t write(const void *ptr, size_t size) override;
+    si64 tell() override { return written + (si64)used; }
+    void flush() override;
+    void close() override;
+
+  private:
+    int fd;
+    ui8 *buf;
+    size_t buf_size;
+    size_t used;       // bytes in buf
+    si64 written;      // bytes written to fd
+  };
+
   ////////////////////////////////////////////////////////////////////////////
   class OJPH_EXPORT infile_base
   {
@@ -288,6 +434,66 @@ namespace ojph {
     size_t size;
   };
 
+  //*************************************************************************/
+  /**  @brief stream_infile reads j2k codestreams from a file descriptor,
+   *         such as that of the standard input or of a pipe
+   *
+   *  Data are read in large chunks into a buffer.  Since the stream
+   *  cannot be seeked, forward seeks skip data, and backward seeks are 
+   *  limited to the data still in the buffer, which always includes the
+   *  last few bytes read; this is all that the codestream parser needs.
+   *  eof() returns true only after all the data of the stream are read, 
+   *  so that the codestreams of a stream that holds many, one after 
+   *  another, can be read until eof() is true.  
+   * 
+   *  The file descriptor is not owned by this object, and close() does 
+   *  nothing; this allows each codestream of a stream to be read, and
+   *  closed, by its own codestream object.
+   */
+  class OJPH_EXPORT stream_infile : public infile_base
+  {
+  public:
+    /**  A constructor */
+    stream_infile()
+    { fd = -1; buf = NULL; buf_size = cur = avail = 0; buf_start = 0; }
+    /**  A destructor */
+    ~stream_infile() override { if (buf) free(buf); }
+
+    /**
+     *  @brief Call this function to start reading from a file descriptor
+     *
+     *  On Windows, the descriptor is switched to binary mode.
+     *
+     *  @param fd is an open file descriptor; 0 is the standard input.
+     *  @param buffer_size is the size of the buffer, 1MB by default.
+     */
+    void open(int fd, size_t buffer_size = 1 << 20);
+
+    //read reads size bytes, returns the number of bytes read
+    size_t read(void *ptr, size_t size) override;
+    //seek returns 0 on success; SEEK_END is not supported
+    int seek(si64 offset, enum infile_base::seek origin) override;
+    si64 tell() override { return buf_start + (si64)cur; }
+    bool eof() override { return cur == avail && !fill(); }
+    void close() override {}
+
+  private:
+    /**
+     *  @brief reads more data into the buffer, which must be consumed
+     *
+     *  @return false at the end of the stream
+     */
+    bool fill();
+
+  private:
+    int fd;
+    ui8 *buf;
+    size_t buf_size;
+    size_t cur;        // read position in buf
+    size_t avail;      // bytes in buf
+    si64 buf_start;    // stream position of buf[0]
+  };
+
 
 }
 
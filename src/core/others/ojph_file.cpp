@@ -41,13 +41,65 @@
  */
 
 #include <cassert>
+#include <cerrno>
 #include <cstddef>
 
 #include "ojph_file.h"
 #include "ojph_message.h"
 
+#ifdef OJPH_OS_WINDOWS
+  #include <fcntl.h>
+  #include <io.h>
+#else
+  #include <climits>
+  #include <sys/uio.h>
+  #include <unistd.h>
+#endif
+
 namespace ojph {
 
+  ////////////////////////////////////////////////////////////////////////////
+  // reads up to size bytes from fd, retrying when interrupted; returns 
+  // the number of bytes read, 0 at the end of the stream, or -1 on error
+  static
+  si64 read_fd(int fd, void *ptr, size_t size)
+  {
+    while (true)
+    {
+#ifdef OJPH_OS_WINDOWS
+      int bytes = _read(fd, ptr, (unsigned)ojph_min(size, (size_t)1 << 30));
+#else
+      ssize_t bytes = ::read(fd, ptr, size);
+#endif
+      if (bytes >= 0 || errno != EINTR)
+        return (si64)bytes;
+    }
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  // writes size bytes to fd, which can take many calls for a pipe; 
+  // returns false on error
+  static
+  bool write_fd(int fd, const void *ptr, size_t size)
+  {
+    const ui8 *p = (const ui8 *)ptr;
+    while (size > 0)
+    {
+#ifdef OJPH_OS_WINDOWS
+      int bytes = _write(fd, p, (unsigned)ojph_min(size, (size_t)1 << 30));
+#else
+      ssize_t bytes = ::write(fd, p, size);
+#endif
+      if (bytes < 0 && errno == EINTR)
+        continue;
+      if (bytes <= 0)
+        return false;
+      p += bytes;
+      size -= (size_t)bytes;
+    }
+    return true;
+  }
+
   ////////////////////////////////////////////////////////////////////////////
   //
   //
@@ -72,6 +124,70 @@ namespace ojph {
     return fwrite(ptr, 1, size, fh);
   }
 
+  ////////////////////////////////////////////////////////////////////////////
+  size_t j2c_outfile::write_vec(const io_vec *vecs, ui32 count)
+  {
+    assert(fh);
+#ifdef OJPH_OS_WINDOWS
+    return outfile_base::write_vec(vecs, count);
+#else
+  #ifdef IOV_MAX
+    const int max_iovs = ojph_min(IOV_MAX, 1024);
+  #else
+    const int max_iovs = 16; // the smallest IOV_MAX allowed by POSIX
+  #endif
+    // data buffered by stdio go first
+    if (fflush(fh) != 0)
+      return 0;
+    int fd = fileno(fh);
+
+    struct iovec iovs[1024];
+    size_t total = 0;
+    bool success = true;
+    ui32 i = 0;
+    while (i < count && success)
+    {
+      int num_iovs = 0;
+      for (; i < count && num_iovs < max_iovs; ++i)
+        if (vecs[i].size > 0)
+        {
+          iovs[num_iovs].iov_base = (void*)vecs[i].ptr;
+          iovs[num_iovs].iov_len = vecs[i].size;
+          ++num_iovs;
+        }
+
+      // a partial write continues from where it stopped
+      int first = 0;
+      while (first < num_iovs)
+      {
+        ssize_t bytes = ::writev(fd, iovs + first, num_iovs - first);
+        if (bytes < 0 && errno == EINTR)
+          continue;
+        if (bytes <= 0)
+        {
+          success = false;
+          break;
+        }
+        total += (size_t)bytes;
+        size_t b = (size_t)bytes;
+        while (first < num_iovs && b >= iovs[first].iov_len)
+          b -= iovs[first++].iov_len;
+        if (first < num_iovs)
+        {
+          iovs[first].iov_base = (ui8*)iovs[first].iov_base + b;
+          iovs[first].iov_len -= b;
+        }
+      }
+    }
+
+    // stdio keeps its own copy of the file position, which is updated
+    off_t pos = lseek(fd, 0, SEEK_CUR);
+    if (pos >= 0)
+      ojph_fseek(fh, (si64)pos, SEEK_SET);
+    return total;
+#endif
+  }
+
   ////////////////////////////////////////////////////////////////////////////
   si64 j2c_outfile::tell()
   {
@@ -101,7 +217,9 @@ namespace ojph {
   /**  */
   mem_outfile::mem_outfile()
   {
-    is_open = clear_mem = false;
+    is_open = clear_mem = external = false;
+    overflow = NULL;
+    overflow_arg = NULL;
     buf_size = used_size = 0;
     buf = cur_ptr = NULL;
   }
@@ -109,9 +227,9 @@ namespace ojph {
   /**  */
   mem_outfile::~mem_outfile()
   {
-    if (buf)
+    if (buf && !external)
       free(buf);
-    is_open = clear_mem = false;
+    is_open = clear_mem = external = false;
     buf_size = used_size = 0;
     buf = cur_ptr = NULL;
   }
@@ -122,6 +240,13 @@ namespace ojph {
     assert(this->is_open == false);
     assert(this->cur_ptr == this->buf);
 
+    if (this->external)
+    { // stop using the caller's buffer
+      this->external = false;
+      this->buf = this->cur_ptr = NULL;
+      this->buf_size = 0;
+    }
+
     // do initial buffer allocation or buffer expansion
     this->is_open = true;
     this->clear_mem = clear_mem;
@@ -130,6 +255,27 @@ namespace ojph {
     this->cur_ptr = this->buf;
   }
 
+  /**  */
+  void mem_outfile::open(void *buffer, size_t size, overflow_fun overflow,
+                         void *arg)
+  {
+    assert(this->is_open == false);
+    assert(this->cur_ptr == this->buf);
+    assert(buffer != NULL || size == 0);
+
+    if (this->buf && !this->external)
+      free(this->buf);
+
+    this->is_open = true;
+    this->clear_mem = false;
+    this->external = true;
+    this->overflow = overflow;
+    this->overflow_arg = arg;
+    this->buf = this->cur_ptr = (ui8*)buffer;
+    this->buf_size = size;
+    this->used_size = 0;
+  }
+
   /**  */
   void mem_outfile::close() {
     is_open = false;
@@ -182,6 +328,36 @@ namespace ojph {
     return new_size;
   }
 
+  /** The buffer is expanded once for all pieces
+   */
+  size_t mem_outfile::write_vec(const io_vec *vecs, ui32 count)
+  {
+    assert(this->is_open);
+
+    size_t total = 0;
+    for (ui32 i = 0; i < count; ++i)
+      total += vecs[i].size;
+    expand_storage((size_t)tell() + total, false);
+
+    for (ui32 i = 0; i < count; ++i)
+    {
+      memcpy(this->cur_ptr, vecs[i].ptr, vecs[i].size);
+      cur_ptr += vecs[i].size;
+    }
+    used_size = ojph_max(used_size, (size_t)tell());
+
+    return total;
+  }
+
+  /** The buffer is expanded once, so that the writes that follow do not
+   *  need to expand it
+   */
+  void mem_outfile::reserve(size_t num_bytes)
+  {
+    assert(this->is_open);
+    expand_storage((size_t)tell() + num_bytes, false);
+  }
+
   /** */
   void mem_outfile::write_to_file(const char *file_name) const
   {
@@ -198,6 +374,12 @@ namespace ojph {
   /** */
   void mem_outfile::expand_storage(size_t needed_size, bool clear_all)
   {
+    if (external)
+    { // the caller's buffer is used as is, until it is too small
+      if (needed_size > buf_size)
+        expand_external(needed_size);
+      return;
+    }
     needed_size += (needed_size + 1) >> 1; // x1.5
     if (needed_size > buf_size)
     {
@@ -218,6 +400,116 @@ namespace ojph {
       memset(this->buf, 0, this->buf_size);
   }
 
+  /** */
+  void mem_outfile::expand_external(size_t needed_size)
+  {
+    si64 cur_pos = tell(); // current write position
+    ui8 *new_buf;
+    size_t new_size = 0;
+    if (overflow)
+    {
+      new_buf = (ui8*)overflow(overflow_arg, buf, needed_size, &new_size);
+      if (new_buf == NULL || new_size < needed_size)
+        OJPH_ERROR(0x0006000A, "failed to obtain a buffer of %zu bytes "
+          "for the memory file", needed_size);
+    }
+    else
+    { // move data to memory owned by this object
+      new_size = needed_size + ((needed_size + 1) >> 1); // x1.5
+      new_buf = (ui8*)malloc(new_size);
+      if (new_buf == NULL)
+        OJPH_ERROR(0x0006000B, "failed to allocate %zu bytes for the "
+          "memory file", new_size);
+      if (this->used_size)
+        memcpy(new_buf, this->buf, this->used_size);
+      external = false;
+    }
+    this->buf = new_buf;
+    this->buf_size = new_size;
+    this->cur_ptr = this->buf + cur_pos;
+  }
+
+
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  //
+  //
+  //
+  //
+  ////////////////////////////////////////////////////////////////////////////
+
+  ////////////////////////////////////////////////////////////////////////////
+  stream_outfile::~stream_outfile()
+  {
+    if (buf)
+    {
+      if (fd != -1 && used > 0)
+        write_fd(fd, buf, used);
+      free(buf);
+    }
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void stream_outfile::open(int fd, size_t buffer_size)
+  {
+    assert(this->fd == -1);
+#ifdef OJPH_OS_WINDOWS
+    _setmode(fd, _O_BINARY);
+#endif
+    if (buf == NULL || buf_size != buffer_size)
+    {
+      if (buf)
+        free(buf);
+      buf_size = ojph_max(buffer_size, (size_t)1);
+      buf = (ui8*)malloc(buf_size);
+      if (buf == NULL)
+        OJPH_ERROR(0x00060005, "failed to allocate a stream buffer");
+    }
+    this->fd = fd;
+    used = 0;
+    written = 0;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  size_t stream_outfile::write(const void *ptr, size_t size)
+  {
+    assert(fd != -1);
+    if (used + size > buf_size)
+      flush();
+    if (size >= buf_size)
+    { // too large to be buffered
+      if (!write_fd(fd, ptr, size))
+        OJPH_ERROR(0x00060006, "failed writing to a stream");
+      written += (si64)size;
+    }
+    else
+    {
+      memcpy(buf + used, ptr, size);
+      used += size;
+    }
+    return size;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void stream_outfile::flush()
+  {
+    assert(fd != -1);
+    if (used > 0)
+    {
+      if (!write_fd(fd, buf, used))
+        OJPH_ERROR(0x00060007, "failed writing to a stream");
+      written += (si64)used;
+      used = 0;
+    }
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  void stream_outfile::close()
+  {
+    assert(fd != -1);
+    flush();
+    fd = -1;
+  }
 
   ////////////////////////////////////////////////////////////////////////////
   //
@@ -332,5 +624,91 @@ namespace ojph {
     return result;
   }
 
+  ////////////////////////////////////////////////////////////////////////////
+  //
+  //
+  //
+  //
+  //
+  ////////////////////////////////////////////////////////////////////////////
+
+  ////////////////////////////////////////////////////////////////////////////
+  // the number of consumed bytes kept in the buffer when it is refilled,
+  // which is the reach of backward seeks
+  static const size_t stream_history_size = 256;
+
+  ////////////////////////////////////////////////////////////////////////////
+  void stream_infile::open(int fd, size_t buffer_size)
+  {
+    assert(this->fd == -1);
+#ifdef OJPH_OS_WINDOWS
+    _setmode(fd, _O_BINARY);
+#endif
+    if (buf)
+      free(buf);
+    buf_size = ojph_max(buffer_size, 2 * stream_history_size);
+    buf = (ui8*)malloc(buf_size);
+    if (buf == NULL)
+      OJPH_ERROR(0x00060008, "failed to allocate a stream buffer");
+    this->fd = fd;
+    cur = avail = 0;
+    buf_start = 0;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  bool stream_infile::fill()
+  {
+    assert(fd != -1 && cur == avail);
+    size_t keep = ojph_min(cur, stream_history_size);
+    memmove(buf, buf + cur - keep, keep);
+    buf_start += (si64)(cur - keep);
+    cur = avail = keep;
+
+    si64 bytes = read_fd(fd, buf + avail, buf_size - avail);
+    if (bytes < 0)
+      OJPH_ERROR(0x00060009, "failed reading from a stream");
+    avail += (size_t)bytes;
+    return bytes > 0;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  size_t stream_infile::read(void *ptr, size_t size)
+  {
+    ui8 *p = (ui8 *)ptr;
+    size_t total = 0;
+    while (total < size)
+    {
+      if (cur == avail && !fill())
+        break;
+      size_t bytes = ojph_min(size - total, avail - cur);
+      memcpy(p + total, buf + cur, bytes);
+      cur += bytes;
+      total += bytes;
+    }
+    return total;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  int stream_infile::seek(si64 offset, enum infile_base::seek origin)
+  {
+    si64 target;
+    if (origin == OJPH_SEEK_SET)
+      target = offset;
+    else if (origin == OJPH_SEEK_CUR)
+      target = tell() + offset;
+    else
+      return -1;
+
+    if (target < buf_start)
+      return -1; // the data is no longer in the buffer
+    while (target > buf_start + (si64)avail)
+    { // skip buffered data
+      cur = avail;
+      if (!fill())
+        return -1;
+    }
+    cur = (size_t)(target - buf_start);
+    return 0;
+  }
 
 }
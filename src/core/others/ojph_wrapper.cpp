@@ -292,6 +292,25 @@ extern "C"
     return ;
   }
 
+  // pulls the whole image into dst; format is one of the
+  // ojph::codestream::pixel_format values, possibly or-ed with PF_PLANAR.
+  // Returns 0 on success, and -1 on failure
+  int ojph_pull_j2c_frame(j2k_struct* j2c, void* dst, int stride,
+                          int format)
+  {
+    try {
+      j2c->codestream.pull_frame(dst, (size_t)stride, (ojph::ui32)format);
+      return 0;
+    }
+    catch (const std::exception& e)
+    {
+      const char *p = e.what();
+      if (strncmp(p, "ojph error", 10) != 0)
+        printf("%s\n", p);
+    }
+    return -1;
+  }
+
   // void ojph_pull_j2c_rgb(j2k_struct* j2c, int n, uint8_t* dst, int dst_size)
   // {
   //   ojph::ui32 ncomps = 4;
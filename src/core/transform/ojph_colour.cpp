@@ -104,6 +104,65 @@ namespace ojph {
       (const float *y, const float *cb, const float *cr,
        float *r, float *g, float *b, ui32 repeat) = NULL;
 
+    //////////////////////////////////////////////////////////////////////////
+    void (*rev_convert_rct_forward)
+      (const line_buf *r, const line_buf *g, const line_buf *b,
+       ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+       si64 shift, ui32 width) = NULL;
+
+    //////////////////////////////////////////////////////////////////////////
+    void (*rct_backward_rev_convert)
+      (const line_buf *y, const line_buf *cb, const line_buf *cr,
+       line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+       si64 shift, ui32 width) = NULL;
+
+    //////////////////////////////////////////////////////////////////////////
+    void (*irv_convert_to_float_ict_forward)
+      (const line_buf *r, const line_buf *g, const line_buf *b,
+       ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+       ui32 bit_depth, bool is_signed, ui32 width) = NULL;
+
+    //////////////////////////////////////////////////////////////////////////
+    void (*ict_backward_irv_convert_to_integer)
+      (const line_buf *y, const line_buf *cb, const line_buf *cr,
+       line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+       ui32 bit_depth, bool is_signed, ui32 width) = NULL;
+
+    //////////////////////////////////////////////////////////////////////////
+    void (*deinterleave_from_ui8)
+      (const ui8 *sp, ui32 num_comps, line_buf *dst_lines,
+       si32 offset, si32 max_val, ui32 width) = NULL;
+
+    //////////////////////////////////////////////////////////////////////////
+    void (*deinterleave_from_ui16)
+      (const ui16 *sp, ui32 num_comps, line_buf *dst_lines,
+       si32 offset, si32 max_val, ui32 width) = NULL;
+
+    //////////////////////////////////////////////////////////////////////////
+    void (*deinterleave_from_float)
+      (const float *sp, ui32 num_comps, line_buf *dst_lines,
+       float mul, si32 low, si32 high, ui32 width) = NULL;
+
+    //////////////////////////////////////////////////////////////////////////
+    void (*deinterleave_from_half)
+      (const ui16 *sp, ui32 num_comps, line_buf *dst_lines,
+       float mul, si32 low, si32 high, ui32 width) = NULL;
+
+    //////////////////////////////////////////////////////////////////////////
+    void (*interleave_to_ui8)
+      (const line_buf *src_lines, ui32 num_comps, ui8 *dp,
+       si32 offset, si32 max_val, ui32 width) = NULL;
+
+    //////////////////////////////////////////////////////////////////////////
+    void (*interleave_to_ui16)
+      (const line_buf *src_lines, ui32 num_comps, ui16 *dp,
+       si32 offset, si32 max_val, ui32 width) = NULL;
+
+    //////////////////////////////////////////////////////////////////////////
+    void (*interleave_to_float)
+      (const line_buf *src_lines, ui32 num_comps, float *dp,
+       float mul, ui32 width) = NULL;
+
     //////////////////////////////////////////////////////////////////////////
     static bool colour_transform_functions_initialized = false;
 
@@ -113,6 +172,15 @@ namespace ojph {
       if (colour_transform_functions_initialized)
         return;
 
+      // these generic functions are also used with WASM SIMD
+      deinterleave_from_ui8 = gen_deinterleave_from_ui8;
+      deinterleave_from_ui16 = gen_deinterleave_from_ui16;
+      deinterleave_from_float = gen_deinterleave_from_float;
+      deinterleave_from_half = gen_deinterleave_from_half;
+      interleave_to_ui8 = gen_interleave_to_ui8;
+      interleave_to_ui16 = gen_interleave_to_ui16;
+      interleave_to_float = gen_interleave_to_float;
+
 #if !defined(OJPH_ENABLE_WASM_SIMD) || !defined(OJPH_EMSCRIPTEN)
 
       rev_convert = gen_rev_convert;
@@ -125,6 +193,11 @@ namespace ojph {
       rct_backward = gen_rct_backward;
       ict_forward = gen_ict_forward;
       ict_backward = gen_ict_backward;
+      rev_convert_rct_forward = gen_rev_convert_rct_forward;
+      rct_backward_rev_convert = gen_rct_backward_rev_convert;
+      irv_convert_to_float_ict_forward = gen_irv_convert_to_float_ict_forward;
+      ict_backward_irv_convert_to_integer =
+        gen_ict_backward_irv_convert_to_integer;
 
   #ifndef OJPH_DISABLE_SIMD
 
@@ -151,6 +224,12 @@ namespace ojph {
             sse2_irv_convert_to_float_nlt_type3;
           rct_forward = sse2_rct_forward;
           rct_backward = sse2_rct_backward;
+          rev_convert_rct_forward = sse2_rev_convert_rct_forward;
+          rct_backward_rev_convert = sse2_rct_backward_rev_convert;
+          irv_convert_to_float_ict_forward =
+            sse2_irv_convert_to_float_ict_forward;
+          ict_backward_irv_convert_to_integer =
+            sse2_ict_backward_irv_convert_to_integer;
         }
       #endif // !OJPH_DISABLE_SSE2
 
@@ -175,6 +254,19 @@ namespace ojph {
             avx2_irv_convert_to_float_nlt_type3;
           rct_forward = avx2_rct_forward;
           rct_backward = avx2_rct_backward;
+          rev_convert_rct_forward = avx2_rev_convert_rct_forward;
+          rct_backward_rev_convert = avx2_rct_backward_rev_convert;
+          irv_convert_to_float_ict_forward =
+            avx2_irv_convert_to_float_ict_forward;
+          ict_backward_irv_convert_to_integer =
+            avx2_ict_backward_irv_convert_to_integer;
+          deinterleave_from_ui8 = avx2_deinterleave_from_ui8;
+          deinterleave_from_ui16 = avx2_deinterleave_from_ui16;
+          deinterleave_from_float = avx2_deinterleave_from_float;
+          deinterleave_from_half = avx2_deinterleave_from_half;
+          interleave_to_ui8 = avx2_interleave_to_ui8;
+          interleave_to_ui16 = avx2_interleave_to_ui16;
+          interleave_to_float = avx2_interleave_to_float;
         }
       #endif // !OJPH_DISABLE_AVX2
 
@@ -196,6 +288,11 @@ namespace ojph {
       rct_backward = wasm_rct_backward;
       ict_forward = wasm_ict_forward;
       ict_backward = wasm_ict_backward;
+      rev_convert_rct_forward = wasm_rev_convert_rct_forward;
+      rct_backward_rev_convert = wasm_rct_backward_rev_convert;
+      irv_convert_to_float_ict_forward = wasm_irv_convert_to_float_ict_forward;
+      ict_backward_irv_convert_to_integer =
+        wasm_ict_backward_irv_convert_to_integer;
 
 #endif // !OJPH_ENABLE_WASM_SIMD
 
@@ -552,7 +649,302 @@ namespace ojph {
       }
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void gen_rev_convert_rct_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      si64 shift, ui32 width)
+    {
+      assert((r->flags  & line_buf::LFT_32BIT) &&
+             (g->flags  & line_buf::LFT_32BIT) &&
+             (b->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_INTEGER) &&
+             (cb->flags & line_buf::LFT_32BIT) &&
+             (cb->flags & line_buf::LFT_INTEGER) &&
+             (cr->flags & line_buf::LFT_32BIT) &&
+             (cr->flags & line_buf::LFT_INTEGER));
+      const si32 *rp = r->i32 + src_line_offset;
+      const si32 *gp = g->i32 + src_line_offset;
+      const si32 *bp = b->i32 + src_line_offset;
+      si32 *yp = y->i32, *cbp = cb->i32, *crp = cr->i32;
+      si32 s = (si32)shift;
+      for (ui32 i = width; i > 0; --i)
+      {
+        si32 rr = *rp++ + s, gg = *gp++ + s, bb = *bp++ + s;
+        *yp++ = (rr + (gg << 1) + bb) >> 2;
+        *cbp++ = (bb - gg);
+        *crp++ = (rr - gg);
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_rct_backward_rev_convert(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      si64 shift, ui32 width)
+    {
+      assert((y->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_INTEGER) &&
+             (cb->flags & line_buf::LFT_32BIT) &&
+             (cb->flags & line_buf::LFT_INTEGER) &&
+             (cr->flags & line_buf::LFT_32BIT) &&
+             (cr->flags & line_buf::LFT_INTEGER) &&
+             (r->flags  & line_buf::LFT_32BIT) &&
+             (g->flags  & line_buf::LFT_32BIT) &&
+             (b->flags  & line_buf::LFT_32BIT));
+      const si32 *yp = y->i32, *cbp = cb->i32, *crp = cr->i32;
+      si32 *rp = r->i32 + dst_line_offset;
+      si32 *gp = g->i32 + dst_line_offset;
+      si32 *bp = b->i32 + dst_line_offset;
+      si32 s = (si32)shift;
+      for (ui32 i = width; i > 0; --i)
+      {
+        si32 yy = *yp++, cbb = *cbp++, crr = *crp++;
+        si32 gg = yy - ((cbb + crr) >> 2);
+        *rp++ = crr + gg + s;
+        *gp++ = gg + s;
+        *bp++ = cbb + gg + s;
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_irv_convert_to_float_ict_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      ui32 bit_depth, bool is_signed, ui32 width)
+    {
+      assert((r->flags  & line_buf::LFT_32BIT) &&
+             (r->flags  & line_buf::LFT_INTEGER) &&
+             (g->flags  & line_buf::LFT_32BIT) &&
+             (g->flags  & line_buf::LFT_INTEGER) &&
+             (b->flags  & line_buf::LFT_32BIT) &&
+             (b->flags  & line_buf::LFT_INTEGER) &&
+             (y->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_INTEGER) == 0 &&
+             (cb->flags & line_buf::LFT_32BIT) &&
+             (cb->flags & line_buf::LFT_INTEGER) == 0 &&
+             (cr->flags & line_buf::LFT_32BIT) &&
+             (cr->flags & line_buf::LFT_INTEGER) == 0);
+
+      assert(bit_depth <= 32);
+      float mul = (float)(1.0 / (double)(1ULL << bit_depth));
+      const si32 half = is_signed ? 0 : (si32)(1ULL << (bit_depth - 1));
+
+      const si32 *rp = r->i32 + src_line_offset;
+      const si32 *gp = g->i32 + src_line_offset;
+      const si32 *bp = b->i32 + src_line_offset;
+      float *yp = y->f32, *cbp = cb->f32, *crp = cr->f32;
+      for (ui32 i = width; i > 0; --i)
+      {
+        float rr = (float)(*rp++ - half) * mul;
+        float gg = (float)(*gp++ - half) * mul;
+        float bb = (float)(*bp++ - half) * mul;
+        float yy = CT_CNST::ALPHA_RF * rr
+                 + CT_CNST::ALPHA_GF * gg
+                 + CT_CNST::ALPHA_BF * bb;
+        *yp++ = yy;
+        *cbp++ = CT_CNST::BETA_CbF * (bb - yy);
+        *crp++ = CT_CNST::BETA_CrF * (rr - yy);
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    static inline
+    si32 gen_cnvrt_float_to_limited_si32(float t, float fl_low_lim,
+      float fl_up_lim, si32 s32_low_lim, si32 s32_up_lim)
+    {
+      si32 v = ojph_round(t);
+      v = t >= fl_low_lim ? v : s32_low_lim;
+      v = t <  fl_up_lim  ? v : s32_up_lim;
+      return v;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_ict_backward_irv_convert_to_integer(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      ui32 bit_depth, bool is_signed, ui32 width)
+    {
+      assert((y->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_INTEGER) == 0 &&
+             (cb->flags & line_buf::LFT_32BIT) &&
+             (cb->flags & line_buf::LFT_INTEGER) == 0 &&
+             (cr->flags & line_buf::LFT_32BIT) &&
+             (cr->flags & line_buf::LFT_INTEGER) == 0 &&
+             (r->flags  & line_buf::LFT_32BIT) &&
+             (r->flags  & line_buf::LFT_INTEGER) &&
+             (g->flags  & line_buf::LFT_32BIT) &&
+             (g->flags  & line_buf::LFT_INTEGER) &&
+             (b->flags  & line_buf::LFT_32BIT) &&
+             (b->flags  & line_buf::LFT_INTEGER));
+
+      assert(bit_depth <= 32);
+      // see local_gen_irv_convert_to_integer for an explanation of limits
+      si32 neg_limit = (si32)INT_MIN >> (32 - bit_depth);
+      float mul = (float)(1ull << bit_depth);
+      float fl_up_lim = -(float)neg_limit; // val < upper
+      float fl_low_lim = (float)neg_limit; // val >= lower
+      si32 s32_up_lim = INT_MAX >> (32 - bit_depth);
+      si32 s32_low_lim = INT_MIN >> (32 - bit_depth);
+      const si32 half = is_signed ? 0 : (si32)(1ULL << (bit_depth - 1));
+
+      const float *yp = y->f32, *cbp = cb->f32, *crp = cr->f32;
+      si32 *rp = r->i32 + dst_line_offset;
+      si32 *gp = g->i32 + dst_line_offset;
+      si32 *bp = b->i32 + dst_line_offset;
+      for (ui32 i = width; i > 0; --i)
+      {
+        float yy = *yp++, cbb = *cbp++, crr = *crp++;
+        float gg = yy - CT_CNST::GAMMA_CR2G * crr - CT_CNST::GAMMA_CB2G * cbb;
+        float rr = yy + CT_CNST::GAMMA_CR2R * crr;
+        float bb = yy + CT_CNST::GAMMA_CB2B * cbb;
+        *rp++ = gen_cnvrt_float_to_limited_si32(rr * mul, fl_low_lim,
+          fl_up_lim, s32_low_lim, s32_up_lim) + half;
+        *gp++ = gen_cnvrt_float_to_limited_si32(gg * mul, fl_low_lim,
+          fl_up_lim, s32_low_lim, s32_up_lim) + half;
+        *bp++ = gen_cnvrt_float_to_limited_si32(bb * mul, fl_low_lim,
+          fl_up_lim, s32_low_lim, s32_up_lim) + half;
+      }
+    }
+
 #endif // !OJPH_ENABLE_WASM_SIMD
 
+    //////////////////////////////////////////////////////////////////////////
+    void gen_deinterleave_from_ui8(
+      const ui8 *sp, ui32 num_comps, line_buf *dst_lines,
+      si32 offset, si32 max_val, ui32 width)
+    {
+      for (ui32 c = 0; c < num_comps; ++c)
+      {
+        const ui8 *p = sp + c;
+        si32 *dp = dst_lines[c].i32;
+        for (ui32 i = width; i > 0; --i, p += num_comps)
+        {
+          si32 v = *p;
+          *dp++ = (v <= max_val ? v : max_val) - offset;
+        }
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_deinterleave_from_ui16(
+      const ui16 *sp, ui32 num_comps, line_buf *dst_lines,
+      si32 offset, si32 max_val, ui32 width)
+    {
+      for (ui32 c = 0; c < num_comps; ++c)
+      {
+        const ui16 *p = sp + c;
+        si32 *dp = dst_lines[c].i32;
+        for (ui32 i = width; i > 0; --i, p += num_comps)
+        {
+          si32 v = *p;
+          *dp++ = (v <= max_val ? v : max_val) - offset;
+        }
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    static inline
+    si32 gen_cnvrt_to_clamped_si32(float t, float mul, si32 low, si32 high)
+    {
+      t *= mul;
+      // a NaN fails the first comparison, and is converted to high
+      t = t <= (float)high ? t : (float)high;
+      t = t >= (float)low ? t : (float)low;
+      return ojph_round(t);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_deinterleave_from_float(
+      const float *sp, ui32 num_comps, line_buf *dst_lines,
+      float mul, si32 low, si32 high, ui32 width)
+    {
+      for (ui32 c = 0; c < num_comps; ++c)
+      {
+        const float *p = sp + c;
+        si32 *dp = dst_lines[c].i32;
+        for (ui32 i = width; i > 0; --i, p += num_comps)
+          *dp++ = gen_cnvrt_to_clamped_si32(*p, mul, low, high);
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_deinterleave_from_half(
+      const ui16 *sp, ui32 num_comps, line_buf *dst_lines,
+      float mul, si32 low, si32 high, ui32 width)
+    {
+      // the exponent and mantissa of a half are moved to those of a float,
+      // which is then rescaled by 2^(127 - 15); this also handles 
+      // subnormals, while infinities become large finite values
+      union { ui32 u; float f; } scale, t;
+      scale.u = 0x77800000;  // 2^112
+      for (ui32 c = 0; c < num_comps; ++c)
+      {
+        const ui16 *p = sp + c;
+        si32 *dp = dst_lines[c].i32;
+        for (ui32 i = width; i > 0; --i, p += num_comps)
+        {
+          ui32 h = *p;
+          t.u = (h & 0x7FFF) << 13;
+          t.f *= scale.f;
+          t.u |= (h & 0x8000) << 16;
+          *dp++ = gen_cnvrt_to_clamped_si32(t.f, mul, low, high);
+        }
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_interleave_to_ui8(
+      const line_buf *src_lines, ui32 num_comps, ui8 *dp,
+      si32 offset, si32 max_val, ui32 width)
+    {
+      for (ui32 c = 0; c < num_comps; ++c)
+      {
+        const si32 *sp = src_lines[c].i32;
+        ui8 *p = dp + c;
+        for (ui32 i = width; i > 0; --i, p += num_comps)
+        {
+          si32 v = *sp++ + offset;
+          v = v >= 0 ? v : 0;
+          v = v <= max_val ? v : max_val;
+          *p = (ui8)v;
+        }
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_interleave_to_ui16(
+      const line_buf *src_lines, ui32 num_comps, ui16 *dp,
+      si32 offset, si32 max_val, ui32 width)
+    {
+      for (ui32 c = 0; c < num_comps; ++c)
+      {
+        const si32 *sp = src_lines[c].i32;
+        ui16 *p = dp + c;
+        for (ui32 i = width; i > 0; --i, p += num_comps)
+        {
+          si32 v = *sp++ + offset;
+          v = v >= 0 ? v : 0;
+          v = v <= max_val ? v : max_val;
+          *p = (ui16)v;
+        }
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_interleave_to_float(
+      const line_buf *src_lines, ui32 num_comps, float *dp,
+      float mul, ui32 width)
+    {
+      for (ui32 c = 0; c < num_comps; ++c)
+      {
+        const si32 *sp = src_lines[c].i32;
+        float *p = dp + c;
+        for (ui32 i = width; i > 0; --i, p += num_comps)
+          *p = (float)*sp++ * mul;
+      }
+    }
+
   }
 }
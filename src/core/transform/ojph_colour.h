@@ -101,6 +101,84 @@ namespace ojph {
   extern void (*ict_backward)
     (const float *y, const float *cb, const float *cr,
      float *r, float *g, float *b, ui32 repeat);
+
+  ////////////////////////////////////////////////////////////////////////////
+  // The following functions fuse sample conversion (level shifting) with
+  // the colour transform, so that the first three components are
+  // processed in one pass over memory.  They apply only when the three
+  // components share bit depth and signedness, have no type 3 NLT, and
+  // when tile-component lines are 32 bits wide.
+  ////////////////////////////////////////////////////////////////////////////
+  extern void (*rev_convert_rct_forward)
+    (const line_buf *r, const line_buf *g, const line_buf *b,
+     ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+     si64 shift, ui32 width);
+
+  ////////////////////////////////////////////////////////////////////////////
+  extern void (*rct_backward_rev_convert)
+    (const line_buf *y, const line_buf *cb, const line_buf *cr,
+     line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+     si64 shift, ui32 width);
+
+  ////////////////////////////////////////////////////////////////////////////
+  extern void (*irv_convert_to_float_ict_forward)
+    (const line_buf *r, const line_buf *g, const line_buf *b,
+     ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+     ui32 bit_depth, bool is_signed, ui32 width);
+
+  ////////////////////////////////////////////////////////////////////////////
+  extern void (*ict_backward_irv_convert_to_integer)
+    (const line_buf *y, const line_buf *cb, const line_buf *cr,
+     line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+     ui32 bit_depth, bool is_signed, ui32 width);
+
+  ////////////////////////////////////////////////////////////////////////////
+  // The following functions fill num_comps consecutive lines of 32-bit 
+  // integer samples from one row of codestream::push_frame() input; 
+  // sample i of line c is read from sp[i * num_comps + c].  Integer inputs
+  // are clamped to [0, max_val] before offset is subtracted, while float
+  // inputs, including half-precision ones, are multiplied by mul, rounded,
+  // and clamped to [low, high].
+  ////////////////////////////////////////////////////////////////////////////
+  extern void (*deinterleave_from_ui8)
+    (const ui8 *sp, ui32 num_comps, line_buf *dst_lines,
+     si32 offset, si32 max_val, ui32 width);
+
+  ////////////////////////////////////////////////////////////////////////////
+  extern void (*deinterleave_from_ui16)
+    (const ui16 *sp, ui32 num_comps, line_buf *dst_lines,
+     si32 offset, si32 max_val, ui32 width);
+
+  ////////////////////////////////////////////////////////////////////////////
+  extern void (*deinterleave_from_float)
+    (const float *sp, ui32 num_comps, line_buf *dst_lines,
+     float mul, si32 low, si32 high, ui32 width);
+
+  ////////////////////////////////////////////////////////////////////////////
+  extern void (*deinterleave_from_half)
+    (const ui16 *sp, ui32 num_comps, line_buf *dst_lines,
+     float mul, si32 low, si32 high, ui32 width);
+
+  ////////////////////////////////////////////////////////////////////////////
+  // The following functions write one row of codestream::pull_frame()
+  // output from num_comps consecutive lines of 32-bit integer samples;
+  // sample i of line c is written to dp[i * num_comps + c].  Integer
+  // outputs add offset to samples and clamp them to [0, max_val], while
+  // float output multiplies them by mul.
+  ////////////////////////////////////////////////////////////////////////////
+  extern void (*interleave_to_ui8)
+    (const line_buf *src_lines, ui32 num_comps, ui8 *dp,
+     si32 offset, si32 max_val, ui32 width);
+
+  ////////////////////////////////////////////////////////////////////////////
+  extern void (*interleave_to_ui16)
+    (const line_buf *src_lines, ui32 num_comps, ui16 *dp,
+     si32 offset, si32 max_val, ui32 width);
+
+  ////////////////////////////////////////////////////////////////////////////
+  extern void (*interleave_to_float)
+    (const line_buf *src_lines, ui32 num_comps, float *dp,
+     float mul, ui32 width);
   }
 }
 
@@ -44,6 +44,7 @@
 #include "ojph_defs.h"
 #include "ojph_mem.h"
 #include "ojph_colour.h"
+#include "ojph_colour_local.h"
 
 #include <immintrin.h>
 
@@ -617,6 +618,725 @@ namespace ojph {
       }
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_rev_convert_rct_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      si64 shift, ui32 width)
+    {
+      assert((r->flags  & line_buf::LFT_32BIT) &&
+             (g->flags  & line_buf::LFT_32BIT) &&
+             (b->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_INTEGER) &&
+             (cb->flags & line_buf::LFT_32BIT) &&
+             (cb->flags & line_buf::LFT_INTEGER) &&
+             (cr->flags & line_buf::LFT_32BIT) &&
+             (cr->flags & line_buf::LFT_INTEGER));
+      const si32 *rp = r->i32 + src_line_offset;
+      const si32 *gp = g->i32 + src_line_offset;
+      const si32 *bp = b->i32 + src_line_offset;
+      si32 *yp = y->i32, *cbp = cb->i32, *crp = cr->i32;
+      __m256i sh = _mm256_set1_epi32((si32)shift);
+      for (int i = (width + 7) >> 3; i > 0; --i)
+      {
+        __m256i mr = _mm256_add_epi32(_mm256_loadu_si256((__m256i*)rp), sh);
+        __m256i mg = _mm256_add_epi32(_mm256_loadu_si256((__m256i*)gp), sh);
+        __m256i mb = _mm256_add_epi32(_mm256_loadu_si256((__m256i*)bp), sh);
+        __m256i t = _mm256_add_epi32(mr, mb);
+        t = _mm256_add_epi32(t, _mm256_slli_epi32(mg, 1));
+        _mm256_store_si256((__m256i*)yp, _mm256_srai_epi32(t, 2));
+        t = _mm256_sub_epi32(mb, mg);
+        _mm256_store_si256((__m256i*)cbp, t);
+        t = _mm256_sub_epi32(mr, mg);
+        _mm256_store_si256((__m256i*)crp, t);
+
+        rp += 8; gp += 8; bp += 8;
+        yp += 8; cbp += 8; crp += 8;
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_rct_backward_rev_convert(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      si64 shift, ui32 width)
+    {
+      assert((y->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_INTEGER) &&
+             (cb->flags & line_buf::LFT_32BIT) &&
+             (cb->flags & line_buf::LFT_INTEGER) &&
+             (cr->flags & line_buf::LFT_32BIT) &&
+             (cr->flags & line_buf::LFT_INTEGER) &&
+             (r->flags  & line_buf::LFT_32BIT) &&
+             (g->flags  & line_buf::LFT_32BIT) &&
+             (b->flags  & line_buf::LFT_32BIT));
+      const si32 *yp = y->i32, *cbp = cb->i32, *crp = cr->i32;
+      si32 *rp = r->i32 + dst_line_offset;
+      si32 *gp = g->i32 + dst_line_offset;
+      si32 *bp = b->i32 + dst_line_offset;
+      __m256i sh = _mm256_set1_epi32((si32)shift);
+      for (int i = (width + 7) >> 3; i > 0; --i)
+      {
+        __m256i my  = _mm256_load_si256((__m256i*)yp);
+        __m256i mcb = _mm256_load_si256((__m256i*)cbp);
+        __m256i mcr = _mm256_load_si256((__m256i*)crp);
+
+        __m256i t = _mm256_add_epi32(mcb, mcr);
+        t = _mm256_sub_epi32(my, _mm256_srai_epi32(t, 2));
+        __m256i u = _mm256_add_epi32(mcb, t);
+        _mm256_storeu_si256((__m256i*)bp, _mm256_add_epi32(u, sh));
+        u = _mm256_add_epi32(mcr, t);
+        _mm256_storeu_si256((__m256i*)rp, _mm256_add_epi32(u, sh));
+        _mm256_storeu_si256((__m256i*)gp, _mm256_add_epi32(t, sh));
+
+        yp += 8; cbp += 8; crp += 8;
+        rp += 8; gp += 8; bp += 8;
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_irv_convert_to_float_ict_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      ui32 bit_depth, bool is_signed, ui32 width)
+    {
+      assert((r->flags  & line_buf::LFT_32BIT) &&
+             (r->flags  & line_buf::LFT_INTEGER) &&
+             (g->flags  & line_buf::LFT_32BIT) &&
+             (g->flags  & line_buf::LFT_INTEGER) &&
+             (b->flags  & line_buf::LFT_32BIT) &&
+             (b->flags  & line_buf::LFT_INTEGER) &&
+             (y->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_INTEGER) == 0 &&
+             (cb->flags & line_buf::LFT_32BIT) &&
+             (cb->flags & line_buf::LFT_INTEGER) == 0 &&
+             (cr->flags & line_buf::LFT_32BIT) &&
+             (cr->flags & line_buf::LFT_INTEGER) == 0);
+
+      assert(bit_depth <= 32);
+      __m256 mul = _mm256_set1_ps((float)(1.0 / (double)(1ULL << bit_depth)));
+      __m256i half = 
+        _mm256_set1_epi32(is_signed ? 0 : (si32)(1ULL << (bit_depth - 1)));
+      __m256 alpha_rf = _mm256_set1_ps(CT_CNST::ALPHA_RF);
+      __m256 alpha_gf = _mm256_set1_ps(CT_CNST::ALPHA_GF);
+      __m256 alpha_bf = _mm256_set1_ps(CT_CNST::ALPHA_BF);
+      __m256 beta_cbf = _mm256_set1_ps(CT_CNST::BETA_CbF);
+      __m256 beta_crf = _mm256_set1_ps(CT_CNST::BETA_CrF);
+
+      const si32 *rp = r->i32 + src_line_offset;
+      const si32 *gp = g->i32 + src_line_offset;
+      const si32 *bp = b->i32 + src_line_offset;
+      float *yp = y->f32, *cbp = cb->f32, *crp = cr->f32;
+      for (int i = (width + 7) >> 3; i > 0; --i)
+      {
+        __m256i t;
+        t = _mm256_sub_epi32(_mm256_loadu_si256((__m256i*)rp), half);
+        __m256 mr = _mm256_mul_ps(_mm256_cvtepi32_ps(t), mul);
+        t = _mm256_sub_epi32(_mm256_loadu_si256((__m256i*)gp), half);
+        __m256 mg = _mm256_mul_ps(_mm256_cvtepi32_ps(t), mul);
+        t = _mm256_sub_epi32(_mm256_loadu_si256((__m256i*)bp), half);
+        __m256 mb = _mm256_mul_ps(_mm256_cvtepi32_ps(t), mul);
+
+        __m256 my = _mm256_mul_ps(alpha_rf, mr);
+        my = _mm256_add_ps(my, _mm256_mul_ps(alpha_gf, mg));
+        my = _mm256_add_ps(my, _mm256_mul_ps(alpha_bf, mb));
+        _mm256_store_ps(yp, my);
+        _mm256_store_ps(cbp, _mm256_mul_ps(beta_cbf, _mm256_sub_ps(mb, my)));
+        _mm256_store_ps(crp, _mm256_mul_ps(beta_crf, _mm256_sub_ps(mr, my)));
+
+        rp += 8; gp += 8; bp += 8;
+        yp += 8; cbp += 8; crp += 8;
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    static inline
+    __m256i avx2_cnvrt_float_to_limited_epi32(__m256 t, 
+      __m256 fl_low_lim, __m256 fl_up_lim, 
+      __m256i s32_low_lim, __m256i s32_up_lim)
+    {
+      __m256i u = _mm256_cvtps_epi32(t);
+      u = ojph_mm256_max_ge_epi32(u, s32_low_lim, t, fl_low_lim);
+      u = ojph_mm256_min_lt_epi32(u,  s32_up_lim, t,  fl_up_lim);
+      return u;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_ict_backward_irv_convert_to_integer(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      ui32 bit_depth, bool is_signed, ui32 width)
+    {
+      assert((y->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_INTEGER) == 0 &&
+             (cb->flags & line_buf::LFT_32BIT) &&
+             (cb->flags & line_buf::LFT_INTEGER) == 0 &&
+             (cr->flags & line_buf::LFT_32BIT) &&
+             (cr->flags & line_buf::LFT_INTEGER) == 0 &&
+             (r->flags  & line_buf::LFT_32BIT) &&
+             (r->flags  & line_buf::LFT_INTEGER) &&
+             (g->flags  & line_buf::LFT_32BIT) &&
+             (g->flags  & line_buf::LFT_INTEGER) &&
+             (b->flags  & line_buf::LFT_32BIT) &&
+             (b->flags  & line_buf::LFT_INTEGER));
+
+      assert(bit_depth <= 32);
+      // see local_avx2_irv_convert_to_integer for an explanation of limits
+      si32 neg_limit = (si32)INT_MIN >> (32 - bit_depth);
+      __m256 mul = _mm256_set1_ps((float)(1ull << bit_depth));
+      __m256 fl_up_lim = _mm256_set1_ps(-(float)neg_limit);  // val < upper
+      __m256 fl_low_lim = _mm256_set1_ps((float)neg_limit);  // val >= lower
+      __m256i s32_up_lim = _mm256_set1_epi32(INT_MAX >> (32 - bit_depth));
+      __m256i s32_low_lim = _mm256_set1_epi32(INT_MIN >> (32 - bit_depth));
+      __m256i half = 
+        _mm256_set1_epi32(is_signed ? 0 : (si32)(1ULL << (bit_depth - 1)));
+      __m256 gamma_cr2g = _mm256_set1_ps(CT_CNST::GAMMA_CR2G);
+      __m256 gamma_cb2g = _mm256_set1_ps(CT_CNST::GAMMA_CB2G);
+      __m256 gamma_cr2r = _mm256_set1_ps(CT_CNST::GAMMA_CR2R);
+      __m256 gamma_cb2b = _mm256_set1_ps(CT_CNST::GAMMA_CB2B);
+
+      const float *yp = y->f32, *cbp = cb->f32, *crp = cr->f32;
+      si32 *rp = r->i32 + dst_line_offset;
+      si32 *gp = g->i32 + dst_line_offset;
+      si32 *bp = b->i32 + dst_line_offset;
+      for (int i = (width + 7) >> 3; i > 0; --i)
+      {
+        __m256 my = _mm256_load_ps(yp);
+        __m256 mcr = _mm256_load_ps(crp);
+        __m256 mcb = _mm256_load_ps(cbp);
+        __m256 mg = _mm256_sub_ps(my, _mm256_mul_ps(gamma_cr2g, mcr));
+        mg = _mm256_sub_ps(mg, _mm256_mul_ps(gamma_cb2g, mcb));
+        __m256 mr = _mm256_add_ps(my, _mm256_mul_ps(gamma_cr2r, mcr));
+        __m256 mb = _mm256_add_ps(my, _mm256_mul_ps(gamma_cb2b, mcb));
+
+        __m256i u;
+        u = avx2_cnvrt_float_to_limited_epi32(_mm256_mul_ps(mr, mul),
+          fl_low_lim, fl_up_lim, s32_low_lim, s32_up_lim);
+        _mm256_storeu_si256((__m256i*)rp, _mm256_add_epi32(u, half));
+        u = avx2_cnvrt_float_to_limited_epi32(_mm256_mul_ps(mg, mul),
+          fl_low_lim, fl_up_lim, s32_low_lim, s32_up_lim);
+        _mm256_storeu_si256((__m256i*)gp, _mm256_add_epi32(u, half));
+        u = avx2_cnvrt_float_to_limited_epi32(_mm256_mul_ps(mb, mul),
+          fl_low_lim, fl_up_lim, s32_low_lim, s32_up_lim);
+        _mm256_storeu_si256((__m256i*)bp, _mm256_add_epi32(u, half));
+
+        yp += 8; cbp += 8; crp += 8;
+        rp += 8; gp += 8; bp += 8;
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // interleaves samples i >= start of num_comps lines using scalar code
+    template <typename T>
+    static inline
+    void avx2_interleave_tail(const line_buf *src_lines, ui32 num_comps,
+                              T *dp, si32 offset, si32 max_val,
+                              ui32 start, ui32 width)
+    {
+      for (ui32 c = 0; c < num_comps; ++c)
+      {
+        const si32 *sp = src_lines[c].i32 + start;
+        T *p = dp + (size_t)start * num_comps + c;
+        for (ui32 i = start; i < width; ++i, p += num_comps)
+        {
+          si32 v = *sp++ + offset;
+          v = v >= 0 ? v : 0;
+          v = v <= max_val ? v : max_val;
+          *p = (T)v;
+        }
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // loads 8 samples, adds the offset, and clamps them to [0, max_val]
+    static inline
+    __m256i avx2_load_clamped(const si32 *sp, __m256i off, __m256i mx)
+    {
+      __m256i t = _mm256_loadu_si256((__m256i*)sp);
+      t = _mm256_add_epi32(t, off);
+      t = _mm256_max_epi32(t, _mm256_setzero_si256());
+      return _mm256_min_epi32(t, mx);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_interleave_to_ui8(
+      const line_buf *src_lines, ui32 num_comps, ui8 *dp,
+      si32 offset, si32 max_val, ui32 width)
+    {
+      __m256i off = _mm256_set1_epi32(offset);
+      __m256i mx = _mm256_set1_epi32(max_val);
+      ui32 i = 0;
+      if (num_comps == 1)
+      {
+        const si32 *sp = src_lines[0].i32;
+        const __m256i idx = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+        for (; i + 32 <= width; i += 32)
+        {
+          __m256i a = avx2_load_clamped(sp + i, off, mx);
+          __m256i b = avx2_load_clamped(sp + i + 8, off, mx);
+          __m256i c = avx2_load_clamped(sp + i + 16, off, mx);
+          __m256i d = avx2_load_clamped(sp + i + 24, off, mx);
+          a = _mm256_packus_epi32(a, b);
+          c = _mm256_packus_epi32(c, d);
+          a = _mm256_packus_epi16(a, c);
+          a = _mm256_permutevar8x32_epi32(a, idx);
+          _mm256_storeu_si256((__m256i*)(dp + i), a);
+        }
+      }
+      else if (num_comps == 3)
+      {
+        const si32 *sp0 = src_lines[0].i32;
+        const si32 *sp1 = src_lines[1].i32;
+        const si32 *sp2 = src_lines[2].i32;
+        const __m256i shuf = _mm256_setr_epi8(
+          0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+          0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+        ui8 *p = dp;
+        // each iteration stores 4 bytes beyond its 24 bytes, which the 
+        // next iteration overwrites; 2 more pixels must exist for these
+        for (; i + 10 <= width; i += 8, p += 24)
+        {
+          __m256i a = avx2_load_clamped(sp0 + i, off, mx);
+          __m256i b = avx2_load_clamped(sp1 + i, off, mx);
+          __m256i c = avx2_load_clamped(sp2 + i, off, mx);
+          a = _mm256_or_si256(a, _mm256_slli_epi32(b, 8));
+          a = _mm256_or_si256(a, _mm256_slli_epi32(c, 16));
+          a = _mm256_shuffle_epi8(a, shuf);
+          _mm_storeu_si128((__m128i*)p, _mm256_castsi256_si128(a));
+          _mm_storeu_si128((__m128i*)(p + 12),
+            _mm256_extracti128_si256(a, 1));
+        }
+      }
+      else if (num_comps == 4)
+      {
+        const si32 *sp0 = src_lines[0].i32;
+        const si32 *sp1 = src_lines[1].i32;
+        const si32 *sp2 = src_lines[2].i32;
+        const si32 *sp3 = src_lines[3].i32;
+        ui8 *p = dp;
+        for (; i + 8 <= width; i += 8, p += 32)
+        {
+          __m256i a = avx2_load_clamped(sp0 + i, off, mx);
+          __m256i b = avx2_load_clamped(sp1 + i, off, mx);
+          __m256i c = avx2_load_clamped(sp2 + i, off, mx);
+          __m256i d = avx2_load_clamped(sp3 + i, off, mx);
+          a = _mm256_or_si256(a, _mm256_slli_epi32(b, 8));
+          a = _mm256_or_si256(a, _mm256_slli_epi32(c, 16));
+          a = _mm256_or_si256(a, _mm256_slli_epi32(d, 24));
+          _mm256_storeu_si256((__m256i*)p, a);
+        }
+      }
+      avx2_interleave_tail(src_lines, num_comps, dp, offset, max_val,
+        i, width);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_interleave_to_ui16(
+      const line_buf *src_lines, ui32 num_comps, ui16 *dp,
+      si32 offset, si32 max_val, ui32 width)
+    {
+      __m256i off = _mm256_set1_epi32(offset);
+      __m256i mx = _mm256_set1_epi32(max_val);
+      ui32 i = 0;
+      if (num_comps == 1)
+      {
+        const si32 *sp = src_lines[0].i32;
+        ui16 *p = dp;
+        for (; i + 16 <= width; i += 16, p += 16)
+        {
+          __m256i a = avx2_load_clamped(sp + i, off, mx);
+          __m256i b = avx2_load_clamped(sp + i + 8, off, mx);
+          a = _mm256_packus_epi32(a, b);
+          a = _mm256_permute4x64_epi64(a, 0xD8);
+          _mm256_storeu_si256((__m256i*)p, a);
+        }
+      }
+      else if (num_comps == 3)
+      {
+        const si32 *sp0 = src_lines[0].i32;
+        const si32 *sp1 = src_lines[1].i32;
+        const si32 *sp2 = src_lines[2].i32;
+        const __m256i shuf = _mm256_setr_epi8(
+          0, 1, 2, 3, 4, 5, 8, 9, 10, 11, 12, 13, -1, -1, -1, -1,
+          0, 1, 2, 3, 4, 5, 8, 9, 10, 11, 12, 13, -1, -1, -1, -1);
+        ui16 *p = dp;
+        // each iteration stores 4 bytes beyond its 48 bytes, which the 
+        // next iteration overwrites; 1 more pixel must exist for these
+        for (; i + 9 <= width; i += 8, p += 24)
+        {
+          __m256i a = avx2_load_clamped(sp0 + i, off, mx);
+          __m256i b = avx2_load_clamped(sp1 + i, off, mx);
+          __m256i c = avx2_load_clamped(sp2 + i, off, mx);
+          a = _mm256_or_si256(a, _mm256_slli_epi32(b, 16));
+          b = _mm256_unpacklo_epi32(a, c); // pixels 0, 1, 4, 5
+          c = _mm256_unpackhi_epi32(a, c); // pixels 2, 3, 6, 7
+          b = _mm256_shuffle_epi8(b, shuf);
+          c = _mm256_shuffle_epi8(c, shuf);
+          _mm_storeu_si128((__m128i*)p, _mm256_castsi256_si128(b));
+          _mm_storeu_si128((__m128i*)(p + 6), _mm256_castsi256_si128(c));
+          _mm_storeu_si128((__m128i*)(p + 12),
+            _mm256_extracti128_si256(b, 1));
+          _mm_storeu_si128((__m128i*)(p + 18),
+            _mm256_extracti128_si256(c, 1));
+        }
+      }
+      else if (num_comps == 4)
+      {
+        const si32 *sp0 = src_lines[0].i32;
+        const si32 *sp1 = src_lines[1].i32;
+        const si32 *sp2 = src_lines[2].i32;
+        const si32 *sp3 = src_lines[3].i32;
+        ui16 *p = dp;
+        for (; i + 8 <= width; i += 8, p += 32)
+        {
+          __m256i a = avx2_load_clamped(sp0 + i, off, mx);
+          __m256i b = avx2_load_clamped(sp1 + i, off, mx);
+          __m256i c = avx2_load_clamped(sp2 + i, off, mx);
+          __m256i d = avx2_load_clamped(sp3 + i, off, mx);
+          a = _mm256_or_si256(a, _mm256_slli_epi32(b, 16));
+          c = _mm256_or_si256(c, _mm256_slli_epi32(d, 16));
+          b = _mm256_unpacklo_epi32(a, c); // pixels 0, 1, 4, 5
+          d = _mm256_unpackhi_epi32(a, c); // pixels 2, 3, 6, 7
+          _mm256_storeu_si256((__m256i*)p,
+            _mm256_permute2x128_si256(b, d, 0x20));
+          _mm256_storeu_si256((__m256i*)(p + 16),
+            _mm256_permute2x128_si256(b, d, 0x31));
+        }
+      }
+      avx2_interleave_tail(src_lines, num_comps, dp, offset, max_val,
+        i, width);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_interleave_to_float(
+      const line_buf *src_lines, ui32 num_comps, float *dp,
+      float mul, ui32 width)
+    {
+      if (num_comps != 1)
+      {
+        gen_interleave_to_float(src_lines, num_comps, dp, mul, width);
+        return;
+      }
+      __m256 m = _mm256_set1_ps(mul);
+      const si32 *sp = src_lines[0].i32;
+      ui32 i = 0;
+      for (; i + 8 <= width; i += 8)
+      {
+        __m256i t = _mm256_loadu_si256((__m256i*)(sp + i));
+        __m256 v = _mm256_mul_ps(_mm256_cvtepi32_ps(t), m);
+        _mm256_storeu_ps(dp + i, v);
+      }
+      for (; i < width; ++i)
+        dp[i] = (float)sp[i] * mul;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // deinterleaves samples i >= start of num_comps lines using scalar code
+    template <typename T>
+    static inline
+    void avx2_deinterleave_tail(const T *sp, ui32 num_comps,
+                                line_buf *dst_lines, si32 offset,
+                                si32 max_val, ui32 start, ui32 width)
+    {
+      for (ui32 c = 0; c < num_comps; ++c)
+      {
+        const T *p = sp + (size_t)start * num_comps + c;
+        si32 *dp = dst_lines[c].i32;
+        for (ui32 i = start; i < width; ++i, p += num_comps)
+        {
+          si32 v = *p;
+          dp[i] = (v <= max_val ? v : max_val) - offset;
+        }
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // clamps 8 widened samples to max_val, and subtracts the offset
+    static inline
+    void avx2_store_deinterleaved(si32 *dp, __m256i t, __m256i off,
+                                  __m256i mx)
+    {
+      t = _mm256_min_epi32(t, mx);
+      _mm256_storeu_si256((__m256i*)dp, _mm256_sub_epi32(t, off));
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_deinterleave_from_ui8(
+      const ui8 *sp, ui32 num_comps, line_buf *dst_lines,
+      si32 offset, si32 max_val, ui32 width)
+    {
+      __m256i off = _mm256_set1_epi32(offset);
+      __m256i mx = _mm256_set1_epi32(max_val);
+      ui32 i = 0;
+      if (num_comps == 1)
+      {
+        si32 *dp = dst_lines[0].i32;
+        for (; i + 8 <= width; i += 8)
+        {
+          __m128i t = _mm_loadl_epi64((__m128i*)(sp + i));
+          avx2_store_deinterleaved(dp + i, _mm256_cvtepu8_epi32(t), off, mx);
+        }
+      }
+      else if (num_comps == 3)
+      {
+        si32 *dp0 = dst_lines[0].i32;
+        si32 *dp1 = dst_lines[1].i32;
+        si32 *dp2 = dst_lines[2].i32;
+        // the lower lane holds pixels 0 to 3 at bytes 0 to 11, and the 
+        // upper lane holds pixels 4 to 7 at bytes 4 to 15
+        const __m256i shuf0 = _mm256_setr_epi8(
+          0, -1, -1, -1, 3, -1, -1, -1, 6, -1, -1, -1, 9, -1, -1, -1,
+          4, -1, -1, -1, 7, -1, -1, -1, 10, -1, -1, -1, 13, -1, -1, -1);
+        const __m256i shuf1 = _mm256_setr_epi8(
+          1, -1, -1, -1, 4, -1, -1, -1, 7, -1, -1, -1, 10, -1, -1, -1,
+          5, -1, -1, -1, 8, -1, -1, -1, 11, -1, -1, -1, 14, -1, -1, -1);
+        const __m256i shuf2 = _mm256_setr_epi8(
+          2, -1, -1, -1, 5, -1, -1, -1, 8, -1, -1, -1, 11, -1, -1, -1,
+          6, -1, -1, -1, 9, -1, -1, -1, 12, -1, -1, -1, 15, -1, -1, -1);
+        const ui8 *p = sp;
+        for (; i + 8 <= width; i += 8, p += 24)
+        {
+          __m256i t = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((__m128i*)p)),
+            _mm_loadu_si128((__m128i*)(p + 8)), 1);
+          avx2_store_deinterleaved(dp0 + i, _mm256_shuffle_epi8(t, shuf0),
+            off, mx);
+          avx2_store_deinterleaved(dp1 + i, _mm256_shuffle_epi8(t, shuf1),
+            off, mx);
+          avx2_store_deinterleaved(dp2 + i, _mm256_shuffle_epi8(t, shuf2),
+            off, mx);
+        }
+      }
+      else if (num_comps == 4)
+      {
+        si32 *dp0 = dst_lines[0].i32;
+        si32 *dp1 = dst_lines[1].i32;
+        si32 *dp2 = dst_lines[2].i32;
+        si32 *dp3 = dst_lines[3].i32;
+        const __m256i mask = _mm256_set1_epi32(0xFF);
+        const ui8 *p = sp;
+        for (; i + 8 <= width; i += 8, p += 32)
+        {
+          __m256i t = _mm256_loadu_si256((__m256i*)p);
+          avx2_store_deinterleaved(dp0 + i, _mm256_and_si256(t, mask),
+            off, mx);
+          avx2_store_deinterleaved(dp1 + i,
+            _mm256_and_si256(_mm256_srli_epi32(t, 8), mask), off, mx);
+          avx2_store_deinterleaved(dp2 + i,
+            _mm256_and_si256(_mm256_srli_epi32(t, 16), mask), off, mx);
+          avx2_store_deinterleaved(dp3 + i, _mm256_srli_epi32(t, 24),
+            off, mx);
+        }
+      }
+      avx2_deinterleave_tail(sp, num_comps, dst_lines, offset, max_val,
+        i, width);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_deinterleave_from_ui16(
+      const ui16 *sp, ui32 num_comps, line_buf *dst_lines,
+      si32 offset, si32 max_val, ui32 width)
+    {
+      __m256i off = _mm256_set1_epi32(offset);
+      __m256i mx = _mm256_set1_epi32(max_val);
+      ui32 i = 0;
+      if (num_comps == 1)
+      {
+        si32 *dp = dst_lines[0].i32;
+        for (; i + 8 <= width; i += 8)
+        {
+          __m128i t = _mm_loadu_si128((__m128i*)(sp + i));
+          avx2_store_deinterleaved(dp + i, _mm256_cvtepu16_epi32(t), off, mx);
+        }
+      }
+      else if (num_comps == 3)
+      {
+        si32 *dp0 = dst_lines[0].i32;
+        si32 *dp1 = dst_lines[1].i32;
+        si32 *dp2 = dst_lines[2].i32;
+        // each 16-byte load provides 2 pixels, at samples 0 to 5; the
+        // lower lane of a and b holds pixels 0, 1 and 4, 5, while the 
+        // upper lane holds pixels 2, 3 and 6, 7
+        const __m256i shuf_a0 = _mm256_setr_epi8(
+          0, 1, -1, -1, 6, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+          0, 1, -1, -1, 6, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+        const __m256i shuf_b0 = _mm256_setr_epi8(
+          -1, -1, -1, -1, -1, -1, -1, -1, 0, 1, -1, -1, 6, 7, -1, -1,
+          -1, -1, -1, -1, -1, -1, -1, -1, 0, 1, -1, -1, 6, 7, -1, -1);
+        // moving to the next component adds 2 to the byte indices, but
+        // not to the -1 entries, which zero their bytes
+        const __m256i step_a = _mm256_and_si256(_mm256_set1_epi8(2),
+          _mm256_cmpgt_epi8(shuf_a0, _mm256_set1_epi8(-1)));
+        const __m256i step_b = _mm256_and_si256(_mm256_set1_epi8(2),
+          _mm256_cmpgt_epi8(shuf_b0, _mm256_set1_epi8(-1)));
+        const __m256i idx = _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7);
+        const ui16 *p = sp;
+        // the last load reads 2 samples beyond the 8 pixels; 1 more pixel
+        // must exist for these
+        for (; i + 9 <= width; i += 8, p += 24)
+        {
+          __m256i a = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((__m128i*)p)),
+            _mm_loadu_si128((__m128i*)(p + 6)), 1);
+          __m256i b = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((__m128i*)(p + 12))),
+            _mm_loadu_si128((__m128i*)(p + 18)), 1);
+          __m256i sa = shuf_a0, sb = shuf_b0;
+          si32 *dps[3] = { dp0, dp1, dp2 };
+          for (int c = 0; c < 3; ++c)
+          {
+            __m256i t = _mm256_or_si256(_mm256_shuffle_epi8(a, sa),
+                                        _mm256_shuffle_epi8(b, sb));
+            t = _mm256_permutevar8x32_epi32(t, idx);
+            avx2_store_deinterleaved(dps[c] + i, t, off, mx);
+            sa = _mm256_add_epi8(sa, step_a);
+            sb = _mm256_add_epi8(sb, step_b);
+          }
+        }
+      }
+      else if (num_comps == 4)
+      {
+        si32 *dp0 = dst_lines[0].i32;
+        si32 *dp1 = dst_lines[1].i32;
+        si32 *dp2 = dst_lines[2].i32;
+        si32 *dp3 = dst_lines[3].i32;
+        const __m256i mask = _mm256_set1_epi32(0xFFFF);
+        const __m256i idx = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+        const ui16 *p = sp;
+        for (; i + 8 <= width; i += 8, p += 32)
+        {
+          // even dwords hold components 0 and 1, odd ones 2 and 3
+          __m256i a = _mm256_loadu_si256((__m256i*)p);
+          __m256i b = _mm256_loadu_si256((__m256i*)(p + 16));
+          a = _mm256_permutevar8x32_epi32(a, idx);
+          b = _mm256_permutevar8x32_epi32(b, idx);
+          __m256i t01 = _mm256_permute2x128_si256(a, b, 0x20);
+          __m256i t23 = _mm256_permute2x128_si256(a, b, 0x31);
+          avx2_store_deinterleaved(dp0 + i, _mm256_and_si256(t01, mask),
+            off, mx);
+          avx2_store_deinterleaved(dp1 + i, _mm256_srli_epi32(t01, 16),
+            off, mx);
+          avx2_store_deinterleaved(dp2 + i, _mm256_and_si256(t23, mask),
+            off, mx);
+          avx2_store_deinterleaved(dp3 + i, _mm256_srli_epi32(t23, 16),
+            off, mx);
+        }
+      }
+      avx2_deinterleave_tail(sp, num_comps, dst_lines, offset, max_val,
+        i, width);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // multiplies 8 samples by mul, clamps them to [low, high], and rounds 
+    // them; a NaN is converted to high, as in the generic code
+    static inline
+    __m256i avx2_cnvrt_to_clamped_si32(__m256 t, __m256 m, __m256 lo,
+                                       __m256 hi)
+    {
+      t = _mm256_mul_ps(t, m);
+      t = _mm256_min_ps(t, hi);
+      t = _mm256_max_ps(t, lo);
+      return _mm256_cvtps_epi32(t);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // converts the 8 half-precision samples in the lower 16 bits of each
+    // dword to floats; see gen_deinterleave_from_half
+    static inline
+    __m256 avx2_half_to_float(__m256i h)
+    {
+      const __m256i mag_mask = _mm256_set1_epi32(0x7FFF);
+      const __m256i sign_mask = _mm256_set1_epi32(0x8000);
+      const __m256 scale = _mm256_castsi256_ps(_mm256_set1_epi32(0x77800000));
+      __m256i t = _mm256_slli_epi32(_mm256_and_si256(h, mag_mask), 13);
+      __m256 f = _mm256_mul_ps(_mm256_castsi256_ps(t), scale);
+      __m256i s = _mm256_slli_epi32(_mm256_and_si256(h, sign_mask), 16);
+      return _mm256_or_ps(f, _mm256_castsi256_ps(s));
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_deinterleave_from_float(
+      const float *sp, ui32 num_comps, line_buf *dst_lines,
+      float mul, si32 low, si32 high, ui32 width)
+    {
+      __m256 m = _mm256_set1_ps(mul);
+      __m256 lo = _mm256_set1_ps((float)low);
+      __m256 hi = _mm256_set1_ps((float)high);
+      __m256i idx = _mm256_mullo_epi32(
+        _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+        _mm256_set1_epi32((si32)num_comps));
+      for (ui32 c = 0; c < num_comps; ++c)
+      {
+        const float *p = sp + c;
+        si32 *dp = dst_lines[c].i32;
+        ui32 i = 0;
+        if (num_comps == 1)
+          for (; i + 8 <= width; i += 8, p += 8)
+          {
+            __m256 t = _mm256_loadu_ps(p);
+            _mm256_storeu_si256((__m256i*)(dp + i),
+              avx2_cnvrt_to_clamped_si32(t, m, lo, hi));
+          }
+        else
+          for (; i + 8 <= width; i += 8, p += 8 * num_comps)
+          {
+            __m256 t = _mm256_i32gather_ps(p, idx, 4);
+            _mm256_storeu_si256((__m256i*)(dp + i),
+              avx2_cnvrt_to_clamped_si32(t, m, lo, hi));
+          }
+        for (; i < width; ++i, p += num_comps)
+        {
+          __m256 t = _mm256_set1_ps(*p);
+          dp[i] = _mm256_cvtsi256_si32(
+            avx2_cnvrt_to_clamped_si32(t, m, lo, hi));
+        }
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_deinterleave_from_half(
+      const ui16 *sp, ui32 num_comps, line_buf *dst_lines,
+      float mul, si32 low, si32 high, ui32 width)
+    {
+      __m256 m = _mm256_set1_ps(mul);
+      __m256 lo = _mm256_set1_ps((float)low);
+      __m256 hi = _mm256_set1_ps((float)high);
+      __m256i mask = _mm256_set1_epi32(0xFFFF);
+      __m256i idx = _mm256_mullo_epi32(
+        _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+        _mm256_set1_epi32((si32)num_comps));
+      for (ui32 c = 0; c < num_comps; ++c)
+      {
+        const ui16 *p = sp + c;
+        si32 *dp = dst_lines[c].i32;
+        ui32 i = 0;
+        if (num_comps == 1)
+          for (; i + 8 <= width; i += 8, p += 8)
+          {
+            __m256i t = _mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i*)p));
+            _mm256_storeu_si256((__m256i*)(dp + i),
+              avx2_cnvrt_to_clamped_si32(avx2_half_to_float(t), m, lo, hi));
+          }
+        else
+          // each gathered dword extends 1 sample beyond the one needed;
+          // 1 more pixel must exist for the last of these
+          for (; i + 9 <= width; i += 8, p += 8 * num_comps)
+          {
+            __m256i t = _mm256_i32gather_epi32((const int*)p, idx, 2);
+            t = _mm256_and_si256(t, mask);
+            _mm256_storeu_si256((__m256i*)(dp + i),
+              avx2_cnvrt_to_clamped_si32(avx2_half_to_float(t), m, lo, hi));
+          }
+        for (; i < width; ++i, p += num_comps)
+        {
+          __m256 t = avx2_half_to_float(_mm256_set1_epi32(*p));
+          dp[i] = _mm256_cvtsi256_si32(
+            avx2_cnvrt_to_clamped_si32(t, m, lo, hi));
+        }
+      }
+    }
+
   }
 }
 
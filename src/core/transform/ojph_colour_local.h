@@ -114,6 +114,65 @@ namespace ojph {
     void gen_ict_backward(const float *y, const float *cb, const float *cr,
                           float *r, float *g, float *b, ui32 repeat);
 
+    //////////////////////////////////////////////////////////////////////////
+    void gen_rev_convert_rct_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      si64 shift, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_rct_backward_rev_convert(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      si64 shift, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_irv_convert_to_float_ict_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      ui32 bit_depth, bool is_signed, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_ict_backward_irv_convert_to_integer(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      ui32 bit_depth, bool is_signed, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_deinterleave_from_ui8(
+      const ui8 *sp, ui32 num_comps, line_buf *dst_lines,
+      si32 offset, si32 max_val, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_deinterleave_from_ui16(
+      const ui16 *sp, ui32 num_comps, line_buf *dst_lines,
+      si32 offset, si32 max_val, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_deinterleave_from_float(
+      const float *sp, ui32 num_comps, line_buf *dst_lines,
+      float mul, si32 low, si32 high, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_deinterleave_from_half(
+      const ui16 *sp, ui32 num_comps, line_buf *dst_lines,
+      float mul, si32 low, si32 high, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_interleave_to_ui8(
+      const line_buf *src_lines, ui32 num_comps, ui8 *dp,
+      si32 offset, si32 max_val, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_interleave_to_ui16(
+      const line_buf *src_lines, ui32 num_comps, ui16 *dp,
+      si32 offset, si32 max_val, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void gen_interleave_to_float(
+      const line_buf *src_lines, ui32 num_comps, float *dp,
+      float mul, ui32 width);
+
     //////////////////////////////////////////////////////////////////////////
     //
     //
@@ -188,6 +247,30 @@ namespace ojph {
       const line_buf *y, const line_buf *cb, const line_buf *cr,
       line_buf *r, line_buf *g, line_buf *b, ui32 repeat);
 
+    //////////////////////////////////////////////////////////////////////////
+    void sse2_rev_convert_rct_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      si64 shift, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void sse2_rct_backward_rev_convert(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      si64 shift, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void sse2_irv_convert_to_float_ict_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      ui32 bit_depth, bool is_signed, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void sse2_ict_backward_irv_convert_to_integer(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      ui32 bit_depth, bool is_signed, ui32 width);
+
     //////////////////////////////////////////////////////////////////////////
     //
     //
@@ -254,6 +337,65 @@ namespace ojph {
       const line_buf *y, const line_buf *cb, const line_buf *cr,
       line_buf *r, line_buf *g, line_buf *b, ui32 repeat);
 
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_rev_convert_rct_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      si64 shift, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_rct_backward_rev_convert(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      si64 shift, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_irv_convert_to_float_ict_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      ui32 bit_depth, bool is_signed, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_ict_backward_irv_convert_to_integer(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      ui32 bit_depth, bool is_signed, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_deinterleave_from_ui8(
+      const ui8 *sp, ui32 num_comps, line_buf *dst_lines,
+      si32 offset, si32 max_val, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_deinterleave_from_ui16(
+      const ui16 *sp, ui32 num_comps, line_buf *dst_lines,
+      si32 offset, si32 max_val, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_deinterleave_from_float(
+      const float *sp, ui32 num_comps, line_buf *dst_lines,
+      float mul, si32 low, si32 high, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_deinterleave_from_half(
+      const ui16 *sp, ui32 num_comps, line_buf *dst_lines,
+      float mul, si32 low, si32 high, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_interleave_to_ui8(
+      const line_buf *src_lines, ui32 num_comps, ui8 *dp,
+      si32 offset, si32 max_val, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_interleave_to_ui16(
+      const line_buf *src_lines, ui32 num_comps, ui16 *dp,
+      si32 offset, si32 max_val, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void avx2_interleave_to_float(
+      const line_buf *src_lines, ui32 num_comps, float *dp,
+      float mul, ui32 width);
+
     //////////////////////////////////////////////////////////////////////////
     //
     //
@@ -312,6 +454,30 @@ namespace ojph {
     void wasm_ict_backward(const float *y, const float *cb, const float *cr,
                            float *r, float *g, float *b, ui32 repeat);
 
+    //////////////////////////////////////////////////////////////////////////
+    void wasm_rev_convert_rct_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      si64 shift, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void wasm_rct_backward_rev_convert(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      si64 shift, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void wasm_irv_convert_to_float_ict_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      ui32 bit_depth, bool is_signed, ui32 width);
+
+    //////////////////////////////////////////////////////////////////////////
+    void wasm_ict_backward_irv_convert_to_integer(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      ui32 bit_depth, bool is_signed, ui32 width);
+
   }
 }
 
@@ -44,6 +44,7 @@
 #include "ojph_defs.h"
 #include "ojph_mem.h"
 #include "ojph_colour.h"
+#include "ojph_colour_local.h"
 
 #include <emmintrin.h>
 
@@ -656,6 +657,214 @@ namespace ojph {
         }
       }
     }
+
+    //////////////////////////////////////////////////////////////////////////
+    void sse2_rev_convert_rct_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      si64 shift, ui32 width)
+    {
+      assert((r->flags  & line_buf::LFT_32BIT) &&
+             (g->flags  & line_buf::LFT_32BIT) &&
+             (b->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_INTEGER) &&
+             (cb->flags & line_buf::LFT_32BIT) &&
+             (cb->flags & line_buf::LFT_INTEGER) &&
+             (cr->flags & line_buf::LFT_32BIT) &&
+             (cr->flags & line_buf::LFT_INTEGER));
+      const si32 *rp = r->i32 + src_line_offset;
+      const si32 *gp = g->i32 + src_line_offset;
+      const si32 *bp = b->i32 + src_line_offset;
+      si32 *yp = y->i32, *cbp = cb->i32, *crp = cr->i32;
+      __m128i sh = _mm_set1_epi32((si32)shift);
+      for (int i = (width + 3) >> 2; i > 0; --i)
+      {
+        __m128i mr = _mm_add_epi32(_mm_loadu_si128((__m128i*)rp), sh);
+        __m128i mg = _mm_add_epi32(_mm_loadu_si128((__m128i*)gp), sh);
+        __m128i mb = _mm_add_epi32(_mm_loadu_si128((__m128i*)bp), sh);
+        __m128i t = _mm_add_epi32(mr, mb);
+        t = _mm_add_epi32(t, _mm_slli_epi32(mg, 1));
+        _mm_store_si128((__m128i*)yp, _mm_srai_epi32(t, 2));
+        t = _mm_sub_epi32(mb, mg);
+        _mm_store_si128((__m128i*)cbp, t);
+        t = _mm_sub_epi32(mr, mg);
+        _mm_store_si128((__m128i*)crp, t);
+
+        rp += 4; gp += 4; bp += 4;
+        yp += 4; cbp += 4; crp += 4;
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void sse2_rct_backward_rev_convert(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      si64 shift, ui32 width)
+    {
+      assert((y->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_INTEGER) &&
+             (cb->flags & line_buf::LFT_32BIT) &&
+             (cb->flags & line_buf::LFT_INTEGER) &&
+             (cr->flags & line_buf::LFT_32BIT) &&
+             (cr->flags & line_buf::LFT_INTEGER) &&
+             (r->flags  & line_buf::LFT_32BIT) &&
+             (g->flags  & line_buf::LFT_32BIT) &&
+             (b->flags  & line_buf::LFT_32BIT));
+      const si32 *yp = y->i32, *cbp = cb->i32, *crp = cr->i32;
+      si32 *rp = r->i32 + dst_line_offset;
+      si32 *gp = g->i32 + dst_line_offset;
+      si32 *bp = b->i32 + dst_line_offset;
+      __m128i sh = _mm_set1_epi32((si32)shift);
+      for (int i = (width + 3) >> 2; i > 0; --i)
+      {
+        __m128i my  = _mm_load_si128((__m128i*)yp);
+        __m128i mcb = _mm_load_si128((__m128i*)cbp);
+        __m128i mcr = _mm_load_si128((__m128i*)crp);
+
+        __m128i t = _mm_add_epi32(mcb, mcr);
+        t = _mm_sub_epi32(my, _mm_srai_epi32(t, 2));
+        __m128i u = _mm_add_epi32(mcb, t);
+        _mm_storeu_si128((__m128i*)bp, _mm_add_epi32(u, sh));
+        u = _mm_add_epi32(mcr, t);
+        _mm_storeu_si128((__m128i*)rp, _mm_add_epi32(u, sh));
+        _mm_storeu_si128((__m128i*)gp, _mm_add_epi32(t, sh));
+
+        yp += 4; cbp += 4; crp += 4;
+        rp += 4; gp += 4; bp += 4;
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void sse2_irv_convert_to_float_ict_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      ui32 bit_depth, bool is_signed, ui32 width)
+    {
+      assert((r->flags  & line_buf::LFT_32BIT) &&
+             (r->flags  & line_buf::LFT_INTEGER) &&
+             (g->flags  & line_buf::LFT_32BIT) &&
+             (g->flags  & line_buf::LFT_INTEGER) &&
+             (b->flags  & line_buf::LFT_32BIT) &&
+             (b->flags  & line_buf::LFT_INTEGER) &&
+             (y->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_INTEGER) == 0 &&
+             (cb->flags & line_buf::LFT_32BIT) &&
+             (cb->flags & line_buf::LFT_INTEGER) == 0 &&
+             (cr->flags & line_buf::LFT_32BIT) &&
+             (cr->flags & line_buf::LFT_INTEGER) == 0);
+
+      assert(bit_depth <= 32);
+      __m128 mul = _mm_set1_ps((float)(1.0 / (double)(1ULL << bit_depth)));
+      __m128i half = 
+        _mm_set1_epi32(is_signed ? 0 : (si32)(1ULL << (bit_depth - 1)));
+      __m128 alpha_rf = _mm_set1_ps(CT_CNST::ALPHA_RF);
+      __m128 alpha_gf = _mm_set1_ps(CT_CNST::ALPHA_GF);
+      __m128 alpha_bf = _mm_set1_ps(CT_CNST::ALPHA_BF);
+      __m128 beta_cbf = _mm_set1_ps(CT_CNST::BETA_CbF);
+      __m128 beta_crf = _mm_set1_ps(CT_CNST::BETA_CrF);
+
+      const si32 *rp = r->i32 + src_line_offset;
+      const si32 *gp = g->i32 + src_line_offset;
+      const si32 *bp = b->i32 + src_line_offset;
+      float *yp = y->f32, *cbp = cb->f32, *crp = cr->f32;
+      for (int i = (width + 3) >> 2; i > 0; --i)
+      {
+        __m128i t;
+        t = _mm_sub_epi32(_mm_loadu_si128((__m128i*)rp), half);
+        __m128 mr = _mm_mul_ps(_mm_cvtepi32_ps(t), mul);
+        t = _mm_sub_epi32(_mm_loadu_si128((__m128i*)gp), half);
+        __m128 mg = _mm_mul_ps(_mm_cvtepi32_ps(t), mul);
+        t = _mm_sub_epi32(_mm_loadu_si128((__m128i*)bp), half);
+        __m128 mb = _mm_mul_ps(_mm_cvtepi32_ps(t), mul);
+
+        __m128 my = _mm_mul_ps(alpha_rf, mr);
+        my = _mm_add_ps(my, _mm_mul_ps(alpha_gf, mg));
+        my = _mm_add_ps(my, _mm_mul_ps(alpha_bf, mb));
+        _mm_store_ps(yp, my);
+        _mm_store_ps(cbp, _mm_mul_ps(beta_cbf, _mm_sub_ps(mb, my)));
+        _mm_store_ps(crp, _mm_mul_ps(beta_crf, _mm_sub_ps(mr, my)));
+
+        rp += 4; gp += 4; bp += 4;
+        yp += 4; cbp += 4; crp += 4;
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void sse2_ict_backward_irv_convert_to_integer(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      ui32 bit_depth, bool is_signed, ui32 width)
+    {
+      assert((y->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_INTEGER) == 0 &&
+             (cb->flags & line_buf::LFT_32BIT) &&
+             (cb->flags & line_buf::LFT_INTEGER) == 0 &&
+             (cr->flags & line_buf::LFT_32BIT) &&
+             (cr->flags & line_buf::LFT_INTEGER) == 0 &&
+             (r->flags  & line_buf::LFT_32BIT) &&
+             (r->flags  & line_buf::LFT_INTEGER) &&
+             (g->flags  & line_buf::LFT_32BIT) &&
+             (g->flags  & line_buf::LFT_INTEGER) &&
+             (b->flags  & line_buf::LFT_32BIT) &&
+             (b->flags  & line_buf::LFT_INTEGER));
+
+      assert(bit_depth <= 32);
+      uint32_t rounding_mode = _MM_GET_ROUNDING_MODE();
+      _MM_SET_ROUNDING_MODE(_MM_ROUND_NEAREST);
+
+      // see local_sse2_irv_convert_to_integer for an explanation of limits
+      si32 neg_limit = (si32)INT_MIN >> (32 - bit_depth);
+      __m128 mul = _mm_set1_ps((float)(1ull << bit_depth));
+      __m128 fl_up_lim = _mm_set1_ps(-(float)neg_limit); // val < upper
+      __m128 fl_low_lim = _mm_set1_ps((float)neg_limit); // val >= lower
+      __m128i s32_up_lim = _mm_set1_epi32(INT_MAX >> (32 - bit_depth));
+      __m128i s32_low_lim = _mm_set1_epi32(INT_MIN >> (32 - bit_depth));
+      __m128i half = 
+        _mm_set1_epi32(is_signed ? 0 : (si32)(1ULL << (bit_depth - 1)));
+      __m128 gamma_cr2g = _mm_set1_ps(CT_CNST::GAMMA_CR2G);
+      __m128 gamma_cb2g = _mm_set1_ps(CT_CNST::GAMMA_CB2G);
+      __m128 gamma_cr2r = _mm_set1_ps(CT_CNST::GAMMA_CR2R);
+      __m128 gamma_cb2b = _mm_set1_ps(CT_CNST::GAMMA_CB2B);
+
+      const float *yp = y->f32, *cbp = cb->f32, *crp = cr->f32;
+      si32 *rp = r->i32 + dst_line_offset;
+      si32 *gp = g->i32 + dst_line_offset;
+      si32 *bp = b->i32 + dst_line_offset;
+      for (int i = (width + 3) >> 2; i > 0; --i)
+      {
+        __m128 my = _mm_load_ps(yp);
+        __m128 mcr = _mm_load_ps(crp);
+        __m128 mcb = _mm_load_ps(cbp);
+        __m128 mg = _mm_sub_ps(my, _mm_mul_ps(gamma_cr2g, mcr));
+        mg = _mm_sub_ps(mg, _mm_mul_ps(gamma_cb2g, mcb));
+        __m128 mr = _mm_add_ps(my, _mm_mul_ps(gamma_cr2r, mcr));
+        __m128 mb = _mm_add_ps(my, _mm_mul_ps(gamma_cb2b, mcb));
+
+        __m128 t;
+        __m128i u;
+        t = _mm_mul_ps(mr, mul);
+        u = _mm_cvtps_epi32(t);
+        u = ojph_mm_max_ge_epi32(u, s32_low_lim, t, fl_low_lim);
+        u = ojph_mm_min_lt_epi32(u, s32_up_lim, t, fl_up_lim);
+        _mm_storeu_si128((__m128i*)rp, _mm_add_epi32(u, half));
+        t = _mm_mul_ps(mg, mul);
+        u = _mm_cvtps_epi32(t);
+        u = ojph_mm_max_ge_epi32(u, s32_low_lim, t, fl_low_lim);
+        u = ojph_mm_min_lt_epi32(u, s32_up_lim, t, fl_up_lim);
+        _mm_storeu_si128((__m128i*)gp, _mm_add_epi32(u, half));
+        t = _mm_mul_ps(mb, mul);
+        u = _mm_cvtps_epi32(t);
+        u = ojph_mm_max_ge_epi32(u, s32_low_lim, t, fl_low_lim);
+        u = ojph_mm_min_lt_epi32(u, s32_up_lim, t, fl_up_lim);
+        _mm_storeu_si128((__m128i*)bp, _mm_add_epi32(u, half));
+
+        yp += 4; cbp += 4; crp += 4;
+        rp += 4; gp += 4; bp += 4;
+      }
+
+      _MM_SET_ROUNDING_MODE(rounding_mode);
+    }
   }
 }
 
@@ -674,5 +674,216 @@ namespace ojph {
       }
     }
 
+
+    //////////////////////////////////////////////////////////////////////////
+    void wasm_rev_convert_rct_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      si64 shift, ui32 width)
+    {
+      assert((r->flags  & line_buf::LFT_32BIT) &&
+             (g->flags  & line_buf::LFT_32BIT) &&
+             (b->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_INTEGER) &&
+             (cb->flags & line_buf::LFT_32BIT) &&
+             (cb->flags & line_buf::LFT_INTEGER) &&
+             (cr->flags & line_buf::LFT_32BIT) &&
+             (cr->flags & line_buf::LFT_INTEGER));
+      const si32 *rp = r->i32 + src_line_offset;
+      const si32 *gp = g->i32 + src_line_offset;
+      const si32 *bp = b->i32 + src_line_offset;
+      si32 *yp = y->i32, *cbp = cb->i32, *crp = cr->i32;
+      v128_t sh = wasm_i32x4_splat((si32)shift);
+      for (int i = (width + 3) >> 2; i > 0; --i)
+      {
+        v128_t mr = wasm_i32x4_add(wasm_v128_load(rp), sh);
+        v128_t mg = wasm_i32x4_add(wasm_v128_load(gp), sh);
+        v128_t mb = wasm_i32x4_add(wasm_v128_load(bp), sh);
+        v128_t t = wasm_i32x4_add(mr, mb);
+        t = wasm_i32x4_add(t, wasm_i32x4_shl(mg, 1));
+        wasm_v128_store(yp, wasm_i32x4_shr(t, 2));
+        t = wasm_i32x4_sub(mb, mg);
+        wasm_v128_store(cbp, t);
+        t = wasm_i32x4_sub(mr, mg);
+        wasm_v128_store(crp, t);
+
+        rp += 4; gp += 4; bp += 4;
+        yp += 4; cbp += 4; crp += 4;
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void wasm_rct_backward_rev_convert(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      si64 shift, ui32 width)
+    {
+      assert((y->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_INTEGER) &&
+             (cb->flags & line_buf::LFT_32BIT) &&
+             (cb->flags & line_buf::LFT_INTEGER) &&
+             (cr->flags & line_buf::LFT_32BIT) &&
+             (cr->flags & line_buf::LFT_INTEGER) &&
+             (r->flags  & line_buf::LFT_32BIT) &&
+             (g->flags  & line_buf::LFT_32BIT) &&
+             (b->flags  & line_buf::LFT_32BIT));
+      const si32 *yp = y->i32, *cbp = cb->i32, *crp = cr->i32;
+      si32 *rp = r->i32 + dst_line_offset;
+      si32 *gp = g->i32 + dst_line_offset;
+      si32 *bp = b->i32 + dst_line_offset;
+      v128_t sh = wasm_i32x4_splat((si32)shift);
+      for (int i = (width + 3) >> 2; i > 0; --i)
+      {
+        v128_t my  = wasm_v128_load(yp);
+        v128_t mcb = wasm_v128_load(cbp);
+        v128_t mcr = wasm_v128_load(crp);
+
+        v128_t t = wasm_i32x4_add(mcb, mcr);
+        t = wasm_i32x4_sub(my, wasm_i32x4_shr(t, 2));
+        v128_t u = wasm_i32x4_add(mcb, t);
+        wasm_v128_store(bp, wasm_i32x4_add(u, sh));
+        u = wasm_i32x4_add(mcr, t);
+        wasm_v128_store(rp, wasm_i32x4_add(u, sh));
+        wasm_v128_store(gp, wasm_i32x4_add(t, sh));
+
+        yp += 4; cbp += 4; crp += 4;
+        rp += 4; gp += 4; bp += 4;
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void wasm_irv_convert_to_float_ict_forward(
+      const line_buf *r, const line_buf *g, const line_buf *b,
+      ui32 src_line_offset, line_buf *y, line_buf *cb, line_buf *cr,
+      ui32 bit_depth, bool is_signed, ui32 width)
+    {
+      assert((r->flags  & line_buf::LFT_32BIT) &&
+             (r->flags  & line_buf::LFT_INTEGER) &&
+             (g->flags  & line_buf::LFT_32BIT) &&
+             (g->flags  & line_buf::LFT_INTEGER) &&
+             (b->flags  & line_buf::LFT_32BIT) &&
+             (b->flags  & line_buf::LFT_INTEGER) &&
+             (y->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_INTEGER) == 0 &&
+             (cb->flags & line_buf::LFT_32BIT) &&
+             (cb->flags & line_buf::LFT_INTEGER) == 0 &&
+             (cr->flags & line_buf::LFT_32BIT) &&
+             (cr->flags & line_buf::LFT_INTEGER) == 0);
+
+      assert(bit_depth <= 32);
+      v128_t mul = wasm_f32x4_splat((float)(1.0 / (double)(1ULL << bit_depth)));
+      v128_t half = 
+        wasm_i32x4_splat(is_signed ? 0 : (si32)(1ULL << (bit_depth - 1)));
+      v128_t alpha_rf = wasm_f32x4_splat(CT_CNST::ALPHA_RF);
+      v128_t alpha_gf = wasm_f32x4_splat(CT_CNST::ALPHA_GF);
+      v128_t alpha_bf = wasm_f32x4_splat(CT_CNST::ALPHA_BF);
+      v128_t beta_cbf = wasm_f32x4_splat(CT_CNST::BETA_CbF);
+      v128_t beta_crf = wasm_f32x4_splat(CT_CNST::BETA_CrF);
+
+      const si32 *rp = r->i32 + src_line_offset;
+      const si32 *gp = g->i32 + src_line_offset;
+      const si32 *bp = b->i32 + src_line_offset;
+      float *yp = y->f32, *cbp = cb->f32, *crp = cr->f32;
+      for (int i = (width + 3) >> 2; i > 0; --i)
+      {
+        v128_t t;
+        t = wasm_i32x4_sub(wasm_v128_load(rp), half);
+        v128_t mr = wasm_f32x4_mul(wasm_f32x4_convert_i32x4(t), mul);
+        t = wasm_i32x4_sub(wasm_v128_load(gp), half);
+        v128_t mg = wasm_f32x4_mul(wasm_f32x4_convert_i32x4(t), mul);
+        t = wasm_i32x4_sub(wasm_v128_load(bp), half);
+        v128_t mb = wasm_f32x4_mul(wasm_f32x4_convert_i32x4(t), mul);
+
+        v128_t my = wasm_f32x4_mul(alpha_rf, mr);
+        my = wasm_f32x4_add(my, wasm_f32x4_mul(alpha_gf, mg));
+        my = wasm_f32x4_add(my, wasm_f32x4_mul(alpha_bf, mb));
+        wasm_v128_store(yp, my);
+        wasm_v128_store(cbp, wasm_f32x4_mul(beta_cbf, wasm_f32x4_sub(mb, my)));
+        wasm_v128_store(crp, wasm_f32x4_mul(beta_crf, wasm_f32x4_sub(mr, my)));
+
+        rp += 4; gp += 4; bp += 4;
+        yp += 4; cbp += 4; crp += 4;
+      }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    static inline
+    v128_t wasm_cnvrt_float_to_limited_i32x4(v128_t t, v128_t zero, 
+      v128_t half, v128_t fl_low_lim, v128_t fl_up_lim, 
+      v128_t s32_low_lim, v128_t s32_up_lim)
+    {
+      v128_t u = ojph_convert_float_to_i32(t, zero, half);
+      u = ojph_wasm_i32x4_max_ge(u, s32_low_lim, t, fl_low_lim);
+      u = ojph_wasm_i32x4_min_lt(u, s32_up_lim, t, fl_up_lim);
+      return u;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    void wasm_ict_backward_irv_convert_to_integer(
+      const line_buf *y, const line_buf *cb, const line_buf *cr,
+      line_buf *r, line_buf *g, line_buf *b, ui32 dst_line_offset,
+      ui32 bit_depth, bool is_signed, ui32 width)
+    {
+      assert((y->flags  & line_buf::LFT_32BIT) &&
+             (y->flags  & line_buf::LFT_INTEGER) == 0 &&
+             (cb->flags & line_buf::LFT_32BIT) &&
+             (cb->flags & line_buf::LFT_INTEGER) == 0 &&
+             (cr->flags & line_buf::LFT_32BIT) &&
+             (cr->flags & line_buf::LFT_INTEGER) == 0 &&
+             (r->flags  & line_buf::LFT_32BIT) &&
+             (r->flags  & line_buf::LFT_INTEGER) &&
+             (g->flags  & line_buf::LFT_32BIT) &&
+             (g->flags  & line_buf::LFT_INTEGER) &&
+             (b->flags  & line_buf::LFT_32BIT) &&
+             (b->flags  & line_buf::LFT_INTEGER));
+
+      assert(bit_depth <= 32);
+      // see local_wasm_irv_convert_to_integer for an explanation of limits
+      si32 neg_limit = (si32)INT_MIN >> (32 - bit_depth);
+      v128_t mul = wasm_f32x4_splat((float)(1ull << bit_depth));
+      v128_t fl_up_lim = wasm_f32x4_splat(-(float)neg_limit); // val < upper
+      v128_t fl_low_lim = wasm_f32x4_splat((float)neg_limit); // val >= lower
+      v128_t s32_up_lim = wasm_i32x4_splat(INT_MAX >> (32 - bit_depth));
+      v128_t s32_low_lim = wasm_i32x4_splat(INT_MIN >> (32 - bit_depth));
+      const v128_t zero = wasm_f32x4_splat(0.0f);
+      const v128_t half = wasm_f32x4_splat(0.5f);
+      v128_t ihalf = 
+        wasm_i32x4_splat(is_signed ? 0 : (si32)(1ULL << (bit_depth - 1)));
+      v128_t gamma_cr2g = wasm_f32x4_splat(CT_CNST::GAMMA_CR2G);
+      v128_t gamma_cb2g = wasm_f32x4_splat(CT_CNST::GAMMA_CB2G);
+      v128_t gamma_cr2r = wasm_f32x4_splat(CT_CNST::GAMMA_CR2R);
+      v128_t gamma_cb2b = wasm_f32x4_splat(CT_CNST::GAMMA_CB2B);
+
+      const float *yp = y->f32, *cbp = cb->f32, *crp = cr->f32;
+      si32 *rp = r->i32 + dst_line_offset;
+      si32 *gp = g->i32 + dst_line_offset;
+      si32 *bp = b->i32 + dst_line_offset;
+      for (int i = (width + 3) >> 2; i > 0; --i)
+      {
+        v128_t my = wasm_v128_load(yp);
+        v128_t mcr = wasm_v128_load(crp);
+        v128_t mcb = wasm_v128_load(cbp);
+        v128_t mg = wasm_f32x4_sub(my, wasm_f32x4_mul(gamma_cr2g, mcr));
+        mg = wasm_f32x4_sub(mg, wasm_f32x4_mul(gamma_cb2g, mcb));
+        v128_t mr = wasm_f32x4_add(my, wasm_f32x4_mul(gamma_cr2r, mcr));
+        v128_t mb = wasm_f32x4_add(my, wasm_f32x4_mul(gamma_cb2b, mcb));
+
+        v128_t u;
+        u = wasm_cnvrt_float_to_limited_i32x4(wasm_f32x4_mul(mr, mul),
+          zero, half, fl_low_lim, fl_up_lim, s32_low_lim, s32_up_lim);
+        wasm_v128_store(rp, wasm_i32x4_add(u, ihalf));
+        u = wasm_cnvrt_float_to_limited_i32x4(wasm_f32x4_mul(mg, mul),
+          zero, half, fl_low_lim, fl_up_lim, s32_low_lim, s32_up_lim);
+        wasm_v128_store(gp, wasm_i32x4_add(u, ihalf));
+        u = wasm_cnvrt_float_to_limited_i32x4(wasm_f32x4_mul(mb, mul),
+          zero, half, fl_low_lim, fl_up_lim, s32_low_lim, s32_up_lim);
+        wasm_v128_store(bp, wasm_i32x4_add(u, ihalf));
+
+        yp += 4; cbp += 4; crp += 4;
+        rp += 4; gp += 4; bp += 4;
+      }
+    }
+
   }
 }
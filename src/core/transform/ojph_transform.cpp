@@ -60,15 +60,21 @@ namespace ojph {
       (const lifting_step* s, const line_buf* sig, const line_buf* other,
         const line_buf* aug, ui32 repeat, bool synthesis) = NULL;
 
+    /////////////////////////////////////////////////////////////////////////
+    void (*rev_vert_53)
+      (const vert_step_lines* lines, ui32 repeat, bool synthesis) = NULL;
+
     /////////////////////////////////////////////////////////////////////////
     void (*rev_horz_ana)
       (const param_atk* atk, const line_buf* ldst, const line_buf* hdst,
-        const line_buf* src, ui32 width, bool even) = NULL;
+        const line_buf* src, ui32 width, bool even,
+        bool skip_last_step) = NULL;
 
     /////////////////////////////////////////////////////////////////////////
     void (*rev_horz_syn)
       (const param_atk* atk, const line_buf* dst, const line_buf* lsrc,
-        const line_buf* hsrc, ui32 width, bool even) = NULL;
+        const line_buf* hsrc, ui32 width, bool even,
+        bool skip_first_step) = NULL;
     
     /////////////////////////////////////////////////////////////////////////
     // Irreversible functions
@@ -83,15 +89,22 @@ namespace ojph {
     void (*irv_vert_times_K)
       (float K, const line_buf* aug, ui32 repeat) = NULL;
 
+    /////////////////////////////////////////////////////////////////////////
+    void (*irv_vert_97)
+      (const vert_step_lines* lines, const line_buf* times_K,
+        const line_buf* times_K_inv, ui32 repeat, bool synthesis) = NULL;
+
     /////////////////////////////////////////////////////////////////////////
     void (*irv_horz_ana)
       (const param_atk* atk, const line_buf* ldst, const line_buf* hdst,
-        const line_buf* src, ui32 width, bool even) = NULL;
+        const line_buf* src, ui32 width, bool even,
+        bool skip_last_step) = NULL;
 
     /////////////////////////////////////////////////////////////////////////
     void (*irv_horz_syn)
       (const param_atk* atk, const line_buf* dst, const line_buf* lsrc,
-        const line_buf* hsrc, ui32 width, bool even) = NULL;
+        const line_buf* hsrc, ui32 width, bool even,
+        bool skip_first_step) = NULL;
 
     ////////////////////////////////////////////////////////////////////////////
     static bool wavelet_transform_functions_initialized = false;
@@ -105,10 +118,12 @@ namespace ojph {
 #if !defined(OJPH_ENABLE_WASM_SIMD) || !defined(OJPH_EMSCRIPTEN)
 
       rev_vert_step             = gen_rev_vert_step;
+      rev_vert_53               = gen_rev_vert_53;
       rev_horz_ana              = gen_rev_horz_ana;
       rev_horz_syn              = gen_rev_horz_syn;
 
       irv_vert_step             = gen_irv_vert_step;
+      irv_vert_97               = gen_irv_vert_97;
       irv_vert_times_K          = gen_irv_vert_times_K;
       irv_horz_ana              = gen_irv_horz_ana;
       irv_horz_syn              = gen_irv_horz_syn;
@@ -121,6 +136,7 @@ namespace ojph {
         if (get_cpu_ext_level() >= X86_CPU_EXT_LEVEL_SSE)
         {
           irv_vert_step             = sse_irv_vert_step;
+          irv_vert_97               = sse_irv_vert_97;
           irv_vert_times_K          = sse_irv_vert_times_K;
           irv_horz_ana              = sse_irv_horz_ana;
           irv_horz_syn              = sse_irv_horz_syn;
@@ -131,6 +147,7 @@ namespace ojph {
         if (get_cpu_ext_level() >= X86_CPU_EXT_LEVEL_SSE2)
         {
           rev_vert_step             = sse2_rev_vert_step;
+          rev_vert_53               = sse2_rev_vert_53;
           rev_horz_ana              = sse2_rev_horz_ana;
           rev_horz_syn              = sse2_rev_horz_syn;
         }
@@ -140,6 +157,7 @@ namespace ojph {
         if (get_cpu_ext_level() >= X86_CPU_EXT_LEVEL_AVX)
         {
           irv_vert_step             = avx_irv_vert_step;
+          irv_vert_97               = avx_irv_vert_97;
           irv_vert_times_K          = avx_irv_vert_times_K;
           irv_horz_ana              = avx_irv_horz_ana;      
           irv_horz_syn              = avx_irv_horz_syn;
@@ -150,6 +168,7 @@ namespace ojph {
         if (get_cpu_ext_level() >= X86_CPU_EXT_LEVEL_AVX2)
         {
           rev_vert_step             = avx2_rev_vert_step;
+          rev_vert_53               = avx2_rev_vert_53;
           rev_horz_ana              = avx2_rev_horz_ana;
           rev_horz_syn              = avx2_rev_horz_syn;
         }
@@ -163,6 +182,7 @@ namespace ojph {
           // rev_horz_syn              = avx512_rev_horz_syn;
 
           irv_vert_step             = avx512_irv_vert_step;
+          irv_vert_97               = avx512_irv_vert_97;
           irv_vert_times_K          = avx512_irv_vert_times_K;
           irv_horz_ana              = avx512_irv_horz_ana;
           irv_horz_syn              = avx512_irv_horz_syn;
@@ -177,10 +197,12 @@ namespace ojph {
 
 #else // OJPH_ENABLE_WASM_SIMD
         rev_vert_step             = wasm_rev_vert_step;
+        rev_vert_53               = wasm_rev_vert_53;
         rev_horz_ana              = wasm_rev_horz_ana;
         rev_horz_syn              = wasm_rev_horz_syn;
         
         irv_vert_step             = wasm_irv_vert_step;
+        irv_vert_97               = wasm_irv_vert_97;
         irv_vert_times_K          = wasm_irv_vert_times_K;
         irv_horz_ana              = wasm_irv_horz_ana;
         irv_horz_syn              = wasm_irv_horz_syn;
@@ -320,11 +342,33 @@ namespace ojph {
       }
     }
 
+    /////////////////////////////////////////////////////////////////////////
+    void gen_rev_vert_53(const vert_step_lines* lines, ui32 repeat,
+                         bool synthesis)
+    {
+      si32* dst0 = lines[0].aug->i32;
+      const si32* src01 = lines[0].sig->i32, * src02 = lines[0].other->i32;
+      si32* dst1 = lines[1].aug->i32;
+      const si32* src11 = lines[1].sig->i32, * src12 = lines[1].other->i32;
+      if (synthesis)
+        for (ui32 i = 0; i < repeat; ++i)
+        {
+          dst0[i] -= (2 + src01[i] + src02[i]) >> 2; // 5/3 update
+          dst1[i] += (src11[i] + src12[i]) >> 1;     // 5/3 predict
+        }
+      else
+        for (ui32 i = 0; i < repeat; ++i)
+        {
+          dst0[i] -= (src01[i] + src02[i]) >> 1;     // 5/3 predict
+          dst1[i] += (2 + src11[i] + src12[i]) >> 2; // 5/3 update
+        }
+    }
+
     /////////////////////////////////////////////////////////////////////////
     static
     void gen_rev_horz_ana32(const param_atk* atk, const line_buf* ldst, 
                             const line_buf* hdst, const line_buf* src, 
-                            ui32 width, bool even)
+                            ui32 width, bool even, bool skip_last_step)
     {
       if (width > 1)
       {
@@ -350,7 +394,8 @@ namespace ojph {
         ui32 l_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 h_width = (width + (even ? 0 : 1)) >> 1;  // high pass
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = num_steps; j > 0; --j)
+        ui32 last_step = skip_last_step ? 1 : 0;
+        for (ui32 j = num_steps; j > last_step; --j)
         {
           // first lifting step
           const lifting_step* s = atk->get_step(j - 1);
@@ -403,7 +448,7 @@ namespace ojph {
     static
     void gen_rev_horz_ana64(const param_atk* atk, const line_buf* ldst, 
                             const line_buf* hdst, const line_buf* src, 
-                            ui32 width, bool even)
+                            ui32 width, bool even, bool skip_last_step)
     {
       if (width > 1)
       {
@@ -429,7 +474,8 @@ namespace ojph {
         ui32 l_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 h_width = (width + (even ? 0 : 1)) >> 1;  // high pass
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = num_steps; j > 0; --j)
+        ui32 last_step = skip_last_step ? 1 : 0;
+        for (ui32 j = num_steps; j > last_step; --j)
         {
           // first lifting step
           const lifting_step* s = atk->get_step(j - 1);
@@ -481,20 +527,20 @@ namespace ojph {
     /////////////////////////////////////////////////////////////////////////
     void gen_rev_horz_ana(const param_atk* atk, const line_buf* ldst, 
                           const line_buf* hdst, const line_buf* src, 
-                          ui32 width, bool even)
+                          ui32 width, bool even, bool skip_last_step)
     {
       if (src->flags & line_buf::LFT_32BIT) 
       {
         assert((ldst == NULL || ldst->flags & line_buf::LFT_32BIT) &&
                (hdst == NULL || hdst->flags & line_buf::LFT_32BIT));
-        gen_rev_horz_ana32(atk, ldst, hdst, src, width, even);
+        gen_rev_horz_ana32(atk, ldst, hdst, src, width, even, skip_last_step);
       }
       else 
       {
         assert((ldst == NULL || ldst->flags & line_buf::LFT_64BIT) &&
                (hdst == NULL || hdst->flags & line_buf::LFT_64BIT) && 
                (src == NULL || src->flags & line_buf::LFT_64BIT));
-        gen_rev_horz_ana64(atk, ldst, hdst, src, width, even);
+        gen_rev_horz_ana64(atk, ldst, hdst, src, width, even, skip_last_step);
       }
     }
 
@@ -502,7 +548,7 @@ namespace ojph {
     static
     void gen_rev_horz_syn32(const param_atk* atk, const line_buf* dst, 
                             const line_buf* lsrc, const line_buf* hsrc, 
-                            ui32 width, bool even)
+                            ui32 width, bool even, bool skip_first_step)
     {
       if (width > 1)
       {
@@ -511,7 +557,15 @@ namespace ojph {
         ui32 aug_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 oth_width = (width + (even ? 0 : 1)) >> 1;  // high pass
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = 0; j < num_steps; ++j)
+        ui32 first_step = 0;
+        if (skip_first_step)
+        { // the first lifting step is performed by the caller
+          si32* t = aug; aug = oth; oth = t;
+          ev = !ev;
+          ui32 w = aug_width; aug_width = oth_width; oth_width = w;
+          first_step = 1;
+        }
+        for (ui32 j = first_step; j < num_steps; ++j)
         {
           const lifting_step* s = atk->get_step(j);
           const si32 a = s->rev.Aatk;
@@ -581,7 +635,7 @@ namespace ojph {
     static
     void gen_rev_horz_syn64(const param_atk* atk, const line_buf* dst, 
                             const line_buf* lsrc, const line_buf* hsrc, 
-                            ui32 width, bool even)
+                            ui32 width, bool even, bool skip_first_step)
     {
       if (width > 1)
       {
@@ -590,7 +644,15 @@ namespace ojph {
         ui32 aug_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 oth_width = (width + (even ? 0 : 1)) >> 1;  // high pass
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = 0; j < num_steps; ++j)
+        ui32 first_step = 0;
+        if (skip_first_step)
+        { // the first lifting step is performed by the caller
+          si64* t = aug; aug = oth; oth = t;
+          ev = !ev;
+          ui32 w = aug_width; aug_width = oth_width; oth_width = w;
+          first_step = 1;
+        }
+        for (ui32 j = first_step; j < num_steps; ++j)
         {
           const lifting_step* s = atk->get_step(j);
           const si64 a = s->rev.Aatk;
@@ -659,20 +721,20 @@ namespace ojph {
     /////////////////////////////////////////////////////////////////////////
     void gen_rev_horz_syn(const param_atk* atk, const line_buf* dst, 
                           const line_buf* lsrc, const line_buf* hsrc, 
-                          ui32 width, bool even)
+                          ui32 width, bool even, bool skip_first_step)
     {
       if (dst->flags & line_buf::LFT_32BIT) 
       {
         assert((lsrc == NULL || lsrc->flags & line_buf::LFT_32BIT) && 
                (hsrc == NULL || hsrc->flags & line_buf::LFT_32BIT));
-        gen_rev_horz_syn32(atk, dst, lsrc, hsrc, width, even);
+        gen_rev_horz_syn32(atk, dst, lsrc, hsrc, width, even, skip_first_step);
       }
       else 
       {
         assert((dst == NULL || dst->flags & line_buf::LFT_64BIT) &&
                (lsrc == NULL || lsrc->flags & line_buf::LFT_64BIT) && 
                (hsrc == NULL || hsrc->flags & line_buf::LFT_64BIT));
-        gen_rev_horz_syn64(atk, dst, lsrc, hsrc, width, even);
+        gen_rev_horz_syn64(atk, dst, lsrc, hsrc, width, even, skip_first_step);
       }
     }    
 
@@ -700,10 +762,45 @@ namespace ojph {
         *dst++ *= K;
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void gen_irv_vert_97(const vert_step_lines* lines,
+                         const line_buf* times_K,
+                         const line_buf* times_K_inv, ui32 repeat,
+                         bool synthesis)
+    {
+      float a[4];
+      float* dst[4];
+      const float* src1[4], * src2[4];
+      for (int j = 0; j < 4; ++j)
+      {
+        a[j] = synthesis ? -irv97_A[j] : irv97_A[3 - j];
+        dst[j] = lines[j].aug->f32;
+        src1[j] = lines[j].sig->f32;
+        src2[j] = lines[j].other->f32;
+      }
+      const float K = irv97_K, K_inv = 1.0f / irv97_K;
+      float* kp = times_K ? times_K->f32 : NULL;
+      float* kip = times_K_inv ? times_K_inv->f32 : NULL;
+
+      for (ui32 i = 0; i < repeat; ++i)
+      {
+        if (synthesis) {
+          if (kp) kp[i] *= K;
+          if (kip) kip[i] *= K_inv;
+        }
+        for (int j = 0; j < 4; ++j)
+          dst[j][i] += a[j] * (src1[j][i] + src2[j][i]);
+        if (!synthesis) {
+          if (kp) kp[i] *= K;
+          if (kip) kip[i] *= K_inv;
+        }
+      }
+    }
+
     /////////////////////////////////////////////////////////////////////////
     void gen_irv_horz_ana(const param_atk* atk, const line_buf* ldst, 
                           const line_buf* hdst, const line_buf* src, 
-                          ui32 width, bool even)
+                          ui32 width, bool even, bool skip_last_step)
     {
       if (width > 1)
       {
@@ -729,7 +826,8 @@ namespace ojph {
         ui32 l_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 h_width = (width + (even ? 0 : 1)) >> 1;  // high pass
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = num_steps; j > 0; --j)
+        ui32 last_step = skip_last_step ? 1 : 0;
+        for (ui32 j = num_steps; j > last_step; --j)
         {
           const lifting_step* s = atk->get_step(j - 1);
           const float a = s->irv.Aatk;
@@ -749,6 +847,7 @@ namespace ojph {
           ui32 w = l_width; l_width = h_width; h_width = w;
         }
 
+        if (!skip_last_step)
         {
           float K = atk->get_K();
           float K_inv = 1.0f / K;
@@ -774,7 +873,7 @@ namespace ojph {
     //////////////////////////////////////////////////////////////////////////
     void gen_irv_horz_syn(const param_atk* atk, const line_buf* dst, 
                           const line_buf* lsrc, const line_buf* hsrc, 
-                          ui32 width, bool even)
+                          ui32 width, bool even, bool skip_first_step)
     {
       if (width > 1)
       {
@@ -783,6 +882,7 @@ namespace ojph {
         ui32 aug_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 oth_width = (width + (even ? 0 : 1)) >> 1;  // high pass
 
+        if (!skip_first_step)
         {
           float K = atk->get_K();
           float K_inv = 1.0f / K;
@@ -798,7 +898,15 @@ namespace ojph {
         }
 
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = 0; j < num_steps; ++j)
+        ui32 first_step = 0;
+        if (skip_first_step)
+        { // the first lifting step is performed by the caller
+          float* t = aug; aug = oth; oth = t;
+          ev = !ev;
+          ui32 w = aug_width; aug_width = oth_width; oth_width = w;
+          first_step = 1;
+        }
+        for (ui32 j = first_step; j < num_steps; ++j)
         {
           const lifting_step* s = atk->get_step(j);
           const float a = s->irv.Aatk;
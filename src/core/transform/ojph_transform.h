@@ -53,6 +53,14 @@ namespace ojph {
     //////////////////////////////////////////////////////////////////////////
     void init_wavelet_transform_functions();
 
+    //////////////////////////////////////////////////////////////////////////
+    // The lines taking part in one vertical lifting step; aug is updated
+    // from sig and other, as in rev_vert_step and irv_vert_step
+    struct vert_step_lines
+    {
+      const line_buf *sig, *other, *aug;
+    };
+
     /////////////////////////////////////////////////////////////////////////
     // Reversible functions
     /////////////////////////////////////////////////////////////////////////
@@ -62,15 +70,31 @@ namespace ojph {
       (const lifting_step* s, const line_buf* sig, const line_buf* other,
         const line_buf* aug, ui32 repeat, bool synthesis);
 
+    /////////////////////////////////////////////////////////////////////////
+    // Performs both vertical lifting steps of the default 5/3 wavelet in one
+    // pass over the lines; lines holds the two steps in the order they are
+    // applied.  Only 32bit lines are supported.
+    extern void (*rev_vert_53)
+      (const vert_step_lines* lines, ui32 repeat, bool synthesis);
+
+    /////////////////////////////////////////////////////////////////////////
+    // When skip_last_step is true, the horizontal analysis functions leave
+    // the last lifting step, and for the irreversible transform the K
+    // scaling, to the caller, which fuses them with codeblock quantization.
+    // Similarly, when skip_first_step is true, the horizontal synthesis
+    // functions expect the caller to have performed the K scaling and the
+    // first lifting step, fused with codeblock dequantization.
+    /////////////////////////////////////////////////////////////////////////
+
     /////////////////////////////////////////////////////////////////////////
     extern void (*rev_horz_ana)
       (const param_atk* atk, const line_buf* ldst, const line_buf* hdst,
-        const line_buf* src, ui32 width, bool even);
+        const line_buf* src, ui32 width, bool even, bool skip_last_step);
 
     /////////////////////////////////////////////////////////////////////////
     extern void (*rev_horz_syn)
       (const param_atk* atk, const line_buf* dst, const line_buf* lsrc,
-        const line_buf* hsrc, ui32 width, bool even);
+        const line_buf* hsrc, ui32 width, bool even, bool skip_first_step);
 
     /////////////////////////////////////////////////////////////////////////
     // Irreversible functions
@@ -85,15 +109,25 @@ namespace ojph {
     extern void (*irv_vert_times_K)
       (float K, const line_buf* aug, ui32 repeat);
 
+    /////////////////////////////////////////////////////////////////////////
+    // Performs the four vertical lifting steps of the default 9/7 wavelet,
+    // and the scaling of times_K by K and of times_K_inv by 1/K, in one
+    // pass over the lines; lines holds the steps in the order they are
+    // applied.  The scaling comes after the lifting steps for analysis,
+    // and before them for synthesis; times_K and times_K_inv can be NULL.
+    extern void (*irv_vert_97)
+      (const vert_step_lines* lines, const line_buf* times_K,
+        const line_buf* times_K_inv, ui32 repeat, bool synthesis);
+
     /////////////////////////////////////////////////////////////////////////
     extern void (*irv_horz_ana)
       (const param_atk* atk, const line_buf* ldst, const line_buf* hdst, 
-        const line_buf* src, ui32 width, bool even);
+        const line_buf* src, ui32 width, bool even, bool skip_last_step);
 
     /////////////////////////////////////////////////////////////////////////
     extern void (*irv_horz_syn)
       (const param_atk* atk, const line_buf* dst, const line_buf* lsrc, 
-        const line_buf* hsrc, ui32 width, bool even);
+        const line_buf* hsrc, ui32 width, bool even, bool skip_first_step);
 
   }
 }
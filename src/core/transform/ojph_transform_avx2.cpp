@@ -399,11 +399,46 @@ namespace ojph {
       }
     }
 
+    /////////////////////////////////////////////////////////////////////////
+    void avx2_rev_vert_53(const vert_step_lines* lines, ui32 repeat,
+                          bool synthesis)
+    {
+      si32* dst0 = lines[0].aug->i32;
+      const si32* src01 = lines[0].sig->i32, * src02 = lines[0].other->i32;
+      si32* dst1 = lines[1].aug->i32;
+      const si32* src11 = lines[1].sig->i32, * src12 = lines[1].other->i32;
+      __m256i two = _mm256_set1_epi32(2);
+      for (ui32 i = 0; i < repeat; i += 8)
+      {
+        __m256i s1 = _mm256_load_si256((__m256i*)(src01 + i));
+        __m256i s2 = _mm256_load_si256((__m256i*)(src02 + i));
+        __m256i d = _mm256_load_si256((__m256i*)(dst0 + i));
+        __m256i t = _mm256_add_epi32(s1, s2);
+        if (synthesis) // 5/3 update
+          d = _mm256_sub_epi32(d,
+            _mm256_srai_epi32(_mm256_add_epi32(two, t), 2));
+        else           // 5/3 predict
+          d = _mm256_sub_epi32(d, _mm256_srai_epi32(t, 1));
+        _mm256_store_si256((__m256i*)(dst0 + i), d);
+
+        s1 = _mm256_load_si256((__m256i*)(src11 + i));
+        s2 = _mm256_load_si256((__m256i*)(src12 + i));
+        d = _mm256_load_si256((__m256i*)(dst1 + i));
+        t = _mm256_add_epi32(s1, s2);
+        if (synthesis) // 5/3 predict
+          d = _mm256_add_epi32(d, _mm256_srai_epi32(t, 1));
+        else           // 5/3 update
+          d = _mm256_add_epi32(d,
+            _mm256_srai_epi32(_mm256_add_epi32(two, t), 2));
+        _mm256_store_si256((__m256i*)(dst1 + i), d);
+      }
+    }
+
     /////////////////////////////////////////////////////////////////////////
     static
     void avx2_rev_horz_ana32(const param_atk* atk, const line_buf* ldst, 
                              const line_buf* hdst, const line_buf* src, 
-                             ui32 width, bool even)
+                             ui32 width, bool even, bool skip_last_step)
     {
       if (width > 1)
       {
@@ -420,7 +455,8 @@ namespace ojph {
         ui32 l_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 h_width = (width + (even ? 0 : 1)) >> 1;  // high pass
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = num_steps; j > 0; --j)
+        ui32 last_step = skip_last_step ? 1 : 0;
+        for (ui32 j = num_steps; j > last_step; --j)
         {
           // first lifting step
           const lifting_step* s = atk->get_step(j - 1);
@@ -571,7 +607,7 @@ namespace ojph {
     static
     void avx2_rev_horz_ana64(const param_atk* atk, const line_buf* ldst, 
                              const line_buf* hdst, const line_buf* src, 
-                             ui32 width, bool even)
+                             ui32 width, bool even, bool skip_last_step)
     {
       if (width > 1)
       {
@@ -588,7 +624,8 @@ namespace ojph {
         ui32 l_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 h_width = (width + (even ? 0 : 1)) >> 1;  // high pass
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = num_steps; j > 0; --j)
+        ui32 last_step = skip_last_step ? 1 : 0;
+        for (ui32 j = num_steps; j > last_step; --j)
         {
           // first lifting step
           const lifting_step* s = atk->get_step(j - 1);
@@ -719,20 +756,20 @@ namespace ojph {
     /////////////////////////////////////////////////////////////////////////
     void avx2_rev_horz_ana(const param_atk* atk, const line_buf* ldst, 
                            const line_buf* hdst, const line_buf* src, 
-                           ui32 width, bool even)
+                           ui32 width, bool even, bool skip_last_step)
     {
       if (src->flags & line_buf::LFT_32BIT) 
       {
         assert((ldst == NULL || ldst->flags & line_buf::LFT_32BIT) &&
                (hdst == NULL || hdst->flags & line_buf::LFT_32BIT));
-        avx2_rev_horz_ana32(atk, ldst, hdst, src, width, even);
+        avx2_rev_horz_ana32(atk, ldst, hdst, src, width, even, skip_last_step);
       }
       else 
       {
         assert((ldst == NULL || ldst->flags & line_buf::LFT_64BIT) &&
                (hdst == NULL || hdst->flags & line_buf::LFT_64BIT) && 
                (src == NULL || src->flags & line_buf::LFT_64BIT));
-        avx2_rev_horz_ana64(atk, ldst, hdst, src, width, even);
+        avx2_rev_horz_ana64(atk, ldst, hdst, src, width, even, skip_last_step);
       }
     } 
     
@@ -740,7 +777,7 @@ namespace ojph {
     static
     void avx2_rev_horz_syn32(const param_atk* atk, const line_buf* dst, 
                              const line_buf* lsrc, const line_buf* hsrc, 
-                             ui32 width, bool even)
+                             ui32 width, bool even, bool skip_first_step)
     {
       if (width > 1)
       {
@@ -749,7 +786,15 @@ namespace ojph {
         ui32 aug_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 oth_width = (width + (even ? 0 : 1)) >> 1;  // high pass
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = 0; j < num_steps; ++j)
+        ui32 first_step = 0;
+        if (skip_first_step)
+        { // the first lifting step is performed by the caller
+          si32* t = aug; aug = oth; oth = t;
+          ev = !ev;
+          ui32 w = aug_width; aug_width = oth_width; oth_width = w;
+          first_step = 1;
+        }
+        for (ui32 j = first_step; j < num_steps; ++j)
         {
           const lifting_step* s = atk->get_step(j);
           const si32 a = s->rev.Aatk;
@@ -908,7 +953,7 @@ namespace ojph {
     static
     void avx2_rev_horz_syn64(const param_atk* atk, const line_buf* dst, 
                              const line_buf* lsrc, const line_buf* hsrc, 
-                             ui32 width, bool even)
+                             ui32 width, bool even, bool skip_first_step)
     {
       if (width > 1)
       {
@@ -917,7 +962,15 @@ namespace ojph {
         ui32 aug_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 oth_width = (width + (even ? 0 : 1)) >> 1;  // high pass
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = 0; j < num_steps; ++j)
+        ui32 first_step = 0;
+        if (skip_first_step)
+        { // the first lifting step is performed by the caller
+          si64* t = aug; aug = oth; oth = t;
+          ev = !ev;
+          ui32 w = aug_width; aug_width = oth_width; oth_width = w;
+          first_step = 1;
+        }
+        for (ui32 j = first_step; j < num_steps; ++j)
         {
           const lifting_step* s = atk->get_step(j);
           const si32 a = s->rev.Aatk;
@@ -1056,20 +1109,22 @@ namespace ojph {
     /////////////////////////////////////////////////////////////////////////
     void avx2_rev_horz_syn(const param_atk* atk, const line_buf* dst, 
                            const line_buf* lsrc, const line_buf* hsrc, 
-                           ui32 width, bool even)
+                           ui32 width, bool even, bool skip_first_step)
     {
       if (dst->flags & line_buf::LFT_32BIT) 
       {
         assert((lsrc == NULL || lsrc->flags & line_buf::LFT_32BIT) && 
                (hsrc == NULL || hsrc->flags & line_buf::LFT_32BIT));
-        avx2_rev_horz_syn32(atk, dst, lsrc, hsrc, width, even);
+        avx2_rev_horz_syn32(atk, dst, lsrc, hsrc, width, even,
+          skip_first_step);
       }
       else 
       {
         assert((dst == NULL || dst->flags & line_buf::LFT_64BIT) &&
                (lsrc == NULL || lsrc->flags & line_buf::LFT_64BIT) && 
                (hsrc == NULL || hsrc->flags & line_buf::LFT_64BIT));
-        avx2_rev_horz_syn64(atk, dst, lsrc, hsrc, width, even);
+        avx2_rev_horz_syn64(atk, dst, lsrc, hsrc, width, even,
+          skip_first_step);
       }
     }
 
@@ -234,10 +234,59 @@ namespace ojph {
       avx512_multiply_const(aug->f32, K, (int)repeat);
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void avx512_irv_vert_97(const vert_step_lines* lines,
+                            const line_buf* times_K,
+                            const line_buf* times_K_inv, ui32 repeat,
+                            bool synthesis)
+    {
+      __m512 factor[4];
+      float* dst[4];
+      const float* src1[4], * src2[4];
+      for (int j = 0; j < 4; ++j)
+      {
+        factor[j] = _mm512_set1_ps(synthesis ? -irv97_A[j] : irv97_A[3 - j]);
+        dst[j] = lines[j].aug->f32;
+        src1[j] = lines[j].sig->f32;
+        src2[j] = lines[j].other->f32;
+      }
+      __m512 K = _mm512_set1_ps(irv97_K);
+      __m512 K_inv = _mm512_set1_ps(1.0f / irv97_K);
+      float* kp = times_K ? times_K->f32 : NULL;
+      float* kip = times_K_inv ? times_K_inv->f32 : NULL;
+
+      for (ui32 i = 0; i < repeat; i += 16)
+      {
+        if (synthesis) {
+          if (kp)
+            _mm512_store_ps(kp + i, _mm512_mul_ps(K, _mm512_load_ps(kp + i)));
+          if (kip)
+            _mm512_store_ps(kip + i,
+              _mm512_mul_ps(K_inv, _mm512_load_ps(kip + i)));
+        }
+        for (int j = 0; j < 4; ++j)
+        {
+          __m512 s1 = _mm512_load_ps(src1[j] + i);
+          __m512 s2 = _mm512_load_ps(src2[j] + i);
+          __m512 d = _mm512_load_ps(dst[j] + i);
+          d = _mm512_add_ps(d,
+            _mm512_mul_ps(factor[j], _mm512_add_ps(s1, s2)));
+          _mm512_store_ps(dst[j] + i, d);
+        }
+        if (!synthesis) {
+          if (kp)
+            _mm512_store_ps(kp + i, _mm512_mul_ps(K, _mm512_load_ps(kp + i)));
+          if (kip)
+            _mm512_store_ps(kip + i,
+              _mm512_mul_ps(K_inv, _mm512_load_ps(kip + i)));
+        }
+      }
+    }
+
     /////////////////////////////////////////////////////////////////////////
     void avx512_irv_horz_ana(const param_atk* atk, const line_buf* ldst, 
                              const line_buf* hdst, const line_buf* src, 
-                             ui32 width, bool even)
+                             ui32 width, bool even, bool skip_last_step)
     {
       if (width > 1)
       {
@@ -255,7 +304,8 @@ namespace ojph {
         ui32 l_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 h_width = (width + (even ? 0 : 1)) >> 1;  // high pass
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = num_steps; j > 0; --j)
+        ui32 last_step = skip_last_step ? 1 : 0;
+        for (ui32 j = num_steps; j > last_step; --j)
         {
           const lifting_step* s = atk->get_step(j - 1);
           const float a = s->irv.Aatk;
@@ -297,6 +347,7 @@ namespace ojph {
           ui32 w = l_width; l_width = h_width; h_width = w;
         }
 
+        if (!skip_last_step)
         { // multiply by K or 1/K
           float K = atk->get_K();
           float K_inv = 1.0f / K;
@@ -315,7 +366,7 @@ namespace ojph {
     //////////////////////////////////////////////////////////////////////////
     void avx512_irv_horz_syn(const param_atk* atk, const line_buf* dst, 
                              const line_buf* lsrc, const line_buf* hsrc, 
-                             ui32 width, bool even)
+                             ui32 width, bool even, bool skip_first_step)
     {
       if (width > 1)
       {
@@ -324,6 +375,7 @@ namespace ojph {
         ui32 aug_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 oth_width = (width + (even ? 0 : 1)) >> 1;  // high pass
 
+        if (!skip_first_step)
         { // multiply by K or 1/K
           float K = atk->get_K();
           float K_inv = 1.0f / K;
@@ -333,7 +385,15 @@ namespace ojph {
 
         // the actual horizontal transform
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = 0; j < num_steps; ++j)
+        ui32 first_step = 0;
+        if (skip_first_step)
+        { // the first lifting step is performed by the caller
+          float* t = aug; aug = oth; oth = t;
+          ev = !ev;
+          ui32 w = aug_width; aug_width = oth_width; oth_width = w;
+          first_step = 1;
+        }
+        for (ui32 j = first_step; j < num_steps; ++j)
         {
           const lifting_step* s = atk->get_step(j);
           const float a = s->irv.Aatk;
@@ -690,7 +750,7 @@ namespace ojph {
     /////////////////////////////////////////////////////////////////////////
     void avx512_rev_horz_ana32(const param_atk* atk, const line_buf* ldst, 
                                const line_buf* hdst, const line_buf* src, 
-                               ui32 width, bool even)
+                               ui32 width, bool even, bool skip_last_step)
     {
       if (width > 1)
       {
@@ -707,7 +767,8 @@ namespace ojph {
         ui32 l_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 h_width = (width + (even ? 0 : 1)) >> 1;  // high pass
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = num_steps; j > 0; --j)
+        ui32 last_step = skip_last_step ? 1 : 0;
+        for (ui32 j = num_steps; j > last_step; --j)
         {
           // first lifting step
           const lifting_step* s = atk->get_step(j - 1);
@@ -857,7 +918,7 @@ namespace ojph {
     /////////////////////////////////////////////////////////////////////////
     void avx512_rev_horz_ana64(const param_atk* atk, const line_buf* ldst, 
                                const line_buf* hdst, const line_buf* src, 
-                               ui32 width, bool even)
+                               ui32 width, bool even, bool skip_last_step)
     {
       if (width > 1)
       {
@@ -874,7 +935,8 @@ namespace ojph {
         ui32 l_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 h_width = (width + (even ? 0 : 1)) >> 1;  // high pass
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = num_steps; j > 0; --j)
+        ui32 last_step = skip_last_step ? 1 : 0;
+        for (ui32 j = num_steps; j > last_step; --j)
         {
           // first lifting step
           const lifting_step* s = atk->get_step(j - 1);
@@ -1038,27 +1100,29 @@ namespace ojph {
     /////////////////////////////////////////////////////////////////////////
     void avx512_rev_horz_ana(const param_atk* atk, const line_buf* ldst, 
                              const line_buf* hdst, const line_buf* src, 
-                             ui32 width, bool even)
+                             ui32 width, bool even, bool skip_last_step)
     {
       if (src->flags & line_buf::LFT_32BIT) 
       {
         assert((ldst == NULL || ldst->flags & line_buf::LFT_32BIT) &&
                (hdst == NULL || hdst->flags & line_buf::LFT_32BIT));
-        avx512_rev_horz_ana32(atk, ldst, hdst, src, width, even);
+        avx512_rev_horz_ana32(atk, ldst, hdst, src, width, even,
+          skip_last_step);
       }
       else 
       {
         assert((ldst == NULL || ldst->flags & line_buf::LFT_64BIT) &&
                (hdst == NULL || hdst->flags & line_buf::LFT_64BIT) && 
                (src == NULL || src->flags & line_buf::LFT_64BIT));
-        avx512_rev_horz_ana64(atk, ldst, hdst, src, width, even);
+        avx512_rev_horz_ana64(atk, ldst, hdst, src, width, even,
+          skip_last_step);
       }
     } 
 
     //////////////////////////////////////////////////////////////////////////
     void avx512_rev_horz_syn32(const param_atk* atk, const line_buf* dst, 
                                const line_buf* lsrc, const line_buf* hsrc, 
-                               ui32 width, bool even)
+                               ui32 width, bool even, bool skip_first_step)
     {
       if (width > 1)
       {
@@ -1067,7 +1131,15 @@ namespace ojph {
         ui32 aug_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 oth_width = (width + (even ? 0 : 1)) >> 1;  // high pass
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = 0; j < num_steps; ++j)
+        ui32 first_step = 0;
+        if (skip_first_step)
+        { // the first lifting step is performed by the caller
+          si32* t = aug; aug = oth; oth = t;
+          ev = !ev;
+          ui32 w = aug_width; aug_width = oth_width; oth_width = w;
+          first_step = 1;
+        }
+        for (ui32 j = first_step; j < num_steps; ++j)
         {
           const lifting_step* s = atk->get_step(j);
           const si32 a = s->rev.Aatk;
@@ -1225,7 +1297,7 @@ namespace ojph {
     //////////////////////////////////////////////////////////////////////////
     void avx512_rev_horz_syn64(const param_atk* atk, const line_buf* dst, 
                                const line_buf* lsrc, const line_buf* hsrc, 
-                               ui32 width, bool even)
+                               ui32 width, bool even, bool skip_first_step)
     {
       if (width > 1)
       {
@@ -1234,7 +1306,15 @@ namespace ojph {
         ui32 aug_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 oth_width = (width + (even ? 0 : 1)) >> 1;  // high pass
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = 0; j < num_steps; ++j)
+        ui32 first_step = 0;
+        if (skip_first_step)
+        { // the first lifting step is performed by the caller
+          si64* t = aug; aug = oth; oth = t;
+          ev = !ev;
+          ui32 w = aug_width; aug_width = oth_width; oth_width = w;
+          first_step = 1;
+        }
+        for (ui32 j = first_step; j < num_steps; ++j)
         {
           const lifting_step* s = atk->get_step(j);
           const si32 a = s->rev.Aatk;
@@ -1406,20 +1486,22 @@ namespace ojph {
     /////////////////////////////////////////////////////////////////////////
     void avx512_rev_horz_syn(const param_atk* atk, const line_buf* dst, 
                              const line_buf* lsrc, const line_buf* hsrc, 
-                             ui32 width, bool even)
+                             ui32 width, bool even, bool skip_first_step)
     {
       if (dst->flags & line_buf::LFT_32BIT) 
       {
         assert((lsrc == NULL || lsrc->flags & line_buf::LFT_32BIT) && 
                (hsrc == NULL || hsrc->flags & line_buf::LFT_32BIT));
-        avx512_rev_horz_syn32(atk, dst, lsrc, hsrc, width, even);
+        avx512_rev_horz_syn32(atk, dst, lsrc, hsrc, width, even,
+          skip_first_step);
       }
       else 
       {
         assert((dst == NULL || dst->flags & line_buf::LFT_64BIT) &&
                (lsrc == NULL || lsrc->flags & line_buf::LFT_64BIT) && 
                (hsrc == NULL || hsrc->flags & line_buf::LFT_64BIT));
-        avx512_rev_horz_syn64(atk, dst, lsrc, hsrc, width, even);
+        avx512_rev_horz_syn64(atk, dst, lsrc, hsrc, width, even,
+          skip_first_step);
       }
     }
 
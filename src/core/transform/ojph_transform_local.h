@@ -49,6 +49,7 @@ namespace ojph {
   namespace local {
     struct param_atk;
     union lifting_step;
+    struct vert_step_lines;
 
     //////////////////////////////////////////////////////////////////////////
     //
@@ -67,18 +68,24 @@ namespace ojph {
                            const line_buf* other, const line_buf* aug, 
                            ui32 repeat, bool synthesis);
 
+    /////////////////////////////////////////////////////////////////////////
+    void gen_irv_vert_97(const vert_step_lines* lines,
+                         const line_buf* times_K,
+                         const line_buf* times_K_inv, ui32 repeat,
+                         bool synthesis);
+
     /////////////////////////////////////////////////////////////////////////
     void gen_irv_vert_times_K(float K, const line_buf* aug, ui32 repeat);
 
     /////////////////////////////////////////////////////////////////////////
     void gen_irv_horz_ana(const param_atk* atk, const line_buf* ldst, 
                           const line_buf* hdst, const line_buf* src, 
-                          ui32 width, bool even);
+                          ui32 width, bool even, bool skip_last_step);
 
     /////////////////////////////////////////////////////////////////////////
     void gen_irv_horz_syn(const param_atk *atk, const line_buf* dst, 
                           const line_buf *lsrc, const line_buf *hsrc, 
-                          ui32 width, bool even);
+                          ui32 width, bool even, bool skip_first_step);
 
     //////////////////////////////////////////////////////////////////////////
     // Reversible functions
@@ -89,15 +96,19 @@ namespace ojph {
                            const line_buf* other, const line_buf* aug, 
                            ui32 repeat, bool synthesis);
 
+    /////////////////////////////////////////////////////////////////////////
+    void gen_rev_vert_53(const vert_step_lines* lines, ui32 repeat,
+                         bool synthesis);
+
     /////////////////////////////////////////////////////////////////////////
     void gen_rev_horz_ana(const param_atk* atk, const line_buf* ldst, 
                           const line_buf* hdst, const line_buf* src, 
-                          ui32 width, bool even);
+                          ui32 width, bool even, bool skip_last_step);
 
     /////////////////////////////////////////////////////////////////////////
     void gen_rev_horz_syn(const param_atk* atk, const line_buf* dst, 
                           const line_buf* lsrc, const line_buf* hsrc, 
-                          ui32 width, bool even);
+                          ui32 width, bool even, bool skip_first_step);
 
     //////////////////////////////////////////////////////////////////////////
     //
@@ -116,18 +127,24 @@ namespace ojph {
                            const line_buf* other, const line_buf* aug, 
                            ui32 repeat, bool synthesis);
 
+    /////////////////////////////////////////////////////////////////////////
+    void sse_irv_vert_97(const vert_step_lines* lines,
+                         const line_buf* times_K,
+                         const line_buf* times_K_inv, ui32 repeat,
+                         bool synthesis);
+
     /////////////////////////////////////////////////////////////////////////
     void sse_irv_vert_times_K(float K, const line_buf* aug, ui32 repeat);
 
     /////////////////////////////////////////////////////////////////////////
     void sse_irv_horz_ana(const param_atk* atk, const line_buf* ldst,
                           const line_buf* hdst, const line_buf* src, 
-                          ui32 width, bool even);
+                          ui32 width, bool even, bool skip_last_step);
 
     /////////////////////////////////////////////////////////////////////////
     void sse_irv_horz_syn(const param_atk *atk, const line_buf* dst,
                           const line_buf *lsrc, const line_buf *hsrc, 
-                          ui32 width, bool even);
+                          ui32 width, bool even, bool skip_first_step);
 
     //////////////////////////////////////////////////////////////////////////
     //
@@ -146,15 +163,19 @@ namespace ojph {
                             const line_buf* other, const line_buf* aug, 
                             ui32 repeat, bool synthesis);
 
+    /////////////////////////////////////////////////////////////////////////
+    void sse2_rev_vert_53(const vert_step_lines* lines, ui32 repeat,
+                          bool synthesis);
+
     /////////////////////////////////////////////////////////////////////////
     void sse2_rev_horz_ana(const param_atk* atk, const line_buf* ldst,
                            const line_buf* hdst, const line_buf* src, 
-                           ui32 width, bool even);
+                           ui32 width, bool even, bool skip_last_step);
 
     /////////////////////////////////////////////////////////////////////////
     void sse2_rev_horz_syn(const param_atk* atk, const line_buf* dst,
                            const line_buf* lsrc, const line_buf* hsrc, 
-                           ui32 width, bool even);
+                           ui32 width, bool even, bool skip_first_step);
 
 
     //////////////////////////////////////////////////////////////////////////
@@ -174,18 +195,24 @@ namespace ojph {
                            const line_buf* other, const line_buf* aug, 
                            ui32 repeat, bool synthesis);
 
+    /////////////////////////////////////////////////////////////////////////
+    void avx_irv_vert_97(const vert_step_lines* lines,
+                         const line_buf* times_K,
+                         const line_buf* times_K_inv, ui32 repeat,
+                         bool synthesis);
+
     /////////////////////////////////////////////////////////////////////////
     void avx_irv_vert_times_K(float K, const line_buf* aug, ui32 repeat);
 
     /////////////////////////////////////////////////////////////////////////
     void avx_irv_horz_ana(const param_atk* atk, const line_buf* ldst,
                           const line_buf* hdst, const line_buf* src, 
-                          ui32 width, bool even);
+                          ui32 width, bool even, bool skip_last_step);
 
     /////////////////////////////////////////////////////////////////////////
     void avx_irv_horz_syn(const param_atk *atk, const line_buf* dst,
                           const line_buf *lsrc, const line_buf *hsrc, 
-                          ui32 width, bool even);
+                          ui32 width, bool even, bool skip_first_step);
 
     //////////////////////////////////////////////////////////////////////////
     //
@@ -204,15 +231,19 @@ namespace ojph {
                             const line_buf* other, const line_buf* aug, 
                             ui32 repeat, bool synthesis);
 
+    /////////////////////////////////////////////////////////////////////////
+    void avx2_rev_vert_53(const vert_step_lines* lines, ui32 repeat,
+                          bool synthesis);
+
     /////////////////////////////////////////////////////////////////////////
     void avx2_rev_horz_ana(const param_atk* atk, const line_buf* ldst,
                            const line_buf* hdst, const line_buf* src, 
-                           ui32 width, bool even);
+                           ui32 width, bool even, bool skip_last_step);
 
     /////////////////////////////////////////////////////////////////////////
     void avx2_rev_horz_syn(const param_atk* atk, const line_buf* dst,
                            const line_buf* lsrc, const line_buf* hsrc, 
-                           ui32 width, bool even);
+                           ui32 width, bool even, bool skip_first_step);
 
     //////////////////////////////////////////////////////////////////////////
     //
@@ -231,18 +262,24 @@ namespace ojph {
                               const line_buf* other, const line_buf* aug, 
                               ui32 repeat, bool synthesis);
 
+    /////////////////////////////////////////////////////////////////////////
+    void avx512_irv_vert_97(const vert_step_lines* lines,
+                            const line_buf* times_K,
+                            const line_buf* times_K_inv, ui32 repeat,
+                            bool synthesis);
+
     /////////////////////////////////////////////////////////////////////////
     void avx512_irv_vert_times_K(float K, const line_buf* aug, ui32 repeat);
 
     /////////////////////////////////////////////////////////////////////////
     void avx512_irv_horz_ana(const param_atk* atk, const line_buf* ldst,
                              const line_buf* hdst, const line_buf* src, 
-                             ui32 width, bool even);
+                             ui32 width, bool even, bool skip_last_step);
 
     /////////////////////////////////////////////////////////////////////////
     void avx512_irv_horz_syn(const param_atk *atk, const line_buf* dst,
                              const line_buf *lsrc, const line_buf *hsrc, 
-                             ui32 width, bool even);
+                             ui32 width, bool even, bool skip_first_step);
 
 
     //////////////////////////////////////////////////////////////////////////
@@ -257,12 +294,12 @@ namespace ojph {
     /////////////////////////////////////////////////////////////////////////
     void avx512_rev_horz_ana(const param_atk* atk, const line_buf* ldst,
                              const line_buf* hdst, const line_buf* src, 
-                             ui32 width, bool even);
+                             ui32 width, bool even, bool skip_last_step);
 
     /////////////////////////////////////////////////////////////////////////
     void avx512_rev_horz_syn(const param_atk* atk, const line_buf* dst,
                              const line_buf* lsrc, const line_buf* hsrc, 
-                             ui32 width, bool even);
+                             ui32 width, bool even, bool skip_first_step);
 
     //////////////////////////////////////////////////////////////////////////
     //
@@ -281,18 +318,24 @@ namespace ojph {
                             const line_buf* other, const line_buf* aug, 
                             ui32 repeat, bool synthesis);
 
+    /////////////////////////////////////////////////////////////////////////
+    void wasm_irv_vert_97(const vert_step_lines* lines,
+                          const line_buf* times_K,
+                          const line_buf* times_K_inv, ui32 repeat,
+                          bool synthesis);
+
     /////////////////////////////////////////////////////////////////////////
     void wasm_irv_vert_times_K(float K, const line_buf* aug, ui32 repeat);
 
     /////////////////////////////////////////////////////////////////////////
     void wasm_irv_horz_ana(const param_atk* atk, const line_buf* ldst,
                            const line_buf* hdst, const line_buf* src, 
-                           ui32 width, bool even);
+                           ui32 width, bool even, bool skip_last_step);
 
     /////////////////////////////////////////////////////////////////////////
     void wasm_irv_horz_syn(const param_atk *atk, const line_buf* dst,
                            const line_buf *lsrc, const line_buf *hsrc, 
-                           ui32 width, bool even);
+                           ui32 width, bool even, bool skip_first_step);
 
     //////////////////////////////////////////////////////////////////////////
     // Reversible functions
@@ -303,15 +346,19 @@ namespace ojph {
                             const line_buf* other, const line_buf* aug, 
                             ui32 repeat, bool synthesis);
 
+    /////////////////////////////////////////////////////////////////////////
+    void wasm_rev_vert_53(const vert_step_lines* lines, ui32 repeat,
+                          bool synthesis);
+
     /////////////////////////////////////////////////////////////////////////
     void wasm_rev_horz_ana(const param_atk* atk, const line_buf* ldst,
                            const line_buf* hdst, const line_buf* src, 
-                           ui32 width, bool even);
+                           ui32 width, bool even, bool skip_last_step);
 
     /////////////////////////////////////////////////////////////////////////
     void wasm_rev_horz_syn(const param_atk* atk, const line_buf* dst,
                            const line_buf* lsrc, const line_buf* hsrc, 
-                           ui32 width, bool even);
+                           ui32 width, bool even, bool skip_first_step);
   }
 }
 
@@ -123,10 +123,53 @@ namespace ojph {
       sse_multiply_const(aug->f32, K, (int)repeat);
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void sse_irv_vert_97(const vert_step_lines* lines,
+                         const line_buf* times_K,
+                         const line_buf* times_K_inv, ui32 repeat,
+                         bool synthesis)
+    {
+      __m128 factor[4];
+      float* dst[4];
+      const float* src1[4], * src2[4];
+      for (int j = 0; j < 4; ++j)
+      {
+        factor[j] = _mm_set1_ps(synthesis ? -irv97_A[j] : irv97_A[3 - j]);
+        dst[j] = lines[j].aug->f32;
+        src1[j] = lines[j].sig->f32;
+        src2[j] = lines[j].other->f32;
+      }
+      __m128 K = _mm_set1_ps(irv97_K), K_inv = _mm_set1_ps(1.0f / irv97_K);
+      float* kp = times_K ? times_K->f32 : NULL;
+      float* kip = times_K_inv ? times_K_inv->f32 : NULL;
+
+      for (ui32 i = 0; i < repeat; i += 4)
+      {
+        if (synthesis) {
+          if (kp) _mm_store_ps(kp + i, _mm_mul_ps(K, _mm_load_ps(kp + i)));
+          if (kip)
+            _mm_store_ps(kip + i, _mm_mul_ps(K_inv, _mm_load_ps(kip + i)));
+        }
+        for (int j = 0; j < 4; ++j)
+        {
+          __m128 s1 = _mm_load_ps(src1[j] + i);
+          __m128 s2 = _mm_load_ps(src2[j] + i);
+          __m128 d  = _mm_load_ps(dst[j] + i);
+          d = _mm_add_ps(d, _mm_mul_ps(factor[j], _mm_add_ps(s1, s2)));
+          _mm_store_ps(dst[j] + i, d);
+        }
+        if (!synthesis) {
+          if (kp) _mm_store_ps(kp + i, _mm_mul_ps(K, _mm_load_ps(kp + i)));
+          if (kip)
+            _mm_store_ps(kip + i, _mm_mul_ps(K_inv, _mm_load_ps(kip + i)));
+        }
+      }
+    }
+
     /////////////////////////////////////////////////////////////////////////
     void sse_irv_horz_ana(const param_atk* atk, const line_buf* ldst, 
                           const line_buf* hdst, const line_buf* src, 
-                          ui32 width, bool even)
+                          ui32 width, bool even, bool skip_last_step)
     {
       if (width > 1)
       {
@@ -144,7 +187,8 @@ namespace ojph {
         ui32 l_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 h_width = (width + (even ? 0 : 1)) >> 1;  // high pass
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = num_steps; j > 0; --j)
+        ui32 last_step = skip_last_step ? 1 : 0;
+        for (ui32 j = num_steps; j > last_step; --j)
         {
           const lifting_step* s = atk->get_step(j - 1);
           const float a = s->irv.Aatk;
@@ -186,6 +230,7 @@ namespace ojph {
           ui32 w = l_width; l_width = h_width; h_width = w;
         }
 
+        if (!skip_last_step)
         { // multiply by K or 1/K
           float K = atk->get_K();
           float K_inv = 1.0f / K;
@@ -204,7 +249,7 @@ namespace ojph {
     //////////////////////////////////////////////////////////////////////////
     void sse_irv_horz_syn(const param_atk* atk, const line_buf* dst, 
                           const line_buf* lsrc, const line_buf* hsrc, 
-                          ui32 width, bool even)
+                          ui32 width, bool even, bool skip_first_step)
     {
       if (width > 1)
       {
@@ -213,6 +258,7 @@ namespace ojph {
         ui32 aug_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 oth_width = (width + (even ? 0 : 1)) >> 1;  // high pass
 
+        if (!skip_first_step)
         { // multiply by K or 1/K
           float K = atk->get_K();
           float K_inv = 1.0f / K;
@@ -222,7 +268,15 @@ namespace ojph {
 
         // the actual horizontal transform
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = 0; j < num_steps; ++j)
+        ui32 first_step = 0;
+        if (skip_first_step)
+        { // the first lifting step is performed by the caller
+          float* t = aug; aug = oth; oth = t;
+          ev = !ev;
+          ui32 w = aug_width; aug_width = oth_width; oth_width = w;
+          first_step = 1;
+        }
+        for (ui32 j = first_step; j < num_steps; ++j)
         {
           const lifting_step* s = atk->get_step(j);
           const float a = s->irv.Aatk;
@@ -370,11 +370,44 @@ namespace ojph {
       }
     }
 
+    /////////////////////////////////////////////////////////////////////////
+    void sse2_rev_vert_53(const vert_step_lines* lines, ui32 repeat,
+                          bool synthesis)
+    {
+      si32* dst0 = lines[0].aug->i32;
+      const si32* src01 = lines[0].sig->i32, * src02 = lines[0].other->i32;
+      si32* dst1 = lines[1].aug->i32;
+      const si32* src11 = lines[1].sig->i32, * src12 = lines[1].other->i32;
+      __m128i two = _mm_set1_epi32(2);
+      for (ui32 i = 0; i < repeat; i += 4)
+      {
+        __m128i s1 = _mm_load_si128((__m128i*)(src01 + i));
+        __m128i s2 = _mm_load_si128((__m128i*)(src02 + i));
+        __m128i d = _mm_load_si128((__m128i*)(dst0 + i));
+        __m128i t = _mm_add_epi32(s1, s2);
+        if (synthesis) // 5/3 update
+          d = _mm_sub_epi32(d, _mm_srai_epi32(_mm_add_epi32(two, t), 2));
+        else           // 5/3 predict
+          d = _mm_sub_epi32(d, _mm_srai_epi32(t, 1));
+        _mm_store_si128((__m128i*)(dst0 + i), d);
+
+        s1 = _mm_load_si128((__m128i*)(src11 + i));
+        s2 = _mm_load_si128((__m128i*)(src12 + i));
+        d = _mm_load_si128((__m128i*)(dst1 + i));
+        t = _mm_add_epi32(s1, s2);
+        if (synthesis) // 5/3 predict
+          d = _mm_add_epi32(d, _mm_srai_epi32(t, 1));
+        else           // 5/3 update
+          d = _mm_add_epi32(d, _mm_srai_epi32(_mm_add_epi32(two, t), 2));
+        _mm_store_si128((__m128i*)(dst1 + i), d);
+      }
+    }
+
     /////////////////////////////////////////////////////////////////////////
     static
     void sse2_rev_horz_ana32(const param_atk* atk, const line_buf* ldst, 
                              const line_buf* hdst, const line_buf* src, 
-                             ui32 width, bool even)
+                             ui32 width, bool even, bool skip_last_step)
     {
       if (width > 1)
       {
@@ -391,7 +424,8 @@ namespace ojph {
         ui32 l_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 h_width = (width + (even ? 0 : 1)) >> 1;  // high pass
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = num_steps; j > 0; --j)
+        ui32 last_step = skip_last_step ? 1 : 0;
+        for (ui32 j = num_steps; j > last_step; --j)
         {
           // first lifting step
           const lifting_step* s = atk->get_step(j - 1);
@@ -521,7 +555,7 @@ namespace ojph {
     static
     void sse2_rev_horz_ana64(const param_atk* atk, const line_buf* ldst, 
                              const line_buf* hdst, const line_buf* src, 
-                             ui32 width, bool even)
+                             ui32 width, bool even, bool skip_last_step)
     {
       if (width > 1)
       {
@@ -538,7 +572,8 @@ namespace ojph {
         ui32 l_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 h_width = (width + (even ? 0 : 1)) >> 1;  // high pass
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = num_steps; j > 0; --j)
+        ui32 last_step = skip_last_step ? 1 : 0;
+        for (ui32 j = num_steps; j > last_step; --j)
         {
           // first lifting step
           const lifting_step* s = atk->get_step(j - 1);
@@ -668,27 +703,27 @@ namespace ojph {
     /////////////////////////////////////////////////////////////////////////
     void sse2_rev_horz_ana(const param_atk* atk, const line_buf* ldst, 
                            const line_buf* hdst, const line_buf* src, 
-                           ui32 width, bool even)
+                           ui32 width, bool even, bool skip_last_step)
     {
       if (src->flags & line_buf::LFT_32BIT) 
       {
         assert((ldst == NULL || ldst->flags & line_buf::LFT_32BIT) &&
                (hdst == NULL || hdst->flags & line_buf::LFT_32BIT));
-        sse2_rev_horz_ana32(atk, ldst, hdst, src, width, even);
+        sse2_rev_horz_ana32(atk, ldst, hdst, src, width, even, skip_last_step);
       }
       else 
       {
         assert((ldst == NULL || ldst->flags & line_buf::LFT_64BIT) &&
                (hdst == NULL || hdst->flags & line_buf::LFT_64BIT) && 
                (src == NULL || src->flags & line_buf::LFT_64BIT));
-        sse2_rev_horz_ana64(atk, ldst, hdst, src, width, even);
+        sse2_rev_horz_ana64(atk, ldst, hdst, src, width, even, skip_last_step);
       }
     }    
     
     //////////////////////////////////////////////////////////////////////////
     void sse2_rev_horz_syn32(const param_atk* atk, const line_buf* dst, 
                              const line_buf* lsrc, const line_buf* hsrc, 
-                             ui32 width, bool even)
+                             ui32 width, bool even, bool skip_first_step)
     {
       if (width > 1)
       {
@@ -697,7 +732,15 @@ namespace ojph {
         ui32 aug_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 oth_width = (width + (even ? 0 : 1)) >> 1;  // high pass
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = 0; j < num_steps; ++j)
+        ui32 first_step = 0;
+        if (skip_first_step)
+        { // the first lifting step is performed by the caller
+          si32* t = aug; aug = oth; oth = t;
+          ev = !ev;
+          ui32 w = aug_width; aug_width = oth_width; oth_width = w;
+          first_step = 1;
+        }
+        for (ui32 j = first_step; j < num_steps; ++j)
         {
           const lifting_step* s = atk->get_step(j);
           const si32 a = s->rev.Aatk;
@@ -836,7 +879,7 @@ namespace ojph {
     //////////////////////////////////////////////////////////////////////////
     void sse2_rev_horz_syn64(const param_atk* atk, const line_buf* dst, 
                              const line_buf* lsrc, const line_buf* hsrc, 
-                             ui32 width, bool even)
+                             ui32 width, bool even, bool skip_first_step)
     {
       if (width > 1)
       {
@@ -845,7 +888,15 @@ namespace ojph {
         ui32 aug_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 oth_width = (width + (even ? 0 : 1)) >> 1;  // high pass
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = 0; j < num_steps; ++j)
+        ui32 first_step = 0;
+        if (skip_first_step)
+        { // the first lifting step is performed by the caller
+          si64* t = aug; aug = oth; oth = t;
+          ev = !ev;
+          ui32 w = aug_width; aug_width = oth_width; oth_width = w;
+          first_step = 1;
+        }
+        for (ui32 j = first_step; j < num_steps; ++j)
         {
           const lifting_step* s = atk->get_step(j);
           const si32 a = s->rev.Aatk;
@@ -983,20 +1034,22 @@ namespace ojph {
     /////////////////////////////////////////////////////////////////////////
     void sse2_rev_horz_syn(const param_atk* atk, const line_buf* dst, 
                            const line_buf* lsrc, const line_buf* hsrc, 
-                           ui32 width, bool even)
+                           ui32 width, bool even, bool skip_first_step)
     {
       if (dst->flags & line_buf::LFT_32BIT) 
       {
         assert((lsrc == NULL || lsrc->flags & line_buf::LFT_32BIT) && 
                (hsrc == NULL || hsrc->flags & line_buf::LFT_32BIT));
-        sse2_rev_horz_syn32(atk, dst, lsrc, hsrc, width, even);
+        sse2_rev_horz_syn32(atk, dst, lsrc, hsrc, width, even,
+          skip_first_step);
       }
       else 
       {
         assert((dst == NULL || dst->flags & line_buf::LFT_64BIT) &&
                (lsrc == NULL || lsrc->flags & line_buf::LFT_64BIT) && 
                (hsrc == NULL || hsrc->flags & line_buf::LFT_64BIT));
-        sse2_rev_horz_syn64(atk, dst, lsrc, hsrc, width, even);
+        sse2_rev_horz_syn64(atk, dst, lsrc, hsrc, width, even,
+          skip_first_step);
       }
     }    
 
@@ -155,10 +155,59 @@ namespace ojph {
       wasm_multiply_const(aug->f32, K, (int)repeat);
     }
 
+    //////////////////////////////////////////////////////////////////////////
+    void wasm_irv_vert_97(const vert_step_lines* lines,
+                          const line_buf* times_K,
+                          const line_buf* times_K_inv, ui32 repeat,
+                          bool synthesis)
+    {
+      v128_t factor[4];
+      float* dst[4];
+      const float* src1[4], * src2[4];
+      for (int j = 0; j < 4; ++j)
+      {
+        factor[j] = wasm_f32x4_splat(synthesis ? -irv97_A[j] : irv97_A[3 - j]);
+        dst[j] = lines[j].aug->f32;
+        src1[j] = lines[j].sig->f32;
+        src2[j] = lines[j].other->f32;
+      }
+      v128_t K = wasm_f32x4_splat(irv97_K);
+      v128_t K_inv = wasm_f32x4_splat(1.0f / irv97_K);
+      float* kp = times_K ? times_K->f32 : NULL;
+      float* kip = times_K_inv ? times_K_inv->f32 : NULL;
+
+      for (ui32 i = 0; i < repeat; i += 4)
+      {
+        if (synthesis) {
+          if (kp)
+            wasm_v128_store(kp + i, wasm_f32x4_mul(K, wasm_v128_load(kp + i)));
+          if (kip)
+            wasm_v128_store(kip + i,
+              wasm_f32x4_mul(K_inv, wasm_v128_load(kip + i)));
+        }
+        for (int j = 0; j < 4; ++j)
+        {
+          v128_t s1 = wasm_v128_load(src1[j] + i);
+          v128_t s2 = wasm_v128_load(src2[j] + i);
+          v128_t d  = wasm_v128_load(dst[j] + i);
+          d = wasm_f32x4_add(d,
+            wasm_f32x4_mul(factor[j], wasm_f32x4_add(s1, s2)));
+          wasm_v128_store(dst[j] + i, d);
+        }
+        if (!synthesis) {
+          if (kp)
+            wasm_v128_store(kp + i, wasm_f32x4_mul(K, wasm_v128_load(kp + i)));
+          if (kip)
+            wasm_v128_store(kip + i,
+              wasm_f32x4_mul(K_inv, wasm_v128_load(kip + i)));
+        }
+      }
+    }
+
     /////////////////////////////////////////////////////////////////////////
     void wasm_irv_horz_ana(const param_atk* atk, const line_buf* ldst, 
                            const line_buf* hdst, const line_buf* src, 
-                           ui32 width, bool even)
+                           ui32 width, bool even, bool skip_last_step)
     {
       if (width > 1)
       {
@@ -176,7 +225,8 @@ namespace ojph {
         ui32 l_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 h_width = (width + (even ? 0 : 1)) >> 1;  // high pass
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = num_steps; j > 0; --j)
+        ui32 last_step = skip_last_step ? 1 : 0;
+        for (ui32 j = num_steps; j > last_step; --j)
         {
           const lifting_step* s = atk->get_step(j - 1);
           const float a = s->irv.Aatk;
@@ -218,6 +268,7 @@ namespace ojph {
           ui32 w = l_width; l_width = h_width; h_width = w;
         }
 
+        if (!skip_last_step)
         { // multiply by K or 1/K
           float K = atk->get_K();
           float K_inv = 1.0f / K;
@@ -236,7 +287,7 @@ namespace ojph {
     //////////////////////////////////////////////////////////////////////////
     void wasm_irv_horz_syn(const param_atk* atk, const line_buf* dst, 
                            const line_buf* lsrc, const line_buf* hsrc, 
-                           ui32 width, bool even)
+                           ui32 width, bool even, bool skip_first_step)
     {
       if (width > 1)
       {
@@ -245,6 +296,7 @@ namespace ojph {
         ui32 aug_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 oth_width = (width + (even ? 0 : 1)) >> 1;  // high pass
 
+        if (!skip_first_step)
         { // multiply by K or 1/K
           float K = atk->get_K();
           float K_inv = 1.0f / K;
@@ -254,7 +306,15 @@ namespace ojph {
 
         // the actual horizontal transform
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = 0; j < num_steps; ++j)
+        ui32 first_step = 0;
+        if (skip_first_step)
+        { // the first lifting step is performed by the caller
+          float* t = aug; aug = oth; oth = t;
+          ev = !ev;
+          ui32 w = aug_width; aug_width = oth_width; oth_width = w;
+          first_step = 1;
+        }
+        for (ui32 j = first_step; j < num_steps; ++j)
         {
           const lifting_step* s = atk->get_step(j);
           const float a = s->irv.Aatk;
@@ -596,11 +656,44 @@ namespace ojph {
       }
     }
 
+    /////////////////////////////////////////////////////////////////////////
+    void wasm_rev_vert_53(const vert_step_lines* lines, ui32 repeat,
+                          bool synthesis)
+    {
+      si32* dst0 = lines[0].aug->i32;
+      const si32* src01 = lines[0].sig->i32, * src02 = lines[0].other->i32;
+      si32* dst1 = lines[1].aug->i32;
+      const si32* src11 = lines[1].sig->i32, * src12 = lines[1].other->i32;
+      v128_t two = wasm_i32x4_splat(2);
+      for (ui32 i = 0; i < repeat; i += 4)
+      {
+        v128_t t0 = wasm_i32x4_add(wasm_v128_load(src01 + i),
+                                   wasm_v128_load(src02 + i));
+        v128_t d0 = wasm_v128_load(dst0 + i);
+        if (synthesis) // 5/3 update
+          d0 = wasm_i32x4_sub(d0,
+            wasm_i32x4_shr(wasm_i32x4_add(two, t0), 2));
+        else           // 5/3 predict
+          d0 = wasm_i32x4_sub(d0, wasm_i32x4_shr(t0, 1));
+        wasm_v128_store(dst0 + i, d0);
+
+        v128_t t1 = wasm_i32x4_add(wasm_v128_load(src11 + i),
+                                   wasm_v128_load(src12 + i));
+        v128_t d1 = wasm_v128_load(dst1 + i);
+        if (synthesis) // 5/3 predict
+          d1 = wasm_i32x4_add(d1, wasm_i32x4_shr(t1, 1));
+        else           // 5/3 update
+          d1 = wasm_i32x4_add(d1,
+            wasm_i32x4_shr(wasm_i32x4_add(two, t1), 2));
+        wasm_v128_store(dst1 + i, d1);
+      }
+    }
+
     /////////////////////////////////////////////////////////////////////////
     static
     void wasm_rev_horz_ana32(const param_atk* atk, const line_buf* ldst, 
                              const line_buf* hdst, const line_buf* src, 
-                             ui32 width, bool even)
+                             ui32 width, bool even, bool skip_last_step)
     {
       if (width > 1)
       {
@@ -617,7 +710,8 @@ namespace ojph {
         ui32 l_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 h_width = (width + (even ? 0 : 1)) >> 1;  // high pass
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = num_steps; j > 0; --j)
+        ui32 last_step = skip_last_step ? 1 : 0;
+        for (ui32 j = num_steps; j > last_step; --j)
         {
           // first lifting step
           const lifting_step* s = atk->get_step(j - 1);
@@ -768,7 +862,7 @@ namespace ojph {
     static
     void wasm_rev_horz_ana64(const param_atk* atk, const line_buf* ldst, 
                              const line_buf* hdst, const line_buf* src, 
-                             ui32 width, bool even)
+                             ui32 width, bool even, bool skip_last_step)
     {
       if (width > 1)
       {
@@ -785,7 +879,8 @@ namespace ojph {
         ui32 l_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 h_width = (width + (even ? 0 : 1)) >> 1;  // high pass
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = num_steps; j > 0; --j)
+        ui32 last_step = skip_last_step ? 1 : 0;
+        for (ui32 j = num_steps; j > last_step; --j)
         {
           // first lifting step
           const lifting_step* s = atk->get_step(j - 1);
@@ -935,27 +1030,27 @@ namespace ojph {
     /////////////////////////////////////////////////////////////////////////
     void wasm_rev_horz_ana(const param_atk* atk, const line_buf* ldst, 
                            const line_buf* hdst, const line_buf* src, 
-                           ui32 width, bool even)
+                           ui32 width, bool even, bool skip_last_step)
     {
       if (src->flags & line_buf::LFT_32BIT) 
       {
         assert((ldst == NULL || ldst->flags & line_buf::LFT_32BIT) &&
                (hdst == NULL || hdst->flags & line_buf::LFT_32BIT));
-        wasm_rev_horz_ana32(atk, ldst, hdst, src, width, even);
+        wasm_rev_horz_ana32(atk, ldst, hdst, src, width, even, skip_last_step);
       }
       else 
       {
         assert((ldst == NULL || ldst->flags & line_buf::LFT_64BIT) &&
                (hdst == NULL || hdst->flags & line_buf::LFT_64BIT) && 
                (src == NULL || src->flags & line_buf::LFT_64BIT));
-        wasm_rev_horz_ana64(atk, ldst, hdst, src, width, even);
+        wasm_rev_horz_ana64(atk, ldst, hdst, src, width, even, skip_last_step);
       }
     } 
 
     //////////////////////////////////////////////////////////////////////////
     void wasm_rev_horz_syn32(const param_atk* atk, const line_buf* dst, 
                              const line_buf* lsrc, const line_buf* hsrc, 
-                             ui32 width, bool even)
+                             ui32 width, bool even, bool skip_first_step)
     {
       if (width > 1)
       {
@@ -964,7 +1059,15 @@ namespace ojph {
         ui32 aug_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 oth_width = (width + (even ? 0 : 1)) >> 1;  // high pass
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = 0; j < num_steps; ++j)
+        ui32 first_step = 0;
+        if (skip_first_step)
+        { // the first lifting step is performed by the caller
+          si32* t = aug; aug = oth; oth = t;
+          ev = !ev;
+          ui32 w = aug_width; aug_width = oth_width; oth_width = w;
+          first_step = 1;
+        }
+        for (ui32 j = first_step; j < num_steps; ++j)
         {
           const lifting_step* s = atk->get_step(j);
           const si32 a = s->rev.Aatk;
@@ -1122,7 +1225,7 @@ namespace ojph {
     //////////////////////////////////////////////////////////////////////////
     void wasm_rev_horz_syn64(const param_atk* atk, const line_buf* dst, 
                              const line_buf* lsrc, const line_buf* hsrc, 
-                             ui32 width, bool even)
+                             ui32 width, bool even, bool skip_first_step)
     {
       if (width > 1)
       {
@@ -1131,7 +1234,15 @@ namespace ojph {
         ui32 aug_width = (width + (even ? 1 : 0)) >> 1;  // low pass
         ui32 oth_width = (width + (even ? 0 : 1)) >> 1;  // high pass
         ui32 num_steps = atk->get_num_steps();
-        for (ui32 j = 0; j < num_steps; ++j)
+        ui32 first_step = 0;
+        if (skip_first_step)
+        { // the first lifting step is performed by the caller
+          si64* t = aug; aug = oth; oth = t;
+          ev = !ev;
+          ui32 w = aug_width; aug_width = oth_width; oth_width = w;
+          first_step = 1;
+        }
+        for (ui32 j = first_step; j < num_steps; ++j)
         {
           const lifting_step* s = atk->get_step(j);
           const si32 a = s->rev.Aatk;
@@ -1289,20 +1400,22 @@ namespace ojph {
     /////////////////////////////////////////////////////////////////////////
     void wasm_rev_horz_syn(const param_atk* atk, const line_buf* dst, 
                            const line_buf* lsrc, const line_buf* hsrc, 
-                           ui32 width, bool even)
+                           ui32 width, bool even, bool skip_first_step)
     {
       if (dst->flags & line_buf::LFT_32BIT) 
       {
         assert((lsrc == NULL || lsrc->flags & line_buf::LFT_32BIT) && 
                (hsrc == NULL || hsrc->flags & line_buf::LFT_32BIT));
-        wasm_rev_horz_syn32(atk, dst, lsrc, hsrc, width, even);
+        wasm_rev_horz_syn32(atk, dst, lsrc, hsrc, width, even,
+          skip_first_step);
       }
       else 
       {
         assert((dst == NULL || dst->flags & line_buf::LFT_64BIT) &&
                (lsrc == NULL || lsrc->flags & line_buf::LFT_64BIT) && 
                (hsrc == NULL || hsrc->flags & line_buf::LFT_64BIT));
-        wasm_rev_horz_syn64(atk, dst, lsrc, hsrc, width, even);
+        wasm_rev_horz_syn64(atk, dst, lsrc, hsrc, width, even,
+          skip_first_step);
       }
     } 
 
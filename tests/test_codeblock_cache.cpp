@@ -0,0 +1,289 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, Aous Naman
+// Copyright (c) 2026, Kakadu Software Pty Ltd, Australia
+// Copyright (c) 2026, The University of New South Wales, Australia
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: test_codeblock_cache.cpp
+// Author: Aous Naman
+// Date: 19 October 2026
+//***************************************************************************/
+
+#include <cstring>
+#include <vector>
+#include "ojph_arch.h"
+#include "ojph_file.h"
+#include "ojph_mem.h"
+#include "ojph_params.h"
+#include "ojph_codestream.h"
+#include "gtest/gtest.h"
+
+using namespace ojph;
+
+////////////////////////////////////////////////////////////////////////////////
+//                                 helpers
+////////////////////////////////////////////////////////////////////////////////
+
+// describes the frames used by a test
+struct frame_desc
+{
+  ui32 width, height;
+  ui32 num_comps;
+  ui32 bit_depth;     // signed samples when above 16
+  size tile_size;     // no tiling if zero
+  bool tile_periodic; // all tiles have the same content
+};
+
+// a sample of frame frame_id; frames differ from frame 0 in a small
+// rectangle, whose location depends on frame_id
+static si32 sample(const frame_desc& d, ui32 frame_id, ui32 c,
+                   ui32 x, ui32 y)
+{
+  if (d.tile_periodic) {
+    x %= d.tile_size.w;
+    y %= d.tile_size.h;
+  }
+  ui32 v = (x * 7 + y * 13 + c * 101 + ((x * y) >> 3)) * 2654435761u;
+  if (frame_id > 0 && x >= 16 * frame_id && x < 16 * frame_id + 12
+      && y >= 4 && y < 20)
+    v ^= 0x5A5A5A5Au * frame_id;
+  if (d.bit_depth > 16)
+    return (si32)v >> (32 - d.bit_depth);   // signed
+  return (si32)(v >> (32 - d.bit_depth));   // unsigned
+}
+
+// sets the parameters of an encoding codestream
+static void set_params(codestream& cs, const frame_desc& d)
+{
+  param_siz siz = cs.access_siz();
+  siz.set_image_extent(point(d.width, d.height));
+  if (d.tile_size.w)
+    siz.set_tile_size(d.tile_size);
+  siz.set_num_components(d.num_comps);
+  for (ui32 c = 0; c < d.num_comps; ++c)
+    siz.set_component(c, point(1, 1), d.bit_depth, d.bit_depth > 16);
+  param_cod cod = cs.access_cod();
+  cod.set_num_decomposition(3);
+  cod.set_block_dims(16, 16);
+  cod.set_reversible(true);
+  cod.set_color_transform(d.num_comps == 3);
+  cs.set_planar(false);
+}
+
+// encodes frame frame_id into out, with cache if it is not NULL
+static void encode(const frame_desc& d, ui32 frame_id,
+                   codeblock_cache* cache, mem_outfile& out)
+{
+  codestream cs;
+  set_params(cs, d);
+  if (cache)
+    cs.set_codeblock_cache(cache);
+  out.open();
+  cs.write_headers(&out);
+  ui32 c;
+  line_buf* line = cs.exchange(NULL, c);
+  for (ui32 y = 0; y < d.height; ++y)
+    for (ui32 i = 0; i < d.num_comps; ++i)
+    {
+      for (ui32 x = 0; x < d.width; ++x)
+        line->i32[x] = sample(d, frame_id, c, x, y);
+      line = cs.exchange(line, c);
+    }
+  cs.flush();
+  cs.close();
+}
+
+// decodes a codestream, with cache if it is not NULL, returning the
+// samples of all components, one row after the other
+static std::vector<si32> decode(const mem_outfile& in, const frame_desc& d,
+                                codeblock_cache* cache)
+{
+  mem_infile file;
+  file.open(in.get_data(), in.get_used_size());
+  codestream cs;
+  cs.set_planar(false);
+  cs.read_headers(&file);
+  if (cache)
+    cs.set_codeblock_cache(cache);
+  cs.create();
+  std::vector<si32> samples;
+  samples.reserve((size_t)d.width * d.height * d.num_comps);
+  for (ui32 y = 0; y < d.height; ++y)
+    for (ui32 i = 0; i < d.num_comps; ++i)
+    {
+      ui32 c;
+      line_buf* line = cs.pull(c);
+      EXPECT_EQ(c, i);
+      samples.insert(samples.end(), line->i32, line->i32 + d.width);
+    }
+  cs.close();
+  return samples;
+}
+
+// the expected samples of frame frame_id
+static std::vector<si32> frame_samples(const frame_desc& d, ui32 frame_id)
+{
+  std::vector<si32> samples;
+  for (ui32 y = 0; y < d.height; ++y)
+    for (ui32 c = 0; c < d.num_comps; ++c)
+      for (ui32 x = 0; x < d.width; ++x)
+        samples.push_back(sample(d, frame_id, c, x, y));
+  return samples;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                  tests
+////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// decodes frame 0 twice, then frame 1, with one cache; the second decoding
+// of frame 0 reuses all codeblocks, and frame 1 reuses those that did not
+// change
+TEST(CodeblockCache, DecodeHitsAndMisses) {
+  frame_desc d = { 160, 96, 3, 8, size(), false };
+  mem_outfile cs0, cs1;
+  encode(d, 0, NULL, cs0);
+  encode(d, 1, NULL, cs1);
+  std::vector<si32> ref0 = decode(cs0, d, NULL);
+  std::vector<si32> ref1 = decode(cs1, d, NULL);
+  EXPECT_TRUE(ref0 == frame_samples(d, 0));
+  EXPECT_TRUE(ref1 == frame_samples(d, 1));
+
+  codeblock_cache cache;
+  ui64 hits, misses;
+  EXPECT_TRUE(decode(cs0, d, &cache) == ref0);
+  cache.get_stats(hits, misses);
+  EXPECT_EQ(hits, 0u);
+  ui64 num_cbs = misses;
+  EXPECT_GT(num_cbs, 0u);
+
+  EXPECT_TRUE(decode(cs0, d, &cache) == ref0);
+  cache.get_stats(hits, misses);
+  EXPECT_EQ(hits, num_cbs);
+  EXPECT_EQ(misses, num_cbs);
+
+  EXPECT_TRUE(decode(cs1, d, &cache) == ref1);
+  cache.get_stats(hits, misses);
+  ui64 changed = misses - num_cbs;
+  EXPECT_GT(changed, 0u);
+  EXPECT_LT(changed, num_cbs / 2);
+  EXPECT_EQ(hits + misses, 3 * num_cbs);
+
+  // going back to frame 0 misses the codeblocks that changed in frame 1
+  EXPECT_TRUE(decode(cs0, d, &cache) == ref0);
+  cache.get_stats(hits, misses);
+  EXPECT_EQ(misses, num_cbs + 2 * changed);
+
+  cache.clear();
+  cache.get_stats(hits, misses);
+  EXPECT_EQ(hits, 0u);
+  EXPECT_EQ(misses, 0u);
+  EXPECT_TRUE(decode(cs1, d, &cache) == ref1);
+  cache.get_stats(hits, misses);
+  EXPECT_EQ(hits, 0u);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// all tiles have the same content, so codeblocks of different tiles have
+// identical coded data, subband, and codeblock index; they must not be
+// mistaken for one another.  The many small tiles also make many cache
+// entries share hash table slots.
+TEST(CodeblockCache, DecodeIdenticalTiles) {
+  frame_desc d = { 640, 512, 1, 8, size(64, 64), true };
+  mem_outfile cs0, cs1;
+  encode(d, 0, NULL, cs0);
+  encode(d, 1, NULL, cs1);
+  std::vector<si32> ref0 = decode(cs0, d, NULL);
+  std::vector<si32> ref1 = decode(cs1, d, NULL);
+  EXPECT_TRUE(ref0 == frame_samples(d, 0));
+  EXPECT_TRUE(ref1 == frame_samples(d, 1));
+
+  codeblock_cache cache;
+  ui64 hits, misses;
+  EXPECT_TRUE(decode(cs0, d, &cache) == ref0);
+  cache.get_stats(hits, misses);
+  EXPECT_EQ(hits, 0u);       // identical data in other tiles do not hit
+  ui64 num_cbs = misses;
+
+  // the change in frame 1 is repeated in every tile
+  EXPECT_TRUE(decode(cs1, d, &cache) == ref1);
+  cache.get_stats(hits, misses);
+  EXPECT_GT(hits, 0u);
+  EXPECT_GT(misses, num_cbs);
+  EXPECT_EQ(hits + misses, 2 * num_cbs);
+
+  EXPECT_TRUE(decode(cs1, d, &cache) == ref1);
+  EXPECT_TRUE(decode(cs0, d, &cache) == ref0);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// encodes frames, where only some codeblocks change from one frame to the
+// next, with one cache; each codestream must be identical to the one
+// encoded without a cache
+static void check_cached_encoding(const frame_desc& d)
+{
+  codeblock_cache cache;
+  const ui32 frames[] = { 0, 1, 1, 2, 0 };
+  for (ui32 f : frames)
+  {
+    mem_outfile ref, out;
+    encode(d, f, NULL, ref);
+    encode(d, f, &cache, out);
+    ASSERT_EQ(ref.get_used_size(), out.get_used_size()) << "frame " << f;
+    EXPECT_EQ(memcmp(ref.get_data(), out.get_data(), ref.get_used_size()),
+      0) << "frame " << f;
+    EXPECT_TRUE(decode(out, d, NULL) == frame_samples(d, f));
+  }
+  ui64 hits, misses;
+  cache.get_stats(hits, misses);
+  EXPECT_GT(hits, 0u);
+  EXPECT_GT(misses, 0u);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// 8-bit samples are coded with 32-bit codeblock buffers
+TEST(CodeblockCache, EncodeIdentical32bit) {
+  frame_desc d = { 160, 96, 3, 8, size(), false };
+  check_cached_encoding(d);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// 30-bit samples are coded with 64-bit codeblock buffers
+TEST(CodeblockCache, EncodeIdentical64bit) {
+  frame_desc d = { 160, 96, 1, 30, size(), false };
+  check_cached_encoding(d);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// tiles of the same content must not share coded data in the cache
+TEST(CodeblockCache, EncodeIdenticalTiles) {
+  frame_desc d = { 640, 512, 1, 8, size(64, 64), true };
+  check_cached_encoding(d);
+}
@@ -36,7 +36,9 @@
 //***************************************************************************/
 
 #include <array>
+#include <cstdio>
 #include <string>
+#include <vector>
 #include "ojph_arch.h"
 #include "gtest/gtest.h"
 
@@ -256,6 +258,131 @@ void compare_files(const std::string& base_filename,
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+//                           write_packed_yuv
+////////////////////////////////////////////////////////////////////////////////
+// Writes a frame of pseudo-random samples in the packed or semi-planar
+// layout of ext (v210, uyvy, nv12, p010, or p016) to filename; padding and
+// unused bits are zero, as ojph_expand writes them.
+static
+bool write_packed_yuv(const std::string& filename, const std::string& ext,
+                      int width, int height)
+{
+  unsigned int seed = 0x1234567u;
+  auto next_sample = [&seed](int bit_depth) {
+    seed = seed * 1664525u + 1013904223u;
+    return seed >> (32 - bit_depth);
+  };
+  int cw = (width + 1) / 2, ch = (height + 1) / 2;
+  std::vector<unsigned char> data;
+
+  if (ext == "v210")
+  { // 6 pixels in 4 little-endian 32-bit words; Cb Y Cr, Y Cb Y, Cr Y Cb,
+    // Y Cr Y, with 10-bit samples at bits 0, 10, and 20 of each word
+    static const int word[3][6] = 
+      { {0, 1, 1, 2, 3, 3}, {0, 1, 2}, {0, 2, 3} };
+    static const int shift[3][6] = 
+      { {10, 0, 20, 10, 0, 20}, {0, 10, 20}, {20, 0, 10} };
+    size_t stride = (size_t)(width + 47) / 48 * 128;
+    data.assign(stride * (size_t)height, 0);
+    for (int y = 0; y < height; ++y)
+      for (int c = 0; c < 3; ++c)
+      {
+        int count = c == 0 ? width : cw, per_group = c == 0 ? 6 : 3;
+        for (int i = 0; i < count; ++i)
+        {
+          size_t w = stride * (size_t)y
+            + (size_t)(i / per_group) * 16 + (size_t)word[c][i % per_group] * 4;
+          unsigned int v = next_sample(10) << shift[c][i % per_group];
+          for (int b = 0; b < 4; ++b)
+            data[w + (size_t)b] |= (unsigned char)(v >> (8 * b));
+        }
+      }
+  }
+  else if (ext == "uyvy" || ext == "nv12")
+  { // every byte is an 8-bit sample when the width is even
+    data.resize(ext == "uyvy" ? (size_t)cw * 4 * (size_t)height
+      : (size_t)width * (size_t)height + (size_t)cw * 2 * (size_t)ch);
+    for (size_t i = 0; i < data.size(); ++i)
+      data[i] = (unsigned char)next_sample(8);
+  }
+  else if (ext == "p010" || ext == "p016")
+  { // 16-bit little-endian words, holding 10-bit samples in their MSBs
+    int bit_depth = ext == "p010" ? 10 : 16;
+    data.resize(2 * ((size_t)width * (size_t)height 
+                     + (size_t)cw * 2 * (size_t)ch));
+    for (size_t i = 0; i < data.size(); i += 2)
+    {
+      unsigned int v = next_sample(bit_depth) << (16 - bit_depth);
+      data[i] = (unsigned char)v;
+      data[i + 1] = (unsigned char)(v >> 8);
+    }
+  }
+  else
+    return false;
+
+  FILE *f = fopen(filename.c_str(), "wb");
+  if (f == NULL)
+    return false;
+  bool success = fwrite(data.data(), 1, data.size(), f) == data.size();
+  return fclose(f) == 0 && success;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                           read_whole_file
+////////////////////////////////////////////////////////////////////////////////
+// Reads filename into data; compare_files is not used for raw frames,
+// because it skips what looks like codestream comments
+static
+bool read_whole_file(const std::string& filename,
+                     std::vector<unsigned char>& data)
+{
+  data.clear();
+  FILE *f = fopen(filename.c_str(), "rb");
+  if (f == NULL)
+    return false;
+  unsigned char buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+    data.insert(data.end(), buf, buf + n);
+  fclose(f);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                        run_packed_yuv_round_trip
+////////////////////////////////////////////////////////////////////////////////
+// Generates a frame in the layout of ext, compresses it losslessly, expands
+// it to the same layout, and checks that the two files are identical
+void run_packed_yuv_round_trip(const std::string& base_filename,
+  const std::string& ext, int width, int height)
+{
+  try {
+    std::string result, command;
+    std::string src = std::string(OUT_FILE_DIR) + base_filename + "." + ext;
+    std::string dec = 
+      std::string(OUT_FILE_DIR) + base_filename + "_dec." + ext;
+    ASSERT_TRUE(write_packed_yuv(src, ext, width, height));
+    command = std::string(COMPRESS_EXECUTABLE)
+      + " -i " + src
+      + " -o " + OUT_FILE_DIR + base_filename + ".j2c"
+      + " -reversible true -dims \"{" + std::to_string(width) + ","
+      + std::to_string(height) + "}\"";
+    EXPECT_EQ(execute(command, result), 0);
+    command = std::string(EXPAND_EXECUTABLE)
+      + " -i " + OUT_FILE_DIR + base_filename + ".j2c"
+      + " -o " + dec;
+    EXPECT_EQ(execute(command, result), 0);
+    std::vector<unsigned char> src_data, dec_data;
+    ASSERT_TRUE(read_whole_file(src, src_data));
+    ASSERT_TRUE(read_whole_file(dec, dec_data));
+    EXPECT_TRUE(src_data == dec_data);
+  }
+  catch (const std::runtime_error& error) {
+    FAIL() << error.what();
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //                                  tests
 ////////////////////////////////////////////////////////////////////////////////
@@ -1460,6 +1587,41 @@ TEST(TestExecutables, DpxEnc1280x72016bitResolve18) {
               "dpx_1280x720_16bit.ppm", "", 3, mse, pae);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Test lossless round trips of the packed and semi-planar layouts; the 
+// frames are generated, and the expanded files must be identical to them.
+// v210 packs 6 pixels in 4 words, and lines are padded to 48 pixels; 102
+// pixels leave a line partially padded, and 100 pixels leave the last
+// group partially filled.
+TEST(TestExecutables, PackedV210Enc102x40) {
+  run_packed_yuv_round_trip("packed_v210_102x40", "v210", 102, 40);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST(TestExecutables, PackedV210Enc100x36) {
+  run_packed_yuv_round_trip("packed_v210_100x36", "v210", 100, 36);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST(TestExecutables, PackedUyvyEnc128x48) {
+  run_packed_yuv_round_trip("packed_uyvy_128x48", "uyvy", 128, 48);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST(TestExecutables, PackedNv12Enc128x48) {
+  run_packed_yuv_round_trip("packed_nv12_128x48", "nv12", 128, 48);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST(TestExecutables, PackedP010Enc130x50) {
+  run_packed_yuv_round_trip("packed_p010_130x50", "p010", 130, 50);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+TEST(TestExecutables, PackedP016Enc128x48) {
+  run_packed_yuv_round_trip("packed_p016_128x48", "p016", 128, 48);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //                                   main
 ////////////////////////////////////////////////////////////////////////////////
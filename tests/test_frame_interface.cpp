@@ -0,0 +1,308 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, Aous Naman
+// Copyright (c) 2026, Kakadu Software Pty Ltd, Australia
+// Copyright (c) 2026, The University of New South Wales, Australia
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: test_frame_interface.cpp
+// Author: Aous Naman
+// Date: 19 October 2026
+//***************************************************************************/
+
+#include <cstring>
+#include <vector>
+#include "ojph_arch.h"
+#include "ojph_file.h"
+#include "ojph_params.h"
+#include "ojph_codestream.h"
+#include "gtest/gtest.h"
+
+using namespace ojph;
+
+////////////////////////////////////////////////////////////////////////////////
+//                                 helpers
+////////////////////////////////////////////////////////////////////////////////
+
+// describes the image used by a test
+struct image_desc
+{
+  ui32 width, height;
+  ui32 num_comps;
+  ui32 bit_depth;
+  bool is_signed;
+  bool color_transform;
+  point last_comp_downsampling; // downsampling of the last component
+  size tile_size;               // no tiling if zero
+};
+
+// dimensions of component c
+static size comp_dims(const image_desc& d, ui32 c)
+{
+  point ds(1, 1);
+  if (c == d.num_comps - 1)
+    ds = d.last_comp_downsampling;
+  return size((d.width + ds.x - 1) / ds.x, (d.height + ds.y - 1) / ds.y);
+}
+
+// a sample value of component c, in [0, 2^bit_depth)
+static ui32 sample(const image_desc& d, ui32 c, ui32 x, ui32 y)
+{
+  ui32 v = (x * 7 + y * 13 + c * 101 + ((x * y) >> 2)) * 2654435761u;
+  return (v >> 7) & ((1u << d.bit_depth) - 1);
+}
+
+// bytes per sample of a pixel format
+static ui32 format_bytes(ui32 format)
+{
+  ui32 type = format & codestream::PF_TYPE_MASK;
+  return type == codestream::PF_UINT8 ? 1
+       : type == codestream::PF_FLOAT32 ? 4 : 2;
+}
+
+// converts a float that half-precision represents exactly, and that is
+// either zero or normal, to its half-precision representation
+static ui16 to_half(float f)
+{
+  ui32 u;
+  memcpy(&u, &f, 4);
+  if ((u & 0x7FFFFFFF) == 0)
+    return (ui16)(u >> 16);
+  ui32 sign = (u >> 16) & 0x8000;
+  ui32 exp = ((u >> 23) & 0xFF) - 127 + 15;
+  ui32 man = (u >> 13) & 0x3FF;
+  return (ui16)(sign | (exp << 10) | man);
+}
+
+// fills a push_frame()/pull_frame() buffer; all values are exact in each
+// of the pixel formats
+static std::vector<ui8> make_frame(const image_desc& d, ui32 format,
+                                   size_t& stride)
+{
+  bool planar = (format & codestream::PF_PLANAR) != 0;
+  ui32 type = format & codestream::PF_TYPE_MASK;
+  ui32 bytes = format_bytes(format);
+  ui32 rows = 0;
+  for (ui32 c = 0; c < (planar ? d.num_comps : 1); ++c)
+    rows += comp_dims(d, c).h;
+  stride = (size_t)d.width * (planar ? 1 : d.num_comps) * bytes + 8;
+  std::vector<ui8> buf(stride * rows);
+
+  ui8* plane = buf.data();
+  float scale = 1.0f / (float)(1u << d.bit_depth);
+  for (ui32 c = 0; c < d.num_comps; ++c)
+  {
+    size s = comp_dims(d, c);
+    ui32 step = planar ? 1 : d.num_comps;
+    for (ui32 y = 0; y < s.h; ++y)
+    {
+      ui8* row = plane + y * stride + (planar ? 0 : c * bytes);
+      for (ui32 x = 0; x < s.w; ++x)
+      {
+        ui32 v = sample(d, c, x, y);
+        ui8* p = row + (size_t)x * step * bytes;
+        float f = (float)v * scale - (d.is_signed ? 0.5f : 0.0f);
+        if (type == codestream::PF_UINT8)
+          *p = (ui8)v;
+        else if (type == codestream::PF_UINT16) {
+          ui16 t = (ui16)v;
+          memcpy(p, &t, 2);
+        }
+        else if (type == codestream::PF_FLOAT32)
+          memcpy(p, &f, 4);
+        else {
+          ui16 t = to_half(f);
+          memcpy(p, &t, 2);
+        }
+      }
+    }
+    if (planar)
+      plane += s.h * stride;
+  }
+  return buf;
+}
+
+// encodes a frame with push_frame() into out
+static void encode(const image_desc& d, const void* src, size_t stride,
+                   ui32 format, mem_outfile& out)
+{
+  codestream cs;
+  param_siz siz = cs.access_siz();
+  siz.set_image_extent(point(d.width, d.height));
+  if (d.tile_size.w)
+    siz.set_tile_size(d.tile_size);
+  siz.set_num_components(d.num_comps);
+  for (ui32 c = 0; c < d.num_comps; ++c)
+    siz.set_component(c,
+      c == d.num_comps - 1 ? d.last_comp_downsampling : point(1, 1),
+      d.bit_depth, d.is_signed);
+  param_cod cod = cs.access_cod();
+  cod.set_num_decomposition(3);
+  cod.set_reversible(true);
+  cod.set_color_transform(d.color_transform);
+
+  out.open();
+  cs.write_headers(&out);
+  cs.push_frame(src, stride, format);
+  cs.flush();
+  cs.close();
+}
+
+// decodes a codestream with pull_frame()
+static std::vector<ui8> decode(const mem_outfile& in, const image_desc& d,
+                               ui32 format, size_t& stride)
+{
+  std::vector<ui8> buf = make_frame(d, format, stride);
+  memset(buf.data(), 0xA5, buf.size());
+
+  mem_infile file;
+  file.open(in.get_data(), in.get_used_size());
+  codestream cs;
+  cs.read_headers(&file);
+  cs.create();
+  cs.pull_frame(buf.data(), stride, format);
+  cs.close();
+  return buf;
+}
+
+// compares the samples of two frames of the same format, ignoring padding
+static void expect_same_samples(const image_desc& d, ui32 format,
+                                const std::vector<ui8>& a,
+                                const std::vector<ui8>& b, size_t stride)
+{
+  bool planar = (format & codestream::PF_PLANAR) != 0;
+  ui32 bytes = format_bytes(format);
+  size_t plane = 0;
+  for (ui32 c = 0; c < d.num_comps; ++c)
+  {
+    size s = comp_dims(d, c);
+    ui32 step = planar ? 1 : d.num_comps;
+    size_t errors = 0;
+    for (ui32 y = 0; y < s.h; ++y)
+      for (ui32 x = 0; x < s.w; ++x)
+      {
+        size_t pos = plane + y * stride
+                   + ((size_t)x * step + (planar ? 0 : c)) * bytes;
+        errors += memcmp(a.data() + pos, b.data() + pos, bytes) != 0;
+      }
+    EXPECT_EQ(errors, 0u) << "component " << c;
+    if (planar)
+      plane += s.h * stride;
+  }
+}
+
+// encodes with in_format, decodes with out_format, and checks that the
+// decoded samples are those that were encoded
+static void round_trip(const image_desc& d, ui32 in_format,
+                       ui32 out_format)
+{
+  size_t in_stride, ref_stride, out_stride;
+  std::vector<ui8> src = make_frame(d, in_format, in_stride);
+  mem_outfile cs_data;
+  encode(d, src.data(), in_stride, in_format, cs_data);
+  std::vector<ui8> ref = make_frame(d, out_format, ref_stride);
+  std::vector<ui8> out = decode(cs_data, d, out_format, out_stride);
+  ASSERT_EQ(ref_stride, out_stride);
+  expect_same_samples(d, out_format, ref, out, out_stride);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                  tests
+////////////////////////////////////////////////////////////////////////////////
+
+typedef codestream cs;
+
+///////////////////////////////////////////////////////////////////////////////
+// 8-bit interleaved RGB with the colour transform
+TEST(FrameInterface, Uint8Interleaved) {
+  image_desc d = { 67, 45, 3, 8, false, true, point(1, 1), size() };
+  round_trip(d, cs::PF_UINT8, cs::PF_UINT8);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// 8-bit planar input, decoded to interleaved output
+TEST(FrameInterface, Uint8PlanarToInterleaved) {
+  image_desc d = { 67, 45, 3, 8, false, true, point(1, 1), size() };
+  round_trip(d, cs::PF_UINT8 | cs::PF_PLANAR, cs::PF_UINT8);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// 12-bit signed samples in 16-bit interleaved input, in tiles
+TEST(FrameInterface, Uint16InterleavedTiled) {
+  image_desc d = { 150, 77, 3, 12, true, false, point(1, 1), size(64, 32) };
+  round_trip(d, cs::PF_UINT16, cs::PF_UINT16 | cs::PF_PLANAR);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// float input and output, planar
+TEST(FrameInterface, Float32Planar) {
+  image_desc d = { 61, 40, 3, 10, false, true, point(1, 1), size() };
+  round_trip(d, cs::PF_FLOAT32 | cs::PF_PLANAR,
+    cs::PF_FLOAT32 | cs::PF_PLANAR);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// half-float input, which pull_frame() does not support, decoded to float
+TEST(FrameInterface, Float16Interleaved) {
+  image_desc d = { 61, 40, 3, 8, true, false, point(1, 1), size() };
+  size_t in_stride, ref_stride, out_stride;
+  std::vector<ui8> src = make_frame(d, cs::PF_FLOAT16, in_stride);
+  mem_outfile cs_data;
+  encode(d, src.data(), in_stride, cs::PF_FLOAT16, cs_data);
+  std::vector<ui8> ref = make_frame(d, cs::PF_FLOAT32, ref_stride);
+  std::vector<ui8> out = decode(cs_data, d, cs::PF_FLOAT32, out_stride);
+  expect_same_samples(d, cs::PF_FLOAT32, ref, out, out_stride);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// the colour transform with a fourth, subsampled component; components 0
+// to 2 must be processed together, and the fourth on its own
+TEST(FrameInterface, ColorTransformWithSubsampledComponent) {
+  image_desc d = { 67, 45, 4, 8, false, true, point(2, 2), size() };
+  round_trip(d, cs::PF_UINT8 | cs::PF_PLANAR, cs::PF_UINT8 | cs::PF_PLANAR);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// as above, with tiles, 16-bit samples, and float output
+TEST(FrameInterface, ColorTransformWithSubsampledComponentTiled) {
+  image_desc d = { 150, 77, 4, 16, false, true, point(2, 2), size(64, 48) };
+  round_trip(d, cs::PF_UINT16 | cs::PF_PLANAR,
+    cs::PF_UINT16 | cs::PF_PLANAR);
+  d.bit_depth = 10;
+  round_trip(d, cs::PF_UINT16 | cs::PF_PLANAR,
+    cs::PF_FLOAT32 | cs::PF_PLANAR);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// the same image without the subsampled component
+TEST(FrameInterface, ColorTransformFourComponents) {
+  image_desc d = { 67, 45, 4, 8, false, true, point(1, 1), size() };
+  round_trip(d, cs::PF_UINT8, cs::PF_UINT8);
+  round_trip(d, cs::PF_UINT8 | cs::PF_PLANAR, cs::PF_UINT8);
+}
+
@@ -0,0 +1,252 @@
+//***************************************************************************/
+// This software is released under the 2-Clause BSD license, included
+// below.
+//
+// Copyright (c) 2026, Aous Naman
+// Copyright (c) 2026, Kakadu Software Pty Ltd, Australia
+// Copyright (c) 2026, The University of New South Wales, Australia
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+//
+// 1. Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright
+// notice, this list of conditions and the following disclaimer in the
+// documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+// IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+// TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+// TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+// PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+// LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//***************************************************************************/
+// This file is part of the OpenJPH software implementation.
+// File: test_mem_outfile.cpp
+// Author: Aous Naman
+// Date: 19 October 2026
+//***************************************************************************/
+
+#include <cstring>
+#include <vector>
+#include "ojph_arch.h"
+#include "ojph_file.h"
+#include "ojph_mem.h"
+#include "ojph_params.h"
+#include "ojph_codestream.h"
+#include "gtest/gtest.h"
+
+using namespace ojph;
+
+////////////////////////////////////////////////////////////////////////////////
+//                                 helpers
+////////////////////////////////////////////////////////////////////////////////
+
+// bytes written to the files of the tests
+static std::vector<ui8> make_data(size_t size)
+{
+  std::vector<ui8> data(size);
+  for (size_t i = 0; i < size; ++i)
+    data[i] = (ui8)(i * 131 + (i >> 8));
+  return data;
+}
+
+// writes data in pieces of different sizes, using write() and
+// write_vec(), then seeks back and rewrites the first bytes
+static void write_pieces(outfile_base& file, const std::vector<ui8>& data)
+{
+  size_t pos = 0, piece = 1;
+  while (pos < data.size())
+  {
+    size_t n = ojph_min(piece, data.size() - pos);
+    if (piece & 1)
+      EXPECT_EQ(file.write(data.data() + pos, n), n);
+    else {
+      io_vec vecs[2] = { { data.data() + pos, n / 2 },
+                         { data.data() + pos + n / 2, n - n / 2 } };
+      EXPECT_EQ(file.write_vec(vecs, 2), n);
+    }
+    pos += n;
+    piece = piece * 3 + 1;
+  }
+  EXPECT_EQ(file.tell(), (si64)data.size());
+  EXPECT_EQ(file.seek(0, outfile_base::OJPH_SEEK_SET), 0);
+  EXPECT_EQ(file.write(data.data(), 16), 16u);
+  EXPECT_EQ(file.seek(0, outfile_base::OJPH_SEEK_SET), 0);
+  EXPECT_EQ(file.seek((si64)data.size(), outfile_base::OJPH_SEEK_CUR), 0);
+}
+
+// checks that file holds data
+static void expect_data(const mem_outfile& file,
+                        const std::vector<ui8>& data)
+{
+  ASSERT_EQ(file.get_used_size(), data.size());
+  EXPECT_EQ(memcmp(file.get_data(), data.data(), data.size()), 0);
+}
+
+// an overflow function that replaces the buffer with a larger one from a
+// list of buffers, which it receives in arg
+struct overflow_buffers
+{
+  std::vector<ui8> bufs[8];
+  int num_calls;
+};
+
+static void* provide_buffer(void* arg, void* buffer, size_t needed_size,
+                            size_t* new_size)
+{
+  overflow_buffers* o = (overflow_buffers*)arg;
+  if (o->num_calls >= 7)
+    return NULL;
+  std::vector<ui8>& cur = o->bufs[o->num_calls];
+  std::vector<ui8>& next = o->bufs[++o->num_calls];
+  EXPECT_EQ(buffer, (void*)cur.data());
+  next.resize(needed_size + 10);
+  memcpy(next.data(), cur.data(), cur.size());
+  *new_size = next.size();
+  return next.data();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                  tests
+////////////////////////////////////////////////////////////////////////////////
+
+///////////////////////////////////////////////////////////////////////////////
+// data that fit in the caller's buffer are written into it
+TEST(MemOutfile, ExternalBufferFits) {
+  std::vector<ui8> data = make_data(5000);
+  std::vector<ui8> buf(data.size());
+  mem_outfile file;
+  file.open(buf.data(), buf.size());
+  write_pieces(file, data);
+  file.reserve(0);
+  file.close();
+  EXPECT_EQ(file.get_data(), buf.data());
+  expect_data(file, data);
+  EXPECT_EQ(memcmp(buf.data(), data.data(), data.size()), 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// without an overflow function, data that outgrow the caller's buffer 
+// are moved to memory owned by the file; the caller's buffer is untouched
+// after that
+TEST(MemOutfile, ExternalBufferTooSmall) {
+  std::vector<ui8> data = make_data(5000);
+  std::vector<ui8> buf(100, 0xEE);
+  mem_outfile file;
+  file.open(buf.data(), 60);
+  write_pieces(file, data);
+  file.close();
+  EXPECT_NE(file.get_data(), buf.data());
+  expect_data(file, data);
+  EXPECT_EQ(buf[60], 0xEE);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// the overflow function provides larger buffers
+TEST(MemOutfile, ExternalBufferOverflow) {
+  std::vector<ui8> data = make_data(5000);
+  overflow_buffers o;
+  o.num_calls = 0;
+  o.bufs[0].resize(10);
+  mem_outfile file;
+  file.open(o.bufs[0].data(), o.bufs[0].size(), provide_buffer, &o);
+  write_pieces(file, data);
+  file.close();
+  EXPECT_GT(o.num_calls, 0);
+  EXPECT_EQ(file.get_data(), o.bufs[o.num_calls].data());
+  expect_data(file, data);
+
+  // reserve() obtains the whole buffer at once
+  o.num_calls = 0;
+  o.bufs[0].assign(10, 0);
+  file.open(o.bufs[0].data(), o.bufs[0].size(), provide_buffer, &o);
+  file.reserve(data.size());
+  EXPECT_EQ(o.num_calls, 1);
+  write_pieces(file, data);
+  EXPECT_EQ(o.num_calls, 1);
+  file.close();
+  expect_data(file, data);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// a file that used the caller's buffer allocates its own when opened with
+// open(size), and can go back to a caller's buffer
+TEST(MemOutfile, ReopenWithOwnBuffer) {
+  std::vector<ui8> data = make_data(3000);
+  std::vector<ui8> buf(data.size());
+  mem_outfile file;
+  file.open(buf.data(), buf.size());
+  write_pieces(file, data);
+  file.close();
+  expect_data(file, data);
+
+  std::vector<ui8> data2 = make_data(7000);
+  file.open(1024);
+  write_pieces(file, data2);
+  file.close();
+  EXPECT_NE(file.get_data(), buf.data());
+  expect_data(file, data2);
+  EXPECT_EQ(memcmp(buf.data(), data.data(), data.size()), 0);
+
+  file.open(buf.data(), buf.size());
+  write_pieces(file, data);
+  file.close();
+  EXPECT_EQ(file.get_data(), buf.data());
+  expect_data(file, data);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// a codestream written into a caller's buffer of the right size needs
+// neither the overflow function, nor memory of the file
+TEST(MemOutfile, CodestreamIntoExternalBuffer) {
+  mem_outfile ref;
+  std::vector<ui8> buf;
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    codestream cs;
+    param_siz siz = cs.access_siz();
+    siz.set_image_extent(point(200, 120));
+    siz.set_tile_size(size(64, 64));
+    siz.set_num_components(1);
+    siz.set_component(0, point(1, 1), 8, false);
+    param_cod cod = cs.access_cod();
+    cod.set_reversible(true);
+    cs.set_tilepart_divisions(true, false);
+    cs.request_tlm_marker(true);
+
+    overflow_buffers o;
+    o.num_calls = 7;             // fails if called
+    mem_outfile file;
+    if (pass == 0)
+      ref.open();
+    else
+      file.open(buf.data(), buf.size(), provide_buffer, &o);
+    cs.write_headers(pass == 0 ? (outfile_base*)&ref : &file);
+    ui32 c;
+    line_buf* line = cs.exchange(NULL, c);
+    for (ui32 y = 0; y < 120; ++y)
+    {
+      for (ui32 x = 0; x < 200; ++x)
+        line->i32[x] = (si32)((x * x + y * 3) & 0xFF);
+      line = cs.exchange(line, c);
+    }
+    cs.flush();
+    cs.close();
+    if (pass == 0)
+      buf.resize(ref.get_used_size());
+    else {
+      EXPECT_EQ(file.get_data(), buf.data());
+      ASSERT_EQ(file.get_used_size(), buf.size());
+      EXPECT_EQ(memcmp(ref.get_data(), buf.data(), buf.size()), 0);
+    }
+  }
+}